@@ -27,6 +27,7 @@
 #include "../Audio/audioBandEqualizer.h"
 #include "../Jack/jackAudioClients.h"
 #include "../Audio/audioPolyphonyMixer.h"
+#include "../Audio/audioDspLoadMeter.h"
 #include "../MIDI/midiStream.h"
 #include "../Settings/settings.h"
 #include "../DSP/dspVoice.h"
@@ -45,12 +46,22 @@ int AdjSynth::num_of_core_voices = 1;
 pthread_mutex_t voice_manage_mutex;
 // Mutex to handle busy/not-busy voices marking
 pthread_mutex_t voice_busy_mutex;
-// Mutex to controll audio memory blocks allocation
+// Mutex to controll audio memory blocks allocation (not used - the audio blocks pool is lock free)
 pthread_mutex_t voice_mem_blocks_allocation_control_mutex;
+// Mutex and condition to handle programs materialize requests
+pthread_mutex_t program_materialize_mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t program_materialize_cv = PTHREAD_COND_INITIALIZER;
+// Mutex to handle the note-ons pending for a program materialization (taken before voice_manage_mutex)
+pthread_mutex_t pending_note_ons_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 // Callback that is initiated by the AudioManager audio-update thread
 void callback_audio_voice_update(int voice_num)
 {
+	if (AdjSynth::synth_voice[voice_num] == NULL)
+	{
+		return;
+	}
+	
 	if (AdjSynth::synth_voice[voice_num]->audio_voice->is_voice_active() ||
 		AdjSynth::synth_voice[voice_num]->audio_voice->is_voice_wait_for_not_active())
 	{
@@ -58,13 +69,60 @@ void callback_audio_voice_update(int voice_num)
 	}
 }
 
+// Callback that is initiated by the AudioManager audio-update thread.
+// Returns the core the voice is allocated to by the polyphony manager; -1 if the voice is not playing.
+int callback_audio_voice_core(int voice_num)
+{
+	if ((AdjSynth::synth_voice[voice_num] == NULL) ||
+		!(AdjSynth::synth_voice[voice_num]->audio_voice->is_voice_active() ||
+		  AdjSynth::synth_voice[voice_num]->audio_voice->is_voice_wait_for_not_active()))
+	{
+		return -1;
+	}
+	
+	return AdjSynth::synth_polyphony_manager->get_voice_core(voice_num);
+}
+
 // Callback that is initiated by the AudioManager audio-update thread.
 void callback_audio_update_cycle_end_tasks(int param)
 {
 	AudioBlockFloat *p;
-	for (p = *AdjSynth::get_instance()->audio_poly_mixer->audio_first_update; p; p = p->audio_next_update)
+	AdjSynth *synth = AdjSynth::get_instance();
+	AudioDspLoadMeter *dsp_load_meter = AudioDspLoadMeter::get_instance();
+	long long start_ns, end_ns;
+	int stage;
+	
+	start_ns = AudioDspLoadMeter::get_time_ns();
+	
+	for (p = *synth->audio_poly_mixer->audio_first_update; p; p = p->audio_next_update)
 	{
 		p->update();
+		
+		// Measure each common block as its own DSP load stage
+		if (p == synth->audio_poly_mixer)
+		{
+			stage = _DSP_LOAD_STAGE_POLY_MIXER;
+		}
+		else if (p == synth->audio_equalizer)
+		{
+			stage = _DSP_LOAD_STAGE_EQUALIZER;
+		}
+		else if (p == synth->audio_reverb)
+		{
+			stage = _DSP_LOAD_STAGE_REVERB;
+		}
+		else if (p == synth->audio_out)
+		{
+			stage = _DSP_LOAD_STAGE_OUTPUT;
+		}
+		else
+		{
+			stage = _DSP_LOAD_STAGE_OTHER;
+		}
+		
+		end_ns = AudioDspLoadMeter::get_time_ns();
+		dsp_load_meter->add_stage_time(stage, end_ns - start_ns);
+		start_ns = end_ns;
 	}
 }
 
@@ -98,8 +156,9 @@ AdjSynth::AdjSynth()
 	hammond_percussion_soft = false; 
 	hammond_ercussion_3_rd = false; 
 	active_sketch = _SKETCH_PROGRAM_1;
+	program_idle_release_time_sec = _DEFAULT_PROGRAM_IDLE_RELEASE_TIME_SEC;
 	
-	polypony_manager = AdjPolyphonyManager::get_poly_manger_instance(num_of_core_voices);
+	polypony_manager = AdjPolyphonyManager::get_poly_manger_instance(num_of_voices);
 
 	// Allocate audio blocks data memory pool
 //	AllocateAudioMemoryBlocksFloatPool(_MAX_AUDIO_BLOCKS_MESSAGES_POOL_SIZE, audio_block_size); // moved down after setting sample-rate and block size
@@ -127,7 +186,7 @@ AdjSynth::AdjSynth()
 	play_mode = _PLAY_MODE_POLY;
 	midi_mapping_mode = _MIDI_MAPPING_MODE_SKETCH;
 	
-	synth_polyphony_manager = NULL; //AdjSynthPolyphony::get_instance(); // new AdjSynthPolyphony();
+	synth_polyphony_manager = polypony_manager; //AdjSynthPolyphony::get_instance(); // new AdjSynthPolyphony();
 	
 	// Don't change the order (stage - TODO:)
 	audio_manager = AudioManager::get_instance();
@@ -137,6 +196,9 @@ AdjSynth::AdjSynth()
 	
 	audio_manager->register_callback_audio_voice_update(&callback_audio_voice_update);
 	audio_manager->register_callback_audio_update_cycle_end_tasks(&callback_audio_update_cycle_end_tasks);
+	// Render voices on the cores they are allocated to by the polyphony manager
+	audio_manager->set_num_of_render_cores(polypony_manager->get_number_of_cores());
+	audio_manager->register_callback_audio_voice_core(&callback_audio_voice_core);
 	
 
 	program_wavetable = new Wavetable();
@@ -163,7 +225,7 @@ AdjSynth::AdjSynth()
 
 	audio_poly_mixer->set_active();
 
-	audio_equalizer = new AudioBandEqualizer(_AUDIO_STAGE_0, audio_block_size, &audio_common_first_update);
+	audio_equalizer = new AudioBandEqualizer(_AUDIO_STAGE_0, sample_rate, audio_block_size, &audio_common_first_update);
 
 	audio_reverb = new AudioReverb(_AUDIO_STAGE_0, sample_rate, audio_block_size, &audio_common_first_update);
 
@@ -171,6 +233,7 @@ AdjSynth::AdjSynth()
 		audio_block_size,
 		audio_manager->audio_block_stereo_float_shared_memory_outputs,
 		&audio_common_first_update);
+	audio_out->set_direct_output_buffer(audio_manager->audio_output_direct_buffer);
 
 	connection_mixer_out_L = audio_manager->connections_manager->get_audio_connection();
 	connection_mixer_out_R = audio_manager->connections_manager->get_audio_connection();	
@@ -205,7 +268,7 @@ AdjSynth::AdjSynth()
 
 AdjSynth::~AdjSynth()
 {
-	
+	stop_program_materialize_thread();
 }
 
 /**
@@ -263,6 +326,11 @@ int AdjSynth::set_sample_rate(int samp_rate)
 	{
 		audio_reverb->set_sample_rate(sample_rate);
 	}
+	
+	if (audio_equalizer)
+	{
+		audio_equalizer->set_sample_rate(sample_rate);
+	}
 
 	return sample_rate;
 }
@@ -333,7 +401,7 @@ int AdjSynth::get_audio_block_size() { return audio_block_size; }
 /**
 *	@brief	Sets the audio driver type
 *			Settings will be effective only after the next call to start_audio().
-*	@param	driver  _AUDIO_JACK, _AUDIO_ALSA (default: _DEFAULT_AUDIO)
+*	@param	driver  _AUDIO_JACK, _AUDIO_ALSA, _AUDIO_NULL (default: _DEFAULT_AUDIO)
 *	@return set audio-driver
 */
 int AdjSynth::set_audio_driver_type(int driver)
@@ -404,7 +472,9 @@ DSP_Voice *AdjSynth::get_original_main_dsp_voices(int voice)
 }
 
 /**
-*   @brief  Set synthvoice instances to point at program[0] voices //Create and initialize the synth voice instances
+*   @brief  Create and initialize the synth voice instances.
+*			A synth voice renders a pooled DSP voice bound at note-on, and is reassigned its
+*			own (original) DSP voice when the note ends.
 *   @param  none
 *   @return void
 */
@@ -421,23 +491,32 @@ void AdjSynth::init_synth_voices()
 			program_wavetable,
 			audio_manager);
 		
-		// Assign the program voice to the original voice
-		synth_voice[voice]->assign_dsp_voice(synth_program[active_sketch]->synth_voices[voice]->dsp_voice);
-		// Assingn LUTs
-		synth_voice[voice]->mso_wtab = synth_program[active_sketch]->mso_wtab;
-		synth_voice[voice]->pad_wavetable = synth_program[active_sketch]->program_wavetable;
+		// Restored when the voice ends (never rendered)
+		original_main_dsp_voices[voice] = synth_voice[voice]->dsp_voice;
 	}
 }
 
 /**
-*   @brief  Create and initialize the synth programs instances
+*   @brief  Create and initialize the synth programs instances.
+*			Only the sketch programs voices and wavetables are created here; the MIDI-mapping 
+*			programs are materialized by the programs materialize thread when mapped to a MIDI
+*			channel, or on demand (patch load or note on).
+*			The DSP voices pool shared by all the programs is created first.
 *   @param  none
 *   @return void
 */
 void AdjSynth::init_synth_programs()
 {
-	// Program[0] is the active non MIDIping mode program used for editting patches, etc.
-	// Program[1] to Program[16] are MIDI-mapping mode programs used each for a MIDI channel 1-16 
+	synth_voice_pool = new SynthVoicePool(
+		num_of_voices + _SYNTH_VOICE_POOL_SPARE_VOICES,
+		sample_rate,
+		audio_block_size,
+		mso_wtab,
+		program_wavetable);
+	
+
+	// Program[0] to Program[15] are MIDI-mapping mode programs used each for a MIDI channel 1-16 
+	// Program[16] to Program[18] are the sketch programs used for editting patches, etc.
 	for (int program = 0; program < num_of_programs; program++)
 	{		
 		synth_program[program] = new SynthProgram(
@@ -447,9 +526,272 @@ void AdjSynth::init_synth_programs()
 			0,						// 1st voice num'
 			_PAD_DEFAULT_WAVETABLE_SIZE,
 			audio_manager);
+		
+		if ((program >= _SKETCH_PROGRAM_1) && (program <= _SKETCH_PROGRAM_3))
+		{
+			// Sketch programs are always materialized (edited online)
+			synth_program[program]->materialize();
+		}
 	}
+	
+	start_program_materialize_thread();
+	materialize_mapped_programs();
 }
 
+/**
+*   @brief  Create a program voices and wavetables if not created yet (e.g. when a patch
+*			is loaded into a MIDI-mapping program), and play the note-ons that are pending
+*			for the program materialization.
+*			The voices management lock is not held: note-on does not use a program 
+*			until it is marked materialized.
+*   @param  prog	program number
+*   @return 0 if done; -1 illegal program number
+*/
+int AdjSynth::materialize_program(int prog)
+{
+	int res, note;
+	
+	if ((prog < 0) || (prog >= num_of_programs) || (synth_program[prog] == NULL))
+	{
+		return -1;
+	}
+	
+	res = synth_program[prog]->materialize();
+	
+	pthread_mutex_lock(&pending_note_ons_mutex);
+	
+	if (synth_program[prog]->is_materialized())
+	{
+		for (note = 0; note < 128; note++)
+		{
+			if (pending_note_on_velocity[prog][note] > 0)
+			{
+				play_program_note_on(prog, 
+					pending_note_on_channel[prog][note],
+					(uint8_t)note, 
+					pending_note_on_velocity[prog][note]);
+				
+				pending_note_on_velocity[prog][note] = 0;
+			}
+		}
+	}
+	
+	pthread_mutex_unlock(&pending_note_ons_mutex);
+	
+	return res;
+}
+
+/**
+*   @brief  Return true if a MIDI channel is mapped to a program: the MIDI-mapping
+*			programs in MIDI-mapping mode, and the sketch programs.
+*   @param  prog	program number
+*   @return true if a MIDI channel is mapped to the program
+*/
+bool AdjSynth::is_mapped_program(int prog)
+{
+	if ((prog >= _SKETCH_PROGRAM_1) && (prog <= _SKETCH_PROGRAM_3))
+	{
+		return true;
+	}
+	
+	return (midi_mapping_mode == _MIDI_MAPPING_MODE_MAPPING) && (prog >= 0) && (prog < _SKETCH_PROGRAM_1);
+}
+
+/**
+*   @brief  Request the programs materialize thread to create the voices and wavetables 
+*			of all the programs a MIDI channel is mapped to.
+*   @param  none
+*   @return void
+*/
+void AdjSynth::materialize_mapped_programs()
+{
+	for (int program = 0; program < num_of_programs; program++)
+	{
+		if ((synth_program[program] != NULL) && is_mapped_program(program) && 
+			!synth_program[program]->is_materialized())
+		{
+			request_program_materialization(program);
+		}
+	}
+}
+
+/**
+*   @brief  Request the programs materialize thread to create a program voices and wavetables
+*			(PAD wavetable generation is too long for the MIDI path).
+*   @param  prog	program number
+*   @return void
+*/
+void AdjSynth::request_program_materialization(int prog)
+{
+	if ((prog < 0) || (prog >= num_of_programs))
+	{
+		return;
+	}
+	
+	pthread_mutex_lock(&program_materialize_mutex);
+	program_materialize_requested[prog] = true;
+	pthread_cond_signal(&program_materialize_cv);
+	pthread_mutex_unlock(&program_materialize_mutex);
+}
+
+/**
+*   @brief  Wait for programs materialize requests and materialize the requested programs.
+*			Returns when the programs materialize thread is stopped.
+*   @param  none
+*   @return void
+*/
+void AdjSynth::run_program_materialization_requests()
+{
+	int program;
+	bool requested;
+	
+	pthread_mutex_lock(&program_materialize_mutex);
+	
+	while (program_materialize_thread_is_running)
+	{
+		for (program = 0; program < num_of_programs; program++)
+		{
+			requested = program_materialize_requested[program];
+			program_materialize_requested[program] = false;
+			
+			if (requested)
+			{
+				pthread_mutex_unlock(&program_materialize_mutex);
+				materialize_program(program);
+				pthread_mutex_lock(&program_materialize_mutex);
+			}
+		}
+		
+		for (program = 0; (program < num_of_programs) && !program_materialize_requested[program]; program++);
+		
+		if ((program == num_of_programs) && program_materialize_thread_is_running)
+		{
+			pthread_cond_wait(&program_materialize_cv, &program_materialize_mutex);
+		}
+	}
+	
+	pthread_mutex_unlock(&program_materialize_mutex);
+}
+
+/**
+*   @brief  Start the programs materialize thread.
+*   @param  none
+*   @return void
+*/
+void AdjSynth::start_program_materialize_thread()
+{
+	if (program_materialize_thread_is_running)
+	{
+		return;
+	}
+	
+	program_materialize_thread_is_running = true;
+	pthread_create(&program_materialize_thread_id, NULL, ADJSYNTH_program_materialize_thread, NULL);
+	pthread_setname_np(program_materialize_thread_id, "adjsyn_prog_mat");
+}
+
+/**
+*   @brief  Stop the programs materialize thread and wait for it to exit.
+*   @param  none
+*   @return void
+*/
+void AdjSynth::stop_program_materialize_thread()
+{
+	if (!program_materialize_thread_is_running)
+	{
+		return;
+	}
+	
+	pthread_mutex_lock(&program_materialize_mutex);
+	program_materialize_thread_is_running = false;
+	pthread_cond_signal(&program_materialize_cv);
+	pthread_mutex_unlock(&program_materialize_mutex);
+	
+	pthread_join(program_materialize_thread_id, NULL);
+}
+
+/**
+*   @brief  Programs materialize thread
+*   @param  arg a pointer to a void argument (not in use)
+*   @return void*
+*/
+void *ADJSYNTH_program_materialize_thread(void *arg)
+{
+	AdjSynth::get_instance()->run_program_materialization_requests();
+	
+	return NULL;
+}
+
+/**
+*   @brief  Release the voices and wavetables of MIDI-mapping programs that are not mapped
+*			to a MIDI channel and were not used for more than the program idle release time.
+*			Called periodically by a non real-time thread.
+*   @param  none
+*   @return void
+*/
+void AdjSynth::release_idle_programs()
+{
+	int program;
+	
+	if ((program_idle_release_time_sec == 0) || (synth_program[active_sketch] == NULL))
+	{
+		// Disabled, or programs are not initialized yet
+		return;
+	}
+	
+	// Note-on does not find a released program that is still materialized
+	pthread_mutex_lock(&pending_note_ons_mutex);
+	pthread_mutex_lock(&voice_manage_mutex);
+	
+	for (program = 0; program < num_of_programs; program++)
+	{
+		if (is_mapped_program(program))
+		{
+			// Mapped programs (and the sketch programs) are kept materialized
+			continue;
+		}
+		
+		if ((synth_program[program] == NULL) || 
+			!synth_program[program]->is_materialized() ||
+			synth_program[program]->has_voices_in_use() ||
+			(synth_program[program]->get_idle_time_sec() < program_idle_release_time_sec))
+		{
+			continue;
+		}
+		
+		// The synth voices render pooled DSP voices only, so none is rendering the program voices
+		synth_program[program]->release();
+	}
+	
+	pthread_mutex_unlock(&voice_manage_mutex);
+	pthread_mutex_unlock(&pending_note_ons_mutex);
+}
+
+/**
+*   @brief  Set the MIDI-mapping programs idle release time
+*   @param  sec	idle time in seconds (_PROGRAM_IDLE_RELEASE_TIME_SEC_MIN - _PROGRAM_IDLE_RELEASE_TIME_SEC_MAX);
+*				0: programs are never released
+*   @return 0 if done; -1 param out of range
+*/
+int AdjSynth::set_program_idle_release_time(int sec)
+{
+	if ((sec < _PROGRAM_IDLE_RELEASE_TIME_SEC_MIN) || (sec > _PROGRAM_IDLE_RELEASE_TIME_SEC_MAX))
+	{
+		return -1;
+	}
+	
+	program_idle_release_time_sec = sec;
+	
+	return 0;
+}
+
+/**
+*   @brief  Return the MIDI-mapping programs idle release time
+*   @param  none
+*   @return idle time in seconds (0: programs are never released)
+*/
+int AdjSynth::get_program_idle_release_time() { return program_idle_release_time_sec; }
+
 /**
 *   @brief   set the adj synth master volume
 *   @param  vol	volume level 0-100
@@ -705,6 +1047,7 @@ void AdjSynth::init_poly()
 		if (synth_voice[voice] != NULL)
 		{	
 			synth_voice[voice]->audio_voice->init_poly();
+			synth_voice[voice]->assign_dsp_voice(original_main_dsp_voices[voice]);
 		}
 		mark_voice_not_busy_callback(voice);
 
@@ -712,14 +1055,12 @@ void AdjSynth::init_poly()
 		{	
 			polypony_manager->clear_core_processing_load_weight(core);
 		}
-
-		for (int program = 0; program < _SYNTH_MAX_NUM_OF_PROGRAMS; program++)
-		{
-			if (synth_program[program]->synth_voices[voice] != NULL)
-			{	
-				synth_program[program]->synth_voices[voice]->dsp_voice->not_in_use();
-			}
-		}
+	}
+	
+	if (synth_voice_pool != NULL)
+	{
+		// Free all the programs voices
+		synth_voice_pool->release_all_voices();
 	}
 }
 
@@ -789,6 +1130,8 @@ void AdjSynth::set_midi_mapping_mode(int mod)
 	else if (mod == _MIDI_MAPPING_MODE_MAPPING)
 	{
 		midi_mapping_mode = _MIDI_MAPPING_MODE_MAPPING;
+		// Create the mapped programs before their channels notes arrive
+		materialize_mapped_programs();
 	}
 
 	audio_poly_mixer->set_midi_maping_mode(midi_mapping_mode);
@@ -906,6 +1249,7 @@ int AdjSynth::set_default_settings_parameters(_settings_params_t *params)
 	res = set_default_settings_parameters_equalizer(params);
 	res |= set_default_settings_parameters_reverb(params);
 	res |= set_default_settings_parameters_keyboard(params);
+	res |= set_default_settings_parameters_polyphony(params);
 	res |= set_default_settings_parameters_mixer(params);
 
 	//	// TODO: GLobal part of modsynth
@@ -976,9 +1320,7 @@ void AdjSynth::update_ui_callback()
 */
 void  AdjSynth::midi_play_note_on(uint8_t channel, uint8_t byte2, uint8_t byte3, int voc)
 {
-	int voice, core, scaledMagnitude, prog = 0;
-	bool reused = false;
-	SynthVoice *prog_voice = NULL;
+	int prog = 0;
 	
 	if (midi_mapping_mode == _MIDI_MAPPING_MODE_MAPPING)
 	{
@@ -989,14 +1331,49 @@ void  AdjSynth::midi_play_note_on(uint8_t channel, uint8_t byte2, uint8_t byte3,
 		prog = active_sketch;
 	}
 
-	pthread_mutex_lock(&voice_manage_mutex);
-
 	if (byte3 == 0)
 	{
-		pthread_mutex_unlock(&voice_manage_mutex);
 		midi_play_note_off(channel, byte2, byte3);
 		return;
 	}
+	
+	pthread_mutex_lock(&pending_note_ons_mutex);
+	
+	if (!synth_program[prog]->is_materialized())
+	{
+		// The program voices and wavetables are created by the programs materialize thread
+		// (not on the MIDI path); the note is played when the program is materialized.
+		pending_note_on_channel[prog][byte2 & 0x7f] = channel;
+		pending_note_on_velocity[prog][byte2 & 0x7f] = byte3;
+		pthread_mutex_unlock(&pending_note_ons_mutex);
+		request_program_materialization(prog);
+		return;
+	}
+	
+	play_program_note_on(prog, channel, byte2, byte3);
+	
+	pthread_mutex_unlock(&pending_note_ons_mutex);
+}
+
+/**
+*   @brief  Play note on of a materialized program.
+*			The caller must hold the pending note-ons lock.
+*   @param	prog	program number
+*   @param	channel	MIDI channel: 0-15 patc1-3: 16-18
+*	@param	byte2	note midi num
+*	@param	byte3	note velocity (> 0).
+*   @return void
+*/
+void AdjSynth::play_program_note_on(int prog, uint8_t channel, uint8_t byte2, uint8_t byte3)
+{
+	int voice, core, scaledMagnitude;
+	bool reused = false, stolen = false, stolen_fade_out = false;
+	SynthVoice *prog_voice = NULL;
+	DSP_Voice *pool_voice = NULL;
+	
+	pthread_mutex_lock(&voice_manage_mutex);
+	
+	synth_program[prog]->touch();
 
 	voice = -1;
 
@@ -1013,7 +1390,7 @@ void  AdjSynth::midi_play_note_on(uint8_t channel, uint8_t byte2, uint8_t byte3,
 		if (poly_mode == _KBD_POLY_MODE_REUSE)
 		{
 			voice = synth_polyphony_manager->get_reused_note((int)byte2, channel); // TODO: program = 0
-			if (voice > -1)
+			if (voice >= 0)
 			{
 				reused = true;
 			}
@@ -1029,12 +1406,13 @@ void  AdjSynth::midi_play_note_on(uint8_t channel, uint8_t byte2, uint8_t byte3,
 
 		if ((voice < 0) && (poly_mode == _KBD_POLY_MODE_FIFO))
 		{
-			// Not found yet - get the oldest active
-			voice = synth_polyphony_manager->get_oldest_voice();
+			// Not found yet (or the voices cap is reached) - steal the best scored sounding voice
+			voice = synth_polyphony_manager->get_voice_to_steal();
+			stolen = voice >= 0;
 		}
 	}
 
-	if ((voice > -1) && !reused)
+	if ((voice >= 0) && !reused)
 	{
 		/*	moved up	
 		 *	if (midi_mapping_mode == _MIDI_MAPPING_MODE_MAPPING)
@@ -1049,19 +1427,53 @@ void  AdjSynth::midi_play_note_on(uint8_t channel, uint8_t byte2, uint8_t byte3,
 		// Voice found and if not reused, get a free voice from mapped program		
 		prog_voice = synth_program[prog]->get_free_voice();
 		
-		if (!prog_voice)
+		if (prog_voice)
+		{
+			// Bind a pooled DSP voice to the program voice (set with the program patch)
+			pool_voice = synth_voice_pool->bind_voice(prog_voice, synth_program[prog]);
+			stolen_fade_out = stolen;
+			if (!pool_voice && stolen)
+			{
+				// No spare pooled voice to fade out the stolen voice - cut it and reuse its DSP voice
+				synth_voice_pool->release_voice(synth_voice[voice]->dsp_voice);
+				stolen_fade_out = false;
+				pool_voice = synth_voice_pool->bind_voice(prog_voice, synth_program[prog]);
+			}
+		}
+		
+		if (!pool_voice)
 			voice = -1;
 		else
 		{
-			// Assign the program voice to the free voice
-			synth_voice[voice]->assign_dsp_voice(prog_voice->dsp_voice);
+			if (stolen)
+			{
+				synth_polyphony_manager->count_stolen_voice();
+			}
+			
+			if (stolen_fade_out)
+			{
+				// The stolen voice is faded out over one control block, and then its pooled voice is freed
+				synth_voice[voice]->audio_voice->fade_out_stolen_voice(synth_voice[voice]->dsp_voice);
+			}
+			else if (!stolen)
+			{
+				// A re-triggered sounding voice (portamento) frees its previous pooled voice
+				synth_voice_pool->release_voice(synth_voice[voice]->dsp_voice);
+			}
+			
+			// Assign the bound pooled voice to the free voice
+			synth_voice[voice]->assign_dsp_voice(pool_voice);
 			// Assingn LUTs
 			synth_voice[voice]->mso_wtab = synth_program[prog]->mso_wtab;			
 			synth_voice[voice]->pad_wavetable = synth_program[prog]->program_wavetable;
 
 			synth_voice[voice]->allocated_to_program_num = prog_voice->allocated_to_program_num;
 			synth_voice[voice]->allocated_to_program_voice_num = prog_voice->voice_num;
-			audio_poly_mixer->preserve_gain_pan(voice);
+			if (!stolen)
+			{
+				// A stolen voice already preserved its original gain and pan
+				audio_poly_mixer->preserve_gain_pan(voice);
+			}
 			audio_poly_mixer->set_voice_gain_1_ptr(voice, prog);
 			audio_poly_mixer->set_voice_gain_2_ptr(voice, prog);
 			audio_poly_mixer->set_voice_pan_1_ptr(voice, prog);
@@ -1078,11 +1490,12 @@ void  AdjSynth::midi_play_note_on(uint8_t channel, uint8_t byte2, uint8_t byte3,
 		}
 	}
 _voice_is_on:
-	if ((voice > -1) && (synth_voice[voice] != NULL))
+	if ((voice >= 0) && (synth_voice[voice] != NULL))
 	{
-		if (!reused)
+		if (!reused && !stolen)
 		{
-			core = voice / num_of_core_voices;
+			// A stolen voice core load weight is already counted
+			core = synth_polyphony_manager->get_voice_core(voice);
 			pthread_mutex_lock(&voice_busy_mutex);
 			synth_polyphony_manager->increase_core_processing_load_weight(core, 
 							AdjPolyphonyManager::voice_processing_weight);
@@ -1169,6 +1582,10 @@ void  AdjSynth::midi_play_note_off(uint8_t channel, uint8_t byte2, uint8_t byte3
 		program = active_sketch;
 	}
 
+	pthread_mutex_lock(&pending_note_ons_mutex);
+	// A note released before its program was materialized is not played
+	pending_note_on_velocity[program][byte2 & 0x7f] = 0;
+	
 	pthread_mutex_lock(&voice_manage_mutex);
 
 	//	while ((voice  -1) /*&& (program < _SYNTH_NUM_OF_PROGRAMS)*/)
@@ -1179,7 +1596,7 @@ void  AdjSynth::midi_play_note_off(uint8_t channel, uint8_t byte2, uint8_t byte3
 	//		program++;
 	//	}
 
-	if (voice != -1)
+	if (voice >= 0)
 	{		
 		synth_voice[voice]->dsp_voice->adsr_note_off(synth_voice[voice]->dsp_voice->adsr_1);
 		synth_voice[voice]->dsp_voice->adsr_note_off(synth_voice[voice]->dsp_voice->adsr_2);
@@ -1206,4 +1623,5 @@ void  AdjSynth::midi_play_note_off(uint8_t channel, uint8_t byte2, uint8_t byte3
 	kbd1->midi_play_note_off(channel, byte2, byte3);
 
 	pthread_mutex_unlock(&voice_manage_mutex);
+	pthread_mutex_unlock(&pending_note_ons_mutex);
 }
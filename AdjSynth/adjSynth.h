@@ -24,6 +24,8 @@
 #include "adjSynthPolyphony.h"
 #include "adjSynthProgram.h"
 #include "adjSynthPolyphonyManager.h"
+#include "adjSynthVoicePool.h"
+#include "adjSynthWavetablesRegistry.h"
 #include "synthKeyboard.h"
 
 #include "../Audio/audioManager.h"
@@ -38,6 +40,7 @@ class AudioOutputFloat;
 class AudioPolyMixerFloat;
 
 void callback_audio_voice_update(int voice_num);
+int callback_audio_voice_core(int voice_num);
 void callback_audio_update_cycle_end_tasks(int param);
 //void callback_voice_end(int voice);
 
@@ -70,6 +73,16 @@ public:
 	void init_synth_voices();
 
 	void init_synth_programs();	
+	int materialize_program(int prog);
+	void request_program_materialization(int prog);
+	bool is_mapped_program(int prog);
+	void materialize_mapped_programs();
+	void run_program_materialization_requests();
+	void start_program_materialize_thread();
+	void stop_program_materialize_thread();
+	void release_idle_programs();
+	int set_program_idle_release_time(int sec);
+	int get_program_idle_release_time();
 
 	void set_master_volume(int vol);
 	int get_master_volume();
@@ -112,6 +125,7 @@ public:
 	int set_default_settings_parameters_reverb(_settings_params_t *params);
 	int set_default_settings_parameters_mixer(_settings_params_t *params);
 	int set_default_settings_parameters_keyboard(_settings_params_t *params);
+	int set_default_settings_parameters_polyphony(_settings_params_t *params);
 
 	//int set_default_general_settings_parameters(_setting_params_t *params);
 	//int set_default_settings_parameters_audio(_setting_params_t *params);
@@ -140,6 +154,8 @@ public:
 	int reverb_event_bool(int revid, int eventid, bool val, _settings_params_t *params);
 	int band_equilizer_event(int beqid, int eventid, int val, _settings_params_t *params);
 	int band_equilizer_event_bool(int beqid, int eventid, bool val, _settings_params_t *params);	
+	int set_equalizer_bands(int num_of_bands, const float *center_frequencies);
+	int get_equalizer_num_of_bands();
 	int midi_mixer_event(int mixid, int eventid, int val, _settings_params_t *params);	
 	int kbd_event_int(int kbid, int eventid, int val, _settings_params_t *params);
 	int kbd_event_bool(int kbid, int eventid, bool val, _settings_params_t *params);
@@ -149,6 +165,9 @@ public:
 	void  midi_play_note_on(uint8_t channel, uint8_t byte2, uint8_t byte3, int voc = 0);
 	void  midi_play_note_off(uint8_t channel, uint8_t byte2, uint8_t byte3, int voc = 0);
 	
+	int run_offline_benchmark(_offline_benchmark_result_t *results, int num_of_cycles);
+	int get_num_of_playing_voices();
+	
 	// UI callbacks intiations
 	void set_num_of_poly_disp_callback(int numv);
 	void mark_voice_not_busy_callback(int vnum);
@@ -177,7 +196,9 @@ public:
 		Each of them is only a pointer to a SynthVoice object. */
 	static SynthVoice *synth_voice[_SYNTH_MAX_NUM_OF_VOICES];
 
-	SynthProgram *synth_program[_SYNTH_MAX_NUM_OF_PROGRAMS];
+	SynthProgram *synth_program[_SYNTH_MAX_NUM_OF_PROGRAMS] = { NULL };
+	/** The DSP voices shared by all the programs (bound to a program voice on note-on) */
+	SynthVoicePool *synth_voice_pool = NULL;
 	static AdjPolyphonyManager *synth_polyphony_manager;
 
 	SynthPADcreator *synth_pad_creator = NULL;
@@ -200,6 +221,10 @@ private:
 	AdjSynth();
 	
 	static AdjSynth *adj_synth;
+	
+	void set_benchmark_generators_state(bool *enable);
+	
+	void play_program_note_on(int prog, uint8_t channel, uint8_t byte2, uint8_t byte3);
 
 	/* Holds the AdjSynth patch parameters */	
 	_settings_params_t active_adj_synth_patch_params;
@@ -219,6 +244,17 @@ private:
 	int num_of_voices;
 	int num_of_programs;
 	int active_sketch;
+	
+	// MIDI-mapping programs are released after being idle for this time (0: never)
+	int program_idle_release_time_sec;
+	
+	// Programs to be materialized by the programs materialize thread (requested on note-on or mapping)
+	bool program_materialize_requested[_SYNTH_MAX_NUM_OF_PROGRAMS] = { false };
+	bool program_materialize_thread_is_running = false;
+	pthread_t program_materialize_thread_id;
+	// Note-ons pending for a program materialization (channel and velocity of each note; velocity 0: none)
+	uint8_t pending_note_on_channel[_SYNTH_MAX_NUM_OF_PROGRAMS][128] = { { 0 } };
+	uint8_t pending_note_on_velocity[_SYNTH_MAX_NUM_OF_PROGRAMS][128] = { { 0 } };
 
 	int master_volume;
 	
@@ -242,6 +278,9 @@ private:
 	
 };
 
+// Creates the programs voices and wavetables requested on the MIDI path
+void *ADJSYNTH_program_materialize_thread(void *arg);
+
 //Callbacks to set general settings
 
 int set_audio_jack_mode_cb(int mode, int prog);
@@ -251,6 +290,13 @@ int set_audio_jack_auto_connect_state_cb(bool state, int prog);
 int set_audio_sample_rate_cb(int rate, int prog);
 int set_audio_block_size_cb(int size, int prog);
 int set_audio_driver_type_cb(int driver, int prog);
+int set_audio_multi_core_voices_rendering_state_cb(bool state, int prog);
+int set_audio_blocks_arena_state_cb(bool state, int prog);
+int set_audio_jack_direct_output_state_cb(bool state, int prog);
+int set_audio_jack_render_in_callback_state_cb(bool state, int prog);
+int set_audio_update_timer_catch_up_state_cb(bool state, int prog);
+int set_audio_voice_silence_threshold_cb(int thresh_db, int prog);
+int set_audio_voice_silence_hold_time_cb(int hold_ms, int prog);
 
 int set_amp_ch_1_send_cb(int lev, int prog);
 int set_amp_ch_2_send_cb(int lev, int prog);
@@ -306,6 +352,12 @@ int set_keyboard_split_point_cb(int splt, int prog);
 int set_keyboard_polyphonic_mode_cb(int mod, int prog);
 int set_keyboard_portamento_enable_state_cb(bool en, int prog);
 
+int set_polyphony_governor_state_cb(bool en, int prog);
+int set_polyphony_governor_high_load_cb(int load, int prog);
+int set_polyphony_governor_low_load_cb(int load, int prog);
+int set_polyphony_governor_min_voices_cb(int voices, int prog);
+int set_program_idle_release_time_cb(int sec, int prog);
+
 int set_mixer_channel_level_cb(int lev, int chan);
 int set_mixer_channel_pan_cb(int pan, int chan);
 int set_mixer_channel_send_cb(int snd, int chan);
@@ -459,6 +511,7 @@ int set_voice_block_filter_1_octave_cb(int oct, int voice, int prog);
 int set_voice_block_filter_1_q_cb(int q, int voice, int prog);
 int set_voice_block_filter_1_kbd_track_cb(int kbdt, int voice, int prog);
 int set_voice_block_filter_1_band_cb(int bnd, int voice, int prog);
+int set_voice_block_filter_1_model_cb(int mdl, int voice, int prog);
 int set_voice_block_filter_1_freq_modulation_lfo_num_cb(int lfo, int voice, int prog);
 int set_voice_block_filter_1_freq_modulation_lfo_level_cb(int lev, int voice, int prog);
 int set_voice_block_filter_1_freq_modulation_env_num_cb(int env, int voice, int prog);
@@ -469,6 +522,7 @@ int set_voice_block_filter_2_octave_cb(int oct, int voice, int prog);
 int set_voice_block_filter_2_q_cb(int q, int voice, int prog);
 int set_voice_block_filter_2_kbd_track_cb(int kbdt, int voice, int prog);
 int set_voice_block_filter_2_band_cb(int bnd, int voice, int prog);
+int set_voice_block_filter_2_model_cb(int mdl, int voice, int prog);
 int set_voice_block_filter_2_freq_modulation_lfo_num_cb(int lfo, int voice, int prog);
 int set_voice_block_filter_2_freq_modulation_lfo_level_cb(int lev, int voice, int prog);
 int set_voice_block_filter_2_freq_modulation_env_num_cb(int env, int voice, int prog);
@@ -0,0 +1,258 @@
+/**
+*	@file		adjSynthBenchmark.cpp
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0
+*
+*	@brief		Offline benchmark of the full AdjSynth audio graph (voices, poly-mixer,
+*				equalizer, reverb and output), run without an audio device.
+*
+*				The audio service must run with the null audio driver (_AUDIO_NULL). For each
+*				patch preset (the default patch with the generators of one of the
+*				adjSynthDefaultPatchParams modules enabled) an increasing number of notes is
+*				played through midi_play_note_on/off() and the update cycles are run back to
+*				back on the calling thread.
+*
+*	History:\n
+*
+*	version 1.0		17-Oct-2026:
+*		First version
+*
+*/
+
+#include "adjSynth.h"
+#include "../Audio/audioDspLoadMeter.h"
+
+extern pthread_mutex_t voice_manage_mutex;
+
+// Update cycles run after the notes are played and before measuring
+#define _OFFLINE_BENCHMARK_WARMUP_CYCLES		8
+// Max update cycles waiting for the released voices to end
+#define _OFFLINE_BENCHMARK_MAX_RELEASE_CYCLES	2000
+// 1st played note (C2); following voices play the next semitones
+#define _OFFLINE_BENCHMARK_BASE_NOTE			36
+#define _OFFLINE_BENCHMARK_NOTE_VELOCITY		100
+
+/* The benchmarked generators enable parameters */
+static const char *benchmark_generators_enable_params[] =
+{
+	"adjsynth.osc1.enabled",
+	"adjsynth.osc2.enabled",
+	"adjsynth.noise.enabled",
+	"adjsynth.karplus_synth.enabled",
+	"adjsynth.mso_synth.enabled",
+	"adjsynth.pad_synth.enabled"
+};
+
+#define _OFFLINE_BENCHMARK_NUM_OF_GENERATORS	6
+
+/**
+*   @brief  Sets the active sketch generators enable state.
+*   @param	enable	an array of _OFFLINE_BENCHMARK_NUM_OF_GENERATORS enable states, ordered as
+*					benchmark_generators_enable_params
+*   @return void
+*/
+void AdjSynth::set_benchmark_generators_state(bool *enable)
+{
+	_settings_params_t *params = get_active_patch_params();
+	int program = get_active_sketch();
+
+	vco_event_bool(_OSC_1_EVENT, _OSC_ENABLE, enable[0], params, program);
+	vco_event_bool(_OSC_2_EVENT, _OSC_ENABLE, enable[1], params, program);
+	noise_event_bool(_NOISE_1_EVENT, _NOISE_ENABLE, enable[2], params, program);
+	karplus_event_bool(_KARPLUS_1_EVENT, _KARPLUS_STRONG_ENABLE, enable[3], params, program);
+	mso_event_bool(_MSO_1_EVENT, _MSO_ENABLE, enable[4], params, program);
+	pad_event_bool(_PAD_1_EVENT, _PAD_ENABLE, enable[5], params, program);
+}
+
+/**
+*   @brief  Returns the number of playing voices (active or waiting for not active)
+*   @param	none
+*   @return the number of playing voices
+*/
+int AdjSynth::get_num_of_playing_voices()
+{
+	int playing = 0;
+
+	for (int voice = 0; voice < num_of_voices; voice++)
+	{
+		if (synth_voice[voice] &&
+			(synth_voice[voice]->audio_voice->is_voice_active() ||
+			 synth_voice[voice]->audio_voice->is_voice_wait_for_not_active()))
+		{
+			playing++;
+		}
+	}
+
+	return playing;
+}
+
+/**
+*   @brief  Runs the offline benchmark for each patch preset.
+*			The audio service must run with the null audio driver (_AUDIO_NULL).
+*			For each number of voices from 1 to the max number of voices, the notes are
+*			played, the update cycles are run and measured, and the notes are released.
+*   @param	results			a pointer to an array of _OFFLINE_BENCHMARK_NUM_OF_PRESETS
+*							_offline_benchmark_result_t structs to be filled
+*   @param	num_of_cycles	number of measured update cycles for each number of voices
+*   @return 0 if done; -1 if parameters are out of range or the null audio driver is not running
+*/
+int AdjSynth::run_offline_benchmark(_offline_benchmark_result_t *results, int num_of_cycles)
+{
+	_settings_bool_param_t param;
+	bool saved_state[_OFFLINE_BENCHMARK_NUM_OF_GENERATORS];
+	bool preset_state[_OFFLINE_BENCHMARK_NUM_OF_GENERATORS];
+	long long period_ns, cycle_ns, total_ns, max_ns, start_ns;
+	int preset, voices, playing, cycle, note, gen;
+	uint8_t channel = (uint8_t)get_active_sketch();
+
+	return_val_if_true(results == NULL || num_of_cycles <= 0, -1);
+
+	// Verify the null driver is running (also warms the pools up)
+	if (audio_manager->run_offline_update_cycle() != 0)
+	{
+		fprintf(stderr, "Offline benchmark: audio service is not running with the null audio driver\n");
+		return -1;
+	}
+
+	period_ns = ((long long)audio_block_size * 1000000000LL) / sample_rate;
+
+	for (gen = 0; gen < _OFFLINE_BENCHMARK_NUM_OF_GENERATORS; gen++)
+	{
+		saved_state[gen] = false;
+		if (adj_synth_settings_manager->get_bool_param(get_active_patch_params(),
+				benchmark_generators_enable_params[gen], &param) == _SETTINGS_KEY_FOUND)
+		{
+			saved_state[gen] = param.value;
+		}
+	}
+
+	for (preset = 0; preset < _OFFLINE_BENCHMARK_NUM_OF_PRESETS; preset++)
+	{
+		for (gen = 0; gen < _OFFLINE_BENCHMARK_NUM_OF_GENERATORS; gen++)
+		{
+			preset_state[gen] = preset == _OFFLINE_BENCHMARK_PRESET_ALL;
+		}
+
+		switch (preset)
+		{
+			case _OFFLINE_BENCHMARK_PRESET_VCO:
+				preset_state[0] = true;
+				preset_state[1] = true;
+				break;
+
+			case _OFFLINE_BENCHMARK_PRESET_NOISE:
+				preset_state[2] = true;
+				break;
+
+			case _OFFLINE_BENCHMARK_PRESET_KPS:
+				preset_state[3] = true;
+				break;
+
+			case _OFFLINE_BENCHMARK_PRESET_MSO:
+				preset_state[4] = true;
+				break;
+
+			case _OFFLINE_BENCHMARK_PRESET_PAD:
+				preset_state[5] = true;
+				break;
+		}
+
+		set_benchmark_generators_state(preset_state);
+
+		results[preset].preset = preset;
+		results[preset].num_of_voices = 0;
+		results[preset].realtime_factor = 0;
+		results[preset].ns_per_sample_per_voice = 0;
+		results[preset].max_polyphony_at_deadline = 0;
+
+		for (voices = 1; voices <= num_of_voices; voices++)
+		{
+			for (note = 0; note < voices; note++)
+			{
+				midi_play_note_on(channel, _OFFLINE_BENCHMARK_BASE_NOTE + note, _OFFLINE_BENCHMARK_NOTE_VELOCITY);
+			}
+
+			for (cycle = 0; cycle < _OFFLINE_BENCHMARK_WARMUP_CYCLES; cycle++)
+			{
+				audio_manager->run_offline_update_cycle();
+			}
+
+			playing = get_num_of_playing_voices();
+
+			total_ns = 0;
+			max_ns = 0;
+			for (cycle = 0; cycle < num_of_cycles; cycle++)
+			{
+				start_ns = AudioDspLoadMeter::get_time_ns();
+				audio_manager->run_offline_update_cycle();
+				cycle_ns = AudioDspLoadMeter::get_time_ns() - start_ns;
+
+				total_ns += cycle_ns;
+				if (cycle_ns > max_ns)
+				{
+					max_ns = cycle_ns;
+				}
+			}
+
+			if ((max_ns <= period_ns) && (playing > results[preset].max_polyphony_at_deadline))
+			{
+				results[preset].max_polyphony_at_deadline = playing;
+			}
+
+			if ((playing > results[preset].num_of_voices) && (total_ns > 0))
+			{
+				results[preset].num_of_voices = playing;
+				results[preset].realtime_factor = (float)((double)period_ns * num_of_cycles / total_ns);
+				results[preset].ns_per_sample_per_voice =
+					(float)((double)total_ns / ((double)num_of_cycles * audio_block_size * playing));
+			}
+
+			for (note = 0; note < voices; note++)
+			{
+				midi_play_note_off(channel, _OFFLINE_BENCHMARK_BASE_NOTE + note, 0);
+			}
+
+			for (cycle = 0; (cycle < _OFFLINE_BENCHMARK_MAX_RELEASE_CYCLES) && (get_num_of_playing_voices() > 0); cycle++)
+			{
+				audio_manager->run_offline_update_cycle();
+			}
+
+			// Voices that did not end (long release) are ended as a decayed voice is: the pooled
+			// DSP voice is freed and the voice is freed by the polyphony manager
+			pthread_mutex_lock(&voice_manage_mutex);
+			for (int voice = 0; voice < num_of_voices; voice++)
+			{
+				if (synth_voice[voice] &&
+					(synth_voice[voice]->audio_voice->is_voice_active() ||
+					 synth_voice[voice]->audio_voice->is_voice_wait_for_not_active()))
+				{
+					DSP_Voice *dsp_voice = synth_voice[voice]->dsp_voice;
+					
+					dsp_voice->end_voice(voice);
+					// Not rendered now - the pooled DSP voice is freed at once
+					dsp_voice->free_if_ended();
+					synth_polyphony_manager->free_voice(voice, false);
+				}
+			}
+			pthread_mutex_unlock(&voice_manage_mutex);
+
+			if (playing < voices)
+			{
+				// No more free voices
+				break;
+			}
+		}
+
+		fprintf(stderr, "Offline benchmark preset %i: voices %i realtime factor %.2f ns/sample/voice %.1f max polyphony at deadline %i\n",
+			preset,
+			results[preset].num_of_voices,
+			results[preset].realtime_factor,
+			results[preset].ns_per_sample_per_voice,
+			results[preset].max_polyphony_at_deadline);
+	}
+
+	set_benchmark_generators_state(saved_state);
+
+	return 0;
+}
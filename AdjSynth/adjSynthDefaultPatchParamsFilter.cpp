@@ -1,14 +1,16 @@
 /**
 *	@file		adjSynthDefaultPatchParamsFilter.cpp
 *	@author		Nahum Budin
-*	@date		4-Oct-2024
-*	@version	1.2
-*					1. Code refactoring and notaion.
+*	@date		17-Oct-2026
+*	@version	1.3
+*					1. Filters model parameters.
 *	
 *	@brief		Set default patch Filters parameters
 *
 *	History:\n
 *	
+*	version 1.2	4-Oct-2024
+*					1. Code refactoring and notaion.
 *	version 1.1	5-Feb-2021
 *					1. Using sample-rate
 *			1.0	15_Nov-2019	First version
@@ -102,6 +104,22 @@ int AdjSynth::set_default_patch_parameters_filter(_settings_params_t *params, in
 		_SET_BLOCK_STOP_INDEX | _SET_BLOCK_CALLBACK,
 		prog);
 
+	res |= adj_synth_settings_manager->set_int_param
+				(params,
+		"adjsynth.filter1.model",
+		_FILTER_MODEL_SVF,
+		_FILTER_MODEL_LADDER,
+		_FILTER_MODEL_SVF,
+		_ADJ_SYNTH_PATCH_PARAMS,
+		NULL,
+		0,
+		num_of_voices - 1,
+		set_voice_block_filter_1_model_cb,
+		_SET_VALUE | _SET_MAX_VAL | _SET_MIN_VAL | 
+		_SET_TYPE | _SET_BLOCK_START_INDEX | 
+		_SET_BLOCK_STOP_INDEX | _SET_BLOCK_CALLBACK,
+		prog);
+
 	res |= adj_synth_settings_manager->set_int_param
 				(params,
 		"adjsynth.filter1.freq_modulation_lfo_num",
@@ -246,6 +264,22 @@ int AdjSynth::set_default_patch_parameters_filter(_settings_params_t *params, in
 		_SET_BLOCK_STOP_INDEX | _SET_BLOCK_CALLBACK,
 		prog);
 
+	res |= adj_synth_settings_manager->set_int_param
+				(params,
+		"adjsynth.filter2.model",
+		_FILTER_MODEL_SVF,
+		_FILTER_MODEL_LADDER,
+		_FILTER_MODEL_SVF,
+		_ADJ_SYNTH_PATCH_PARAMS,
+		NULL,
+		0,
+		num_of_voices - 1,
+		set_voice_block_filter_2_model_cb,
+		_SET_VALUE | _SET_MAX_VAL | _SET_MIN_VAL | 
+		_SET_TYPE | _SET_BLOCK_START_INDEX | 
+		_SET_BLOCK_STOP_INDEX | _SET_BLOCK_CALLBACK,
+		prog);
+
 	res |= adj_synth_settings_manager->set_int_param
 				(params,
 		"adjsynth.filter2.freq_modulation_lfo_num",
@@ -1,14 +1,16 @@
 /**
 *	@file		adjSynthDefaultPatchParamsVCO.cpp
 *	@author		Nahum Budin
-*	@date		4-Oct-2024
-*	@version	1.1
-*					1. Code refactoring and notaion.
+*	@date		17-Oct-2026
+*	@version	1.2
+*					1. Saw waveform.
 *	
 *	@brief		Set default patch VCOs parameters
 *
 *	History:\n
 *	
+*	version 1.1		4-Oct-2024:
+*		Code refactoring and notaion.
 *	version 1.0		15_Nov-2019:		
 *		First version
 *		
@@ -44,7 +46,7 @@ int AdjSynth::set_default_patch_parameters_vco(_settings_params_t *params, int p
 				(params,
 		"adjsynth.osc1.waveform",
 		_OSC_WAVEFORM_SINE,
-		_OSC_WAVEFORM_SAMPHOLD,
+		_OSC_WAVEFORM_SAW,
 		_OSC_WAVEFORM_SINE,
 		_ADJ_SYNTH_PATCH_PARAMS,
 		NULL,
@@ -583,7 +585,7 @@ int AdjSynth::set_default_patch_parameters_vco(_settings_params_t *params, int p
 				(params,
 		"adjsynth.osc2.waveform",
 		_OSC_WAVEFORM_SINE,
-		_OSC_WAVEFORM_SAMPHOLD,
+		_OSC_WAVEFORM_SAW,
 		_OSC_WAVEFORM_SINE,
 		_ADJ_SYNTH_PATCH_PARAMS,
 		NULL,
@@ -0,0 +1,102 @@
+/**
+*	@file		adjSynthDefaultSettingsPolyphony.cpp
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0
+*
+*	@brief		Set default settings Polyphony governor and programs resources parameters
+*
+*	History:\n
+*
+*	version 1.0		17-Oct-2026:
+*		First version
+*
+*/
+
+#include "adjSynth.h"
+
+/**
+*   @brief  Set the settings Polyphony governor parameters to their default values
+*   @param	params	a _setting_params_t parameters struct
+*   @return 0 if done
+*/
+int AdjSynth::set_default_settings_parameters_polyphony(_settings_params_t *params)
+{
+	int res = 0;
+
+	return_val_if_true(params == NULL, _SETTINGS_BAD_PARAMETERS);
+
+	res = adj_synth_settings_manager->set_bool_param
+		(params,
+		"adjsynth.polyphony.governor_state",
+		_DEFAULT_POLY_GOVERNOR == _POLY_GOVERNOR_EN,
+		"instrument_settings_param",
+		set_polyphony_governor_state_cb,
+		0,
+		0,
+		NULL,
+		_SET_VALUE | _SET_TYPE | _SET_CALLBACK,
+		-1); // -1: no prog (common resource)
+
+	res |= adj_synth_settings_manager->set_int_param
+		(params,
+		"adjsynth.polyphony.governor_high_load",
+		_DEFAULT_POLY_GOVERNOR_HIGH_LOAD,
+		_POLY_GOVERNOR_LOAD_MAX,
+		_POLY_GOVERNOR_LOAD_MIN,
+		"instrument_settings_param",
+		set_polyphony_governor_high_load_cb,
+		0,
+		0,
+		NULL,
+		_SET_VALUE | _SET_MAX_VAL | _SET_MIN_VAL |
+		_SET_TYPE | _SET_CALLBACK,
+		-1);
+
+	res |= adj_synth_settings_manager->set_int_param
+		(params,
+		"adjsynth.polyphony.governor_low_load",
+		_DEFAULT_POLY_GOVERNOR_LOW_LOAD,
+		_POLY_GOVERNOR_LOAD_MAX,
+		_POLY_GOVERNOR_LOAD_MIN,
+		"instrument_settings_param",
+		set_polyphony_governor_low_load_cb,
+		0,
+		0,
+		NULL,
+		_SET_VALUE | _SET_MAX_VAL | _SET_MIN_VAL |
+		_SET_TYPE | _SET_CALLBACK,
+		-1);
+
+	res |= adj_synth_settings_manager->set_int_param
+		(params,
+		"adjsynth.polyphony.governor_min_voices",
+		_DEFAULT_POLY_GOVERNOR_MIN_VOICES,
+		_SYNTH_MAX_NUM_OF_VOICES,
+		_POLY_GOVERNOR_MIN_VOICES_MIN,
+		"instrument_settings_param",
+		set_polyphony_governor_min_voices_cb,
+		0,
+		0,
+		NULL,
+		_SET_VALUE | _SET_MAX_VAL | _SET_MIN_VAL |
+		_SET_TYPE | _SET_CALLBACK,
+		-1);
+	
+	res |= adj_synth_settings_manager->set_int_param
+		(params,
+		"adjsynth.polyphony.program_idle_release_time_sec",
+		_DEFAULT_PROGRAM_IDLE_RELEASE_TIME_SEC,
+		_PROGRAM_IDLE_RELEASE_TIME_SEC_MAX,
+		_PROGRAM_IDLE_RELEASE_TIME_SEC_MIN,
+		"instrument_settings_param",
+		set_program_idle_release_time_cb,
+		0,
+		0,
+		NULL,
+		_SET_VALUE | _SET_MAX_VAL | _SET_MIN_VAL |
+		_SET_TYPE | _SET_CALLBACK,
+		-1);
+
+	return res;
+}
@@ -4,6 +4,7 @@
 *	@date		5-Feb-2021
 *	@version	1.2
 *					1. Code refactoring and notaion.
+*					2. Equalizer bands settings (17-Oct-2026).
 *	
 *	@brief		AdjHeart Synthesizer Band Equilizer Events Handling
 *
@@ -237,3 +238,29 @@ int AdjSynth::band_equilizer_event_bool(int beqid, int eventid, bool val, _setti
 {
 	return 0;
 }
+
+/**
+*   @brief  Sets the equalizer bands.
+*   @param  num_of_bands		number of bands (1 to _EQUALIZER_MAX_NUM_OF_BANDS)
+*   @param  center_frequencies	an array of num_of_bands bands center frequencies [Hz];
+*								NULL for the default bands frequencies
+*   @return 0 if done; -1 if parameters are out of range
+*/
+int AdjSynth::set_equalizer_bands(int num_of_bands, const float *center_frequencies)
+{
+	return_val_if_true(audio_equalizer == NULL, -1);
+	
+	return audio_equalizer->set_bands(num_of_bands, center_frequencies);
+}
+
+/**
+*   @brief  Returns the equalizer number of bands.
+*   @param  none
+*   @return number of bands
+*/
+int AdjSynth::get_equalizer_num_of_bands()
+{
+	return_val_if_true(audio_equalizer == NULL, 0);
+	
+	return audio_equalizer->band_equalizer_L->get_num_of_bands();
+}
@@ -1,14 +1,16 @@
 /**
 *	@file		adjSynthEventsHandlingFilter.cpp
 *	@author		Nahum Budin
-*	@date		11-Oct-2024
-*	@version	1.0
-*					1. Code refactoring and notaion.
+*	@date		17-Oct-2026
+*	@version	1.1
+*					1. Filter model event.
 *	
 *	@brief		AdjHeart Synthesizer Filters Events Handling
 *
 *	History:\n
 *	
+*	version 1.0		11-Oct-2024:
+*		Code refactoring and notaion.
 *	version 1.0		15_Nov-2019:		
 *		First version
 *		
@@ -22,7 +24,7 @@
 *   @param  int filtid	target filter: _FILTER_1_EVENT, _FILTER_2_EVENT
 *	@param	int eventid	specific event code:\n
 *				_FILTER_FREQ, _FILTER_OCT, _FILTER_Q\n
-*				_FILTER_KBD_TRACK, _FILTER_BAND\n
+*				_FILTER_KBD_TRACK, _FILTER_BAND, _FILTER_MODEL\n
 *				_FILTER_FREQ_MOD_LFO, _FILTER_FREQ_MOD_LFO_LEVEL\n
 *				_FILTER_FREQ_MOD_ENV, _FILTER_FREQ_MOD_ENV_LEVEL\n
 *	@param	int val event parameter value (must be used with the relevant event id):\n
@@ -34,6 +36,10 @@
 \verbatim
 _FILTER_BAND_LPF, _FILTER_BAND_HPF, _FILTER_BAND_BPF, _FILTER_BAND_PASS_ALL\n
 \endverbatim
+*				_FILTER_MODEL:\n
+\verbatim
+_FILTER_MODEL_SVF, _FILTER_MODEL_ZDF_SVF, _FILTER_MODEL_LADDER\n
+\endverbatim
 *				FILTER_FREQ_MOD_LFO:\n
 \verbatim
 	_LFO_NONE, _LFO_1, _LFO_2, _LFO_3, _LFO_4, _LFO_5,
@@ -143,6 +149,27 @@ int AdjSynth::filter_event(int filtid, int eventid, int val, _settings_params_t
 		}
 		break;
 
+	case _FILTER_MODEL:
+		if (filtid == _FILTER_1_EVENT)
+		{
+			adj_synth_settings_manager->set_int_param_value
+				(params,
+				"adjsynth.filter1.model",
+				val,
+				_EXEC_BLOCK_CALLBACK,
+				program);
+		}
+		else if (filtid == _FILTER_2_EVENT)
+		{
+			adj_synth_settings_manager->set_int_param_value
+				(params,
+				"adjsynth.filter2.model",
+				val,
+				_EXEC_BLOCK_CALLBACK,
+				program);
+		}
+		break;
+
 	case _FILTER_KBD_TRACK:
 		if (filtid == _FILTER_1_EVENT)
 		{
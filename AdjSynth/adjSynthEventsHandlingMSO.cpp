@@ -125,24 +125,11 @@ int AdjSynth::mso_event_int(int msoid, int eventid, int val, _settings_params_t
 				_EXEC_CALLBACK,
 				program);
 		}
-		else if (eventid == _MSO_CALC_BASE_LUT)
+		else if ((eventid == _MSO_CALC_BASE_LUT) || (eventid == _MSO_CALC_MORPHED_LUT))
 		{
-			synth_program[program]->mso_wtab->calc_segments_lengths(
-				&synth_program[program]->mso_wtab->base_segment_lengths, 
-				&synth_program[program]->mso_wtab->base_segment_positions);
-
-			synth_program[0]->mso_wtab->calc_wtab(
-				synth_program[program]->mso_wtab->base_waveform_tab, 
-				&synth_program[program]->mso_wtab->base_segment_lengths, 
-				&synth_program[program]->mso_wtab->base_segment_positions);
-		}
-		else if (eventid == _MSO_CALC_MORPHED_LUT)
-		{
-			synth_program[program]->mso_wtab->set_morphing_symetry(synth_program[program]->mso_wtab->get_morphing_symetry());
-			synth_program[program]->mso_wtab->calc_wtab(
-				synth_program[program]->mso_wtab->morphed_waveform_tab,
-				&synth_program[program]->mso_wtab->morphed_segment_lengths,
-				&synth_program[program]->mso_wtab->morphed_segment_positions);
+			// Shared wavetables are immutable: the base and morphed tables of the 
+			// changed settings are calculated (if not shared) into a new wavetable.
+			synth_program[program]->update_mso_wavetable();
 		}
 		else if (eventid == _MSO_DETUNE_OCTAVE)
 		{
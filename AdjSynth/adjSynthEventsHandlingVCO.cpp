@@ -41,7 +41,7 @@
 *				_OSC_PARAM_WAVEFORM:\n
 \verbatim
 				_OSC_WAVEFORM_SINE, _OSC_WAVEFORM_SQUARE, _OSC_WAVEFORM_PULSE
-				_OSC_WAVEFORM_TRIANGLE, _OSC_WAVEFORM_SAMPHOLD
+				_OSC_WAVEFORM_TRIANGLE, _OSC_WAVEFORM_SAMPHOLD, _OSC_WAVEFORM_SAW
 \endverbatim
 *				_OSC_PWM_SYMMETRY: 5-95\n
 *				_OSC_DETUNE_OCTAVE: 0 to (getOscDetuneMaxOctave() - getOscDetuneMinOctave() + 1); 0->min octave-detune\n
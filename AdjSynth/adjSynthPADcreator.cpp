@@ -1,11 +1,14 @@
 /**
 *	@file		adjSynthPADcreator.cpp
 *	@author		Nahum Budin
-*	@date		5-Oct-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion.
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Generating parameters key (shared wavetables registry).
+*					2. Wavetable descriptors (size and base frequency only, no samples).
 				
 *	@History
+*	version	1.2 5-Oct-2024
+*					1. Code refactoring and notaion.
 *	version	1.1 3-Feb-2021
 *					1. Code refactoring and notaion.
 *	version	1.0	15-Nov-2019 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 October, 2018)
@@ -279,7 +282,8 @@ float SynthPADcreator::get_harmonies_detune()
 
 /**
 * @brief	set wavetable buffer length (1<<(15+len). 
-*			(deletes prev table and allocates a new one)
+*			(deletes prev table and allocates a new one; a wavetable descriptor with no 
+*			samples only gets the new length)
 * param		wt	a pointer to a wave table object of type Wavetable
 * @param	int len _PAD_QUALITY_32K - _PAD_QUALITY_1024K (0-5).
 * @return	length (samples) if OK; -1 if params out of range.
@@ -293,12 +297,15 @@ int SynthPADcreator::set_wavetable_length(Wavetable *wt, int len)
 	
 	if ((len >= _PAD_QUALITY_32K) && (len <= _PAD_QUALITY_1024K))
 	{
-		delete[] wt->samples;
-		//	delete(wt);
-		//	wt = new Wavetable();
 		wt->size = (1 << (15 + len));
-		wt->samples = new float[wt->size];
-		wt->samples[0] = 0.0f;
+		if (wt->samples != NULL)
+		{
+			delete[] wt->samples;
+			//	delete(wt);
+			//	wt = new Wavetable();
+			wt->samples = new float[wt->size];
+			wt->samples[0] = 0.0f;
+		}
 		wt->base_freq = _PAD_DEFAULT_BASE_NOTE_FREQ;
 		
 		if (spectrum != NULL)
@@ -587,6 +594,25 @@ void SynthPADcreator::generate_spectrum_bandwidth_mode(
 	}
 }
 
+/**
+* @brief  Calculates the harmonies profile and the spectrum (without generating the wavetable;
+*		  e.g. when a wavetable with the same generating parameters already exists)
+* @param  none
+* @return void
+*/
+void SynthPADcreator::update_profile_and_spectrum()
+{
+	const float bwadjust = get_profile(&profile[0], profile_size);
+	
+	generate_spectrum_bandwidth_mode(
+		spectrum,
+		spectrum_length,
+		base_frequency,
+		profile,
+		profile_size,
+		bwadjust);
+}
+
 /**
 * @brief  Generates the wavetable
 * @param  wt	a pointer to a wave table object of type Wavetable
@@ -606,19 +632,11 @@ int SynthPADcreator::generate_wavetable(Wavetable *wt)
 		return -2;
 	}
 
-	const float bwadjust = get_profile(&profile[0], profile_size);
+	update_profile_and_spectrum();
 	
 	// prepare the IFFT
 	FFTwrapper *fft = new FFTwrapper(wavetable->size);
 	fft_t      *fftfreqs = new fft_t[spectrum_length];
-
-	generate_spectrum_bandwidth_mode(
-		spectrum,
-		spectrum_length,
-		base_frequency,
-		profile,
-		profile_size,
-		bwadjust);
 	
 	//randomize the phases
 	for (i = 1; i < spectrum_length; ++i) 
@@ -652,6 +670,28 @@ int SynthPADcreator::generate_wavetable(Wavetable *wt)
 	return 0;
 }
 
+/**
+* @brief  Returns the wavetable generating parameters as a raw bytes blob: harmonies levels, 
+*		  shape, shape cutoff, base width, harmonies detune, base note, quality (size) and 
+*		  sample-rate. Wavetables generated with equal parameters differ only by their random phases.
+* @param  params	a pointer to a string that will hold the parameters blob
+* @return void
+*/
+void SynthPADcreator::get_generating_params(std::string *params)
+{
+	int size = wavetable->size;
+	
+	params->clear();
+	params->append((const char*)harmonies_levels, sizeof(harmonies_levels));
+	params->append((const char*)&harmony_shape, sizeof(harmony_shape));
+	params->append((const char*)&harmony_shape_cutoff, sizeof(harmony_shape_cutoff));
+	params->append((const char*)&base_harmony_bandwidth, sizeof(base_harmony_bandwidth));
+	params->append((const char*)&harmonies_detune, sizeof(harmonies_detune));
+	params->append((const char*)&base_note, sizeof(base_note));
+	params->append((const char*)&size, sizeof(size));
+	params->append((const char*)&sample_rate, sizeof(sample_rate));
+}
+
 /**
 * @brief  Build the profile
 * @param  smp		a pointer to the data
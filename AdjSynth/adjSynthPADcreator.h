@@ -1,8 +1,12 @@
 /**
 *	@file		adjSynthPADcreator.h
 *	@author		Nahum Budin
-*	@date		4-Oct-2024
-*	@version	1.2 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Generating parameters key (shared wavetables registry).
+*					2. Wavetable descriptors (size and base frequency only, no samples).
+*					
+*	@version	1.2 4-Oct-2024
 *					1. Code refactoring and notaion.
 *					
 *	@version	1.1 3-Feb-2021
@@ -17,6 +21,8 @@
 #pragma once
 
 
+#include <string>
+
 #include "../DSP/dspWavetable.h"
 #include "../LibAPI/audio.h"
 #include "../LibAPI/synthesizer.h"
@@ -77,7 +83,10 @@ public:
 
 	float get_profile(float *smp = NULL, int size = profile_size);
 
+	void update_profile_and_spectrum();
 	int generate_wavetable(Wavetable *wt = NULL);
+	
+	void get_generating_params(std::string *params);
 
 	static const int profile_size = 512;
 	
@@ -58,7 +58,7 @@ int AdjSynthPolyphony::get_reused_note(int note, int program)
 	/*
 	int i, result = -1;
 	
-	if (mod_synth_get_cpu_utilization() > 90)
+	if (mod_synth_get_system_cpu_utilization() > 90)
 		// CPU is too loaded
 	{	
 		return -2;
@@ -1,8 +1,14 @@
 /**
 *	@file		adjSynthPolyphonyManager.cpp
 *	@author		Nahum Budin
-*	@date		9-Oct-2024
-*	@version	1.0 1st version	
+*	@date		17-Oct-2026
+*	@version	1.2
+*					1. Load adaptive voices cap (polyphony governor).
+*					2. Steal voices by a weighted score of release phase, amplitude, age and cost.
+*	
+*	@History	1.1 17-Oct-2026
+*					1. Select the less busy core by the measured voices processing cost.
+*				1.0 9-Oct-2024	1st version	
 *	
 *	Based on adjSynthPolyphony.cpp version 1.1 3-Feb-2021
 *
@@ -16,8 +22,11 @@
 #include "adjSynth.h"
 #include "../LibAPI/synthesizer.h"
 #include "../commonDefs.h"
+#include "../Audio/audioVoiceRenderPool.h"
+#include "../Audio/audioDspLoadMeter.h"
 
 extern pthread_mutex_t voice_busy_mutex;
+extern pthread_mutex_t voice_manage_mutex;
 
 AdjPolyphonyManager *AdjPolyphonyManager::poly_manager_instance = NULL;
 
@@ -37,13 +46,34 @@ AdjPolyphonyManager::AdjPolyphonyManager(int num_of_voic)
 		number_of_cores = _SYNTH_MAX_NUM_OF_CORES;
 	}
 	
+	if (number_of_cores < 1)
+	{
+		// hardware_concurrency() could not tell
+		number_of_cores = 1;
+	}
+	
 	max_num_of_voices_per_core = max_number_of_voices / number_of_cores;
 	
 	for (int i = 0; i < _SYNTH_MAX_NUM_OF_CORES; i++)
 	{
 		cores_load[i] = 0;
+		cores_processing_cost[i] = 0;
+	}
+	
+	for (int i = 0; i < _SYNTH_MAX_NUM_OF_PROGRAMS; i++)
+	{
+		programs_processing_cost[i] = 0;
 	}
 	
+	governor_enabled = _DEFAULT_POLY_GOVERNOR;
+	governor_high_load = _DEFAULT_POLY_GOVERNOR_HIGH_LOAD;
+	governor_low_load = _DEFAULT_POLY_GOVERNOR_LOW_LOAD;
+	governor_min_voices = _DEFAULT_POLY_GOVERNOR_MIN_VOICES;
+	voices_cap.store(max_number_of_voices);
+	governor_load = 0.0f;
+	governor_cycles = 0;
+	reset_governor_stats();
+	
 	gettimeofday(&start_time, NULL);
 	
 }
@@ -121,31 +151,107 @@ int AdjPolyphonyManager::clear_core_processing_load_weight(int core)
 	}
 }
 
+/**
+*   @brief  Returns the less busy core that has a free voice.
+*			Cores are compared by the measured processing cost of their active voices.
+*			Until any cost is measured, cores are compared by their processing load weights.
+*   @param  none
+*   @return the less busy core; -1 if not found
+*/
 int AdjPolyphonyManager::get_less_busy_core()
 {
-	int i, min_load = 1000, min_core, result = 1000;
+	int i, voice, core, program, min_core = -1, min_load = 1000;
+	int programs_measured_voices[_SYNTH_MAX_NUM_OF_PROGRAMS] = { 0 };
+	float programs_cost[_SYNTH_MAX_NUM_OF_PROGRAMS] = { 0 };
+	float cost, min_cost = 0;
+	bool measured = false;
+	AudioVoiceRenderPool *render_pool = AudioVoiceRenderPool::get_instance();
+	
+	if (get_num_of_active_voices() >= voices_cap.load())
+	{
+		// The governor voices cap is reached - a voice may only be stolen
+		return -1;
+	}
+	
+	for (i = 0; i < number_of_cores; i++)
+	{
+		cores_processing_cost[i] = 0;
+	}
+	
+	// Sum the measured cost of the active voices on each core
+	for (voice = 0; voice < max_number_of_voices; voice++)
+	{
+		if ((AdjSynth::get_instance()->synth_voice[voice] != NULL) &&
+			(AdjSynth::get_instance()->synth_voice[voice]->audio_voice->is_voice_active() ||
+			 AdjSynth::get_instance()->synth_voice[voice]->audio_voice->is_voice_wait_for_not_active()))
+		{
+			core = get_voice_core(voice);
+			cost = render_pool->get_voice_processing_cost(voice);
+			if ((core >= 0) && (cost > 0))
+			{
+				cores_processing_cost[core] += cost;
+				measured = true;
+				
+				program = AdjSynth::get_instance()->synth_voice[voice]->get_allocated_program();
+				if ((program >= 0) && (program < _SYNTH_MAX_NUM_OF_PROGRAMS))
+				{
+					programs_cost[program] += cost;
+					programs_measured_voices[program]++;
+				}
+			}
+		}
+	}
 	
+	// A program voice cost estimate is the average cost of its active voices
+	for (program = 0; program < _SYNTH_MAX_NUM_OF_PROGRAMS; program++)
+	{
+		if (programs_measured_voices[program] > 0)
+		{
+			programs_processing_cost[program] = programs_cost[program] / programs_measured_voices[program];
+		}
+	}
+
 	// Look for the less busy core
-	min_load = 1000;
-	min_core = 1000;
 	for (i = 0; i < number_of_cores; i++)
 	{
-		if (cores_load[i] < min_load)
+		if (get_a_free_voice(i) < 0)
+		{
+			// No free voice on this core
+			continue;
+		}
+		
+		if (measured)
+		{
+			if ((min_core < 0) || (cores_processing_cost[i] < min_cost))
+			{
+				min_cost = cores_processing_cost[i];
+				min_core = i;
+			}
+		}
+		else if (cores_load[i] < min_load)
 		{
 			min_load = cores_load[i];
 			min_core = i;
 		}
 	}
 
-	if (min_core >= number_of_cores) 
+	return min_core;
+}
+
+/**
+*   @brief  Returns the measured processing cost of the active voices on a core,
+*			as calculated by the last get_less_busy_core() call.
+*   @param  core	core number
+*   @return processing cost [uSec]; -1 if core is out of range
+*/
+float AdjPolyphonyManager::get_core_processing_cost(int core)
+{
+	if ((core < 0) || (core >= number_of_cores))
 	{
-		// No min core found - error
 		return -1;
 	}
-	else 
-	{
-		return min_core;
-	}
+	
+	return cores_processing_cost[core];
 }
 
 /**
@@ -159,7 +265,7 @@ int AdjPolyphonyManager::get_a_free_voice(int core)
 	int min_voice = -1, min_core = -1;
 	bool reused = false;
 	
-	if (core < number_of_cores)
+	if ((core >= 0) && (core < number_of_cores))
 	{
 		// Look for a free voice on selected core
 		voice_num = core * max_num_of_voices_per_core;
@@ -180,7 +286,7 @@ int AdjPolyphonyManager::get_a_free_voice(int core)
 			}
 		}
 
-		if (voice_num < max_number_of_voices)
+		if ((voice_num < max_number_of_voices) && (voice_num < (core + 1) * max_num_of_voices_per_core))
 		{
 			return voice_num;
 			//	printf("Min Core %i Free voice %i", core, voice);
@@ -198,6 +304,30 @@ int AdjPolyphonyManager::get_a_free_voice(int core)
 	}
 }
 
+/**
+*   @brief  Returns the core a voice is allocated to.
+*			Voices are allocated to cores in consecutive ranges of max_num_of_voices_per_core 
+*			voices (see get_a_free_voice()); remaining voices are spread over the cores.
+*   @param  voice	voice number
+*   @return the core the voice is allocated to; -1 if voice is out of range
+*/
+int AdjPolyphonyManager::get_voice_core(int voice)
+{
+	if ((voice < 0) || (voice >= max_number_of_voices))
+	{
+		return -1;
+	}
+	
+	if (voice < number_of_cores * max_num_of_voices_per_core)
+	{
+		return voice / max_num_of_voices_per_core;
+	}
+	else
+	{
+		return voice % number_of_cores;
+	}
+}
+
 /**
 *   @brief  Returns the voice number of the voice which is active for the longest time
 *   @param  none
@@ -225,6 +355,90 @@ int AdjPolyphonyManager::get_oldest_voice()
 	return minvoice;
 }
 
+/**
+*   @brief  Returns the voice to steal for a new note: the sounding voice with the highest
+*			weighted score of release phase (released voices first), low output level, 
+*			age and measured processing cost. Voices that are being faded out are skipped.
+*   @param  none
+*   @return the voice number of the voice to steal; -1 if none
+*/
+int AdjPolyphonyManager::get_voice_to_steal()
+{
+	int i, max_voice = -1;
+	uint64_t now = get_elapsed_time_ms(), age, max_age = 0;
+	float cost, max_cost = 0, level, score, max_score = -1.0f;
+	AudioVoiceFloat *audio_voice;
+	AudioVoiceRenderPool *render_pool = AudioVoiceRenderPool::get_instance();
+	
+	// Normalization factors
+	for (i = 0; i < max_number_of_voices; i++)
+	{
+		if (AdjSynth::get_instance()->synth_voice[i] == NULL)
+		{
+			continue;
+		}
+		
+		audio_voice = AdjSynth::get_instance()->synth_voice[i]->audio_voice;
+		if ((audio_voice->is_voice_active() || audio_voice->is_voice_wait_for_not_active()) &&
+			!audio_voice->is_fade_out_requested())
+		{
+			age = now > audio_voice->get_timestamp() ? now - audio_voice->get_timestamp() : 0;
+			max_age = age > max_age ? age : max_age;
+			cost = render_pool->get_voice_processing_cost(i);
+			max_cost = cost > max_cost ? cost : max_cost;
+		}
+	}
+	
+	for (i = 0; i < max_number_of_voices; i++)
+	{
+		if (AdjSynth::get_instance()->synth_voice[i] == NULL)
+		{
+			continue;
+		}
+		
+		audio_voice = AdjSynth::get_instance()->synth_voice[i]->audio_voice;
+		if (!(audio_voice->is_voice_active() || audio_voice->is_voice_wait_for_not_active()) ||
+			audio_voice->is_fade_out_requested())
+		{
+			continue;
+		}
+		
+		score = 0.0f;
+		
+		if (audio_voice->is_voice_wait_for_not_active())
+		{
+			score += _POLY_STEAL_RELEASE_WEIGHT;
+		}
+		
+		level = audio_voice->get_output_level();
+		if (level > 1.0f)
+		{
+			level = 1.0f;
+		}
+		
+		score += _POLY_STEAL_AMPLITUDE_WEIGHT * (1.0f - level);
+		
+		if (max_age > 0)
+		{
+			age = now > audio_voice->get_timestamp() ? now - audio_voice->get_timestamp() : 0;
+			score += _POLY_STEAL_AGE_WEIGHT * (float)age / (float)max_age;
+		}
+		
+		if (max_cost > 0)
+		{
+			score += _POLY_STEAL_COST_WEIGHT * render_pool->get_voice_processing_cost(i) / max_cost;
+		}
+		
+		if (score > max_score)
+		{
+			max_score = score;
+			max_voice = i;
+		}
+	}
+	
+	return max_voice;
+}
+
 /**
 *   @brief  Returns a voice num that is already assigned to this note and program.
 *			If more than 1 found, look for the 1st to become used (oldest). 
@@ -232,7 +446,7 @@ int AdjPolyphonyManager::get_oldest_voice()
 *   @param  note	requested note
 *   @param	program	requested program
 *   @return a voice num that is already assigned to this note and program;
-*			-2 if CPU is too loaded; -3 if params are out of range
+*			-1 if not found; -3 if params are out of range
 */
 int AdjPolyphonyManager::get_reused_note(int note, int program)
 {
@@ -241,13 +455,8 @@ int AdjPolyphonyManager::get_reused_note(int note, int program)
 	int64_t mintime = INT64_MAX;
 	int minvoice = -1;
 
-	
-	if (mod_synth_get_cpu_utilization() > 90)
-		// CPU is too loaded
-	{	
-		return -2;
-	}
-
+	// No CPU load check: a playing note must always be found (note-off). New voices are
+	// limited by the polyphony governor.
 	if ((note < 0) || (note > 127) || (program < 0) ||
 		(program >= AdjSynth::get_instance()->get_num_of_programs()))
 		// Illegal parameters range
@@ -316,6 +525,12 @@ int AdjPolyphonyManager::activate_resource(int res_num, int note, int program)
 	AdjSynth::get_instance()->synth_voice[res_num]->audio_voice->reset_wait_for_not_active();
 	AdjSynth::get_instance()->synth_voice[res_num]->set_allocated_program(program);
 	
+	if ((program < _SYNTH_MAX_NUM_OF_PROGRAMS) && (programs_processing_cost[program] > 0))
+	{
+		// Start with the cost measured for this program voices until this voice is measured
+		AudioVoiceRenderPool::get_instance()->set_voice_processing_cost(res_num, programs_processing_cost[program]);
+	}
+	
 	return 0;
 }
 
@@ -331,7 +546,7 @@ void AdjPolyphonyManager::free_voice(int voice, bool pend)
 	
 	if ((voice >= 0) && (voice < AdjSynth::get_instance()->get_num_of_voices()))
 	{
-		int core = voice / AdjSynth::num_of_core_voices;
+		int core = get_voice_core(voice);
 
 		if (pend)
 		{
@@ -370,3 +585,234 @@ void AdjPolyphonyManager::free_voice(int voice, bool pend)
 		}
 	}
 }
+
+/**
+*   @brief  Returns the number of sounding voices (active or released), not including
+*			voices that are being faded out.
+*   @param  none
+*   @return the number of sounding voices
+*/
+int AdjPolyphonyManager::get_num_of_active_voices()
+{
+	int count = 0;
+	AudioVoiceFloat *audio_voice;
+	
+	for (int voice = 0; voice < max_number_of_voices; voice++)
+	{
+		if (AdjSynth::get_instance()->synth_voice[voice] != NULL)
+		{
+			audio_voice = AdjSynth::get_instance()->synth_voice[voice]->audio_voice;
+			if ((audio_voice->is_voice_active() || audio_voice->is_voice_wait_for_not_active()) &&
+				!audio_voice->is_fade_out_requested())
+			{
+				count++;
+			}
+		}
+	}
+	
+	return count;
+}
+
+/**
+*   @brief  Polyphony governor - called once per audio update cycle.
+*			Follows the update cycle time (DSP load) moving average. When it exceeds the high
+*			threshold (or a cycle overruns the period), the voices cap is lowered below the number
+*			of sounding voices, and the voice with the highest stealing score is faded out, 
+*			before the load reaches the period deadline. When the load is below the low threshold
+*			for a while, the cap is raised back one voice at a time.
+*			Suspended with the null audio driver, so offline benchmarks are not capped.
+*			Runs on the audio thread: never blocks on the voices management lock - if the 
+*			MIDI thread holds it, the voice stealing is retried on the next cycle.
+*   @param  none
+*   @return void
+*/
+void AdjPolyphonyManager::update_polyphony_governor()
+{
+	float load = AudioDspLoadMeter::get_instance()->get_last_cycle_load();
+	int active, cap, voice;
+	
+	governor_load += (load - governor_load) * _POLY_GOVERNOR_LOAD_AVERAGING_FACTOR;
+	
+	if (!governor_enabled || (AudioManager::get_instance()->get_audio_driver_type() == _AUDIO_NULL))
+	{
+		voices_cap.store(max_number_of_voices);
+		governor_cycles = 0;
+		return;
+	}
+	
+	if (governor_cycles < _POLY_GOVERNOR_INCREASE_HOLD_CYCLES)
+	{
+		// Counted up to the longest hold time only
+		governor_cycles++;
+	}
+	
+	cap = voices_cap.load();
+	
+	if ((governor_load > (float)governor_high_load) || (load >= 100.0f))
+	{
+		if ((governor_cycles >= _POLY_GOVERNOR_DECREASE_HOLD_CYCLES) &&
+			(pthread_mutex_trylock(&voice_manage_mutex) == 0))
+		{
+			active = get_num_of_active_voices();
+			
+			cap = (active < cap ? active : cap) - 1;
+			if (cap < governor_min_voices)
+			{
+				cap = governor_min_voices;
+			}
+			
+			governor_cycles = 0;
+			
+			if (active > cap)
+			{
+				voice = get_voice_to_steal();
+				if (voice >= 0)
+				{
+					AdjSynth::get_instance()->synth_voice[voice]->audio_voice->request_fade_out();
+					shed_voices.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+			
+			pthread_mutex_unlock(&voice_manage_mutex);
+		}
+	}
+	else if (governor_load < (float)governor_low_load)
+	{
+		if ((cap < max_number_of_voices) && (governor_cycles >= _POLY_GOVERNOR_INCREASE_HOLD_CYCLES))
+		{
+			cap++;
+			governor_cycles = 0;
+		}
+	}
+	else
+	{
+		// Between thresholds - keep the cap
+		governor_cycles = 0;
+	}
+	
+	voices_cap.store(cap);
+}
+
+/**
+*   @brief  Enable or disable the polyphony governor (when disabled, all voices can be used).
+*   @param  state	true - enabled; false - disabled
+*   @return void
+*/
+void AdjPolyphonyManager::set_governor_state(bool state)
+{
+	governor_enabled = state;
+}
+
+bool AdjPolyphonyManager::get_governor_state() { return governor_enabled; }
+
+/**
+*   @brief  Set the DSP load above which the voices cap is lowered.
+*   @param  load	_POLY_GOVERNOR_LOAD_MIN to _POLY_GOVERNOR_LOAD_MAX [% of the audio period];
+*					at least _POLY_GOVERNOR_MIN_LOAD_HYSTERESIS above the low load
+*   @return the set load; -1 if out of range
+*/
+int AdjPolyphonyManager::set_governor_high_load(int load)
+{
+	if ((load < _POLY_GOVERNOR_LOAD_MIN) || (load > _POLY_GOVERNOR_LOAD_MAX) ||
+		(load < governor_low_load + _POLY_GOVERNOR_MIN_LOAD_HYSTERESIS))
+	{
+		return -1;
+	}
+	
+	governor_high_load = load;
+	
+	return governor_high_load;
+}
+
+int AdjPolyphonyManager::get_governor_high_load() { return governor_high_load; }
+
+/**
+*   @brief  Set the DSP load below which the voices cap is raised back.
+*   @param  load	_POLY_GOVERNOR_LOAD_MIN to _POLY_GOVERNOR_LOAD_MAX [% of the audio period];
+*					at least _POLY_GOVERNOR_MIN_LOAD_HYSTERESIS below the high load
+*   @return the set load; -1 if out of range
+*/
+int AdjPolyphonyManager::set_governor_low_load(int load)
+{
+	if ((load < _POLY_GOVERNOR_LOAD_MIN) || (load > _POLY_GOVERNOR_LOAD_MAX) ||
+		(load > governor_high_load - _POLY_GOVERNOR_MIN_LOAD_HYSTERESIS))
+	{
+		return -1;
+	}
+	
+	governor_low_load = load;
+	
+	return governor_low_load;
+}
+
+int AdjPolyphonyManager::get_governor_low_load() { return governor_low_load; }
+
+/**
+*   @brief  Set the minimum voices cap.
+*   @param  voices	_POLY_GOVERNOR_MIN_VOICES_MIN to _SYNTH_MAX_NUM_OF_VOICES
+*   @return the set min voices; -1 if out of range
+*/
+int AdjPolyphonyManager::set_governor_min_voices(int voices)
+{
+	if ((voices < _POLY_GOVERNOR_MIN_VOICES_MIN) || (voices > _SYNTH_MAX_NUM_OF_VOICES))
+	{
+		return -1;
+	}
+	
+	governor_min_voices = voices;
+	
+	if (voices_cap.load() < governor_min_voices)
+	{
+		voices_cap.store(governor_min_voices);
+	}
+	
+	return governor_min_voices;
+}
+
+int AdjPolyphonyManager::get_governor_min_voices() { return governor_min_voices; }
+
+/**
+*   @brief  Returns the current voices cap.
+*   @param  none
+*   @return the max number of sounding voices
+*/
+int AdjPolyphonyManager::get_voices_cap() { return voices_cap.load(); }
+
+/**
+*   @brief  Count a voice stolen by a new note.
+*   @param  none
+*   @return void
+*/
+void AdjPolyphonyManager::count_stolen_voice()
+{
+	stolen_voices.fetch_add(1, std::memory_order_relaxed);
+}
+
+unsigned long AdjPolyphonyManager::get_stolen_voices() { return stolen_voices.load(std::memory_order_relaxed); }
+
+unsigned long AdjPolyphonyManager::get_shed_voices() { return shed_voices.load(std::memory_order_relaxed); }
+
+/**
+*   @brief  Reset the stolen and shed voices counters.
+*   @param  none
+*   @return void
+*/
+void AdjPolyphonyManager::reset_governor_stats()
+{
+	stolen_voices.store(0);
+	shed_voices.store(0);
+}
+
+/**
+*   @brief  Returns the elapsed time since the polyphony manager was created (voices timestamps time base).
+*   @param  none
+*   @return elapsed time [mSec]
+*/
+uint64_t AdjPolyphonyManager::get_elapsed_time_ms()
+{
+	struct timeval now;
+	
+	gettimeofday(&now, NULL);
+	
+	return (now.tv_usec - start_time.tv_usec) / 1000 + (now.tv_sec - start_time.tv_sec) * 1000;
+}
@@ -1,8 +1,14 @@
 /**
 *	@file		adjSynthPolyphonyManager.h
 *	@author		Nahum Budin
-*	@date		9-Oct-2024
-*	@version	1.0 1st version	
+*	@date		17-Oct-2026
+*	@version	1.2
+*					1. Load adaptive voices cap (polyphony governor).
+*					2. Steal voices by a weighted score of release phase, amplitude, age and cost.
+*	
+*	@History	1.1 17-Oct-2026
+*					1. Select the less busy core by the measured voices processing cost.
+*				1.0 9-Oct-2024	1st version	
 *	
 *
 *	Based on adjSynthPolyphony.cpp version 1.1 3-Feb-2021
@@ -13,8 +19,25 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "../LibAPI/synthesizer.h"
 
+// Polyphony governor DSP load moving average factor (per update cycle)
+#define _POLY_GOVERNOR_LOAD_AVERAGING_FACTOR	0.05f
+// Min number of update cycles between voices cap reductions (let the load settle)
+#define _POLY_GOVERNOR_DECREASE_HOLD_CYCLES		8
+// Min number of low load update cycles before the voices cap is increased
+#define _POLY_GOVERNOR_INCREASE_HOLD_CYCLES		200
+// Min difference between the high and the low load thresholds [% of the audio period]
+#define _POLY_GOVERNOR_MIN_LOAD_HYSTERESIS		5
+
+// Voice stealing score weights (the voice with the highest score is stolen)
+#define _POLY_STEAL_RELEASE_WEIGHT				4.0f	// released voice (in release phase)
+#define _POLY_STEAL_AMPLITUDE_WEIGHT			2.0f	// (1 - output level)
+#define _POLY_STEAL_AGE_WEIGHT					1.0f	// age relative to the oldest voice
+#define _POLY_STEAL_COST_WEIGHT					1.0f	// processing cost relative to the most costly voice
+
 class AdjPolyphonyManager
 {
 public:
@@ -29,14 +52,35 @@ public:
 	int get_core_processing_load_weight(int core);
 	
 	int get_less_busy_core();
+	float get_core_processing_cost(int core);
 	int get_a_free_voice(int core);
+	int get_voice_core(int voice);
 	
 	int get_oldest_voice();
+	int get_voice_to_steal();
 	int get_reused_note(int note = -1, int program = 0);
 	
 	int activate_resource(int res_num = -1, int note = -1, int program = 0);
 	void free_voice(int voice = -1, bool pend = true);
 	
+	int get_num_of_active_voices();
+	
+	void update_polyphony_governor();
+	void set_governor_state(bool state);
+	bool get_governor_state();
+	int set_governor_high_load(int load);
+	int get_governor_high_load();
+	int set_governor_low_load(int load);
+	int get_governor_low_load();
+	int set_governor_min_voices(int voices);
+	int get_governor_min_voices();
+	int get_voices_cap();
+	
+	void count_stolen_voice();
+	unsigned long get_stolen_voices();
+	unsigned long get_shed_voices();
+	void reset_governor_stats();
+	
 	/* Processing weights. TODO: adjust. */
 	static const int voice_processing_weight = 1;
 	static const int freeverb3mod2_processing_weight = 20;
@@ -62,6 +106,31 @@ private:
 	 *  a core, the process wheight is decreasd by the process wight. */
 	int cores_load[_SYNTH_MAX_NUM_OF_CORES];
 	
+	/* Measured processing cost [uSec] of the active voices on each core, and the average cost
+	 * of an active voice of each program. Updated by get_less_busy_core(). A new voice of a 
+	 * program starts with its program cost estimate. */
+	float cores_processing_cost[_SYNTH_MAX_NUM_OF_CORES];
+	float programs_processing_cost[_SYNTH_MAX_NUM_OF_PROGRAMS];
+	
+	/* Polyphony governor settings */
+	bool governor_enabled;
+	int governor_high_load;
+	int governor_low_load;
+	int governor_min_voices;
+	
+	/* Max number of sounding voices, lowered by the governor when the DSP load is high */
+	std::atomic<int> voices_cap;
+	/* DSP load moving average [% of period] */
+	float governor_load;
+	/* Update cycles since the last voices cap change */
+	int governor_cycles;
+	
+	/* Voices stolen by new notes, and voices faded out by the governor (since last reset) */
+	std::atomic<unsigned long> stolen_voices;
+	std::atomic<unsigned long> shed_voices;
+	
+	uint64_t get_elapsed_time_ms();
+	
 	
 	struct timeval start_time;
 };
@@ -1,12 +1,16 @@
 /**
 *	@file		adjSynthProgram.cpp
 *	@author		Nahum Budin
-*	@date		5-Oct-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion.
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. On demand (lazy) creation of the program voices and wavetables,
+*					   and release of idle programs resources.
+*					2. Program voices are handles bound to shared pooled DSP voices.
+*					3. PAD and MSO wavetables are shared (wavetables registry).
 *					
 *	History:\n	
 *		
+*		version	1.2	5-Oct-2024	Code refactoring and notaion.
 *		version	1.1	4-Feb-2021	Code refactoring and notaion.
 *		version	1.0	15-Nov-2019 
 *
@@ -30,7 +34,9 @@ extern pthread_mutex_t voice_busy_mutex;
 int SynthProgram::prog_numbers = 0; 
 
 /**
-*   @brief  Condtructor - creates an instance of a SynthProgram object
+*   @brief  Condtructor - creates an instance of a SynthProgram object.
+*			Only the program patch parameters are created; the voices and wavetables 
+*			are created by materialize().
 *   @param	samp_rate	sample-rate
 *   @param	block_size	audio block-size
 *   @param  voices	number of voices
@@ -50,9 +56,19 @@ SynthProgram::SynthProgram(
 	char name[64] = "Patch1";
 	uint32_t patch_version;
 
+	pthread_mutexattr_t mutex_attr;
+	
 	// Allocate a sequntial ID
 	prog_num = prog_numbers++;
 	
+	patch_params_version.store(0);
+	
+	// Callbacks run by materialize() (patch reapply) lock the resources again
+	pthread_mutexattr_init(&mutex_attr);
+	pthread_mutexattr_settype(&mutex_attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&resources_mutex, &mutex_attr);
+	pthread_mutexattr_destroy(&mutex_attr);
+	
 	audio_manager = aud_mng;
 
 	set_sample_rate(samp_rate);
@@ -86,36 +102,268 @@ SynthProgram::SynthProgram(
 	settings_manager = new Settings(&active_patch_params);
 	active_patch_params.version = settings_manager->get_settings_version();
 
-	program_wavetable = new Wavetable();
-	program_wavetable->size = wt_size;
-	program_wavetable->samples = (float*)malloc(wt_size * sizeof(float));
-	synth_pad_creator = new SynthPADcreator(program_wavetable, program_wavetable->size);
-	program_wavetable->base_freq =
-		synth_pad_creator->set_base_frequency(program_wavetable, _PAD_DEFAULT_BASE_NOTE);
-
-	mso_wtab = new DSP_MorphingSinusOscWTAB();
-	mso_wtab->calc_segments_lengths(&mso_wtab->base_segment_lengths, &mso_wtab->base_segment_positions);
-	mso_wtab->calc_wtab(mso_wtab->base_waveform_tab, &mso_wtab->base_segment_lengths, &mso_wtab->base_segment_positions);
-	mso_wtab->calc_segments_lengths(&mso_wtab->morphed_segment_lengths, &mso_wtab->morphed_segment_positions);
-	mso_wtab->calc_wtab(mso_wtab->morphed_waveform_tab, &mso_wtab->morphed_segment_lengths, &mso_wtab->morphed_segment_positions);	
+	wavetable_size = wt_size;
+	materialized = false;
+	patch_reapply_required = false;
+	gettimeofday(&last_used_time, NULL);
 
-	// synthVoice instances are dynamiclly created in set_num_of_voices(int nov) hereafter
+	// synthVoice instances are dynamiclly created in set_num_of_voices(int nov) when materialized
 	for (i = 0; i < _SYNTH_MAX_NUM_OF_VOICES; i++)
 	{
 		synth_voices[i] = NULL;
 	}
 
 	num_of_voices = 4; // Just in case illegal num of voices was provided (something to start with
-	set_num_of_voices(voices); // This will also create the synthVoice objects
+	set_num_of_voices(voices); 
 }
 
 SynthProgram::~SynthProgram()
 {
-	delete[] program_wavetable->samples;
-	delete program_wavetable;
+	free_program_resources();
+	delete settings_manager;
+	pthread_mutex_destroy(&resources_mutex);
+}
+
+/**
+*   @brief  Create the program voices, PAD wavetable and MSO wavetable (if not created yet).
+*			If the program was released before (or its patch was changed before it was 
+*			materialized), its patch parameters are reapplied.
+*			Not to be called on the MIDI path (the PAD wavetable may be generated).
+*   @param  none
+*   @return 0 if done
+*/
+int SynthProgram::materialize()
+{
+	_settings_params_t patch_params;
+	
+	lock_resources();
+	touch();
+	
+	if (materialized)
+	{
+		unlock_resources();
+		return 0;
+	}
+	
+	// The PAD creator generates into shared wavetables; the descriptor holds the size and base frequency
+	pad_wavetable_descriptor.size = wavetable_size;
+	pad_wavetable_descriptor.samples = NULL;
+	synth_pad_creator = new SynthPADcreator(&pad_wavetable_descriptor, pad_wavetable_descriptor.size);
+	pad_wavetable_descriptor.base_freq =
+		synth_pad_creator->set_base_frequency(&pad_wavetable_descriptor, _PAD_DEFAULT_BASE_NOTE);
+	// Acquire the (shared) default wavetables
+	update_pad_wavetable();
+	mso_wtab_settings = new DSP_MorphingSinusOscWTAB();
+	update_mso_wavetable();
+	
+	unbound_dsp_voice = new DSP_Voice(0, sample_rate, audio_block_size, mso_wtab, program_wavetable, NULL);
+	patch_params_changed();
+	
+	// Create the synthVoice handles
+	set_num_of_voices(num_of_voices);
+	// All the handles point at the unbound DSP voice
+	synth_voices[0]->set_voice_params(&active_patch_params);
+	
+	if (patch_reapply_required)
+	{
+		// Restore the PAD, MSO and voices states of the patch that was active when released
+		settings_manager->settings_params_deep_copy(&patch_params, &active_patch_params);
+		set_program_patch_params(&patch_params);
+		patch_reapply_required = false;
+	}
+	
+	// Only now note-on may use the program
+	materialized = true;
+	unlock_resources();
+	
+	fprintf(stderr, "program: %i materialized\n", prog_num);
+	
+	return 0;
+}
 
-	delete[] mso_wtab->base_waveform_tab;
-	delete[] mso_wtab->morphed_waveform_tab;
+/**
+*   @brief  Release the program voices, PAD wavetable and MSO wavetable.
+*			The patch parameters are kept, and are reapplied when materialized again.
+*			Must be called with the voices management lock held (no concurrent note-on).
+*			Skipped if the program resources are in use (e.g. by a settings callback).
+*   @param  none
+*   @return 0 if done; -1 if some program voices or resources are still in use
+*/
+int SynthProgram::release()
+{
+	if (!materialized)
+	{
+		return 0;
+	}
+	
+	if (pthread_mutex_trylock(&resources_mutex) != 0)
+	{
+		return -1;
+	}
+	
+	if (has_voices_in_use())
+	{
+		unlock_resources();
+		return -1;
+	}
+	
+	free_program_resources();
+	patch_reapply_required = true;
+	unlock_resources();
+	
+	fprintf(stderr, "program: %i released\n", prog_num);
+	
+	return 0;
+}
+
+/**
+*   @brief  Return the program materialized state.
+*   @param  none
+*   @return true if the program voices and wavetables are created
+*/
+bool SynthProgram::is_materialized() { return materialized; }
+
+/**
+*   @brief  Lock the program voices and wavetables (recursive): they are not created or 
+*			released while locked.
+*   @param  none
+*   @return void
+*/
+void SynthProgram::lock_resources() { pthread_mutex_lock(&resources_mutex); }
+
+/**
+*   @brief  Unlock the program voices and wavetables.
+*   @param  none
+*   @return void
+*/
+void SynthProgram::unlock_resources() { pthread_mutex_unlock(&resources_mutex); }
+
+/**
+*   @brief  Return true if the program voices and wavetables exist.
+*			Valid while the program resources are locked. True inside materialize() 
+*			once created, before the program is marked materialized.
+*   @param  none
+*   @return true if the program voices and wavetables exist
+*/
+bool SynthProgram::has_resources() { return unbound_dsp_voice != NULL; }
+
+/**
+*   @brief  Mark the program patch parameters to be applied when materialized
+*			(a patch parameter was set while the program was not materialized).
+*   @param  none
+*   @return void
+*/
+void SynthProgram::require_patch_reapply() { patch_reapply_required = true; }
+
+/**
+*   @brief  Mark the program voices parameters as changed: a pooled voice bound later is 
+*			set with the program patch parameters.
+*   @param  none
+*   @return void
+*/
+void SynthProgram::patch_params_changed() { patch_params_version.fetch_add(1); }
+
+/**
+*   @brief  Return the program patch parameters version (see patch_params_changed()).
+*   @param  none
+*   @return the program patch parameters version
+*/
+uint32_t SynthProgram::get_patch_params_version() { return patch_params_version.load(); }
+
+/**
+*   @brief  Return true if any of the program voices is in use (bound to a pooled DSP voice).
+*   @param  none
+*   @return true if any of the program voices is in use
+*/
+bool SynthProgram::has_voices_in_use()
+{
+	for (int voice = 0; voice < _SYNTH_MAX_NUM_OF_VOICES; voice++)
+	{
+		if ((synth_voices[voice] != NULL) && synth_voices[voice]->dsp_voice_is_bound())
+		{
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+/**
+*   @brief  Mark the program as used now (restarts its idle time).
+*   @param  none
+*   @return void
+*/
+void SynthProgram::touch()
+{
+	gettimeofday(&last_used_time, NULL);
+}
+
+/**
+*   @brief  Return the time passed since the program was last used.
+*   @param  none
+*   @return the program idle time in seconds
+*/
+int SynthProgram::get_idle_time_sec()
+{
+	struct timeval now;
+	
+	gettimeofday(&now, NULL);
+	
+	return (int)(now.tv_sec - last_used_time.tv_sec);
+}
+
+/**
+*   @brief  Delete the program voices and wavetables.
+*   @param  none
+*   @return void
+*/
+void SynthProgram::free_program_resources()
+{
+	for (int voice = 0; voice < _SYNTH_MAX_NUM_OF_VOICES; voice++)
+	{
+		if (synth_voices[voice] != NULL)
+		{
+			if (AdjSynth::get_instance()->synth_voice_pool != NULL)
+			{
+				AdjSynth::get_instance()->synth_voice_pool->forget_program_voice(synth_voices[voice]);
+			}
+			delete synth_voices[voice];
+			synth_voices[voice] = NULL;
+		}
+	}
+	
+	if (unbound_dsp_voice != NULL)
+	{
+		delete unbound_dsp_voice;
+		unbound_dsp_voice = NULL;
+	}
+	
+	if (synth_pad_creator != NULL)
+	{
+		delete synth_pad_creator;
+		synth_pad_creator = NULL;
+	}
+	
+	// Shared wavetables are deleted by the registry when no longer used
+	if (program_wavetable != NULL)
+	{
+		SynthWavetablesRegistry::get_instance()->release_pad_wavetable(program_wavetable);
+		program_wavetable = NULL;
+	}
+	
+	if (mso_wtab != NULL)
+	{
+		SynthWavetablesRegistry::get_instance()->release_mso_wavetable(mso_wtab);
+		mso_wtab = NULL;
+	}
+	
+	if (mso_wtab_settings != NULL)
+	{
+		delete mso_wtab_settings;
+		mso_wtab_settings = NULL;
+	}
+	
+	materialized = false;
 }
 
 /**
@@ -276,14 +524,200 @@ void SynthProgram::set_program_patch_params(_settings_params_t *params)
 			prog_num);
 	}
 
-	synth_pad_creator->generate_wavetable(program_wavetable);
+	update_pad_wavetable();
+	update_mso_wavetable();
+}
 
-	mso_wtab->calc_segments_lengths(&mso_wtab->morphed_segment_lengths, &mso_wtab->morphed_segment_positions);
-	mso_wtab->calc_wtab(mso_wtab->morphed_waveform_tab, &mso_wtab->morphed_segment_lengths, &mso_wtab->morphed_segment_positions);
+/**
+*   @brief  Set the program PAD wavetable to the (shared) wavetable of the PAD creator 
+*			current generating parameters. The wavetable is generated only if no wavetable 
+*			with the same generating parameters is registered.
+*   @param  none
+*   @return void
+*/
+void SynthProgram::update_pad_wavetable()
+{
+	SynthWavetablesRegistry *registry = SynthWavetablesRegistry::get_instance();
+	Wavetable *wavetable;
+	std::string params;
+	
+	lock_resources();
+	
+	if (synth_pad_creator == NULL)
+	{
+		// Not materialized
+		unlock_resources();
+		return;
+	}
+	
+	synth_pad_creator->get_generating_params(&params);
+	wavetable = registry->acquire_pad_wavetable(params);
+	
+	if (wavetable == NULL)
+	{
+		wavetable = new Wavetable();
+		wavetable->size = pad_wavetable_descriptor.size;
+		wavetable->base_freq = synth_pad_creator->get_base_frequency();
+		wavetable->samples = (float*)malloc(wavetable->size * sizeof(float));
+		synth_pad_creator->generate_wavetable(wavetable);
+		wavetable = registry->add_pad_wavetable(params, wavetable);
+	}
+	else
+	{
+		// Keep the profile and spectrum (displayed) data of the current parameters
+		synth_pad_creator->update_profile_and_spectrum();
+	}
+	
+	set_program_pad_wavetable(wavetable);
+	unlock_resources();
 }
 
 /**
-*   @brief  Return a free program voice resource.
+*   @brief  Return the program MSO wavetable settings object, to change the MSO segments
+*			positions and symetry. The shared MSO wavetable is never changed: the settings
+*			take effect when update_mso_wavetable() is called.
+*			The caller must hold the program resources lock.
+*   @param  none
+*   @return a pointer to the program MSO wavetable settings object
+*/
+DSP_MorphingSinusOscWTAB *SynthProgram::edit_mso_wavetable()
+{
+	if (mso_wtab_settings == NULL)
+	{
+		if (mso_wtab != NULL)
+		{
+			mso_wtab_settings = new DSP_MorphingSinusOscWTAB(mso_wtab->get_sample_rate());
+			mso_wtab_settings->copy_segments_settings(mso_wtab);
+		}
+		else
+		{
+			// Not materialized - default settings
+			mso_wtab_settings = new DSP_MorphingSinusOscWTAB();
+		}
+	}
+	
+	return mso_wtab_settings;
+}
+
+/**
+*   @brief  Set the program MSO wavetable to the (shared) wavetable of the current MSO
+*			settings. The wavetable is calculated only if no wavetable with the same 
+*			settings is registered.
+*   @param  none
+*   @return void
+*/
+void SynthProgram::update_mso_wavetable()
+{
+	SynthWavetablesRegistry *registry = SynthWavetablesRegistry::get_instance();
+	DSP_MorphingSinusOscWTAB *wavetable;
+	std::string params;
+	
+	lock_resources();
+	
+	if ((mso_wtab_settings == NULL) || (synth_pad_creator == NULL))
+	{
+		// Not changed, or not materialized
+		unlock_resources();
+		return;
+	}
+	
+	mso_wtab_settings->get_generating_params(&params);
+	wavetable = registry->acquire_mso_wavetable(params);
+	
+	if (wavetable == NULL)
+	{
+		wavetable = new DSP_MorphingSinusOscWTAB(mso_wtab_settings->get_sample_rate());
+		wavetable->copy_segments_settings(mso_wtab_settings);
+		wavetable->calc_base_and_morphed_wtabs();
+		wavetable = registry->add_mso_wavetable(params, wavetable);
+	}
+	
+	delete mso_wtab_settings;
+	mso_wtab_settings = NULL;
+	
+	set_program_mso_wavetable(wavetable);
+	unlock_resources();
+}
+
+/**
+*   @brief  Replace the program PAD wavetable (an acquired registered wavetable) and set it
+*			to the program voices. The previous wavetable is released.
+*   @param  wavetable	a pointer to the new PAD wavetable
+*   @return void
+*/
+void SynthProgram::set_program_pad_wavetable(Wavetable *wavetable)
+{
+	Wavetable *prev_wavetable = program_wavetable;
+	
+	if (wavetable == prev_wavetable)
+	{
+		// Already used - drop the extra reference
+		SynthWavetablesRegistry::get_instance()->release_pad_wavetable(wavetable);
+		return;
+	}
+	
+	program_wavetable = wavetable;
+	
+	if (unbound_dsp_voice != NULL)
+	{
+		unbound_dsp_voice->set_pad_wavetable(wavetable);
+	}
+	
+	for (int voice = 0; voice < _SYNTH_MAX_NUM_OF_VOICES; voice++)
+	{
+		if ((synth_voices[voice] != NULL) && synth_voices[voice]->dsp_voice_is_bound())
+		{
+			synth_voices[voice]->dsp_voice->set_pad_wavetable(wavetable);
+		}
+	}
+	
+	if (prev_wavetable != NULL)
+	{
+		SynthWavetablesRegistry::get_instance()->release_pad_wavetable(prev_wavetable);
+	}
+}
+
+/**
+*   @brief  Replace the program MSO wavetable (an acquired registered wavetable) and set it
+*			to the program voices. The previous wavetable is released.
+*   @param  wavetable	a pointer to the new MSO wavetable
+*   @return void
+*/
+void SynthProgram::set_program_mso_wavetable(DSP_MorphingSinusOscWTAB *wavetable)
+{
+	DSP_MorphingSinusOscWTAB *prev_wavetable = mso_wtab;
+	
+	if (wavetable == prev_wavetable)
+	{
+		// Already used - drop the extra reference
+		SynthWavetablesRegistry::get_instance()->release_mso_wavetable(wavetable);
+		return;
+	}
+	
+	mso_wtab = wavetable;
+	
+	if (unbound_dsp_voice != NULL)
+	{
+		unbound_dsp_voice->set_mso_wavetable(wavetable);
+	}
+	
+	for (int voice = 0; voice < _SYNTH_MAX_NUM_OF_VOICES; voice++)
+	{
+		if ((synth_voices[voice] != NULL) && synth_voices[voice]->dsp_voice_is_bound())
+		{
+			synth_voices[voice]->dsp_voice->set_mso_wavetable(wavetable);
+		}
+	}
+	
+	if (prev_wavetable != NULL)
+	{
+		SynthWavetablesRegistry::get_instance()->release_mso_wavetable(prev_wavetable);
+	}
+}
+
+/**
+*   @brief  Return a free program voice resource (a handle that is not bound to a pooled
+*			DSP voice). The handle is marked in use when a pooled DSP voice is bound to it.
 *   @param  none
 *   @return a pointer to a free program voice resource.
 */
@@ -301,7 +735,12 @@ SynthVoice *SynthProgram::get_free_voice()
 	//	return NULL;
 	//}
 
-	if (portamento_enabled)
+	if (!materialized)
+	{
+		return NULL;
+	}
+
+	if (portamento_enabled && (synth_voices[_SYNTH_VOICE_1]->audio_voice != NULL))
 	{
 		synth_voices[_SYNTH_VOICE_1]->audio_voice->set_active();
 		synth_voices[_SYNTH_VOICE_1]->audio_voice->reset_wait_for_not_active();
@@ -315,14 +754,13 @@ SynthVoice *SynthProgram::get_free_voice()
 
 	// Look for a free voice
 	voice = 0;
-	while ((voice < num_of_voices) && synth_voices[voice]->dsp_voice->is_in_use())
+	while ((voice < num_of_voices) && synth_voices[voice]->dsp_voice_is_bound())
 	{
 		voice++;
 	}
 
 	if (voice < num_of_voices)
 	{
-		synth_voices[voice]->dsp_voice->in_use();
 		return synth_voices[voice];
 	}
 	else
@@ -332,15 +770,16 @@ SynthVoice *SynthProgram::get_free_voice()
 }
 
 /**
-*   @brief  Free in-use program voice resource.
+*   @brief  Free in-use program voice resource (free its bound pooled DSP voice).
 *   @param  voice	voice resource number
 *   @return void
 */
 void SynthProgram::free_voice(int voice)
 {
-	if ((voice >= 0) && (voice < num_of_voices))
+	if ((voice >= 0) && (voice < num_of_voices) && (synth_voices[voice] != NULL) &&
+		synth_voices[voice]->dsp_voice_is_bound())
 	{
-		synth_voices[voice]->dsp_voice->not_in_use();
+		AdjSynth::get_instance()->synth_voice_pool->release_voice(synth_voices[voice]->dsp_voice);
 		printf("program: %i free voice: %i\n", prog_num, voice);
 	}
 		
@@ -348,7 +787,7 @@ void SynthProgram::free_voice(int voice)
 
 /**
 *   @brief  Set the number of voices.
-*			Create additional new voices if required.
+*			Create additional new voices handles if required (only when materialized).
 *   @param  nov	number of voice resources to create.
 *   @return void
 */
@@ -360,20 +799,12 @@ void SynthProgram::set_num_of_voices(int nov)
 	{
 		num_of_voices = nov;
 		// Increase num of voices per demand.
-		for (i = 0; i < num_of_voices; i++)
+		for (i = 0; has_resources() && (i < num_of_voices); i++)
 		{
 			if (synth_voices[i] == NULL)
 			{				
-				synth_voices[i] = new SynthVoice(
-					i,
-					prog_num,
-					sample_rate,
-					audio_block_size,
-					&active_patch_params, 
-					mso_wtab,
-					program_wavetable,
-					audio_manager);
-				synth_voices[i]->set_voice_params(&active_patch_params);
+				// Program voice handle - DSP voices are bound from the shared voices pool
+				synth_voices[i] = new SynthVoice(i, prog_num, unbound_dsp_voice);
 			}
 		}
 	}	
@@ -496,3 +927,56 @@ void SynthProgram::update_actual_frequency()
 		actual_freq = note_freq;
 	}
 }
+
+/**
+*   @brief  Lock a program resources for the scope of a settings callback.
+*			A program parameter set while the program is not materialized is applied 
+*			when the program is materialized.
+*   @param  prog	program number
+*   @return none
+*/
+SynthProgramResourcesGuard::SynthProgramResourcesGuard(int prog)
+{
+	program = NULL;
+	resources = false;
+	
+	if ((prog >= 0) && (prog < _SYNTH_MAX_NUM_OF_PROGRAMS))
+	{
+		program = AdjSynth::get_instance()->synth_program[prog];
+	}
+	
+	if (program == NULL)
+	{
+		return;
+	}
+	
+	program->lock_resources();
+	resources = program->has_resources();
+	
+	if (resources)
+	{
+		// An edited program is not idle
+		program->touch();
+		// The callback changes the bound voices only; free pooled voices get the change when bound
+		program->patch_params_changed();
+	}
+	else
+	{
+		program->require_patch_reapply();
+	}
+}
+
+SynthProgramResourcesGuard::~SynthProgramResourcesGuard()
+{
+	if (program != NULL)
+	{
+		program->unlock_resources();
+	}
+}
+
+/**
+*   @brief  Return true if the program voices and wavetables may be used by the callback.
+*   @param  none
+*   @return true if the program voices and wavetables exist
+*/
+bool SynthProgramResourcesGuard::has_resources() { return resources; }
@@ -1,8 +1,14 @@
 /**
 *	@file		adjSynthProgram.h
 *	@author		Nahum Budin
-*	@date		4-Oct-2024
-*	@version	1.3 
+*	@date		17-Oct-2026
+*	@version	1.4 
+*					1. On demand (lazy) creation of the program voices and wavetables,
+*					   and release of idle programs resources.
+*					2. Program voices are handles bound to shared pooled DSP voices.
+*					3. PAD and MSO wavetables are shared (wavetables registry).
+*					
+*	@version	1.3	4-Oct-2024
 *					1. Code refactoring and notaion.
 *					
 *	@version	1.1	4-Feb-2021
@@ -22,6 +28,21 @@
 *					17		Sketch 2 - settings can be changed online
 *					18		Sketch 3 - settings can be changed online
 *					
+*				A program holds its patch parameters from creation, but its voices, PAD wavetable and
+*				MSO wavetable are only created (materialized) when first needed and may be released
+*				when the program is idle. A released program keeps its patch parameters and reapplies
+*				them when it is materialized again.
+*				
+*				The program voices are light handles: the DSP voices are shared by all the programs
+*				(SynthVoicePool), and a pooled DSP voice is bound to a program voice on note-on.
+*				Unbound handles point at the program unbound DSP voice that is never rendered.
+*				
+*				The PAD and MSO wavetables are immutable wavetables shared by all the programs with
+*				the same generating parameters (SynthWavetablesRegistry).
+*				
+*				A program voices and wavetables are used (settings callbacks) and changed (materialize,
+*				release) only while its resources lock is held. Settings callbacks of a program that is
+*				not materialized only keep the patch parameters, which are applied when materialized.
 *				
 *					
 */
@@ -29,6 +50,8 @@
 #pragma once
 
 #include <stdint.h>
+#include <pthread.h>
+#include <atomic>
 
 #include "../Settings/settings.h"
 #include "adjSynthVoice.h"
@@ -38,6 +61,7 @@
 #include "../LibAPI/types.h"
 
 class SynthVoice;
+class DSP_Voice;
 
 class SynthProgram
 {
@@ -83,17 +107,43 @@ public:
 
 	SynthVoice *get_free_voice();
 	void free_voice(int voice);
+	
+	int materialize();
+	int release();
+	bool is_materialized();
+	bool has_voices_in_use();
+	
+	void lock_resources();
+	void unlock_resources();
+	bool has_resources();
+	void require_patch_reapply();
+	
+	void patch_params_changed();
+	uint32_t get_patch_params_version();
+	
+	void touch();
+	int get_idle_time_sec();
+	
+	void update_pad_wavetable();
+	DSP_MorphingSinusOscWTAB *edit_mso_wavetable();
+	void update_mso_wavetable();
 
 	SynthVoice *synth_voices[_SYNTH_MAX_NUM_OF_VOICES] = { NULL };
 
 	Settings *settings_manager = NULL; 
 	_settings_params_t active_patch_params, prev_active_patch_params_x;  
 
+	// MSO wavetable (shared - not to be changed; see edit_mso_wavetable())
 	DSP_MorphingSinusOscWTAB *mso_wtab = NULL;
+	
+	// Unbound program voices handles point at this DSP voice (absorbs patch parameters updates)
+	DSP_Voice *unbound_dsp_voice = NULL;
 
-	// synthPAD wavetable
+	// synthPAD wavetable (shared)
 	SynthPADcreator *synth_pad_creator = NULL;
 	Wavetable *program_wavetable = NULL;
+	// The PAD wavetable size and base frequency settings (no samples)
+	Wavetable pad_wavetable_descriptor = { _PAD_DEFAULT_WAVETABLE_SIZE, _PAD_DEFAULT_BASE_NOTE_FREQ, NULL };
 	
 
 private:
@@ -107,6 +157,28 @@ private:
 	// Indicates 1st voice index out of all synthesizer voices. 
 	// e.g. firstVoiceIndex = 10 and numOfVoices = 12 => program voices: 10 to 21.
 	int first_voice_index;
+	
+	// Program PAD wavetable size
+	int wavetable_size;
+	// True when the program voices and wavetables are created (set last, so note-on may use them)
+	std::atomic<bool> materialized;
+	// Held while the program voices and wavetables are used or changed (recursive)
+	pthread_mutex_t resources_mutex;
+	// Changed whenever the program voices parameters may have been changed (pooled voices
+	// holding an older version must be set with the patch parameters when bound)
+	std::atomic<uint32_t> patch_params_version;
+	// True when the program was released, and its patch parameters must be reapplied when materialized
+	bool patch_reapply_required;
+	// Last time a note was played or a patch was loaded (used for idle release)
+	struct timeval last_used_time;
+
+	void free_program_resources();
+	
+	void set_program_pad_wavetable(Wavetable *wavetable);
+	void set_program_mso_wavetable(DSP_MorphingSinusOscWTAB *wavetable);
+	
+	// MSO settings being changed (NULL if not changed since the MSO wavetable was updated)
+	DSP_MorphingSinusOscWTAB *mso_wtab_settings = NULL;
 
 	bool portamento_enabled;
 	// Portamento gliding time
@@ -129,3 +201,27 @@ private:
 	func_ptr_int_settings_parms_ptr_int_t set_patch_settings_default_params_callback_ptr = NULL;
 	func_ptr_void_int_t mark_voice_bussy_callback_ptr = NULL;
 };
+
+/**
+*	@brief	Holds a program resources lock for the scope of a settings callback.
+*			The callback may use the program voices and wavetables only when has_resources() 
+*			is true; otherwise only the patch parameter value is kept, and the patch parameters
+*			are applied when the program is materialized.
+*/
+class SynthProgramResourcesGuard
+{
+public:
+	SynthProgramResourcesGuard(int prog);
+	~SynthProgramResourcesGuard();
+	
+	bool has_resources();
+	
+private:
+	SynthProgram *program;
+	bool resources;
+};
+
+// Settings callbacks that use a program voices or wavetables start with this guard
+#define _SYNTH_PROGRAM_RESOURCES_GUARD(prog) \
+	SynthProgramResourcesGuard program_resources_guard(prog); \
+	if (!program_resources_guard.has_resources()) { return 0; }
@@ -73,3 +73,50 @@ int set_audio_jack_auto_connect_state_cb(bool state, int prog)
 
 	return 0;
 }
+
+int set_audio_multi_core_voices_rendering_state_cb(bool state, int prog)
+{
+	return AdjSynth::get_instance()->audio_manager->set_multi_core_voices_rendering_state(state);
+}
+
+int set_audio_blocks_arena_state_cb(bool state, int prog)
+{
+	AdjSynth::get_instance()->audio_manager->set_audio_blocks_arena_state(state);
+	
+	return 0;
+}
+
+int set_audio_jack_direct_output_state_cb(bool state, int prog)
+{
+	AdjSynth::get_instance()->audio_manager->set_jack_direct_output_state(state);
+	
+	return 0;
+}
+
+int set_audio_jack_render_in_callback_state_cb(bool state, int prog)
+{
+	AdjSynth::get_instance()->audio_manager->set_jack_render_in_callback_state(state);
+	
+	return 0;
+}
+
+int set_audio_update_timer_catch_up_state_cb(bool state, int prog)
+{
+	AdjSynth::get_instance()->audio_manager->set_update_timer_catch_up_state(state);
+	
+	return 0;
+}
+
+int set_audio_voice_silence_threshold_cb(int thresh_db, int prog)
+{
+	DSP_Voice::set_silence_threshold_db(thresh_db);
+	
+	return 0;
+}
+
+int set_audio_voice_silence_hold_time_cb(int hold_ms, int prog)
+{
+	DSP_Voice::set_silence_hold_time_ms(hold_ms);
+	
+	return 0;
+}
@@ -0,0 +1,49 @@
+/**
+*	@file		adjSynthSettingsCallbacksPolyphony.cpp
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0
+*
+*	@brief		Callback to handle Polyphony governor and programs resources settings
+*
+*	History:\n
+*
+*	version 1.0	17-Oct-2026 First version
+*
+*/
+
+#include "adjSynth.h"
+
+int set_polyphony_governor_state_cb(bool en, int prog)
+{
+	return_val_if_true(AdjSynth::synth_polyphony_manager == NULL, -1);
+	
+	AdjSynth::synth_polyphony_manager->set_governor_state(en);
+	return 0;
+}
+
+int set_polyphony_governor_high_load_cb(int load, int prog)
+{
+	return_val_if_true(AdjSynth::synth_polyphony_manager == NULL, -1);
+	
+	return AdjSynth::synth_polyphony_manager->set_governor_high_load(load);
+}
+
+int set_polyphony_governor_low_load_cb(int load, int prog)
+{
+	return_val_if_true(AdjSynth::synth_polyphony_manager == NULL, -1);
+	
+	return AdjSynth::synth_polyphony_manager->set_governor_low_load(load);
+}
+
+int set_polyphony_governor_min_voices_cb(int voices, int prog)
+{
+	return_val_if_true(AdjSynth::synth_polyphony_manager == NULL, -1);
+	
+	return AdjSynth::synth_polyphony_manager->set_governor_min_voices(voices);
+}
+
+int set_program_idle_release_time_cb(int sec, int prog)
+{
+	return AdjSynth::get_instance()->set_program_idle_release_time(sec);
+}
@@ -153,6 +153,8 @@ int set_voice_block_amp_ch_2_pan_modulation_lfo_level_cb(int lev, int voice, int
 
 int set_voice_block_amp_fixed_levels_state_cb(bool en, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	if ((prog >= 0) && (prog < _SYNTH_MAX_NUM_OF_PROGRAMS))
 	{
 		if (en == _AMP_FIXED_LEVELS_ENABLE)
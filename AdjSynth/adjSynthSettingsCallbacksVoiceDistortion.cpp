@@ -20,6 +20,8 @@
 
 int set_voice_block_distortion_enabled_cb(bool enable, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	if (enable)
 	{
 		AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->enable_distortion_1();
@@ -36,6 +38,8 @@ int set_voice_block_distortion_enabled_cb(bool enable, int voice, int prog)
 
 int set_voice_block_distortion_auto_gain_enabled_cb(bool enable, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	if (enable)
 	{
 		AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->
@@ -57,6 +61,8 @@ int set_voice_block_distortion_auto_gain_enabled_cb(bool enable, int voice, int
 
 int set_voice_block_distortion_1_drive_cb(int drv, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->
 					dsp_voice->distortion_1->set_drive((float)drv / 100.f);
 	return 0;
@@ -64,6 +70,8 @@ int set_voice_block_distortion_1_drive_cb(int drv, int voice, int prog)
 
 int set_voice_block_distortion_1_range_cb(int rng, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	float value = ((float)rng / 100.f) * (_DISTORTION_MAX_RANGE - _DISTORTION_MIN_RANGE) + _DISTORTION_MIN_RANGE;
 
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->
@@ -73,6 +81,8 @@ int set_voice_block_distortion_1_range_cb(int rng, int voice, int prog)
 
 int set_voice_block_distortion_1_blend_cb(int blnd, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->
 					dsp_voice->distortion_1->set_blend((float)blnd / 100.f);
 	return 0;
@@ -81,6 +91,8 @@ int set_voice_block_distortion_1_blend_cb(int blnd, int voice, int prog)
 
 int set_voice_block_distortion_2_drive_cb(int drv, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->
 					dsp_voice->distortion_2->set_drive((float)drv / 100.f);
 	return 0;
@@ -88,6 +100,8 @@ int set_voice_block_distortion_2_drive_cb(int drv, int voice, int prog)
 
 int set_voice_block_distortion_2_range_cb(int rng, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	float value = ((float)rng / 100.f) * (_DISTORTION_MAX_RANGE - _DISTORTION_MIN_RANGE) + _DISTORTION_MIN_RANGE;
 
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->
@@ -97,6 +111,8 @@ int set_voice_block_distortion_2_range_cb(int rng, int voice, int prog)
 
 int set_voice_block_distortion_2_blend_cb(int blnd, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->
 					dsp_voice->distortion_2->set_blend((float)blnd / 100.f);
 	return 0;
@@ -1,15 +1,17 @@
 /**
 *	@file		adjSynthSettingsCallbacksVoiceFilter.cpp
 *	@author		Nahum Budin
-*	@date		5-Oct-2024
-*	@version	1.2
-*					1. Code refactoring and notaion.
+*	@date		17-Oct-2026
+*	@version	1.3
+*					1. Filter model callbacks.
 *	
 *	@brief		Callback to handle voice block Filters Settings
 *	settings
 *
 *	History:\n
 *	
+*	version	1.2	5-Oct-2024
+*					1. Code refactoring and notaion.
 *	version	1.1	5-Feb-2021
 *					1. Code refactoring and notaion.
 *	version 1.0	15_Nov-2019	First version
@@ -21,6 +23,8 @@
 
 int set_voice_block_filter_1_frequency_cb(int freq, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->filter_1->
 					set_frequency(freq);
 	return 0;
@@ -28,6 +32,8 @@ int set_voice_block_filter_1_frequency_cb(int freq, int voice, int prog)
 
 int set_voice_block_filter_1_octave_cb(int oct, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->filter_1->
 					set_octave(oct);
 	return 0;
@@ -35,6 +41,8 @@ int set_voice_block_filter_1_octave_cb(int oct, int voice, int prog)
 
 int set_voice_block_filter_1_q_cb(int q, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->filter_1->
 					set_resonance(q);
 	return 0;
@@ -42,6 +50,8 @@ int set_voice_block_filter_1_q_cb(int q, int voice, int prog)
 
 int set_voice_block_filter_1_kbd_track_cb(int kbdt, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->filter_1->
 					set_kbd_track(kbdt);
 	return 0;
@@ -49,13 +59,26 @@ int set_voice_block_filter_1_kbd_track_cb(int kbdt, int voice, int prog)
 
 int set_voice_block_filter_1_band_cb(int bnd, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->filter_1->
 					set_band(bnd);
 	return 0;
 }
 
+int set_voice_block_filter_1_model_cb(int mdl, int voice, int prog)
+{
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
+	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->filter_1->
+					set_model(mdl);
+	return 0;
+}
+
 int set_voice_block_filter_1_freq_modulation_lfo_num_cb(int lfo, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_filter_1_freq_mod_lfo(lfo);
 	return 0;
@@ -63,6 +86,8 @@ int set_voice_block_filter_1_freq_modulation_lfo_num_cb(int lfo, int voice, int
 
 int set_voice_block_filter_1_freq_modulation_lfo_level_cb(int lev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_filter_1_freq_mod_lfo_level(lev);
 	return 0;
@@ -70,6 +95,8 @@ int set_voice_block_filter_1_freq_modulation_lfo_level_cb(int lev, int voice, in
 
 int set_voice_block_filter_1_freq_modulation_env_num_cb(int env, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_filter_1_freq_mod_env(env);
 	return 0;
@@ -77,6 +104,8 @@ int set_voice_block_filter_1_freq_modulation_env_num_cb(int env, int voice, int
 
 int set_voice_block_filter_1_freq_modulation_env_level_cb(int lev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_filter_1_freq_mod_env_level(lev);
 	return 0;
@@ -85,6 +114,8 @@ int set_voice_block_filter_1_freq_modulation_env_level_cb(int lev, int voice, in
 
 int set_voice_block_filter_2_frequency_cb(int freq, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->filter_2->
 					set_frequency(freq);
 	return 0;
@@ -92,6 +123,8 @@ int set_voice_block_filter_2_frequency_cb(int freq, int voice, int prog)
 
 int set_voice_block_filter_2_octave_cb(int oct, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->filter_2->
 					set_octave(oct);
 	return 0;
@@ -99,6 +132,8 @@ int set_voice_block_filter_2_octave_cb(int oct, int voice, int prog)
 
 int set_voice_block_filter_2_q_cb(int q, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->filter_2->
 					set_resonance(q);
 	return 0;
@@ -106,6 +141,8 @@ int set_voice_block_filter_2_q_cb(int q, int voice, int prog)
 
 int set_voice_block_filter_2_kbd_track_cb(int kbdt, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->filter_2->
 					set_kbd_track(kbdt);
 	return 0;
@@ -113,13 +150,26 @@ int set_voice_block_filter_2_kbd_track_cb(int kbdt, int voice, int prog)
 
 int set_voice_block_filter_2_band_cb(int bnd, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->filter_2->
 					set_band(bnd);
 	return 0;
 }
 
+int set_voice_block_filter_2_model_cb(int mdl, int voice, int prog)
+{
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
+	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->filter_2->
+					set_model(mdl);
+	return 0;
+}
+
 int set_voice_block_filter_2_freq_modulation_lfo_num_cb(int lfo, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_filter_2_freq_mod_lfo(lfo);
 	return 0;
@@ -127,6 +177,8 @@ int set_voice_block_filter_2_freq_modulation_lfo_num_cb(int lfo, int voice, int
 
 int set_voice_block_filter_2_freq_modulation_lfo_level_cb(int lev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_filter_2_freq_mod_lfo_level(lev);
 	return 0;
@@ -134,6 +186,8 @@ int set_voice_block_filter_2_freq_modulation_lfo_level_cb(int lev, int voice, in
 
 int set_voice_block_filter_2_freq_modulation_env_num_cb(int env, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_filter_2_freq_mod_env(env);
 	return 0;
@@ -141,6 +195,8 @@ int set_voice_block_filter_2_freq_modulation_env_num_cb(int env, int voice, int
 
 int set_voice_block_filter_2_freq_modulation_env_level_cb(int lev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_filter_2_freq_mod_env_level(lev);
 	return 0;
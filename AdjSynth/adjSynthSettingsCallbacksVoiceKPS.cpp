@@ -20,6 +20,8 @@
 
 int set_voice_block_karplus_synth_enabled_cb(bool enable, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	if (enable)
 	{
 		AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->
@@ -35,6 +37,8 @@ int set_voice_block_karplus_synth_enabled_cb(bool enable, int voice, int prog)
 
 int set_voice_block_karplus_synth_excitation_waveform_type_cb(int type, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->karplus_1->
 					set_excitation_waveform_type(type);
 	return 0;
@@ -42,6 +46,8 @@ int set_voice_block_karplus_synth_excitation_waveform_type_cb(int type, int voic
 
 int set_voice_block_karplus_synth_excitation_waveform_variations_cb(int var, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->karplus_1->
 					set_excitation_waveform_variations(var);
 	return 0;
@@ -55,6 +61,8 @@ int set_voice_block_karplus_synth_decay_cb(int dec, int voice, int prog)
 
 int set_voice_block_karplus_synth_pluck_damping_cb(int dump, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->karplus_1->
 					set_pluck_damping(dump);
 	return 0;
@@ -62,6 +70,8 @@ int set_voice_block_karplus_synth_pluck_damping_cb(int dump, int voice, int prog
 
 int set_voice_block_karplus_synth_pluck_damping_variations_cb(int dump, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->karplus_1->
 					set_pluck_damping_variation(dump);
 	return 0;
@@ -69,6 +79,8 @@ int set_voice_block_karplus_synth_pluck_damping_variations_cb(int dump, int voic
 
 int set_voice_block_karplus_synth_string_damping_cb(int dump, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->karplus_1->
 					set_string_damping(dump);
 	return 0;
@@ -76,6 +88,8 @@ int set_voice_block_karplus_synth_string_damping_cb(int dump, int voice, int pro
 
 int set_voice_block_karplus_synth_string_damping_variations_cb(int dump, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->karplus_1->
 					set_pluck_damping_variation(dump);
 	return 0;
@@ -83,6 +97,8 @@ int set_voice_block_karplus_synth_string_damping_variations_cb(int dump, int voi
 
 int set_voice_block_karplus_synth_string_damping_calculation_mode_cb(int mode, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->karplus_1->
 					set_string_dumping_calculation_mode(mode);
 	return 0;
@@ -90,6 +106,8 @@ int set_voice_block_karplus_synth_string_damping_calculation_mode_cb(int mode, i
 
 int set_voice_block_karplus_synth_send_filter_1_cb(int snd, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_karplus_1_send_filter_1_level(snd);
 	return 0;
@@ -97,6 +115,8 @@ int set_voice_block_karplus_synth_send_filter_1_cb(int snd, int voice, int prog)
 
 int set_voice_block_karplus_synth_send_filter_2_cb(int snd, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_karplus_1_send_filter_2_level(snd);
 	return 0;
@@ -104,6 +124,8 @@ int set_voice_block_karplus_synth_send_filter_2_cb(int snd, int voice, int prog)
 
 int set_voice_block_karplus_synth_on_decay_cb(int dec, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->karplus_1->
 					set_on_decay(dec);
 	return 0;
@@ -111,6 +133,8 @@ int set_voice_block_karplus_synth_on_decay_cb(int dec, int voice, int prog)
 
 int set_voice_block_karplus_synth_off_decay_cb(int dec, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->karplus_1->
 					set_off_decay(dec);
 	return 0;
@@ -20,6 +20,8 @@
 
 int set_voice_block_mso_synth_enabled_cb(bool enable, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	if (enable)
 	{
 		AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
@@ -35,6 +37,8 @@ int set_voice_block_mso_synth_enabled_cb(bool enable, int voice, int prog)
 
 int set_voice_block_mso_synth_tune_offset_oct_cb(int oct, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->mso_1->
 					set_freq_detune_oct(oct);
 	return 0;
@@ -42,6 +46,8 @@ int set_voice_block_mso_synth_tune_offset_oct_cb(int oct, int voice, int prog)
 
 int set_voice_block_mso_synth_tune_offset_semitones_cb(int semi, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->mso_1->
 					set_freq_detune_semitones(semi);
 	return 0;
@@ -49,6 +55,8 @@ int set_voice_block_mso_synth_tune_offset_semitones_cb(int semi, int voice, int
 
 int set_voice_block_mso_synth_tune_offset_cents_cb(int cnt, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->mso_1->
 					set_freq_detune_cents(cnt);
 	return 0;
@@ -56,6 +64,8 @@ int set_voice_block_mso_synth_tune_offset_cents_cb(int cnt, int voice, int prog)
 
 int set_voice_block_mso_synth_send_filter_1_cb(int send, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_mso_1_send_filter_1_level(send);
 	return 0;
@@ -63,6 +73,8 @@ int set_voice_block_mso_synth_send_filter_1_cb(int send, int voice, int prog)
 
 int set_voice_block_mso_synth_send_filter_2_cb(int send, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_mso_1_send_filter_2_level(send);
 	return 0;
@@ -70,6 +82,8 @@ int set_voice_block_mso_synth_send_filter_2_cb(int send, int voice, int prog)
 
 int set_voice_block_mso_synth_freq_modulation_lfo_num_cb(int lfon, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 		set_mso_1_freq_mod_lfo(lfon);
 	return 0;
@@ -77,6 +91,8 @@ int set_voice_block_mso_synth_freq_modulation_lfo_num_cb(int lfon, int voice, in
 
 int set_voice_block_mso_synth_freq_modulation_lfo_level_cb(int lfolev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_mso_1_freq_mod_lfo_level(lfolev);
 	return 0;
@@ -84,6 +100,8 @@ int set_voice_block_mso_synth_freq_modulation_lfo_level_cb(int lfolev, int voice
 
 int set_voice_block_mso_synth_freq_modulation_env_num_cb(int envn, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_mso_1_freq_mod_env(envn);
 	return 0;
@@ -91,6 +109,8 @@ int set_voice_block_mso_synth_freq_modulation_env_num_cb(int envn, int voice, in
 
 int set_voice_block_mso_synth_freq_modulation_env_level_cb(int envlev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_mso_1_freq_mod_env_level(envlev);
 	return 0;
@@ -98,6 +118,8 @@ int set_voice_block_mso_synth_freq_modulation_env_level_cb(int envlev, int voice
 
 int set_voice_block_mso_synth_pwm_modulation_lfo_num_cb(int lfon, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_mso_1_pwm_mod_lfo(lfon);
 	return 0;
@@ -105,6 +127,8 @@ int set_voice_block_mso_synth_pwm_modulation_lfo_num_cb(int lfon, int voice, int
 
 int set_voice_block_mso_synth_pwm_modulation_lfo_level_cb(int lfolev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_mso_1_pwm_mod_lfo_level(lfolev);
 	return 0;
@@ -112,6 +136,8 @@ int set_voice_block_mso_synth_pwm_modulation_lfo_level_cb(int lfolev, int voice,
 
 int set_voice_block_mso_synth_pwm_modulation_env_num_cb(int envn, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_mso_1_pwm_mod_env(envn);
 	return 0;
@@ -119,6 +145,8 @@ int set_voice_block_mso_synth_pwm_modulation_env_num_cb(int envn, int voice, int
 
 int set_voice_block_mso_synth_pwm_modulation_env_level_cb(int envlev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_mso_1_pwm_mod_env_level(envlev);
 	return 0;
@@ -126,6 +154,8 @@ int set_voice_block_mso_synth_pwm_modulation_env_level_cb(int envlev, int voice,
 
 int set_voice_block_mso_synth_amp_modulation_lfo_num_cb(int lfon, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_mso_1_amp_mod_lfo(lfon);
 	return 0;
@@ -133,6 +163,8 @@ int set_voice_block_mso_synth_amp_modulation_lfo_num_cb(int lfon, int voice, int
 
 int set_voice_block_mso_synth_amp_modulation_lfo_level_cb(int lfolev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_mso_1_amp_mod_lfo_level(lfolev);
 	return 0;
@@ -140,6 +172,8 @@ int set_voice_block_mso_synth_amp_modulation_lfo_level_cb(int lfolev, int voice,
 
 int set_voice_block_mso_synth_amp_modulation_env_num_cb(int envn, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_mso_1_amp_mod_env(envn);
 	return 0;
@@ -147,6 +181,8 @@ int set_voice_block_mso_synth_amp_modulation_env_num_cb(int envn, int voice, int
 
 int set_voice_block_mso_synth_amp_modulation_env_level_cb(int envlev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_mso_1_amp_mod_env_level(envlev);
 	return 0;
@@ -154,66 +190,76 @@ int set_voice_block_mso_synth_amp_modulation_env_level_cb(int envlev, int voice,
 
 int set_mso_synth_symmetry_cb(int sym, int prog)
 {
-	AdjSynth::get_instance()->synth_program[prog]->mso_wtab->set_morphing_symetry(sym);
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
+	DSP_MorphingSinusOscWTAB *mso_wtab = AdjSynth::get_instance()->synth_program[prog]->edit_mso_wavetable();
+	
+	mso_wtab->set_morphing_symetry(sym);
 	return 0;
 }
 
 int set_mso_synth_segment_position_a_cb(int pos, int prog)
 {
-	AdjSynth::get_instance()->synth_program[prog]->mso_wtab->set_segment_position(
-		pos_a, 
-		pos, 
-		&AdjSynth::get_instance()->synth_program[prog]->mso_wtab->base_segment_positions);
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
+	DSP_MorphingSinusOscWTAB *mso_wtab = AdjSynth::get_instance()->synth_program[prog]->edit_mso_wavetable();
+	
+	mso_wtab->set_segment_position(pos_a, pos, &mso_wtab->base_segment_positions);
 	
 	return 0;
 }
 
 int set_mso_synth_segment_position_b_cb(int pos, int prog)
 {
-	AdjSynth::get_instance()->synth_program[prog]->mso_wtab->set_segment_position(
-		pos_b, 
-		pos, 
-		&AdjSynth::get_instance()->synth_program[prog]->mso_wtab->base_segment_positions);
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
+	DSP_MorphingSinusOscWTAB *mso_wtab = AdjSynth::get_instance()->synth_program[prog]->edit_mso_wavetable();
+	
+	mso_wtab->set_segment_position(pos_b, pos, &mso_wtab->base_segment_positions);
 	
 	return 0;
 }
 
 int set_mso_synth_segment_position_c_cb(int pos, int prog)
 {
-	AdjSynth::get_instance()->synth_program[prog]->mso_wtab->set_segment_position(
-		pos_c, 
-		pos, 
-		&AdjSynth::get_instance()->synth_program[prog]->mso_wtab->base_segment_positions);
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
+	DSP_MorphingSinusOscWTAB *mso_wtab = AdjSynth::get_instance()->synth_program[prog]->edit_mso_wavetable();
+	
+	mso_wtab->set_segment_position(pos_c, pos, &mso_wtab->base_segment_positions);
 	
 	return 0;
 }
 
 int set_mso_synth_segment_position_d_cb(int pos, int prog)
 {
-	AdjSynth::get_instance()->synth_program[prog]->mso_wtab->set_segment_position(
-		pos_d, 
-		pos, 
-		&AdjSynth::get_instance()->synth_program[prog]->mso_wtab->base_segment_positions);
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
+	DSP_MorphingSinusOscWTAB *mso_wtab = AdjSynth::get_instance()->synth_program[prog]->edit_mso_wavetable();
+	
+	mso_wtab->set_segment_position(pos_d, pos, &mso_wtab->base_segment_positions);
 	
 	return 0;
 }
 
 int set_mso_synth_segment_position_e_cb(int pos, int prog)
 {
-	AdjSynth::get_instance()->synth_program[prog]->mso_wtab->set_segment_position(
-		pos_e, 
-		pos, 
-		&AdjSynth::get_instance()->synth_program[prog]->mso_wtab->base_segment_positions);
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
+	DSP_MorphingSinusOscWTAB *mso_wtab = AdjSynth::get_instance()->synth_program[prog]->edit_mso_wavetable();
+	
+	mso_wtab->set_segment_position(pos_e, pos, &mso_wtab->base_segment_positions);
 	
 	return 0;
 }
 
 int set_mso_synth_segment_position_f_cb(int pos, int prog)
 {
-	AdjSynth::get_instance()->synth_program[prog]->mso_wtab->set_segment_position(
-		pos_f, 
-		pos, 
-		&AdjSynth::get_instance()->synth_program[prog]->mso_wtab->base_segment_positions);
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
+	DSP_MorphingSinusOscWTAB *mso_wtab = AdjSynth::get_instance()->synth_program[prog]->edit_mso_wavetable();
+	
+	mso_wtab->set_segment_position(pos_f, pos, &mso_wtab->base_segment_positions);
 	
 	return 0;
 }
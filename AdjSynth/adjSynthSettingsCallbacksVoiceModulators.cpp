@@ -20,6 +20,8 @@
 
 int set_voice_block_lfo_1_waveform_cb(int wavf, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->lfo_1->
 					set_waveform(wavf);
 	return 0;
@@ -27,6 +29,8 @@ int set_voice_block_lfo_1_waveform_cb(int wavf, int voice, int prog)
 
 int set_voice_block_lfo_1_rate_cb(int rate, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_lfo_1_frequency(rate);
 	return 0;
@@ -34,6 +38,8 @@ int set_voice_block_lfo_1_rate_cb(int rate, int voice, int prog)
 
 int set_voice_block_lfo_1_symmetry_cb(int sym, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->lfo_1->
 					set_pwm_dcycle(sym);
 	return 0;
@@ -42,6 +48,8 @@ int set_voice_block_lfo_1_symmetry_cb(int sym, int voice, int prog)
 
 int set_voice_block_lfo_2_waveform_cb(int wavf, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->lfo_2->
 					set_waveform(wavf);
 	return 0;
@@ -49,6 +57,8 @@ int set_voice_block_lfo_2_waveform_cb(int wavf, int voice, int prog)
 
 int set_voice_block_lfo_2_rate_cb(int rate, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_lfo_2_frequency(rate);
 	return 0;
@@ -56,6 +66,8 @@ int set_voice_block_lfo_2_rate_cb(int rate, int voice, int prog)
 
 int set_voice_block_lfo_2_symmetry_cb(int sym, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->lfo_2->
 					set_pwm_dcycle(sym);
 	return 0;
@@ -64,6 +76,8 @@ int set_voice_block_lfo_2_symmetry_cb(int sym, int voice, int prog)
 
 int set_voice_block_lfo_3_waveform_cb(int wavf, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->lfo_3->
 					set_waveform(wavf);
 	return 0;
@@ -71,6 +85,8 @@ int set_voice_block_lfo_3_waveform_cb(int wavf, int voice, int prog)
 
 int set_voice_block_lfo_3_rate_cb(int rate, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_lfo_3_frequency(rate);
 	//	AdjSynth::get_instance()->audioPolyMixer->setLfo3Frequency(rate);
@@ -79,6 +95,8 @@ int set_voice_block_lfo_3_rate_cb(int rate, int voice, int prog)
 
 int set_voice_block_lfo_3_symmetry_cb(int sym, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					lfo_3->set_pwm_dcycle(sym);
 	return 0;
@@ -87,6 +105,8 @@ int set_voice_block_lfo_3_symmetry_cb(int sym, int voice, int prog)
 
 int set_voice_block_lfo_4_waveform_cb(int wavf, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->lfo_4->
 					set_waveform(wavf);
 	return 0;
@@ -94,6 +114,8 @@ int set_voice_block_lfo_4_waveform_cb(int wavf, int voice, int prog)
 
 int set_voice_block_lfo_4_rate_cb(int rate, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_lfo_4_frequency(rate);
 	//	AdjSynth::get_instance()->audioPolyMixer->setLfo4Frequency(rate);
@@ -102,6 +124,8 @@ int set_voice_block_lfo_4_rate_cb(int rate, int voice, int prog)
 
 int set_voice_block_lfo_4_symmetry_cb(int sym, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->lfo_4->
 					set_pwm_dcycle(sym);
 	return 0;
@@ -110,6 +134,8 @@ int set_voice_block_lfo_4_symmetry_cb(int sym, int voice, int prog)
 
 int set_voice_block_lfo_5_waveform_cb(int wavf, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->lfo_5->
 					set_waveform(wavf);
 	return 0;
@@ -117,6 +143,8 @@ int set_voice_block_lfo_5_waveform_cb(int wavf, int voice, int prog)
 
 int set_voice_block_lfo_5_rate_cb(int rate, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_lfo_5_frequency(rate);
 	//	AdjSynth::get_instance()->audioPolyMixer->setLfo5Frequency(rate);
@@ -125,6 +153,8 @@ int set_voice_block_lfo_5_rate_cb(int rate, int voice, int prog)
 
 int set_voice_block_lfo_5_symmetry_cb(int sym, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->lfo_5->
 					set_pwm_dcycle(sym);
 	return 0;
@@ -132,6 +162,8 @@ int set_voice_block_lfo_5_symmetry_cb(int sym, int voice, int prog)
 
 int set_voice_block_lfo_6_waveform_cb(int wavf, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->lfo_6->
 		set_waveform(wavf);
 	return 0;
@@ -139,6 +171,8 @@ int set_voice_block_lfo_6_waveform_cb(int wavf, int voice, int prog)
 
 int set_voice_block_lfo_6_rate_cb(int rate, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 		set_lfo_6_frequency(rate);
 	//	AdjSynth::get_instance()->audioPolyMixer->setLfo5Frequency(rate);
@@ -147,6 +181,8 @@ int set_voice_block_lfo_6_rate_cb(int rate, int voice, int prog)
 
 int set_voice_block_lfo_6_symmetry_cb(int sym, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->lfo_6->
 		set_pwm_dcycle(sym);
 	return 0;
@@ -155,6 +191,8 @@ int set_voice_block_lfo_6_symmetry_cb(int sym, int voice, int prog)
 
 int set_voice_block_env_1_attack_cb(int attck, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_1->
 					set_attack_time_sec(attck);
 	return 0;
@@ -162,6 +200,8 @@ int set_voice_block_env_1_attack_cb(int attck, int voice, int prog)
 
 int set_voice_block_env_1_decay_cb(int dec, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_1->
 					set_decay_time_sec(dec);
 	return 0;
@@ -169,6 +209,8 @@ int set_voice_block_env_1_decay_cb(int dec, int voice, int prog)
 
 int set_voice_block_env_1_sustain_cb(int sus, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_1->
 					set_send_level_1(sus);
 	return 0;
@@ -176,6 +218,8 @@ int set_voice_block_env_1_sustain_cb(int sus, int voice, int prog)
 
 int set_voice_block_env_1_release_cb(int rel, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_1->
 					set_release_time_sec(rel);
 	return 0;
@@ -184,6 +228,8 @@ int set_voice_block_env_1_release_cb(int rel, int voice, int prog)
 
 int set_voice_block_env_2_attack_cb(int attck, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_2->
 					set_attack_time_sec(attck);
 	return 0;
@@ -191,6 +237,8 @@ int set_voice_block_env_2_attack_cb(int attck, int voice, int prog)
 
 int set_voice_block_env_2_decay_cb(int dec, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_2->
 					set_decay_time_sec(dec);
 	return 0;
@@ -198,6 +246,8 @@ int set_voice_block_env_2_decay_cb(int dec, int voice, int prog)
 
 int set_voice_block_env_2_sustain_cb(int sus, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_2->
 					set_sustain_level(sus);
 	return 0;
@@ -205,6 +255,8 @@ int set_voice_block_env_2_sustain_cb(int sus, int voice, int prog)
 
 int set_voice_block_env_2_release_cb(int rel, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_2->
 					set_release_time_sec(rel);
 	return 0;
@@ -213,6 +265,8 @@ int set_voice_block_env_2_release_cb(int rel, int voice, int prog)
 
 int set_voice_block_env_3_attack_cb(int attck, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_3->
 					set_attack_time_sec(attck);
 	return 0;
@@ -220,6 +274,8 @@ int set_voice_block_env_3_attack_cb(int attck, int voice, int prog)
 
 int set_voice_block_env_3_decay_cb(int dec, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_3->
 					set_decay_time_sec(dec);
 	return 0;
@@ -227,6 +283,8 @@ int set_voice_block_env_3_decay_cb(int dec, int voice, int prog)
 
 int set_voice_block_env_3_sustain_cb(int sus, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_3->
 					set_sustain_level(sus);
 	return 0;
@@ -234,6 +292,8 @@ int set_voice_block_env_3_sustain_cb(int sus, int voice, int prog)
 
 int set_voice_block_env_3_release_cb(int rel, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_3->
 					set_release_time_sec(rel);
 	return 0;
@@ -242,6 +302,8 @@ int set_voice_block_env_3_release_cb(int rel, int voice, int prog)
 
 int set_voice_block_env_4_attack_cb(int attck, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					adsr_4->set_attack_time_sec(attck);
 	return 0;
@@ -249,6 +311,8 @@ int set_voice_block_env_4_attack_cb(int attck, int voice, int prog)
 
 int set_voice_block_env_4_decay_cb(int dec, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					adsr_4->set_decay_time_sec(dec);
 	return 0;
@@ -256,6 +320,8 @@ int set_voice_block_env_4_decay_cb(int dec, int voice, int prog)
 
 int set_voice_block_env_4_sustain_cb(int sus, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					adsr_4->set_sustain_level(sus);
 	return 0;
@@ -263,6 +329,8 @@ int set_voice_block_env_4_sustain_cb(int sus, int voice, int prog)
 
 int set_voice_block_env_4_release_cb(int rel, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					adsr_4->set_release_time_sec(rel);
 	return 0;
@@ -271,6 +339,8 @@ int set_voice_block_env_4_release_cb(int rel, int voice, int prog)
 
 int set_voice_block_env_5_attack_cb(int attck, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					adsr_5->set_attack_time_sec(attck);
 	return 0;
@@ -278,6 +348,8 @@ int set_voice_block_env_5_attack_cb(int attck, int voice, int prog)
 
 int set_voice_block_env_5_decay_cb(int dec, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_5->
 					set_decay_time_sec(dec);
 	return 0;
@@ -285,6 +357,8 @@ int set_voice_block_env_5_decay_cb(int dec, int voice, int prog)
 
 int set_voice_block_env_5_sustain_cb(int sus, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_5->
 					set_sustain_level(sus);
 	return 0;
@@ -292,6 +366,8 @@ int set_voice_block_env_5_sustain_cb(int sus, int voice, int prog)
 
 int set_voice_block_env_5_release_cb(int rel, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_5->
 					set_release_time_sec(rel);
 	return 0;
@@ -299,6 +375,8 @@ int set_voice_block_env_5_release_cb(int rel, int voice, int prog)
 
 int set_voice_block_env_6_attack_cb(int attck, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 		adsr_6->set_attack_time_sec(attck);
 	return 0;
@@ -306,6 +384,8 @@ int set_voice_block_env_6_attack_cb(int attck, int voice, int prog)
 
 int set_voice_block_env_6_decay_cb(int dec, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_6->
 		set_decay_time_sec(dec);
 	return 0;
@@ -313,6 +393,8 @@ int set_voice_block_env_6_decay_cb(int dec, int voice, int prog)
 
 int set_voice_block_env_6_sustain_cb(int sus, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_6->
 		set_sustain_level(sus);
 	return 0;
@@ -320,6 +402,8 @@ int set_voice_block_env_6_sustain_cb(int sus, int voice, int prog)
 
 int set_voice_block_env_6_release_cb(int rel, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->adsr_6->
 		set_release_time_sec(rel);
 	return 0;
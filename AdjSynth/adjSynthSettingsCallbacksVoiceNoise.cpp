@@ -19,6 +19,8 @@
 
 int set_voice_block_noise_enabled_cb(bool enable, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	if (enable)
 	{
 		AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
@@ -34,6 +36,8 @@ int set_voice_block_noise_enabled_cb(bool enable, int voice, int prog)
 
 int set_voice_block_noise_color_cb(int typ, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->noise_1->
 					set_noise_type(typ);	
 	return 0;
@@ -41,6 +45,8 @@ int set_voice_block_noise_color_cb(int typ, int voice, int prog)
 
 int set_voice_block_noise_send_filter_1_cb(int snd, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_noise_1_send_filter_1_level(snd);
 	return 0;
@@ -48,6 +54,8 @@ int set_voice_block_noise_send_filter_1_cb(int snd, int voice, int prog)
 
 int set_voice_block_noise_send_filter_2_cb(int snd, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->
 					dsp_voice->set_noise_1_send_filter_2_level(snd);
 	return 0;
@@ -55,6 +63,8 @@ int set_voice_block_noise_send_filter_2_cb(int snd, int voice, int prog)
 
 int set_voice_block_noise_amp_modulation_lfo_num_cb(int lfon, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_noise_1_amp_mod_lfo(lfon);
 	return 0;
@@ -62,6 +72,8 @@ int set_voice_block_noise_amp_modulation_lfo_num_cb(int lfon, int voice, int pro
 
 int set_voice_block_noise_amp_modulation_lfo_level_cb(int lfolev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_noise_1_amp_mod_lfo_level(lfolev);
 	return 0;
@@ -69,6 +81,8 @@ int set_voice_block_noise_amp_modulation_lfo_level_cb(int lfolev, int voice, int
 
 int set_voice_block_noise_amp_modulation_env_num_cb(int envn, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_noise_1_amp_mod_env(envn);
 	return 0;
@@ -76,6 +90,8 @@ int set_voice_block_noise_amp_modulation_env_num_cb(int envn, int voice, int pro
 
 int set_voice_block_noise_amp_modulation_env_level_cb(int envlev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_noise_1_amp_mod_env_level(envlev);
 	return 0;
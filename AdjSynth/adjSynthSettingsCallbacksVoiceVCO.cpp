@@ -20,6 +20,8 @@
 
 int set_voice_block_osc_1_enabled_cb(bool enable, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	if (enable)
 	{
 		AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
@@ -35,6 +37,8 @@ int set_voice_block_osc_1_enabled_cb(bool enable, int voice, int prog)
 
 int set_voice_block_osc_1_waveform_cb(int wvf, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_waveform(wvf);
 	return 0;
@@ -42,6 +46,8 @@ int set_voice_block_osc_1_waveform_cb(int wvf, int voice, int prog)
 
 int set_voice_block_osc_1_pwm_symmetry_cb(int sym, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_pwm_dcycle(sym);
 	return 0;
@@ -49,6 +55,8 @@ int set_voice_block_osc_1_pwm_symmetry_cb(int sym, int voice, int prog)
 
 int set_voice_block_osc_1_send_filter_1_cb(int snd, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_1_send_filter_1_level(snd);
 	return 0;
@@ -56,6 +64,8 @@ int set_voice_block_osc_1_send_filter_1_cb(int snd, int voice, int prog)
 
 int set_voice_block_osc_1_send_filter_2_cb(int snd, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_1_send_filter_2_level(snd);
 	return 0;
@@ -63,6 +73,8 @@ int set_voice_block_osc_1_send_filter_2_cb(int snd, int voice, int prog)
 
 int set_voice_block_osc_1_tune_offset_oct_cb(int oct, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_freq_detune_oct(oct);
 	return 0;
@@ -70,6 +82,8 @@ int set_voice_block_osc_1_tune_offset_oct_cb(int oct, int voice, int prog)
 
 int set_voice_block_osc_1_tune_offset_semitones_cb(int smt, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_freq_detune_semitones(smt);
 	return 0;
@@ -77,6 +91,8 @@ int set_voice_block_osc_1_tune_offset_semitones_cb(int smt, int voice, int prog)
 
 int set_voice_block_osc_1_tune_offset_cents_cb(int cnt, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_freq_detune_cents(cnt);
 	return 0;
@@ -84,6 +100,8 @@ int set_voice_block_osc_1_tune_offset_cents_cb(int cnt, int voice, int prog)
 
 int set_voice_block_osc_1_freq_modulation_lfo_num_cb(int lfon, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_1_freq_mod_lfo(lfon);
 	return 0;
@@ -91,6 +109,8 @@ int set_voice_block_osc_1_freq_modulation_lfo_num_cb(int lfon, int voice, int pr
 
 int set_voice_block_osc_1_freq_modulation_lfo_level_cb(int lfolev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_1_freq_mod_lfo_level(lfolev);
 	return 0;
@@ -98,6 +118,8 @@ int set_voice_block_osc_1_freq_modulation_lfo_level_cb(int lfolev, int voice, in
 
 int set_voice_block_osc_1_freq_modulation_env_num_cb(int envn, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_1_freq_mod_env(envn);
 	return 0;
@@ -105,6 +127,8 @@ int set_voice_block_osc_1_freq_modulation_env_num_cb(int envn, int voice, int pr
 
 int set_voice_block_osc_1_freq_modulation_env_level_cb(int envlev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_1_freq_mod_env_level(envlev);
 	return 0;
@@ -112,6 +136,8 @@ int set_voice_block_osc_1_freq_modulation_env_level_cb(int envlev, int voice, in
 
 int set_voice_block_osc_1_pwm_modulation_lfo_num_cb(int lfon, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_1_pwm_mod_lfo(lfon);
 	return 0;
@@ -119,6 +145,8 @@ int set_voice_block_osc_1_pwm_modulation_lfo_num_cb(int lfon, int voice, int pro
 
 int set_voice_block_osc_1_pwm_modulation_lfo_level_cb(int lfolev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_1_pwm_mod_lfo_level(lfolev);
 	return 0;
@@ -126,6 +154,8 @@ int set_voice_block_osc_1_pwm_modulation_lfo_level_cb(int lfolev, int voice, int
 
 int set_voice_block_osc_1_pwm_modulation_env_num_cb(int envn, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_1_pwm_mod_env(envn);
 	return 0;
@@ -133,6 +163,8 @@ int set_voice_block_osc_1_pwm_modulation_env_num_cb(int envn, int voice, int pro
 
 int set_voice_block_osc_1_pwm_modulation_env_level_cb(int envlev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_1_pwm_mod_env_level(envlev);
 	return 0;
@@ -140,6 +172,8 @@ int set_voice_block_osc_1_pwm_modulation_env_level_cb(int envlev, int voice, int
 
 int set_voice_block_osc_1_amp_modulation_lfo_num_cb(int lfon, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_1_amp_mod_lfo(lfon);
 	return 0;
@@ -147,6 +181,8 @@ int set_voice_block_osc_1_amp_modulation_lfo_num_cb(int lfon, int voice, int pro
 
 int set_voice_block_osc_1_amp_modulation_lfo_level_cb(int lfolev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_1_amp_mod_lfo_level(lfolev);
 	return 0;
@@ -154,6 +190,8 @@ int set_voice_block_osc_1_amp_modulation_lfo_level_cb(int lfolev, int voice, int
 
 int set_voice_block_osc_1_amp_modulation_env_num_cb(int envn, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_1_amp_mod_env(envn);
 	return 0;
@@ -161,6 +199,8 @@ int set_voice_block_osc_1_amp_modulation_env_num_cb(int envn, int voice, int pro
 
 int set_voice_block_osc_1_amp_modulation_env_level_cb(int envlev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_1_amp_mod_env_level(envlev);
 	return 0;
@@ -168,6 +208,8 @@ int set_voice_block_osc_1_amp_modulation_env_level_cb(int envlev, int voice, int
 
 int set_voice_block_osc_1_unison_mod_cb(int unimod, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					osc_1->set_unison_mode(unimod);
 	if (voice == 0)
@@ -179,6 +221,8 @@ int set_voice_block_osc_1_unison_mod_cb(int unimod, int voice, int prog)
 
 int set_voice_block_osc_1_hammond_percussion_mode_cb(int pmode, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	if (voice == 0)
 	{
 		AdjSynth::get_instance()->set_hammond_percusion_mode(pmode, 
@@ -193,6 +237,8 @@ int set_voice_block_osc_1_hammond_percussion_mode_cb(int pmode, int voice, int p
 
 int set_voice_block_osc_1_unison_level_1_cb(int level, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_harmony_level(0, level);
 	return 0;
@@ -200,6 +246,8 @@ int set_voice_block_osc_1_unison_level_1_cb(int level, int voice, int prog)
 
 int set_voice_block_osc_1_unison_level_2_cb(int level, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_harmony_level(1, level);
 	return 0;
@@ -207,6 +255,8 @@ int set_voice_block_osc_1_unison_level_2_cb(int level, int voice, int prog)
 
 int set_voice_block_osc_1_unison_level_3_cb(int level, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_harmony_level(2, level);
 	return 0;
@@ -214,6 +264,8 @@ int set_voice_block_osc_1_unison_level_3_cb(int level, int voice, int prog)
 
 int set_voice_block_osc_1_unison_level_4_cb(int level, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_harmony_level(3, level);
 	return 0;
@@ -221,6 +273,8 @@ int set_voice_block_osc_1_unison_level_4_cb(int level, int voice, int prog)
 
 int set_voice_block_osc_1_unison_level_5_cb(int level, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_harmony_level(4, level);
 	return 0;
@@ -228,6 +282,8 @@ int set_voice_block_osc_1_unison_level_5_cb(int level, int voice, int prog)
 
 int set_voice_block_osc_1_unison_level_6_cb(int level, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_harmony_level(5, level);
 	return 0;
@@ -235,6 +291,8 @@ int set_voice_block_osc_1_unison_level_6_cb(int level, int voice, int prog)
 
 int set_voice_block_osc_1_unison_level_7_cb(int level, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_harmony_level(6, level);
 	return 0;
@@ -242,6 +300,8 @@ int set_voice_block_osc_1_unison_level_7_cb(int level, int voice, int prog)
 
 int set_voice_block_osc_1_unison_level_8_cb(int level, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_harmony_level(7, level);
 	return 0;
@@ -249,6 +309,8 @@ int set_voice_block_osc_1_unison_level_8_cb(int level, int voice, int prog)
 
 int set_voice_block_osc_1_unison_level_9_cb(int level, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_harmony_level(8, level);
 	return 0;
@@ -256,6 +318,8 @@ int set_voice_block_osc_1_unison_level_9_cb(int level, int voice, int prog)
 
 int set_voice_block_osc_1_unison_distortion_cb(int dist, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_harmonies_distortion(dist);
 	return 0;
@@ -263,6 +327,8 @@ int set_voice_block_osc_1_unison_distortion_cb(int dist, int voice, int prog)
 
 int set_voice_block_osc_1_unison_detune_cb(int det, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
 					set_harmonies_detune(det);
 	return 0;
@@ -270,6 +336,8 @@ int set_voice_block_osc_1_unison_detune_cb(int det, int voice, int prog)
 
 int set_voice_block_osc_1_unison_set_square_cb(bool sqr, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	if (sqr)
 	{
 		AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_1->
@@ -286,6 +354,8 @@ int set_voice_block_osc_1_unison_set_square_cb(bool sqr, int voice, int prog)
 
 int set_voice_block_osc_2_enabled_cb(bool enable, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	if (enable)
 	{
 		AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
@@ -301,6 +371,8 @@ int set_voice_block_osc_2_enabled_cb(bool enable, int voice, int prog)
 
 int set_voice_block_osc_2_waveform_cb(int wvf, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_2->
 					set_waveform(wvf);
 	return 0;
@@ -308,6 +380,8 @@ int set_voice_block_osc_2_waveform_cb(int wvf, int voice, int prog)
 
 int set_voice_block_osc_2_pwm_symmetry_cb(int sym, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_2->
 					set_pwm_dcycle(sym);
 	return 0;
@@ -315,6 +389,8 @@ int set_voice_block_osc_2_pwm_symmetry_cb(int sym, int voice, int prog)
 
 int set_voice_block_osc_2_send_filter_1_cb(int snd, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_2_send_filter_1_level(snd);
 	return 0;
@@ -322,6 +398,8 @@ int set_voice_block_osc_2_send_filter_1_cb(int snd, int voice, int prog)
 
 int set_voice_block_osc_2_send_filter_2_cb(int snd, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_2_send_filter_2_level(snd);
 	return 0;
@@ -329,6 +407,8 @@ int set_voice_block_osc_2_send_filter_2_cb(int snd, int voice, int prog)
 
 int set_voice_block_osc_2_tune_offset_oct_cb(int oct, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_2->
 					set_freq_detune_oct(oct);
 	return 0;
@@ -336,6 +416,8 @@ int set_voice_block_osc_2_tune_offset_oct_cb(int oct, int voice, int prog)
 
 int set_voice_block_osc_2_tune_offset_semitones_cb(int smt, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_2->
 					set_freq_detune_semitones(smt);
 	return 0;
@@ -343,6 +425,8 @@ int set_voice_block_osc_2_tune_offset_semitones_cb(int smt, int voice, int prog)
 
 int set_voice_block_osc_2_tune_offset_cents_cb(int cnt, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->osc_2->
 					set_freq_detune_cents(cnt);
 	return 0;
@@ -350,6 +434,8 @@ int set_voice_block_osc_2_tune_offset_cents_cb(int cnt, int voice, int prog)
 
 int set_voice_block_osc_2_freq_modulation_lfo_num_cb(int lfon, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_2_freq_mod_lfo(lfon);
 	return 0;
@@ -357,6 +443,8 @@ int set_voice_block_osc_2_freq_modulation_lfo_num_cb(int lfon, int voice, int pr
 
 int set_voice_block_osc_2_freq_modulation_lfo_level_cb(int lfolev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_2_freq_mod_lfo_level(lfolev);
 	return 0;
@@ -364,6 +452,8 @@ int set_voice_block_osc_2_freq_modulation_lfo_level_cb(int lfolev, int voice, in
 
 int set_voice_block_osc_2_freq_modulation_env_num_cb(int envn, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_2_freq_mod_env(envn);
 	return 0;
@@ -371,6 +461,8 @@ int set_voice_block_osc_2_freq_modulation_env_num_cb(int envn, int voice, int pr
 
 int set_voice_block_osc_2_freq_modulation_env_level_cb(int envlev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_2_freq_mod_env_level(envlev);
 	return 0;
@@ -378,6 +470,8 @@ int set_voice_block_osc_2_freq_modulation_env_level_cb(int envlev, int voice, in
 
 int set_voice_block_osc_2_pwm_modulation_lfo_num_cb(int lfon, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_2_pwm_mod_lfo(lfon);
 	return 0;
@@ -385,6 +479,8 @@ int set_voice_block_osc_2_pwm_modulation_lfo_num_cb(int lfon, int voice, int pro
 
 int set_voice_block_osc_2_pwm_modulation_lfo_level_cb(int lfolev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_2_pwm_mod_lfo_level(lfolev);
 	return 0;
@@ -392,6 +488,8 @@ int set_voice_block_osc_2_pwm_modulation_lfo_level_cb(int lfolev, int voice, int
 
 int set_voice_block_osc_2_pwm_modulation_env_num_cb(int envn, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_2_pwm_mod_env(envn);
 	return 0;
@@ -399,6 +497,8 @@ int set_voice_block_osc_2_pwm_modulation_env_num_cb(int envn, int voice, int pro
 
 int set_voice_block_osc_2_pwm_modulation_env_level_cb(int envlev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_2_pwm_mod_env_level(envlev);
 	return 0;
@@ -406,6 +506,8 @@ int set_voice_block_osc_2_pwm_modulation_env_level_cb(int envlev, int voice, int
 
 int set_voice_block_osc_2_amp_modulation_lfo_num_cb(int lfon, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_2_amp_mod_lfo(lfon);
 	return 0;
@@ -413,6 +515,8 @@ int set_voice_block_osc_2_amp_modulation_lfo_num_cb(int lfon, int voice, int pro
 
 int set_voice_block_osc_2_amp_modulation_lfo_level_cb(int lfolev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_2_amp_mod_lfo_level(lfolev);
 	return 0;
@@ -420,6 +524,8 @@ int set_voice_block_osc_2_amp_modulation_lfo_level_cb(int lfolev, int voice, int
 
 int set_voice_block_osc_2_amp_modulation_env_num_cb(int envn, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_2_amp_mod_env(envn);
 	return 0;
@@ -427,6 +533,8 @@ int set_voice_block_osc_2_amp_modulation_env_num_cb(int envn, int voice, int pro
 
 int set_voice_block_osc_2_amp_modulation_env_level_cb(int envlev, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
 					set_osc_2_amp_mod_env_level(envlev);
 	return 0;
@@ -434,6 +542,8 @@ int set_voice_block_osc_2_amp_modulation_env_level_cb(int envlev, int voice, int
 
 int set_voice_block_osc_2_sync_on_osc_1_state_cb(bool sync, int voice, int prog)
 {
+	_SYNTH_PROGRAM_RESOURCES_GUARD(prog);
+	
 	if (sync)
 	{
 		AdjSynth::get_instance()->synth_program[prog]->synth_voices[voice]->dsp_voice->
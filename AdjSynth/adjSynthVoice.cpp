@@ -1,8 +1,13 @@
 /**
 *	@file		adjSynthVoice.cpp
 *	@author		Nahum Budin
-*	@date		3-Oct-2024
-*	@version	1.2 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Per stage audio blocks profiling counters.
+*					2. Program voices (DSP voice only, no audio path).
+*					3. Program voice handles bound to pooled DSP voices.
+*					
+*	@version	3-Oct-2024	1.2
 *					1. Code refactoring and notaion.
 *					
 *	@version	2-Feb--2021	1.1
@@ -16,6 +21,7 @@
 
 #include "adjSynthVoice.h"
 #include "../DSP/dspVoice.h"
+#include "../Audio/audioVoiceProfiler.h"
 
 /**
 *	@brief	Creates a SynthVoice instance
@@ -24,6 +30,8 @@
 *	@param	params	a pointer to a _setting_params_t structure (patch parameters) 
 *	@param	msolut	a pointer to a DSP_MorphingSinusOscLUT object
 *	@param	synthPADwavetable a pointer to a Wavetable object
+*	@param	aud_mng	a pointer to the AudioManager object; if NULL, a program voice is created:
+*					only its DSP voice is created, without an audio path.
 *	@return none
 */
 SynthVoice::SynthVoice(
@@ -52,6 +60,17 @@ SynthVoice::SynthVoice(
 	settings_manager->settings_params_deep_copy(&active_params, params);
 		
 	dsp_voice = new DSP_Voice(voice_num, sample_rate, audio_block_size, mso_wtab, pad_wavetable, NULL); //<<<<<< 
+	
+	own_dsp_voice = true;
+	
+	if (audio_manager == NULL)
+	{
+		// Program voice - its DSP voice is assigned to the synth (audio) voices
+		settings_manager = new Settings(&active_params);
+		set_voice_params(&active_params);
+		return;
+	}
+	
 	audio_voice = new AudioVoiceFloat(
 			_AUDIO_STAGE_2,			// process stage 2
 		sample_rate,
@@ -79,6 +98,54 @@ SynthVoice::SynthVoice(
 	set_voice_params(&active_params);
 }
 
+/**
+*	@brief	Creates a program voice handle SynthVoice instance.
+*			A handle owns no DSP voice: a pooled DSP voice is bound to it on note-on, and
+*			it points at the given unbound DSP voice otherwise (patch parameters updates
+*			of an unbound handle are absorbed by the unbound DSP voice).
+*	@param	vnum	voice id number 
+*	@param	prg		allocated to program number
+*	@param	unbound_dspv	a pointer to the DSP voice the handle points at when not bound
+*	@return none
+*/
+SynthVoice::SynthVoice(int vnum, int prg, DSP_Voice *unbound_dspv)
+{
+	sample_rate = _DEFAULT_SAMPLE_RATE;
+	audio_block_size = _DEFAULT_BLOCK_SIZE;
+	update_in_progress = false;
+	
+	voice_num = vnum;
+	set_allocated_program(prg);
+	allocated_to_program_voice_num = -1;
+	
+	unbound_dsp_voice = unbound_dspv;
+	dsp_voice = unbound_dsp_voice;
+	own_dsp_voice = false;
+	// Used only to read the patch parameters in set_voice_params()
+	settings_manager = new Settings(&active_params);
+}
+
+/**
+*	@brief	Destroys a SynthVoice instance.
+*			Only program voices own their DSP voice (program voice handles do not). 
+*			The audio path objects are linked to pooled audio connections and are kept 
+*			for the synthesizer lifetime.
+*	@param	none
+*	@return none
+*/
+SynthVoice::~SynthVoice()
+{
+	if (own_dsp_voice && (audio_voice == NULL))
+	{
+		delete dsp_voice;
+	}
+	
+	if (settings_manager != NULL)
+	{
+		delete settings_manager;
+	}
+}
+
 /**
 *   @brief  Return a pointer to the SynthVoice object instance
 *   @param  none
@@ -208,6 +275,8 @@ void SynthVoice::update_all()
 	uint8_t stage;
 	int coreNum, ID;
 	static uint32_t count = 0;
+	bool profile;
+	uint64_t start_ticks;
 
 	if (!update_in_progress)
 	{
@@ -218,13 +287,29 @@ void SynthVoice::update_all()
 		//if (update_enable) <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 		//{
 		pthread_mutex_lock(&update_mutex[voice_num]); // mutex defind at audioManager
+		// Profiling state is checked once per block
+		profile = AudioVoiceProfiler::is_enabled();
 		for (stage = 0; stage < _MAX_STAGE_NUM; stage++)
 		{
 			for (p = audio_first_update[stage]; p; p = p->audio_next_update)
 			{
-				p->update();
+				if (profile)
+				{
+					start_ticks = AudioVoiceProfiler::get_ticks();
+					p->update();
+					AudioVoiceProfiler::add_stage_ticks(voice_num, stage, AudioVoiceProfiler::get_ticks() - start_ticks);
+				}
+				else
+				{
+					p->update();
+				}
 			}
 		}
+		
+		if (profile)
+		{
+			AudioVoiceProfiler::add_voice_update(voice_num);
+		}
 
 		update_in_progress = false;
 
@@ -240,13 +325,51 @@ void SynthVoice::update_all()
 */
 void SynthVoice::assign_dsp_voice(DSP_Voice *dspv)
 {
-	if (dspv)
+	if (dspv && audio_voice)
 	{
 		dsp_voice = dspv;
 		audio_voice->dsp_voice = dspv;
 	}
 }
 
+/**
+*   @brief  Bind a pooled DSP voice to a program voice handle
+*   @param  dspv	a pointer to a (pooled) DSP_Voice object instance
+*   @return void
+*/
+void SynthVoice::bind_dsp_voice(DSP_Voice *dspv)
+{
+	if (dspv && (unbound_dsp_voice != NULL))
+	{
+		dsp_voice = dspv;
+	}
+}
+
+/**
+*   @brief  Unbind a program voice handle: point back at its unbound DSP voice
+*   @param  none
+*   @return void
+*/
+void SynthVoice::unbind_dsp_voice()
+{
+	if (unbound_dsp_voice != NULL)
+	{
+		dsp_voice = unbound_dsp_voice;
+	}
+}
+
+/**
+*   @brief  Return true if a program voice handle is bound to an in-use pooled DSP voice
+*   @param  none
+*   @return true if bound to an in-use pooled DSP voice
+*/
+bool SynthVoice::dsp_voice_is_bound()
+{
+	DSP_Voice *dspv = dsp_voice;
+	
+	return (unbound_dsp_voice != NULL) && (dspv != unbound_dsp_voice) && dspv->is_in_use();
+}
+
 /**
 *   @brief  Return a pointer to the active setting (patch) parametersce
 *   @parm	none
@@ -1011,6 +1134,12 @@ void SynthVoice::set_voice_params(_settings_params_t *params)
 		dsp_voice->filter_1->set_band(int_param.value);
 	}
 	
+	res = settings_manager->get_int_param(params, "adjsynth.filter1.model", &int_param);
+	if (res == _SETTINGS_KEY_FOUND)
+	{
+		dsp_voice->filter_1->set_model(int_param.value);
+	}
+	
 	res = settings_manager->get_int_param(params, "adjsynth.filter1.freq_modulation_lfo_num", &int_param);
 	if (res == _SETTINGS_KEY_FOUND)
 	{
@@ -1065,6 +1194,12 @@ void SynthVoice::set_voice_params(_settings_params_t *params)
 		dsp_voice->filter_2->set_band(int_param.value);
 	}
 	
+	res = settings_manager->get_int_param(params, "adjsynth.filter2.model", &int_param);
+	if (res == _SETTINGS_KEY_FOUND)
+	{
+		dsp_voice->filter_2->set_model(int_param.value);
+	}
+	
 	res = settings_manager->get_int_param(params, "adjsynth.filter2.freq_modulation_lfo_num", &int_param);
 	if (res == _SETTINGS_KEY_FOUND)
 	{
@@ -1,8 +1,12 @@
 /**
 *	@file		adjSynthVoice.h
 *	@author		Nahum Budin
-*	@date		3-Oct-2024
-*	@version	1.2 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Program voices (DSP voice only, no audio path).
+*					2. Program voice handles bound to pooled DSP voices.
+*					
+*	@version	3-Oct-2024	1.2
 *					1. Code refactoring and notaion.
 *					
 *	@version	2-Feb--2021	1.1
@@ -43,6 +47,12 @@ public:
 		Wavetable *synth_pad_wavetable = NULL,
 		AudioManager *aud_mng = NULL);
 	
+	SynthVoice(int vnum,
+		int prg,
+		DSP_Voice *unbound_dspv);
+	
+	~SynthVoice();
+	
 	SynthVoice* get_instance();
 	
 	int set_sample_rate(int samp_rate);
@@ -55,6 +65,10 @@ public:
 	_settings_params_t *get_voice_params();
 
 	void assign_dsp_voice(DSP_Voice *dspv = NULL);
+	
+	void bind_dsp_voice(DSP_Voice *dspv);
+	void unbind_dsp_voice();
+	bool dsp_voice_is_bound();
 
 	void set_allocated_program(int prg);
 	int get_allocated_program();
@@ -96,4 +110,9 @@ private:
 	
 	_settings_params_t active_params, prev_active_params;
 	Settings *settings_manager = NULL;
+	
+	// True if the DSP voice was created by (and is deleted with) this voice
+	bool own_dsp_voice = false;
+	// Program voice handle: the DSP voice it points at when no pooled DSP voice is bound to it
+	DSP_Voice *unbound_dsp_voice = NULL;
 };
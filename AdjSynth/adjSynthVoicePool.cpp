@@ -0,0 +1,230 @@
+/**
+*	@file		adjSynthVoicePool.cpp
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0	1st version
+*
+*	@brief		A pool of DSP voices shared by all the synthesizer programs.
+*/
+
+#include <stdio.h>
+
+#include "adjSynthVoicePool.h"
+#include "adjSynthVoice.h"
+#include "adjSynthProgram.h"
+#include "../DSP/dspVoice.h"
+
+/**
+*   @brief  Creates a SynthVoicePool instance and its pooled DSP voices.
+*   @param  num_of_voic	number of pooled DSP voices (up to _SYNTH_VOICE_POOL_MAX_NUM_OF_VOICES)
+*   @param	samp_rate	sample-rate
+*   @param	block_size	audio block-size
+*   @param	mso_wtab	a pointer to a default MSO wavetable (until bound to a program)
+*   @param	pad_wavetable	a pointer to a default PAD wavetable (until bound to a program)
+*   @return none
+*/
+SynthVoicePool::SynthVoicePool(
+	int num_of_voic,
+	int samp_rate,
+	int block_size,
+	DSP_MorphingSinusOscWTAB *mso_wtab,
+	Wavetable *pad_wavetable)
+{
+	num_of_voices = num_of_voic;
+
+	if (num_of_voices > _SYNTH_VOICE_POOL_MAX_NUM_OF_VOICES)
+	{
+		num_of_voices = _SYNTH_VOICE_POOL_MAX_NUM_OF_VOICES;
+	}
+	else if (num_of_voices < 1)
+	{
+		num_of_voices = 1;
+	}
+
+	for (int voice = 0; voice < num_of_voices; voice++)
+	{
+		pool_voices[voice] = new DSP_Voice(voice, samp_rate, block_size, mso_wtab, pad_wavetable, NULL);
+		pool_voices[voice]->not_in_use();
+		bound_program_voice[voice] = NULL;
+		params_program[voice] = NULL;
+	}
+
+	next_free_voice_search_index = 0;
+}
+
+SynthVoicePool::~SynthVoicePool()
+{
+	for (int voice = 0; voice < num_of_voices; voice++)
+	{
+		if (bound_program_voice[voice] != NULL)
+		{
+			bound_program_voice[voice]->unbind_dsp_voice();
+		}
+
+		delete pool_voices[voice];
+		pool_voices[voice] = NULL;
+	}
+}
+
+/**
+*   @brief  Bind a free pooled DSP voice to a program voice handle: the pooled voice is set
+*			with the program wavetables, and with the program patch parameters unless it already
+*			holds them (last bound to the same program, and the patch was not changed since).
+*			Must be called with the voices management lock held (note-on).
+*   @param  prog_voice	a pointer to the program voice handle
+*   @param  program		a pointer to the program the handle belongs to
+*   @return a pointer to the bound DSP voice; NULL if no pooled voice is free
+*/
+DSP_Voice *SynthVoicePool::bind_voice(SynthVoice *prog_voice, SynthProgram *program)
+{
+	int voice, index = -1;
+	uint32_t patch_version;
+
+	if ((prog_voice == NULL) || (program == NULL))
+	{
+		return NULL;
+	}
+
+	for (int i = 0; (i < num_of_voices) && (index < 0); i++)
+	{
+		voice = (next_free_voice_search_index + i) % num_of_voices;
+		if (!pool_voices[voice]->is_in_use())
+		{
+			index = voice;
+		}
+	}
+
+	if (index < 0)
+	{
+		return NULL;
+	}
+
+	next_free_voice_search_index = (index + 1) % num_of_voices;
+	pool_voices[index]->in_use();
+
+	// The handle the voice was previously bound to may still point at it
+	if ((bound_program_voice[index] != NULL) &&
+		(bound_program_voice[index]->dsp_voice == pool_voices[index]))
+	{
+		bound_program_voice[index]->unbind_dsp_voice();
+	}
+
+	pool_voices[index]->set_mso_wavetable(program->mso_wtab);
+	pool_voices[index]->set_pad_wavetable(program->program_wavetable);
+
+	prog_voice->bind_dsp_voice(pool_voices[index]);
+	bound_program_voice[index] = prog_voice;
+	
+	patch_version = program->get_patch_params_version();
+	if ((params_program[index] != program) || (params_patch_version[index] != patch_version))
+	{
+		// Copy the program patch parameters into the pooled voice
+		prog_voice->set_voice_params(&program->active_patch_params);
+		params_program[index] = program;
+		params_patch_version[index] = patch_version;
+	}
+
+	return pool_voices[index];
+}
+
+/**
+*   @brief  Free a pooled DSP voice (ignored if not a pooled voice).
+*   @param  dsp_voice	a pointer to the DSP voice
+*   @return void
+*/
+void SynthVoicePool::release_voice(DSP_Voice *dsp_voice)
+{
+	if (get_pool_voice_index(dsp_voice) >= 0)
+	{
+		dsp_voice->not_in_use();
+	}
+}
+
+/**
+*   @brief  Free all the pooled DSP voices.
+*   @param  none
+*   @return void
+*/
+void SynthVoicePool::release_all_voices()
+{
+	for (int voice = 0; voice < num_of_voices; voice++)
+	{
+		pool_voices[voice]->not_in_use();
+	}
+}
+
+/**
+*   @brief  Remove a program voice handle that is going to be deleted from the pool records.
+*   @param  prog_voice	a pointer to the program voice handle
+*   @return void
+*/
+void SynthVoicePool::forget_program_voice(SynthVoice *prog_voice)
+{
+	for (int voice = 0; voice < num_of_voices; voice++)
+	{
+		if (bound_program_voice[voice] == prog_voice)
+		{
+			bound_program_voice[voice] = NULL;
+		}
+	}
+}
+
+/**
+*   @brief  Return true if a DSP voice is a pooled voice.
+*   @param  dsp_voice	a pointer to the DSP voice
+*   @return true if a pooled voice
+*/
+bool SynthVoicePool::is_pool_voice(DSP_Voice *dsp_voice)
+{
+	return get_pool_voice_index(dsp_voice) >= 0;
+}
+
+/**
+*   @brief  Return the number of pooled DSP voices.
+*   @param  none
+*   @return the number of pooled DSP voices
+*/
+int SynthVoicePool::get_num_of_voices() { return num_of_voices; }
+
+/**
+*   @brief  Return the number of free pooled DSP voices.
+*   @param  none
+*   @return the number of free pooled DSP voices
+*/
+int SynthVoicePool::get_num_of_free_voices()
+{
+	int free_voices = 0;
+
+	for (int voice = 0; voice < num_of_voices; voice++)
+	{
+		if (!pool_voices[voice]->is_in_use())
+		{
+			free_voices++;
+		}
+	}
+
+	return free_voices;
+}
+
+/**
+*   @brief  Return the pool index of a DSP voice.
+*   @param  dsp_voice	a pointer to the DSP voice
+*   @return the pool index; -1 if not a pooled voice
+*/
+int SynthVoicePool::get_pool_voice_index(DSP_Voice *dsp_voice)
+{
+	if (dsp_voice == NULL)
+	{
+		return -1;
+	}
+
+	for (int voice = 0; voice < num_of_voices; voice++)
+	{
+		if (pool_voices[voice] == dsp_voice)
+		{
+			return voice;
+		}
+	}
+
+	return -1;
+}
@@ -0,0 +1,65 @@
+/**
+*	@file		adjSynthVoicePool.h
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0	1st version
+*
+*	@brief		A pool of DSP voices shared by all the synthesizer programs.
+*	
+*				A program holds only its patch parameters, wavetables and light voice handles.
+*				On note-on, a free pooled DSP voice is bound to a program voice handle: it is set
+*				with the program MSO and PAD wavetables and with the program patch parameters.
+*				While bound, patch parameters updates of the program reach the pooled DSP voice
+*				through the handle.
+*				A pooled DSP voice is freed (not in use) when its voice ends, or when it is done 
+*				being faded out after being stolen.
+*/
+
+#pragma once
+
+#include "../LibAPI/synthesizer.h"
+#include "../DSP/dspMorphedSineOsc.h"
+#include "../DSP/dspWavetable.h"
+
+class DSP_Voice;
+class SynthVoice;
+class SynthProgram;
+
+class SynthVoicePool
+{
+public:
+	
+	SynthVoicePool(
+		int num_of_voic,
+		int samp_rate,
+		int block_size,
+		DSP_MorphingSinusOscWTAB *mso_wtab,
+		Wavetable *pad_wavetable);
+	
+	~SynthVoicePool();
+	
+	DSP_Voice *bind_voice(SynthVoice *prog_voice, SynthProgram *program);
+	void release_voice(DSP_Voice *dsp_voice);
+	void release_all_voices();
+	void forget_program_voice(SynthVoice *prog_voice);
+	
+	bool is_pool_voice(DSP_Voice *dsp_voice);
+	
+	int get_num_of_voices();
+	int get_num_of_free_voices();
+	
+private:
+	
+	int get_pool_voice_index(DSP_Voice *dsp_voice);
+	
+	int num_of_voices;
+	
+	DSP_Voice *pool_voices[_SYNTH_VOICE_POOL_MAX_NUM_OF_VOICES] = { NULL };
+	// The program voice handle a pooled voice was last bound to 
+	SynthVoice *bound_program_voice[_SYNTH_VOICE_POOL_MAX_NUM_OF_VOICES] = { NULL };
+	// The program, and its patch parameters version, a pooled voice parameters were last set with
+	SynthProgram *params_program[_SYNTH_VOICE_POOL_MAX_NUM_OF_VOICES] = { NULL };
+	uint32_t params_patch_version[_SYNTH_VOICE_POOL_MAX_NUM_OF_VOICES] = { 0 };
+	// Next pool voice to look for a free voice from (round robin)
+	int next_free_voice_search_index;
+};
@@ -0,0 +1,378 @@
+/**
+*	@file		adjSynthWavetablesRegistry.cpp
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0	1st version
+*
+*	@brief		A registry of PAD and MSO wavetables shared by the synthesizer programs.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "adjSynthWavetablesRegistry.h"
+#include "../utils/utils.h"
+
+SynthWavetablesRegistry *SynthWavetablesRegistry::wavetables_registry = NULL;
+
+SynthWavetablesRegistry::SynthWavetablesRegistry()
+{
+	pthread_mutex_init(&registry_mutex, NULL);
+}
+
+SynthWavetablesRegistry::~SynthWavetablesRegistry()
+{
+	std::multimap<uint64_t, wavetables_registry_entry_t>::iterator entry;
+
+	for (entry = pad_wavetables.begin(); entry != pad_wavetables.end(); ++entry)
+	{
+		delete_pad_wavetable((Wavetable*)entry->second.wavetable);
+	}
+
+	for (entry = mso_wavetables.begin(); entry != mso_wavetables.end(); ++entry)
+	{
+		delete (DSP_MorphingSinusOscWTAB*)entry->second.wavetable;
+	}
+
+	pad_wavetables.clear();
+	mso_wavetables.clear();
+
+	pthread_mutex_destroy(&registry_mutex);
+}
+
+/**
+*   @brief  retruns the single SynthWavetablesRegistry instance
+*   @param  none
+*   @return the single SynthWavetablesRegistry instance
+*/
+SynthWavetablesRegistry *SynthWavetablesRegistry::get_instance()
+{
+	if (wavetables_registry == NULL)
+	{
+		wavetables_registry = new SynthWavetablesRegistry();
+	}
+
+	return wavetables_registry;
+}
+
+/**
+*   @brief  Acquire (add a reference to) a registered PAD wavetable.
+*   @param  params	the wavetable generating parameters blob
+*   @return a pointer to the wavetable; NULL if the parameters are not registered
+*/
+Wavetable *SynthWavetablesRegistry::acquire_pad_wavetable(const std::string &params)
+{
+	return (Wavetable*)acquire_wavetable(&pad_wavetables, params);
+}
+
+/**
+*   @brief  Register a new generated PAD wavetable (the registry owns it from now on,
+*			and the caller holds one reference). If the parameters were registered meanwhile,
+*			the new wavetable is deleted and the registered one is acquired.
+*			The samples buffer must be allocated by malloc().
+*   @param  params	the wavetable generating parameters blob
+*   @param  wavetable	a pointer to the generated wavetable
+*   @return a pointer to the registered wavetable
+*/
+Wavetable *SynthWavetablesRegistry::add_pad_wavetable(const std::string &params, Wavetable *wavetable)
+{
+	Wavetable *registered = (Wavetable*)add_wavetable(&pad_wavetables, params, wavetable);
+
+	if (registered != wavetable)
+	{
+		delete_pad_wavetable(wavetable);
+	}
+
+	return registered;
+}
+
+/**
+*   @brief  Release (remove a reference to) a registered PAD wavetable.
+*   @param  wavetable	a pointer to the wavetable
+*   @return void
+*/
+void SynthWavetablesRegistry::release_pad_wavetable(Wavetable *wavetable)
+{
+	release_wavetable(&pad_wavetables, wavetable);
+}
+
+/**
+*   @brief  Acquire (add a reference to) a registered MSO wavetable.
+*   @param  params	the wavetable generating parameters blob
+*   @return a pointer to the wavetable; NULL if the parameters are not registered
+*/
+DSP_MorphingSinusOscWTAB *SynthWavetablesRegistry::acquire_mso_wavetable(const std::string &params)
+{
+	return (DSP_MorphingSinusOscWTAB*)acquire_wavetable(&mso_wavetables, params);
+}
+
+/**
+*   @brief  Register a new calculated MSO wavetable (the registry owns it from now on,
+*			and the caller holds one reference). If the parameters were registered meanwhile,
+*			the new wavetable is deleted and the registered one is acquired.
+*   @param  params	the wavetable generating parameters blob
+*   @param  wavetable	a pointer to the calculated wavetable
+*   @return a pointer to the registered wavetable
+*/
+DSP_MorphingSinusOscWTAB *SynthWavetablesRegistry::add_mso_wavetable(const std::string &params, DSP_MorphingSinusOscWTAB *wavetable)
+{
+	DSP_MorphingSinusOscWTAB *registered =
+		(DSP_MorphingSinusOscWTAB*)add_wavetable(&mso_wavetables, params, wavetable);
+
+	if (registered != wavetable)
+	{
+		delete wavetable;
+	}
+
+	return registered;
+}
+
+/**
+*   @brief  Release (remove a reference to) a registered MSO wavetable.
+*   @param  wavetable	a pointer to the wavetable
+*   @return void
+*/
+void SynthWavetablesRegistry::release_mso_wavetable(DSP_MorphingSinusOscWTAB *wavetable)
+{
+	release_wavetable(&mso_wavetables, wavetable);
+}
+
+/**
+*   @brief  Delete the wavetables that are not referenced for at least the given time.
+*			Called periodically by a non real-time thread.
+*   @param  min_unused_sec	min unreferenced time in seconds
+*   @return the number of deleted wavetables
+*/
+int SynthWavetablesRegistry::purge_unused_wavetables(int min_unused_sec)
+{
+	std::multimap<uint64_t, wavetables_registry_entry_t>::iterator entry;
+	struct timeval now;
+	int purged = 0;
+
+	gettimeofday(&now, NULL);
+
+	pthread_mutex_lock(&registry_mutex);
+
+	for (entry = pad_wavetables.begin(); entry != pad_wavetables.end();)
+	{
+		if ((entry->second.ref_count == 0) &&
+			((now.tv_sec - entry->second.unused_since.tv_sec) >= min_unused_sec))
+		{
+			delete_pad_wavetable((Wavetable*)entry->second.wavetable);
+			entry = pad_wavetables.erase(entry);
+			purged++;
+		}
+		else
+		{
+			++entry;
+		}
+	}
+
+	for (entry = mso_wavetables.begin(); entry != mso_wavetables.end();)
+	{
+		if ((entry->second.ref_count == 0) &&
+			((now.tv_sec - entry->second.unused_since.tv_sec) >= min_unused_sec))
+		{
+			delete (DSP_MorphingSinusOscWTAB*)entry->second.wavetable;
+			entry = mso_wavetables.erase(entry);
+			purged++;
+		}
+		else
+		{
+			++entry;
+		}
+	}
+
+	pthread_mutex_unlock(&registry_mutex);
+
+	if (purged > 0)
+	{
+		fprintf(stderr, "wavetables registry: %i unused wavetables deleted\n", purged);
+	}
+
+	return purged;
+}
+
+/**
+*   @brief  Return the number of registered PAD wavetables.
+*   @param  none
+*   @return the number of registered PAD wavetables
+*/
+int SynthWavetablesRegistry::get_num_of_pad_wavetables()
+{
+	int num;
+
+	pthread_mutex_lock(&registry_mutex);
+	num = (int)pad_wavetables.size();
+	pthread_mutex_unlock(&registry_mutex);
+
+	return num;
+}
+
+/**
+*   @brief  Return the number of registered MSO wavetables.
+*   @param  none
+*   @return the number of registered MSO wavetables
+*/
+int SynthWavetablesRegistry::get_num_of_mso_wavetables()
+{
+	int num;
+
+	pthread_mutex_lock(&registry_mutex);
+	num = (int)mso_wavetables.size();
+	pthread_mutex_unlock(&registry_mutex);
+
+	return num;
+}
+
+/**
+*   @brief  Acquire (add a reference to) a registered wavetable.
+*   @param  entries	a pointer to the wavetables entries map
+*   @param  params	the wavetable generating parameters blob
+*   @return a pointer to the wavetable; NULL if the parameters are not registered
+*/
+void *SynthWavetablesRegistry::acquire_wavetable(std::multimap<uint64_t, wavetables_registry_entry_t> *entries, const std::string &params)
+{
+	std::multimap<uint64_t, wavetables_registry_entry_t>::iterator entry;
+	uint64_t key = get_params_key(params);
+	void *wavetable = NULL;
+
+	pthread_mutex_lock(&registry_mutex);
+
+	entry = find_wavetable(entries, key, params);
+	if (entry != entries->end())
+	{
+		entry->second.ref_count++;
+		wavetable = entry->second.wavetable;
+	}
+
+	pthread_mutex_unlock(&registry_mutex);
+
+	return wavetable;
+}
+
+/**
+*   @brief  Register a wavetable with one reference.
+*   @param  entries	a pointer to the wavetables entries map
+*   @param  params	the wavetable generating parameters blob
+*   @param  wavetable	a pointer to the wavetable
+*   @return a pointer to the registered wavetable (an already registered one if the parameters exist)
+*/
+void *SynthWavetablesRegistry::add_wavetable(std::multimap<uint64_t, wavetables_registry_entry_t> *entries, const std::string &params, void *wavetable)
+{
+	std::multimap<uint64_t, wavetables_registry_entry_t>::iterator entry;
+	wavetables_registry_entry_t new_entry;
+	uint64_t key = get_params_key(params);
+	void *registered;
+
+	pthread_mutex_lock(&registry_mutex);
+
+	entry = find_wavetable(entries, key, params);
+	if (entry != entries->end())
+	{
+		entry->second.ref_count++;
+		registered = entry->second.wavetable;
+	}
+	else
+	{
+		new_entry.wavetable = wavetable;
+		new_entry.params = params;
+		new_entry.ref_count = 1;
+		gettimeofday(&new_entry.unused_since, NULL);
+		entries->insert(std::make_pair(key, new_entry));
+		registered = wavetable;
+	}
+
+	pthread_mutex_unlock(&registry_mutex);
+
+	return registered;
+}
+
+/**
+*   @brief  Find the entry of a wavetable by its key and its generating parameters
+*			(an entry with an equal key and different parameters is a key collision).
+*			The caller must hold the registry lock.
+*   @param  entries	a pointer to the wavetables entries map
+*   @param  key	the generating parameters key
+*   @param  params	the wavetable generating parameters blob
+*   @return the entry iterator; entries->end() if not found
+*/
+std::multimap<uint64_t, wavetables_registry_entry_t>::iterator SynthWavetablesRegistry::find_wavetable(
+	std::multimap<uint64_t, wavetables_registry_entry_t> *entries, uint64_t key, const std::string &params)
+{
+	std::multimap<uint64_t, wavetables_registry_entry_t>::iterator entry;
+
+	for (entry = entries->lower_bound(key); (entry != entries->end()) && (entry->first == key); ++entry)
+	{
+		if (entry->second.params == params)
+		{
+			return entry;
+		}
+	}
+
+	return entries->end();
+}
+
+/**
+*   @brief  Release (remove a reference to) a registered wavetable.
+*   @param  entries	a pointer to the wavetables entries map
+*   @param  wavetable	a pointer to the wavetable
+*   @return true if found
+*/
+bool SynthWavetablesRegistry::release_wavetable(std::multimap<uint64_t, wavetables_registry_entry_t> *entries, void *wavetable)
+{
+	std::multimap<uint64_t, wavetables_registry_entry_t>::iterator entry;
+	bool found = false;
+
+	if (wavetable == NULL)
+	{
+		return false;
+	}
+
+	pthread_mutex_lock(&registry_mutex);
+
+	for (entry = entries->begin(); (entry != entries->end()) && !found; ++entry)
+	{
+		if (entry->second.wavetable == wavetable)
+		{
+			found = true;
+			if (entry->second.ref_count > 0)
+			{
+				entry->second.ref_count--;
+			}
+
+			if (entry->second.ref_count == 0)
+			{
+				gettimeofday(&entry->second.unused_since, NULL);
+			}
+		}
+	}
+
+	pthread_mutex_unlock(&registry_mutex);
+
+	return found;
+}
+
+/**
+*   @brief  Return the key (FNV-1a hash) of a wavetable generating parameters blob.
+*   @param  params	the wavetable generating parameters blob
+*   @return the parameters key
+*/
+uint64_t SynthWavetablesRegistry::get_params_key(const std::string &params)
+{
+	return Utils::calc_fnv1a_hash(params.data(), (int)params.size());
+}
+
+/**
+*   @brief  Delete a PAD wavetable and its samples buffer.
+*   @param  wavetable	a pointer to the wavetable
+*   @return void
+*/
+void SynthWavetablesRegistry::delete_pad_wavetable(Wavetable *wavetable)
+{
+	if (wavetable != NULL)
+	{
+		free(wavetable->samples);
+		delete wavetable;
+	}
+}
@@ -0,0 +1,84 @@
+/**
+*	@file		adjSynthWavetablesRegistry.h
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0	1st version
+*
+*	@brief		A registry of PAD and MSO wavetables shared by the synthesizer programs.
+*	
+*				Wavetables are keyed by a hash of their generating parameters, so programs that
+*				use the same PAD or MSO settings share one wavetable, and a wavetable is generated
+*				only when its parameters are new. Each entry keeps its generating parameters blob,
+*				which is compared on a key hit (keys collisions are not shared).
+*				Registered wavetables are immutable and reference counted: a program that changes 
+*				its settings acquires (or generates and adds) another wavetable and releases the 
+*				previous one. Wavetables that are no longer referenced are deleted by a periodic 
+*				purge (non real-time), after a delay that lets rendering voices drop them.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <map>
+#include <string>
+
+#include "../DSP/dspWavetable.h"
+#include "../DSP/dspMorphedSineOsc.h"
+
+// Unreferenced wavetables are deleted after this time (also kept for reuse until then)
+#define _WAVETABLES_REGISTRY_PURGE_DELAY_SEC	10
+
+typedef struct wavetables_registry_entry
+{
+	void *wavetable;
+	// The wavetable generating parameters blob
+	std::string params;
+	int ref_count;
+	// The time the wavetable was released by its last user
+	struct timeval unused_since;
+} wavetables_registry_entry_t;
+
+class SynthWavetablesRegistry
+{
+public:
+	
+	static SynthWavetablesRegistry *get_instance();
+	
+	~SynthWavetablesRegistry();
+	
+	Wavetable *acquire_pad_wavetable(const std::string &params);
+	Wavetable *add_pad_wavetable(const std::string &params, Wavetable *wavetable);
+	void release_pad_wavetable(Wavetable *wavetable);
+	
+	DSP_MorphingSinusOscWTAB *acquire_mso_wavetable(const std::string &params);
+	DSP_MorphingSinusOscWTAB *add_mso_wavetable(const std::string &params, DSP_MorphingSinusOscWTAB *wavetable);
+	void release_mso_wavetable(DSP_MorphingSinusOscWTAB *wavetable);
+	
+	int purge_unused_wavetables(int min_unused_sec = _WAVETABLES_REGISTRY_PURGE_DELAY_SEC);
+	
+	int get_num_of_pad_wavetables();
+	int get_num_of_mso_wavetables();
+	
+private:
+	
+	SynthWavetablesRegistry();
+	
+	static SynthWavetablesRegistry *wavetables_registry;
+	
+	void *acquire_wavetable(std::multimap<uint64_t, wavetables_registry_entry_t> *entries, const std::string &params);
+	void *add_wavetable(std::multimap<uint64_t, wavetables_registry_entry_t> *entries, const std::string &params, void *wavetable);
+	bool release_wavetable(std::multimap<uint64_t, wavetables_registry_entry_t> *entries, void *wavetable);
+	std::multimap<uint64_t, wavetables_registry_entry_t>::iterator find_wavetable(
+		std::multimap<uint64_t, wavetables_registry_entry_t> *entries, uint64_t key, const std::string &params);
+	
+	static uint64_t get_params_key(const std::string &params);
+	static void delete_pad_wavetable(Wavetable *wavetable);
+	
+	// Keys collisions are kept as separate entries
+	std::multimap<uint64_t, wavetables_registry_entry_t> pad_wavetables;
+	std::multimap<uint64_t, wavetables_registry_entry_t> mso_wavetables;
+	
+	pthread_mutex_t registry_mutex;
+};
@@ -2,6 +2,10 @@
 *	@file		audioBandEqualizer.h
 *	@author		Nahum Budin
 *	@date		3-Oct-2024
+*	@version	1.3	17-Oct-2026
+*					1. Block equalizer processing.
+*					2. Sample-rate and bands settings.
+*					
 *	@version	1.2 
 *					1. Code refactoring and notaion.
 *					
@@ -19,17 +23,18 @@
 #include "../LibAPI/synthesizer.h"
 #include "../utils/utils.h"
 
-extern pthread_mutex_t voice_mem_blocks_allocation_control_mutex;
-
 /**
 *   @brief  Creates and initializes a band equilizer audio-block object instance.
 *   @param  stage	update stage number
+*   @param  samp_rate	sample rate
+*   @param  block_size	audio block size
 *	@param	audio_first_update_ptr  a pointer to an audio block object instance
 *								    that is the first in the update chain
 *   @return none
 */
 AudioBandEqualizer::AudioBandEqualizer(
 					uint8_t stage,	
+	int samp_rate,
 	int block_size,				
 	AudioBlockFloat **audio_first_update_ptr)
 	: AudioBlockFloat(4, // audio inputs
@@ -41,8 +46,47 @@ AudioBandEqualizer::AudioBandEqualizer(
 	preset = _BAND_EQUALIZER_SET_ALL_ZERO;
 	set_audio_block_size(block_size);
 	
-	band_equalizer_L = new DSP_BandEqualizer();
-	band_equalizer_R = new DSP_BandEqualizer();
+	band_equalizer_L = new DSP_BandEqualizer(samp_rate);
+	band_equalizer_R = new DSP_BandEqualizer(samp_rate);
+	sample_rate = band_equalizer_L->get_sample_rate();
+}
+
+/**
+*	@brief	Sets the sample-rate; the bands filters coefficients are recalculated
+*	@param	samp_rate	sample rate: _SAMPLE_RATE_44 (44100Hz) or _SAMPLE_RATE_48 (48000Hz)
+*						if non of the above, sample rate is set to _DEFAULT_SAMPLE_RATE (44100).
+*	@return set sample-rate
+*/
+int AudioBandEqualizer::set_sample_rate(int samp_rate)
+{
+	band_equalizer_L->set_sample_rate(samp_rate);
+	sample_rate = band_equalizer_R->set_sample_rate(samp_rate);
+	
+	return sample_rate;
+}
+
+/**
+*	@brief	Returns the set sample-rate
+*	@param	none
+*	@return set sample-rate
+*/
+int AudioBandEqualizer::get_sample_rate() { return sample_rate; }
+
+/**
+*	@brief	Sets the equalizer bands (both channels)
+*	@param	num					number of bands (1 to _EQUALIZER_MAX_NUM_OF_BANDS)
+*	@param	center_frequencies	an array of num bands center frequencies [Hz];
+*								NULL for the default bands frequencies
+*	@return 0 if done; -1 if parameters are out of range
+*/
+int AudioBandEqualizer::set_bands(int num, const float *center_frequencies)
+{
+	if (band_equalizer_L->set_bands(num, center_frequencies) != 0)
+	{
+		return -1;
+	}
+	
+	return band_equalizer_R->set_bands(num, center_frequencies);
 }
 
 /**
@@ -114,7 +158,6 @@ void AudioBandEqualizer::update(void)
 {
 	audio_block_float_mono_t *in_block_L1, *in_block_R1, *in_block_L2, *in_block_R2, *out_block_L, *out_block_R;
 	int i;
-	float inL = 0.f, inR = 0.f;
 
 	// Get input samples
 	in_block_L1 = receive_audio_block_read_only(_LEFT);
@@ -124,7 +167,6 @@ void AudioBandEqualizer::update(void)
 
 	if (!in_block_L1 || !in_block_R1 || !in_block_L2 || !in_block_R2)
 	{
-		pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 		if (in_block_L1)
 			release_audio_block(in_block_L1);
 		if (in_block_R1)
@@ -133,7 +175,6 @@ void AudioBandEqualizer::update(void)
 			release_audio_block(in_block_L2);
 		if (in_block_R2)
 			release_audio_block(in_block_R2);
-		pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 		return;
 	}
 	/*
@@ -142,25 +183,20 @@ void AudioBandEqualizer::update(void)
 			// Equilizer disabled - pass through
 			transmit_audio_block(in_block_L1, _LEFT);
 			transmit_audio_block(in_block_R1, _RIGHT);
-			pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 			release_audio_block(in_block_L1);
 			release_audio_block(in_block_R1);
 			release_audio_block(in_block_L2);
 			release_audio_block(in_block_R2);
-			pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 		}
 		else
 		{*/
 	// Equilizer enabled
 
-	pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 	out_block_L = allocate_audio_block();
 	out_block_R = allocate_audio_block();
-	pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 	if (!out_block_L || !out_block_R)
 	{
 		// Can't allocate 2audio blocks
-		pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 		if (in_block_L1)
 			release_audio_block(in_block_L1);
 		if (in_block_R1)
@@ -173,7 +209,6 @@ void AudioBandEqualizer::update(void)
 			release_audio_block(out_block_L);
 		if (out_block_R)
 			release_audio_block(out_block_R);
-		pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 
 		return;
 	}
@@ -181,30 +216,23 @@ void AudioBandEqualizer::update(void)
 	// Process inpur samples
 	for (i = 0; i < audio_block_size; i++)
 	{
-		inL = in_block_L1->data[i] + in_block_L2->data[i];
-		inR = in_block_R1->data[i] + in_block_R2->data[i];
-
-		if (!equalizer_enabled)
-		{
-			out_block_L->data[i] = inL;
-			out_block_R->data[i] = inR;
-		}
-		else
-		{
-			out_block_L->data[i] = band_equalizer_L->get_equalizer_next_output(inL);
-			out_block_R->data[i] = band_equalizer_R->get_equalizer_next_output(inR);
-		}
+		out_block_L->data[i] = in_block_L1->data[i] + in_block_L2->data[i];
+		out_block_R->data[i] = in_block_R1->data[i] + in_block_R2->data[i];
+	}
+	
+	if (equalizer_enabled)
+	{
+		band_equalizer_L->get_equalizer_next_output_block(out_block_L->data, out_block_L->data, audio_block_size);
+		band_equalizer_R->get_equalizer_next_output_block(out_block_R->data, out_block_R->data, audio_block_size);
 	}
 
 	transmit_audio_block(out_block_L, _LEFT);
 	transmit_audio_block(out_block_R, _RIGHT);
-	pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 	release_audio_block(out_block_L);
 	release_audio_block(out_block_R);
 	release_audio_block(in_block_L1);
 	release_audio_block(in_block_R1);
 	release_audio_block(in_block_L2);
 	release_audio_block(in_block_R2);
-	pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 	//	}
 }
@@ -2,6 +2,10 @@
 *	@file		audioBandEqualizer.h
 *	@author		Nahum Budin
 *	@date		3-Oct-2024
+*	@version	1.3	17-Oct-2026
+*					1. Block equalizer processing.
+*					2. Sample-rate and bands settings.
+*					
 *	@version	1.2 
 *					1. Code refactoring and notaion.
 *					
@@ -24,11 +28,17 @@ class AudioBandEqualizer : public AudioBlockFloat
 public:
 	AudioBandEqualizer(
 		uint8_t stage = 0, 
+		int samp_rate = _DEFAULT_SAMPLE_RATE,
 		int block_size = _DEFAULT_BLOCK_SIZE,
 		AudioBlockFloat **audio_first_update_ptr = NULL);
 	
+	int set_sample_rate(int samp_rate);
+	int get_sample_rate();
+	
 	int set_audio_block_size(int size);
 	int get_audio_block_size();
+	
+	int set_bands(int num, const float *center_frequencies);
 
 	void set_preset(int prst);
 
@@ -45,5 +55,6 @@ private:
 	bool equalizer_enabled;
 	int preset;
 	
+	int sample_rate;
 	int audio_block_size;
 };
@@ -1,11 +1,15 @@
 /**
 *	@file		audioBlock.cpp
 *	@author		Nahum Budin
-*	@date		30-Sep-2024
-*	@version	1.1 
-*					1. Code refactoring and notaion.
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Blocks data in a single 64 bytes aligned slab.
+*					2. Per update cycle arena allocation mode.
 *					
-*	@version	1.1	29-Jan-2021	Code refactoring and notaion
+*	@version	1.3	17-Oct-2026	Audio blocks arena
+*				1.2	17-Oct-2026	Lock-free audio blocks pool
+*				1.1	30-Sep-2024	Code refactoring and notaion
+*				1.1	29-Jan-2021	Code refactoring and notaion
 *				1.0	4-Nov-2019	(13/6/2018 No control blocks)
 *
 *	@brief		Audio blocks and connections .
@@ -89,8 +93,6 @@
 #include "../utils/utils.h"
 #include "../LibAPI/audio.h"
 
-extern pthread_mutex_t voice_mem_blocks_allocation_control_mutex;
-
 // Set default values 
 //unsigned int AudioBlockFloat::period_time;
 volatile bool AudioBlockFloat::update_enable = false;
@@ -99,10 +101,47 @@ volatile bool AudioBlockFloat::update_in_progress = false;
 /* A global memory pool of audio blocks */
 audio_block_float_mono_t *AudioBlockFloat::audio_data_blocks_memory_pool;
 
-uint32_t AudioBlockFloat::audio_data_blocks_memory_pool_available_mask[_AUDIO_BLOCKS_MESSAGES_POOL_NUM_OF_MASKS];
-uint16_t AudioBlockFloat::audio_data_blocks_memory_pool_first_mask;
+std::atomic<uint32_t> AudioBlockFloat::audio_data_blocks_memory_pool_available_mask[_AUDIO_BLOCKS_MESSAGES_POOL_NUM_OF_MASKS];
+std::atomic<uint16_t> AudioBlockFloat::audio_data_blocks_memory_pool_first_mask(0);
+std::atomic<uint32_t> AudioBlockFloat::audio_data_blocks_memory_pool_generation(0);
+
+/* Each thread free audio blocks cache */
+typedef struct audio_blocks_thread_cache
+{
+	// Pool generation the cached blocks belong to
+	uint32_t generation;
+	int num_of_blocks;
+	audio_block_float_mono_t *blocks[_AUDIO_BLOCKS_THREAD_CACHE_SIZE];
+} audio_blocks_thread_cache_t;
+
+static thread_local audio_blocks_thread_cache_t audio_blocks_thread_cache = { 0, 0, { NULL } };
+
+/**
+*   @brief  Return the calling thread free blocks cache.
+*			A cache holding blocks of a previous pool generation is emptied 
+*			(all blocks were marked as free when the pool was re-initialized).
+*   @param  generation	the current pool generation
+*   @return a pointer to the calling thread cache
+*/
+static inline audio_blocks_thread_cache_t *get_audio_blocks_thread_cache(uint32_t generation)
+{
+	audio_blocks_thread_cache_t *cache = &audio_blocks_thread_cache;
+	
+	if (cache->generation != generation)
+	{
+		cache->generation = generation;
+		cache->num_of_blocks = 0;
+	}
+	
+	return cache;
+}
 
 uint16_t AudioBlockFloat::audio_block_size = _AUDIO_MAX_BUF_SIZE;
+uint16_t AudioBlockFloat::audio_data_blocks_memory_pool_num_of_blocks = 0;
+float *AudioBlockFloat::audio_data_blocks_memory_slab = NULL;
+
+bool AudioBlockFloat::audio_blocks_arena_mode = false;
+std::atomic<uint32_t> AudioBlockFloat::audio_blocks_arena_next(0);
 
 /**
 *   @brief  Creates and initializes an audio-block object instance.
@@ -202,7 +241,8 @@ int AudioBlockFloat::get_stage() { return stage_num; }
 */
 void AudioBlockFloat::initialize_audio_memory(audio_block_float_mono_t *blocks, uint16_t num, uint16_t size)
 {
-	unsigned int i;
+	unsigned int i, stride;
+	void *slab;
 
 	if (num > _MAX_AUDIO_BLOCKS_MESSAGES_POOL_SIZE)
 	{
@@ -218,17 +258,30 @@ void AudioBlockFloat::initialize_audio_memory(audio_block_float_mono_t *blocks,
 
 	update_stop();
 	
+	// Each block data occupies a whole number of aligned chunks, so all buffers are aligned
+	stride = ((audio_block_size * sizeof(float) + _AUDIO_BLOCK_DATA_ALIGNMENT - 1) / 
+		_AUDIO_BLOCK_DATA_ALIGNMENT) * _AUDIO_BLOCK_DATA_ALIGNMENT / sizeof(float);
+	
+	if (posix_memalign(&slab, _AUDIO_BLOCK_DATA_ALIGNMENT, (size_t)stride * num * sizeof(float)) != 0)
+	{
+		fprintf(stderr, "Init audio memory error: unable to allocate audio blocks memory\n");
+		exit(1);
+	}
+	
+	if (audio_data_blocks_memory_slab != NULL)
+	{
+		free(audio_data_blocks_memory_slab);
+	}
+	
+	audio_data_blocks_memory_slab = (float*)slab;
+	
 	for (i = 0; i < num; i++) 	
 	{
-		if (blocks[i].data != NULL) 
-		{
-			delete[] blocks[i].data;
-		}
-		
-		blocks[i].data = new float[size];
+		blocks[i].data = audio_data_blocks_memory_slab + (i * stride);
 	}
 
 	audio_data_blocks_memory_pool = blocks;
+	audio_data_blocks_memory_pool_num_of_blocks = num;
 	audio_data_blocks_memory_pool_first_mask = 0;
 	
 	// Clear all masks indicating block availability 
@@ -240,69 +293,154 @@ void AudioBlockFloat::initialize_audio_memory(audio_block_float_mono_t *blocks,
 	// Set all masks to "1" ("free")
 	for (i = 0; i < num; i++) 
 	{
-		audio_data_blocks_memory_pool_available_mask[i >> 5] |= (1 << (i & 0x1F));
+		audio_data_blocks_memory_pool_available_mask[i >> 5] |= (1u << (i & 0x1F));
 	}
 
 	// Add index num to each block
 	for (i = 0; i < num; i++) 
 	{
 		blocks[i].memory_pool_index = i;
+		blocks[i].ref_count = 0;
 	}
 	
+	// Drop all the blocks held by the threads caches
+	audio_data_blocks_memory_pool_generation++;
+	audio_blocks_arena_next = 0;
+	
 	update_start();
 }
 
+/**
+*   @brief  Claim up to num free audio data blocks from the pool.
+*			Lock free: the blocks are claimed by atomically clearing their
+*			availability mask bits.
+*   @param  blocks	a pointer to an array of blocks pointers to be filled
+*	@param	num		maximum number of blocks to claim
+*   @return the number of claimed blocks
+*/
+int AudioBlockFloat::claim_pool_audio_blocks(audio_block_float_mono_t **blocks, int num)
+{
+	uint32_t index, avail, claim, rest, bit;
+	int count = 0, claimed;
+	bool wrapped = false;
+	
+	if ((audio_data_blocks_memory_pool == NULL) || (num <= 0))
+	{
+		return 0;
+	}
+
+	index = audio_data_blocks_memory_pool_first_mask.load(std::memory_order_relaxed);
+	
+	while (count < num)
+	{
+		if (index >= _AUDIO_BLOCKS_MESSAGES_POOL_NUM_OF_MASKS)
+		{
+			if (wrapped)
+			{
+				break;
+			}
+			// The first mask hint may be stale - rescan the whole pool once
+			index = 0;
+			wrapped = true;
+		}
+		
+		avail = audio_data_blocks_memory_pool_available_mask[index].load(std::memory_order_relaxed);
+		do
+		{
+			// Select the lowest available blocks of this mask
+			claim = 0;
+			claimed = 0;
+			rest = avail;
+			while (rest && ((count + claimed) < num))
+			{
+				bit = rest & (~rest + 1);
+				claim |= bit;
+				rest &= ~bit;
+				claimed++;
+			}
+			
+			if (claim == 0)
+			{
+				break;
+			}
+			
+		} while (!audio_data_blocks_memory_pool_available_mask[index].compare_exchange_weak(
+			avail, avail & ~claim, std::memory_order_acquire, std::memory_order_relaxed));
+		
+		while (claim)
+		{
+			blocks[count++] = audio_data_blocks_memory_pool + ((index << 5) + __builtin_ctz(claim));
+			claim &= claim - 1;
+		}
+		
+		if (count < num)
+		{
+			// This mask is exhausted
+			index++;
+		}
+	}
+	
+	// Only a hint for the next search, a released block lowers it back
+	if (index > audio_data_blocks_memory_pool_first_mask.load(std::memory_order_relaxed))
+	{
+		audio_data_blocks_memory_pool_first_mask.store(index, std::memory_order_relaxed);
+	}
+	
+	return count;
+}
+
+/**
+*   @brief  Return a free audio data block to the pool.
+*   @param  block	a pointer to the returned block (audio_block_float_mono_t)
+*   @return void
+*/
+void AudioBlockFloat::return_pool_audio_block(audio_block_float_mono_t *block)
+{
+	uint32_t mask = 1u << (block->memory_pool_index & 0x1F);
+	uint16_t index = block->memory_pool_index >> 5;
+	uint16_t first = audio_data_blocks_memory_pool_first_mask.load(std::memory_order_relaxed);
+
+	audio_data_blocks_memory_pool_available_mask[index].fetch_or(mask, std::memory_order_release);
+	
+	while ((index < first) &&
+		!audio_data_blocks_memory_pool_first_mask.compare_exchange_weak(first, index, std::memory_order_relaxed)) ;
+}
+
 /**
 *   @brief  Allocate 1 audio data block.
 *			If successful, the caller is the only owner of this new block.
+*			Lock free, may be called concurrently by several threads.
 *   @param  none
 *   @return a pointer to the allocated audio_block_float_mono_t block
 */
 audio_block_float_mono_t * AudioBlockFloat::allocate_audio_block(void)
 {
-	uint32_t n, index, avail;
-	uint32_t *p, *end;
 	audio_block_float_mono_t *block;
-
-	p = audio_data_blocks_memory_pool_available_mask;
-	end = p + _AUDIO_BLOCKS_MESSAGES_POOL_NUM_OF_MASKS;
+	audio_blocks_thread_cache_t *cache;
 	
-	update_stop();
+	if (audio_blocks_arena_mode)
+	{
+		return allocate_arena_audio_block();
+	}
 	
-	index = audio_data_blocks_memory_pool_first_mask;
-	p += index;
-	while (1) 
+	cache = get_audio_blocks_thread_cache(
+		audio_data_blocks_memory_pool_generation.load(std::memory_order_acquire));
+	
+	if (cache->num_of_blocks == 0)
 	{
-		if (p >= end) 
+		// Refill the cache with a batch of blocks
+		cache->num_of_blocks = claim_pool_audio_blocks(cache->blocks, _AUDIO_BLOCKS_THREAD_CACHE_BATCH);
+		if (cache->num_of_blocks == 0) 
 		{
-			update_start();
 			return NULL;
 		}
-		avail = *p;
-		if (avail)
-		{
-			break;
-		}
-		index++;
-		p++;
-	}
-	// Mark as used
-	n = __builtin_clz(avail);
-	avail &= ~(0x80000000 >> n);
-	*p = avail;
-	if (!avail) 
-	{
-		index++;
-		audio_data_blocks_memory_pool_first_mask = index;
 	}
-	index = p - audio_data_blocks_memory_pool_available_mask;
-	block = audio_data_blocks_memory_pool + ((index << 5) + (31 - n));
-	block->ref_count = 1;
+	
+	block = cache->blocks[--cache->num_of_blocks];
+	block->ref_count.store(1, std::memory_order_relaxed);
 
 	//	printf("allocate block %i\n", block->memory_pool_index);
 	
-	update_start();
-	
 	return block;
 }
 
@@ -310,31 +448,158 @@ audio_block_float_mono_t * AudioBlockFloat::allocate_audio_block(void)
 /**
 *   @brief  Release ownership of a data block.
 *			If no other streams have ownership, the block is
-*			returned to the free pool
+*			returned to the free pool (through the calling thread cache).
+*			Lock free, may be called concurrently by several threads.
 *   @param  block	a pointer to the to be released block (audio_block_float_mono_t)
 *   @return void
 */
 void AudioBlockFloat::release_audio_block(audio_block_float_mono_t *block)
 {
-	//if (block == NULL) return;
-	uint32_t mask = (0x80000000 >> (31 - (block->memory_pool_index & 0x1F)));
-	uint32_t index = block->memory_pool_index >> 5;
+	audio_blocks_thread_cache_t *cache;
+	
+	if (block == NULL) 
+	{
+		return;
+	}
+	
+	if (block->ref_count.fetch_sub(1, std::memory_order_acq_rel) > 1) 
+	{
+		// Still owned by others
+		return;
+	}
+	
+	if (audio_blocks_arena_mode)
+	{
+		// Reused when the arena is reset
+		return;
+	}
+	
+	cache = get_audio_blocks_thread_cache(
+		audio_data_blocks_memory_pool_generation.load(std::memory_order_acquire));
+	
+	if (cache->num_of_blocks == _AUDIO_BLOCKS_THREAD_CACHE_SIZE)
+	{
+		// Cache is full - flush a batch back to the pool
+		for (int i = 0; i < _AUDIO_BLOCKS_THREAD_CACHE_BATCH; i++)
+		{
+			return_pool_audio_block(cache->blocks[--cache->num_of_blocks]);
+		}
+	}
+	
+	cache->blocks[cache->num_of_blocks++] = block;
+}
 
-	update_stop();
-	if (block->ref_count > 1) 
+/**
+*   @brief  Allocate 1 audio data block from the update cycle arena.
+*			Blocks are taken in order from the start of the slab, skipping
+*			blocks still owned from previous cycles.
+*			Lock free, may be called concurrently by several threads.
+*   @param  none
+*   @return a pointer to the allocated audio_block_float_mono_t block; NULL if arena is exhausted
+*/
+audio_block_float_mono_t *AudioBlockFloat::allocate_arena_audio_block()
+{
+	uint32_t index;
+	audio_block_float_mono_t *block;
+	
+	while (true)
 	{
-		block->ref_count--;
+		index = audio_blocks_arena_next.fetch_add(1, std::memory_order_relaxed);
+		if (index >= audio_data_blocks_memory_pool_num_of_blocks)
+		{
+			return NULL;
+		}
+		
+		block = audio_data_blocks_memory_pool + index;
+		if (block->ref_count.load(std::memory_order_acquire) == 0)
+		{
+			block->ref_count.store(1, std::memory_order_relaxed);
+			return block;
+		}
 	}
-	else 
+}
+
+/**
+*   @brief  Rebuild the pool availability masks from the blocks reference counts
+*			(a block is free when it is not referenced).
+*			Must be called when no audio update is in progress.
+*   @param  none
+*   @return void
+*/
+void AudioBlockFloat::rebuild_pool_available_masks()
+{
+	unsigned int i;
+	
+	for (i = 0; i < _AUDIO_BLOCKS_MESSAGES_POOL_NUM_OF_MASKS; i++) 
+	{
+		audio_data_blocks_memory_pool_available_mask[i] = 0;
+	}
+	
+	for (i = 0; i < audio_data_blocks_memory_pool_num_of_blocks; i++) 
 	{
-		audio_data_blocks_memory_pool_available_mask[index] |= mask;
-		if (index < audio_data_blocks_memory_pool_first_mask)
+		if (audio_data_blocks_memory_pool[i].ref_count.load(std::memory_order_relaxed) == 0)
 		{
-			audio_data_blocks_memory_pool_first_mask = index;
+			audio_data_blocks_memory_pool_available_mask[i >> 5] |= (1u << (i & 0x1F));
 		}
 	}
+	
+	audio_data_blocks_memory_pool_first_mask = 0;
+	// The threads caches blocks are not referenced, so are now marked as free
+	audio_data_blocks_memory_pool_generation++;
+}
 
-	update_start();
+/**
+*   @brief  Audio update cycle end: resets the blocks arena and applies
+*			the blocks allocation mode for the next cycle.
+*			Must be called by the audio update thread after all the cycle
+*			blocks updates are done.
+*   @param  arena_mode	true - allocate the next cycle blocks from the arena; 
+*						false - allocate blocks from the pool
+*   @return void
+*/
+void AudioBlockFloat::end_audio_update_cycle(bool arena_mode)
+{
+	if (audio_data_blocks_memory_pool == NULL)
+	{
+		return;
+	}
+	
+	if (arena_mode && !audio_blocks_arena_mode)
+	{
+		// Blocks cached by the threads are not referenced and will be taken by the arena
+		audio_data_blocks_memory_pool_generation++;
+	}
+	else if (!arena_mode && audio_blocks_arena_mode)
+	{
+		rebuild_pool_available_masks();
+	}
+	
+	audio_blocks_arena_mode = arena_mode;
+	audio_blocks_arena_next.store(0, std::memory_order_release);
+}
+
+/**
+*   @brief  Returns the blocks allocation mode.
+*   @param  none
+*   @return true if blocks are allocated from the update cycle arena
+*/
+bool AudioBlockFloat::get_audio_blocks_arena_mode() { return audio_blocks_arena_mode; }
+
+/**
+*   @brief  Return all the free blocks held by the calling thread cache to the pool.
+*			Should be called by a thread that stops processing audio.
+*   @param  none
+*   @return void
+*/
+void AudioBlockFloat::flush_thread_audio_blocks_cache()
+{
+	audio_blocks_thread_cache_t *cache = get_audio_blocks_thread_cache(
+		audio_data_blocks_memory_pool_generation.load(std::memory_order_acquire));
+	
+	while (cache->num_of_blocks > 0)
+	{
+		return_pool_audio_block(cache->blocks[--cache->num_of_blocks]);
+	}
 }
 
 /**
@@ -359,7 +624,7 @@ void AudioBlockFloat::transmit_audio_block(audio_block_float_mono_t *block, uint
 			if (c->dst->audio_input_queue[c->dest_index] == NULL) 
 			{
 				c->dst->audio_input_queue[c->dest_index] = block;
-				block->ref_count++;
+				block->ref_count.fetch_add(1, std::memory_order_relaxed);
 			}
 		}
 	}
@@ -404,16 +669,14 @@ audio_block_float_mono_t * AudioBlockFloat::receive_audio_block_writable(uint16_
 
 	in = audio_input_queue[index];
 	audio_input_queue[index] = NULL;
-	if (in && in->ref_count > 1) 
+	if (in && in->ref_count.load(std::memory_order_acquire) > 1) 
 	{
-		pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 		p = allocate_audio_block();
-		pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 		if (p)
 		{
-			memcpy(p->data, in->data, sizeof(*p->data)); // <<<<<<<<<<<<<<<<
+			memcpy(p->data, in->data, audio_block_size * sizeof(*p->data));
 		}
-		in->ref_count--;
+		release_audio_block(in);
 		in = p;
 	}
 
@@ -436,8 +699,13 @@ void AudioBlockFloat::free_used_audio_blocks()
 	// Set all masks to "1"
 	for (i = 0; i < _MAX_AUDIO_BLOCKS_MESSAGES_POOL_SIZE; i++) 
 	{
-		audio_data_blocks_memory_pool_available_mask[i >> 5] |= (1 << (i & 0x1F));
+		audio_data_blocks_memory_pool_available_mask[i >> 5] |= (1u << (i & 0x1F));
 	}
+	
+	audio_data_blocks_memory_pool_first_mask = 0;
+	// Drop all the blocks held by the threads caches
+	audio_data_blocks_memory_pool_generation++;
+	audio_blocks_arena_next = 0;
 }
 
 /**
@@ -1,11 +1,15 @@
 /**
 *	@file		audioBlock.h
 *	@author		Nahum Budin
-*	@date		30-Sep-2024
-*	@version	1.1 
-*					1. Code refactoring and notaion.
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Blocks data in a single 64 bytes aligned slab.
+*					2. Per update cycle arena allocation mode.
 *					
-*	@version	1.1	29-Jan-2021	Code refactoring and notaion
+*	@version	1.3	17-Oct-2026	Audio blocks arena
+*				1.2	17-Oct-2026	Lock-free audio blocks pool
+*				1.1	30-Sep-2024	Code refactoring and notaion
+*				1.1	29-Jan-2021	Code refactoring and notaion
 *				1.0	4-Nov-2019	(13/6/2018 No control blocks)
 *
 *	@brief		Audio blocks and connections .
@@ -80,12 +84,35 @@
 *	The connect function creates a linked list of destination Audio-blocks that the source Audio-object 
 *	output should be transfered to their inputs using the Audio-block 
 *	transmit_audio_block(audio_block_float_mono_t *block, uint16_t index) function.
+*
+*	***************** Audio Blocks Pool *********************
+*
+*	Audio data blocks are taken from a global pool whose free blocks are marked by 32 bits
+*	availability masks. The masks are updated using atomic operations, so allocating and releasing
+*	blocks does not require any lock and may be performed concurrently by the voices rendering
+*	worker threads.
+*
+*	To reduce the contention on the masks, each thread holds a small cache of free blocks.
+*	Allocations are served from the cache, which is refilled in batches of
+*	_AUDIO_BLOCKS_THREAD_CACHE_BATCH blocks from the pool. Released blocks are returned to the
+*	releasing thread cache, which flushes a batch back to the pool when full.
+*	A thread that stops processing audio should call flush_thread_audio_blocks_cache().
+*
+*	All the blocks data buffers are carved from a single contiguous slab, each buffer is
+*	_AUDIO_BLOCK_DATA_ALIGNMENT (64) bytes aligned.
+*
+*	In arena mode, the blocks of an update cycle are bump-allocated from the start of the slab
+*	and the arena is reset when the cycle ends (end_audio_update_cycle()), so the blocks of
+*	a cycle are contiguous in memory and no availability mask is scanned. Releasing a block only
+*	drops its reference count; a block still referenced when the cycle ends (outlives the cycle)
+*	is skipped by the next cycle allocations until it is released.
 */
 
 #pragma once
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <atomic>
 
 #include "audioCommons.h"
 
@@ -108,6 +135,14 @@ Error : must be n * 32
 	// Used for allocation 32 bits masks
 #define _AUDIO_BLOCKS_MESSAGES_POOL_NUM_OF_MASKS (_MAX_AUDIO_BLOCKS_MESSAGES_POOL_SIZE >> 5) 
 
+// Per thread free audio blocks cache size
+#define _AUDIO_BLOCKS_THREAD_CACHE_SIZE			32
+// Number of blocks moved at once between a thread cache and the pool
+#define _AUDIO_BLOCKS_THREAD_CACHE_BATCH		16
+
+// Audio blocks data buffers alignment (bytes) - a cache line
+#define _AUDIO_BLOCK_DATA_ALIGNMENT				64
+
 #define _MAX_NUM_OF_AUDIO_CONNECTIONS			2048
 
 #define _CONNECTION_OK							0
@@ -156,6 +191,11 @@ public:
 	
 	static void initialize_audio_memory(audio_block_float_mono_t *blocks, uint16_t num, uint16_t block_size);	
 	
+	static void flush_thread_audio_blocks_cache();
+	
+	static void end_audio_update_cycle(bool arena_mode);
+	static bool get_audio_blocks_arena_mode();
+	
 	static int16_t random(int16_t min, int16_t max);	
 
 	/* Performs block processing */
@@ -204,9 +244,23 @@ private:
 	volatile static bool update_in_progress;
 	// A global memory pool of audio blocks
 	static audio_block_float_mono_t *audio_data_blocks_memory_pool;
-	static uint32_t audio_data_blocks_memory_pool_available_mask[];
-	static uint16_t audio_data_blocks_memory_pool_first_mask;
+	static std::atomic<uint32_t> audio_data_blocks_memory_pool_available_mask[];
+	static std::atomic<uint16_t> audio_data_blocks_memory_pool_first_mask;
+	// Incremented when the pool is re-initialized to invalidate the threads caches
+	static std::atomic<uint32_t> audio_data_blocks_memory_pool_generation;
 	static uint16_t audio_block_size;
+	static uint16_t audio_data_blocks_memory_pool_num_of_blocks;
+	// A single aligned memory slab holding all the blocks data
+	static float *audio_data_blocks_memory_slab;
+	// When true, blocks are bump-allocated from the cycle arena
+	static bool audio_blocks_arena_mode;
+	// Next arena block index
+	static std::atomic<uint32_t> audio_blocks_arena_next;
+	
+	static audio_block_float_mono_t *allocate_arena_audio_block();
+	static void rebuild_pool_available_masks();
+	static int claim_pool_audio_blocks(audio_block_float_mono_t **blocks, int num);
+	static void return_pool_audio_block(audio_block_float_mono_t *block);
 	
 	friend class AudioConnectionFloat;
 	friend class AudioConnectionsManagerFloat;
@@ -15,6 +15,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "../libAdjRaspi5Synth1_1/libAdjRaspi5Synth1_1.h"
 
 #define _AUDIO_MAX_BUF_SIZE				2048
@@ -29,7 +31,8 @@ typedef struct audio_block_float_mono {
 
 	unsigned int id;
 	unsigned int memory_pool_index;
-	unsigned int ref_count;
+	// Number of owners, updated concurrently by the voices rendering threads
+	std::atomic<unsigned int> ref_count;
 	float* data;
 } audio_block_float_mono_t;
 
@@ -43,4 +46,26 @@ typedef struct shared_memory_audio_block_float_stereo_struct {
 	float data[2][_AUDIO_MAX_BUF_SIZE];  // TODO: NOTE MAX BUFFER SIZE
 } shared_memory_audio_block_float_stereo_struct_t;
 
+// Published buffer index flag: the buffer was not claimed by the reader yet
+#define _AUDIO_OUTPUT_BUFFER_NEW		0x4
+#define _AUDIO_OUTPUT_BUFFER_INDEX_MASK	0x3
+
+// Triple buffered stereo output: written by the output audio-block, read by the audio driver callback.
+// The writer and the reader each own one buffer and swap it with the published one, so the 
+// buffer being read is never written, whatever the writer and reader timing is.
+typedef struct audio_output_triple_buffer {
+	
+	// [buffer][channel] aligned buffers of size samples
+	float *data[3][2];
+	unsigned int size;
+	// The buffer owned by the writer (being written)
+	int write_index;
+	// The buffer owned by the reader (being read)
+	int read_index;
+	// True when the reader buffer holds a published block
+	bool read_valid;
+	// Index of the last completed buffer, ORed with _AUDIO_OUTPUT_BUFFER_NEW if not read yet
+	std::atomic<int> published;
+} audio_output_triple_buffer_t;
+
 
@@ -0,0 +1,316 @@
+/**
+*	@file		audioDspLoadMeter.cpp
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.2
+*
+*	@History	1.2	17-Oct-2026	Last cycle load (polyphony governor)
+*				1.1	17-Oct-2026	Voices silence detector statistics
+*				1.0	17-Oct-2026	1st version
+*
+*	@brief		Audio update cycles DSP load meter.
+*/
+
+#include <time.h>
+#include <string.h>
+#include <algorithm>
+
+#include "audioDspLoadMeter.h"
+
+/* A pointer to the singleton AudioDspLoadMeter instance */
+AudioDspLoadMeter *AudioDspLoadMeter::dsp_load_meter_instance = NULL;
+
+/**
+*   @brief  Create and return a pointer to the singleton AudioDspLoadMeter instance.
+*   @param  none
+*   @return a pointer to the singleton AudioDspLoadMeter instance
+*/
+AudioDspLoadMeter *AudioDspLoadMeter::get_instance()
+{
+	if (!dsp_load_meter_instance)
+	{
+		dsp_load_meter_instance = new AudioDspLoadMeter();
+	}
+
+	return dsp_load_meter_instance;
+}
+
+/**
+*   @brief  Create an AudioDspLoadMeter object instance.
+*   @param  none
+*   @return none
+*/
+AudioDspLoadMeter::AudioDspLoadMeter()
+{
+	dsp_load_meter_instance = this;
+	
+	cycle_start_ns = 0;
+	cycle_period_ns = 0;
+	
+	reset_stats();
+}
+
+/**
+*   @brief  Returns the current time of the raw monotonic clock (not NTP adjusted).
+*   @param  none
+*   @return time [nSec]
+*/
+long long AudioDspLoadMeter::get_time_ns()
+{
+	struct timespec ts;
+	
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+	
+	return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/**
+*   @brief  Start measuring an update cycle.
+*   @param  period_ns	the audio period time [nSec] the cycle must be completed in
+*   @return void
+*/
+void AudioDspLoadMeter::begin_cycle(long long period_ns)
+{
+	cycle_period_ns = period_ns;
+	
+	for (int stage = 0; stage < _DSP_LOAD_NUM_OF_STAGES; stage++)
+	{
+		cycle_stage_ns[stage] = 0;
+	}
+	
+	cycle_start_ns = get_time_ns();
+}
+
+/**
+*   @brief  Add a measured processing time to a stage of the current cycle.
+*   @param  stage	stage _DSP_LOAD_STAGE_VOICES to _DSP_LOAD_STAGE_OTHER
+*	@param	time_ns	processing time [nSec]
+*   @return void
+*/
+void AudioDspLoadMeter::add_stage_time(int stage, long long time_ns)
+{
+	if ((stage >= 0) && (stage < _DSP_LOAD_NUM_OF_STAGES))
+	{
+		cycle_stage_ns[stage] += time_ns;
+	}
+}
+
+/**
+*   @brief  End measuring an update cycle: update the statistics windows and 
+*			the overruns counters.
+*			The cycle time not accounted for by any stage is added to _DSP_LOAD_STAGE_OTHER.
+*   @param  none
+*   @return void
+*/
+void AudioDspLoadMeter::end_cycle()
+{
+	long long cycle_ns = get_time_ns() - cycle_start_ns;
+	long long stages_ns = 0;
+	int index, stage, max_stage = _DSP_LOAD_STAGE_OTHER;
+	float load;
+	
+	if (cycle_period_ns <= 0)
+	{
+		return;
+	}
+	
+	for (stage = 0; stage < _DSP_LOAD_NUM_OF_STAGES; stage++)
+	{
+		stages_ns += cycle_stage_ns[stage];
+	}
+	
+	if (cycle_ns > stages_ns)
+	{
+		cycle_stage_ns[_DSP_LOAD_STAGE_OTHER] += cycle_ns - stages_ns;
+	}
+	
+	index = window_index.load(std::memory_order_relaxed);
+	
+	load = 100.0f * (float)cycle_ns / (float)cycle_period_ns;
+	cycle_load_window[index] = load;
+	last_cycle_load.store(load, std::memory_order_relaxed);
+	
+	for (stage = 0; stage < _DSP_LOAD_NUM_OF_STAGES; stage++)
+	{
+		stage_load_window[stage][index] = 100.0f * (float)cycle_stage_ns[stage] / (float)cycle_period_ns;
+		
+		if (cycle_stage_ns[stage] > cycle_stage_ns[max_stage])
+		{
+			max_stage = stage;
+		}
+	}
+	
+	window_index.store((index + 1) % _DSP_LOAD_WINDOW_SIZE, std::memory_order_release);
+	if (window_count.load(std::memory_order_relaxed) < _DSP_LOAD_WINDOW_SIZE)
+	{
+		window_count.fetch_add(1, std::memory_order_release);
+	}
+	
+	num_of_cycles.fetch_add(1, std::memory_order_relaxed);
+	
+	if (cycle_ns > cycle_period_ns)
+	{
+		// Overrun - attribute it to the heaviest stage of this cycle
+		overruns.fetch_add(1, std::memory_order_relaxed);
+		stage_overruns[max_stage].fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+/**
+*   @brief  Calculate the min/avg/max/p99 of a load window.
+*   @param  window			a pointer to the window samples
+*	@param	num_of_samples	number of valid samples
+*	@param	measure			a pointer to a _dsp_load_measure_t struct to be filled
+*   @return void
+*/
+void AudioDspLoadMeter::calc_measure(float *window, int num_of_samples, _dsp_load_measure_t *measure)
+{
+	float sorted[_DSP_LOAD_WINDOW_SIZE];
+	float sum = 0;
+	int p99_index;
+	
+	if (num_of_samples <= 0)
+	{
+		measure->min = 0;
+		measure->avg = 0;
+		measure->max = 0;
+		measure->p99 = 0;
+		
+		return;
+	}
+	
+	memcpy(sorted, window, num_of_samples * sizeof(float));
+	std::sort(sorted, sorted + num_of_samples);
+	
+	for (int i = 0; i < num_of_samples; i++)
+	{
+		sum += sorted[i];
+	}
+	
+	p99_index = (num_of_samples * 99) / 100;
+	if (p99_index >= num_of_samples)
+	{
+		p99_index = num_of_samples - 1;
+	}
+	
+	measure->min = sorted[0];
+	measure->avg = sum / num_of_samples;
+	measure->max = sorted[num_of_samples - 1];
+	measure->p99 = sorted[p99_index];
+}
+
+/**
+*   @brief  Get the DSP load statistics over the last _DSP_LOAD_WINDOW_SIZE cycles.
+*			Not real-time safe (sorts the windows), must not be called by the audio threads.
+*   @param  stats	a pointer to a _dsp_load_stats_t struct to be filled
+*   @return 0 if done; -1 if stats is NULL
+*/
+int AudioDspLoadMeter::get_stats(_dsp_load_stats_t *stats)
+{
+	int count = window_count.load(std::memory_order_acquire);
+	
+	if (stats == NULL)
+	{
+		return -1;
+	}
+	
+	calc_measure(cycle_load_window, count, &stats->cycle);
+	
+	for (int stage = 0; stage < _DSP_LOAD_NUM_OF_STAGES; stage++)
+	{
+		calc_measure(stage_load_window[stage], count, &stats->stage[stage]);
+		stats->stage_overruns[stage] = stage_overruns[stage].load(std::memory_order_relaxed);
+	}
+	
+	stats->num_of_cycles = num_of_cycles.load(std::memory_order_relaxed);
+	stats->overruns = overruns.load(std::memory_order_relaxed);
+	
+	stats->silent_voices_freed = silent_voices_freed.load(std::memory_order_relaxed);
+	stats->silent_voice_blocks = silent_voice_blocks.load(std::memory_order_relaxed);
+	stats->saved_voice_blocks = saved_voice_blocks.load(std::memory_order_relaxed);
+	stats->saved_voice_time_us = saved_voice_time_us.load(std::memory_order_relaxed);
+	
+	return 0;
+}
+
+/**
+*   @brief  Reset the DSP load statistics.
+*   @param  none
+*   @return void
+*/
+void AudioDspLoadMeter::reset_stats()
+{
+	window_count.store(0);
+	window_index.store(0);
+	num_of_cycles.store(0);
+	overruns.store(0);
+	last_cycle_load.store(0);
+	silent_voices_freed.store(0);
+	silent_voice_blocks.store(0);
+	saved_voice_blocks.store(0);
+	saved_voice_time_us.store(0);
+	
+	for (int stage = 0; stage < _DSP_LOAD_NUM_OF_STAGES; stage++)
+	{
+		stage_overruns[stage].store(0);
+	}
+}
+
+/**
+*   @brief  Returns the average DSP load over the last _DSP_LOAD_WINDOW_SIZE cycles.
+*			Light weight - does not sort the window.
+*   @param  none
+*   @return the average cycle load in percentages of the audio period; -1 if no cycle was measured
+*/
+int AudioDspLoadMeter::get_load()
+{
+	int count = window_count.load(std::memory_order_acquire);
+	float sum = 0;
+	
+	if (count <= 0)
+	{
+		return -1;
+	}
+	
+	for (int i = 0; i < count; i++)
+	{
+		sum += cycle_load_window[i];
+	}
+	
+	return (int)(sum / count + 0.5f);
+}
+
+/**
+*   @brief  Returns the load of the last measured update cycle.
+*   @param  none
+*   @return the last cycle time in percentages of the audio period (0 if no cycle was measured)
+*/
+float AudioDspLoadMeter::get_last_cycle_load()
+{
+	return last_cycle_load.load(std::memory_order_relaxed);
+}
+
+/**
+*   @brief  Count a voice audio block rendered below the voices silence threshold.
+*			May be called by any voices rendering thread.
+*   @param  none
+*   @return void
+*/
+void AudioDspLoadMeter::add_silent_voice_block()
+{
+	silent_voice_blocks.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+*   @brief  Count a voice freed early by the voices silence detector.
+*			May be called by any voices rendering thread.
+*   @param  saved_blocks	estimated number of the voice audio blocks that are not rendered
+*	@param	saved_time_us	estimated processing time of the saved blocks [uSec]
+*   @return void
+*/
+void AudioDspLoadMeter::add_silent_voice_freed(unsigned long saved_blocks, unsigned long long saved_time_us)
+{
+	silent_voices_freed.fetch_add(1, std::memory_order_relaxed);
+	saved_voice_blocks.fetch_add(saved_blocks, std::memory_order_relaxed);
+	saved_voice_time_us.fetch_add(saved_time_us, std::memory_order_relaxed);
+}
@@ -0,0 +1,87 @@
+/**
+*	@file		audioDspLoadMeter.h
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.2
+*
+*	@History	1.2	17-Oct-2026	Last cycle load (polyphony governor)
+*				1.1	17-Oct-2026	Voices silence detector statistics
+*				1.0	17-Oct-2026	1st version
+*
+*	@brief		Audio update cycles DSP load meter.
+*
+*				Measures each update cycle, and each of its stages (voices, poly-mixer, equalizer,
+*				reverb, output), using CLOCK_MONOTONIC_RAW, as a percentage of the audio period.
+*				Keeps a sliding window of the last _DSP_LOAD_WINDOW_SIZE cycles for min/avg/max/p99
+*				statistics, and counts overruns (cycles longer than the period), attributing each
+*				overrun to the stage that took the largest part of that cycle.
+*
+*				The measurements are written by the thread running the update cycles only, and may
+*				be read by any thread.
+*				The voices silence detector counters are updated by the voices rendering threads.
+*/
+
+#pragma once
+
+#include <atomic>
+
+#include "../LibAPI/audio.h"
+
+// Number of last cycles the statistics are calculated over
+#define _DSP_LOAD_WINDOW_SIZE		256
+
+class AudioDspLoadMeter
+{
+public:
+
+	static AudioDspLoadMeter *get_instance();
+
+	void begin_cycle(long long period_ns);
+	void add_stage_time(int stage, long long time_ns);
+	void end_cycle();
+
+	int get_stats(_dsp_load_stats_t *stats);
+	void reset_stats();
+	
+	int get_load();
+	float get_last_cycle_load();
+	
+	void add_silent_voice_block();
+	void add_silent_voice_freed(unsigned long saved_blocks, unsigned long long saved_time_us);
+
+	static long long get_time_ns();
+
+private:
+
+	AudioDspLoadMeter();
+
+	static AudioDspLoadMeter *dsp_load_meter_instance;
+	
+	static void calc_measure(float *window, int num_of_samples, _dsp_load_measure_t *measure);
+
+	/* Current cycle */
+	long long cycle_start_ns;
+	long long cycle_period_ns;
+	long long cycle_stage_ns[_DSP_LOAD_NUM_OF_STAGES];
+
+	/* Sliding windows of the cycles and stages loads [% of period] */
+	float cycle_load_window[_DSP_LOAD_WINDOW_SIZE];
+	float stage_load_window[_DSP_LOAD_NUM_OF_STAGES][_DSP_LOAD_WINDOW_SIZE];
+	/* Next window index to write */
+	std::atomic<int> window_index;
+	/* Number of valid window entries */
+	std::atomic<int> window_count;
+
+	std::atomic<unsigned long> num_of_cycles;
+	std::atomic<unsigned long> overruns;
+	std::atomic<unsigned long> stage_overruns[_DSP_LOAD_NUM_OF_STAGES];
+	
+	/* Last cycle load [% of period] */
+	std::atomic<float> last_cycle_load;
+	
+	/* Voices silence detector */
+	std::atomic<unsigned long> silent_voices_freed;
+	std::atomic<unsigned long> silent_voice_blocks;
+	std::atomic<unsigned long> saved_voice_blocks;
+	std::atomic<unsigned long long> saved_voice_time_us;
+};
@@ -19,10 +19,14 @@
 
 #include <sys/shm.h>		//Used for shared memory
 #include <sys/time.h>
+#include <time.h>
+#include <errno.h>
 //#include <omp.h>
 
 #include "audioManager.h"
 #include "audioCommons.h"
+#include "audioVoiceRenderPool.h"
+#include "audioDspLoadMeter.h"
 #include "../Misc/priorities.h"
 #include "../commonDefs.h"
 #include "../ALSA/alsaAudioHandling.h"
@@ -35,17 +39,19 @@ AudioManager *AudioManager::audio_manager_instance = NULL;
 func_ptr_void_int_t AudioManager::callback_audio_update_cycle_start_tasks_ptr = NULL;
 func_ptr_void_int_t AudioManager::callback_audio_voice_update_ptr = NULL;
 func_ptr_void_int_t AudioManager::callback_audio_update_cycle_end_tasks_ptr = NULL;
+func_ptr_int_int_t AudioManager::callback_audio_voice_core_ptr = NULL;
 
 /* Mutexs to control polyphonic voices update process */
 pthread_mutex_t update_mutex[_SYNTH_MAX_NUM_OF_VOICES];
 
-// Mutex to controll audio memory blocks allocation 
-extern pthread_mutex_t voice_mem_blocks_allocation_control_mutex;
-
 /* Update thread conditional variable signaling */
 pthread_cond_t update_thread_cv = PTHREAD_COND_INITIALIZER;
 /* Update thread control mutex */
 pthread_mutex_t update_thread_mutex = PTHREAD_MUTEX_INITIALIZER; 
+/* Number of update cycles the update thread should run (protected by update_thread_mutex) */
+int update_cycles_pending = 0;
+/* Held while an update cycle is run (by the update thread or by the JACK process callback) */
+pthread_mutex_t update_cycle_mutex = PTHREAD_MUTEX_INITIALIZER; 
 
 /* True when update thread is running, false otherwise */
 bool update_thread_is_running = false;
@@ -93,10 +99,21 @@ AudioManager::AudioManager(int mseed)
 	
 	jack_thread_is_running = false;
 	
+	multi_core_voices_rendering = _DEFAULT_MULTI_CORE_VOICES_RENDERING;
+	voices_render_pool_unavailable = false;
+	num_of_render_cores = 1;
+	audio_blocks_arena = _DEFAULT_AUDIO_BLOCKS_ARENA;
+	jack_direct_output = _DEFAULT_JACK_DIRECT_OUTPUT;
+	audio_driver = _DEFAULT_AUDIO_DRIVER;
+	jack_render_in_callback = _DEFAULT_JACK_RENDER_IN_CALLBACK;
+	update_timer_catch_up = _DEFAULT_UPDATE_TIMER_CATCH_UP;
+	update_timer_missed_deadlines = 0;
+	
 	connections_manager = new AudioConnectionsManagerFloat();
 	
 	// Create shared memory blocks for audio data transfer
 	create_audio_shared_memory(mem_seed);
+	create_audio_output_direct_buffer();
 	
 	for (int i = 0; i < _SYNTH_MAX_NUM_OF_VOICES; i++) 
 	{
@@ -188,6 +205,42 @@ int AudioManager::create_audio_shared_memory(int seed)
 	return err;
 }
 
+/**
+*   @brief  Allocates the stereo output triple buffer read directly by the JACK process callback.
+*			Buffers are _AUDIO_MAX_BUF_SIZE samples long and 64 bytes aligned.
+*   @param  none
+*   @return 0 if done
+*/
+int AudioManager::create_audio_output_direct_buffer()
+{
+	void *buf;
+	
+	audio_output_direct_buffer = new audio_output_triple_buffer_t();
+	
+	for (int b = 0; b < 3; b++)
+	{
+		for (int ch = _LEFT; ch <= _RIGHT; ch++)
+		{
+			if (posix_memalign(&buf, _AUDIO_BLOCK_DATA_ALIGNMENT, _AUDIO_MAX_BUF_SIZE * sizeof(float)) != 0)
+			{
+				fprintf(stderr, "Audio-manager direct output buffer allocation failed\n");
+				exit(EXIT_FAILURE);
+			}
+			
+			memset(buf, 0, _AUDIO_MAX_BUF_SIZE * sizeof(float));
+			audio_output_direct_buffer->data[b][ch] = (float*)buf;
+		}
+	}
+	
+	audio_output_direct_buffer->size = _AUDIO_MAX_BUF_SIZE;
+	audio_output_direct_buffer->write_index = 0;
+	audio_output_direct_buffer->published = 1;
+	audio_output_direct_buffer->read_index = 2;
+	audio_output_direct_buffer->read_valid = false;
+	
+	return 0;
+}
+
 /**
 *	@brief	Sets the sample-rate. Update also period_time
 *	@param	sample  rate: _SAMPLE_RATE_44 (44100Hz) or _SAMPLE_RATE_48 (48000Hz)
@@ -375,6 +428,7 @@ int AudioManager::start_audio_service(int driver, int samp_rate, int block_size)
 	}
 	
 	audio_service_started = true;
+	audio_driver = driver;
 
 	start_audio_update_thread();
 	
@@ -383,14 +437,26 @@ int AudioManager::start_audio_service(int driver, int samp_rate, int block_size)
 		//		stop_jack_connect_thread();
 		disconnect_jack_audio_ports_out();
 		start_alsa_main_thread();
+		// JACK is not driving the update cycles
+		start_update_process_periodic_timer();
 	}
 	else if (driver == _AUDIO_JACK)
 	{
+		stop_update_process_periodic_timer();
 		stop_alsa_main_thread();
 		//start_jack_main_thread();
 		
 		//start_jack_service(_JACK_MODE_APP_CONTROL, _DEFAULT_JACK_AUTO_START, _DEFAULT_JACK_AUTO_CONNECT_AUDIO); // TODO:
 		start_jack_service(get_jack_mode(), get_jack_auto_start_state(), get_jack_auto_connect_audio_state());
+		// Create the voices rendering workers before the JACK callback runs update cycles
+		update_voices_render_pool_in_callback_mode();
+	}
+	else if (driver == _AUDIO_NULL)
+	{
+		// No audio device: the update cycles are run by run_offline_update_cycle()
+		stop_update_process_periodic_timer();
+		disconnect_jack_audio_ports_out();
+		stop_alsa_main_thread();
 	}
 	
 	// Start anyhow for fluidsynth until handling fluid will be added
@@ -407,6 +473,7 @@ int AudioManager::start_audio_service(int driver, int samp_rate, int block_size)
 int AudioManager::stop_audio_service()
 {
 	audio_service_started = false;
+	stop_update_process_periodic_timer();
 	stop_audio_update_thread();
 	stop_jack_connect_thread();
 	disconnect_jack_audio_ports_out();
@@ -458,7 +525,11 @@ void AudioManager::start_audio_update_thread()
 */
 void AudioManager::stop_audio_update_thread()
 {
+	pthread_mutex_lock(&update_thread_mutex);
 	update_thread_is_running = false;
+	// Wake the update thread so it exits
+	pthread_cond_signal(&update_thread_cv);
+	pthread_mutex_unlock(&update_thread_mutex);
 }
 
 /**
@@ -581,6 +652,11 @@ int AudioManager::start_update_process_periodic_timer()
 	pthread_attr_t tattr;
 	struct sched_param params;
 
+	if (periodic_update_timer_thread_is_running)
+	{
+		return 0;
+	}
+	
 	if (period_time_us < 1000)
 	{
 		// period < 1msec
@@ -609,22 +685,86 @@ int AudioManager::start_update_process_periodic_timer()
 	periodic_update_timer_thread_is_running = true;
 	// Run audio thread
 	ret = pthread_create(&process_periodic_timer_thread_id, &tattr, AUDMNG_periodic_update_timer_thread, (void *)1);
+	if (ret != 0)
+	{
+		// Probably not permitted to use realtime scheduling - run with inherited scheduling
+		ret = pthread_create(&process_periodic_timer_thread_id, NULL, AUDMNG_periodic_update_timer_thread, (void *)1);
+	}
+	
+	if (ret != 0)
+	{
+		fprintf(stderr, "Unsuccessful in creating process update periodic timer thread\n");
+		periodic_update_timer_thread_is_running = false;
+		return ret;
+	}
+	
 	pthread_setname_np(process_periodic_timer_thread_id, "aud_mng_updat_timer_tethread");
 
 	return ret;
 }
 
 /**
-*   @brief  stop the periodic update timer .
+*   @brief  stop the periodic update timer and wait for its thread to exit.
 *   @param  none
 *   @return 0
 */
 int AudioManager::stop_update_process_periodic_timer()
 {
+	if (!periodic_update_timer_thread_is_running)
+	{
+		return 0;
+	}
+	
 	periodic_update_timer_thread_is_running = false;
+	pthread_join(process_periodic_timer_thread_id, NULL);
+	
 	return 0;
 }
 
+/**
+*   @brief  Enable or disable catching up missed periodic update timer deadlines.
+*   @param  state	true - the missed cycles are run back to back (up to _UPDATE_TIMER_MAX_CATCH_UP_CYCLES);
+*					false - the missed cycles are skipped and the timer is resynchronized
+*   @return none
+*/
+void AudioManager::set_update_timer_catch_up_state(bool state)
+{
+	update_timer_catch_up = state;
+}
+
+/**
+*   @brief  Returns the periodic update timer catch up state.
+*   @param  none
+*   @return true if missed deadlines are caught up
+*/
+bool AudioManager::get_update_timer_catch_up_state() { return update_timer_catch_up; }
+
+/**
+*   @brief  Returns the number of periodic update timer missed deadlines since last reset.
+*			A deadline is missed when the timer thread wakes up a period or more late, 
+*			or when the previous requested cycle was not started yet.
+*   @param  none
+*   @return number of missed deadlines
+*/
+unsigned long AudioManager::get_update_timer_missed_deadlines() { return update_timer_missed_deadlines; }
+
+/**
+*   @brief  Reset the periodic update timer missed deadlines counter.
+*   @param  none
+*   @return none
+*/
+void AudioManager::reset_update_timer_missed_deadlines() { update_timer_missed_deadlines = 0; }
+
+/**
+*   @brief  Add to the periodic update timer missed deadlines counter (called by the timer thread).
+*   @param  missed	number of missed deadlines
+*   @return none
+*/
+void AudioManager::add_update_timer_missed_deadlines(int missed) 
+{ 
+	update_timer_missed_deadlines += missed; 
+}
+
 /**
 *   @brief  A callback function that is called at the begining of every audio update cycle.
 *			Registered function should be small as possible.
@@ -700,6 +840,325 @@ void AudioManager::register_callback_audio_update_cycle_end_tasks(func_ptr_void_
 	callback_audio_update_cycle_end_tasks_ptr = ptr;
 }
 
+/**
+*   @brief  A callback function that returns the core a voice should be rendered on.
+*   @param  voice_num	voice number
+*   @return the voice core; -1 if the voice is not playing or no callback is registered
+*/
+int AudioManager::callback_audio_voice_core(int voice_num)
+{
+	if (callback_audio_voice_core_ptr)
+	{
+		return callback_audio_voice_core_ptr(voice_num);
+	}
+	
+	return -1;
+}
+
+/**
+*   @brief  Register a callback function that returns the core a voice should be rendered on,
+*			or -1 if the voice is not playing and need not be rendered.
+*			Called for every voice at the begining of every audio update cycle.
+*			Registered function should be small as possible.
+*   @param  ptr	a pointer to an int foo(int voice_num) function
+*   @return none
+*/
+void AudioManager::register_callback_audio_voice_core(func_ptr_int_int_t ptr)
+{
+	callback_audio_voice_core_ptr = ptr;
+}
+
+/**
+*   @brief  Enable or disable rendering voices in parallel on multiple cores.
+*			Takes effect on the next audio update cycle (immediately when the JACK
+*			callback runs the update cycles). Starting the render workers is retried 
+*			if it failed before.
+*   @param  state	true - multi-core rendering; false - all voices rendered by the update thread
+*   @return 0 if done; -1 if the render workers could not be started (voices are rendered serially)
+*/
+int AudioManager::set_multi_core_voices_rendering_state(bool state)
+{
+	multi_core_voices_rendering = state;
+	voices_render_pool_unavailable = false;
+	update_voices_render_pool_in_callback_mode();
+	
+	return voices_render_pool_unavailable ? -1 : 0;
+}
+
+/**
+*   @brief  Returns the multi-core voices rendering state.
+*   @param  none
+*   @return true if multi-core voices rendering is enabled
+*/
+bool AudioManager::get_multi_core_voices_rendering_state() { return multi_core_voices_rendering; }
+
+/**
+*   @brief  Returns false if the render workers could not be started, so voices are 
+*			rendered serially although multi-core rendering is enabled.
+*   @param  none
+*   @return true if the render workers are available
+*/
+bool AudioManager::voices_render_pool_is_available() { return !voices_render_pool_unavailable; }
+
+/**
+*   @brief  Set the number of cores voices are rendered on in multi-core mode.
+*			Takes effect the next time the multi-core rendering is started.
+*   @param  num	number of cores 1 to _SYNTH_MAX_NUM_OF_CORES
+*   @return set number of cores; -1 param out of range
+*/
+int AudioManager::set_num_of_render_cores(int num)
+{
+	if ((num < 1) || (num > _SYNTH_MAX_NUM_OF_CORES))
+	{
+		return -1;
+	}
+	
+	num_of_render_cores = num;
+	// Retry starting the render workers
+	voices_render_pool_unavailable = false;
+	
+	return num_of_render_cores;
+}
+
+/**
+*   @brief  Returns the number of cores voices are rendered on in multi-core mode.
+*   @param  none
+*   @return number of cores
+*/
+int AudioManager::get_num_of_render_cores() { return num_of_render_cores; }
+
+/**
+*   @brief  Enable or disable allocating the audio blocks from a per update cycle arena.
+*			Takes effect on the next audio update cycle.
+*   @param  state	true - arena allocation; false - pool allocation
+*   @return none
+*/
+void AudioManager::set_audio_blocks_arena_state(bool state)
+{
+	audio_blocks_arena = state;
+}
+
+/**
+*   @brief  Returns the audio blocks arena allocation state.
+*   @param  none
+*   @return true if audio blocks are allocated from a per update cycle arena
+*/
+bool AudioManager::get_audio_blocks_arena_state() { return audio_blocks_arena; }
+
+/**
+*   @brief  Enable or disable handing the output to the JACK process callback through 
+*			the direct output triple buffer (instead of the output shared memory).
+*			Takes effect on the next audio update cycle.
+*   @param  state	true - direct output; false - shared memory output
+*   @return none
+*/
+void AudioManager::set_jack_direct_output_state(bool state)
+{
+	jack_direct_output = state;
+}
+
+/**
+*   @brief  Returns the JACK direct output state.
+*   @param  none
+*   @return true if JACK direct output is enabled
+*/
+bool AudioManager::get_jack_direct_output_state() { return jack_direct_output; }
+
+/**
+*   @brief  Returns true if the output is currently handed through the direct output buffer
+*			(direct output is enabled and the JACK driver is used).
+*   @param  none
+*   @return true if JACK direct output is active
+*/
+bool AudioManager::jack_direct_output_is_active() 
+{ 
+	return jack_direct_output && (audio_driver == _AUDIO_JACK); 
+}
+
+/**
+*   @brief  Enable or disable running the whole update cycle synchronously inside the JACK
+*			process callback, so the block rendered in a period is played in the same period.
+*			Takes effect on the next JACK period.
+*   @param  state	true - render in the JACK callback; false - render in the update thread
+*   @return none
+*/
+void AudioManager::set_jack_render_in_callback_state(bool state)
+{
+	jack_render_in_callback = state;
+	update_voices_render_pool_in_callback_mode();
+}
+
+/**
+*   @brief  Returns the JACK render in callback state.
+*   @param  none
+*   @return true if JACK render in callback is enabled
+*/
+bool AudioManager::get_jack_render_in_callback_state() { return jack_render_in_callback; }
+
+/**
+*   @brief  Returns true if the update cycle is currently run inside the JACK process callback
+*			(render in callback is enabled and the JACK driver is used).
+*   @param  none
+*   @return true if JACK render in callback is active
+*/
+bool AudioManager::jack_render_in_callback_is_active() 
+{ 
+	return jack_render_in_callback && (audio_driver == _AUDIO_JACK); 
+}
+
+/**
+*   @brief  Returns the audio driver the audio service was started with.
+*   @param  none
+*   @return _AUDIO_JACK, _AUDIO_ALSA or _AUDIO_NULL
+*/
+int AudioManager::get_audio_driver_type() { return audio_driver; }
+
+/**
+*   @brief  Start or stop the voices rendering workers according to the multi-core mode.
+*			Never called from the JACK process callback.
+*			The caller must hold the update_cycle_mutex.
+*   @param  pin_caller	true - the caller is the thread running the update cycles
+*   @return none
+*/
+void AudioManager::update_voices_render_pool(bool pin_caller)
+{
+	bool multi_core = multi_core_voices_rendering && !voices_render_pool_unavailable && 
+		(num_of_render_cores > 1);
+	AudioVoiceRenderPool *render_pool = AudioVoiceRenderPool::get_instance();
+		
+	if (multi_core && !render_pool->is_running())
+	{
+		if (render_pool->start(num_of_render_cores, pin_caller) != 0)
+		{
+			// Workers could not be created - keep rendering serially (the multi-core setting 
+			// is kept; starting is retried when the setting or the number of cores is set)
+			voices_render_pool_unavailable = true;
+		}
+	}
+	else if (!multi_core && render_pool->is_running())
+	{
+		render_pool->stop();
+	}
+}
+
+/**
+*   @brief  When the update cycles are run by the JACK process callback, start or stop
+*			the voices rendering workers on the calling (non real-time) thread, so the callback
+*			never creates threads or changes affinities. The callback skips the cycles
+*			it runs into meanwhile. Otherwise the update thread does it before its next cycle.
+*   @param  none
+*   @return none
+*/
+void AudioManager::update_voices_render_pool_in_callback_mode()
+{
+	if (!audio_service_started || !jack_render_in_callback_is_active())
+	{
+		return;
+	}
+	
+	pthread_mutex_lock(&update_cycle_mutex);
+	update_voices_render_pool(false);
+	pthread_mutex_unlock(&update_cycle_mutex);
+}
+
+/**
+*   @brief  Run a single audio update cycle: the cycle start tasks, all the voices 
+*			(in parallel when multi-core rendering is enabled) and the cycle end tasks
+*			(poly-mixer, reverb, stereo-output).
+*			The caller must hold the update_cycle_mutex.
+*   @param  none
+*   @return none
+*/
+void AudioManager::run_audio_update_cycle()
+{
+	long long stage_start_ns;
+	AudioVoiceRenderPool *render_pool = AudioVoiceRenderPool::get_instance();
+	AudioDspLoadMeter *dsp_load_meter = AudioDspLoadMeter::get_instance();
+	
+	if (sample_rate > 0)
+	{
+		dsp_load_meter->begin_cycle(((long long)audio_block_size * 1000000000LL) / sample_rate);
+	}
+	else
+	{
+		dsp_load_meter->begin_cycle((long long)period_time_us * 1000);
+	}
+	
+	// Activate update cycle start tasks (e.g. ModSynth::update_tasks() )
+	if (callback_audio_update_cycle_start_tasks_ptr)
+	{
+		callback_audio_update_cycle_start_tasks_ptr(0); // 0 - dummy param
+	}
+	
+	stage_start_ns = AudioDspLoadMeter::get_time_ns();
+		
+	if (render_pool->is_running())
+	{
+		// Render all voices in parallel; returns when all voices outputs are ready
+		render_pool->render_voices();
+	}
+	else
+	{
+		// Activate each voice update on this thread
+		render_pool->render_voices_serially();
+	}
+	
+	dsp_load_meter->add_stage_time(_DSP_LOAD_STAGE_VOICES, AudioDspLoadMeter::get_time_ns() - stage_start_ns);
+		
+	// Update common blocks: poly-mixer, reverb, stereo-output (each measures its own stage time)	
+	if (callback_audio_update_cycle_end_tasks_ptr)
+	{
+		callback_audio_update_cycle_end_tasks_ptr(0); // 0 - dummy param
+	}
+	
+	// All cycle blocks are done - reset the blocks arena
+	AudioBlockFloat::end_audio_update_cycle(audio_blocks_arena);
+	
+	dsp_load_meter->end_cycle();
+}
+
+/**
+*   @brief  Run a single audio update cycle from the JACK process callback.
+*			Never blocks: if the update thread is still running a cycle (render in callback 
+*			was just enabled) the cycle is skipped.
+*   @param  none
+*   @return 0 if a cycle was run; -1 if skipped
+*/
+int AudioManager::run_audio_update_cycle_in_callback()
+{
+	if (pthread_mutex_trylock(&update_cycle_mutex) != 0)
+	{
+		return -1;
+	}
+	
+	run_audio_update_cycle();
+	
+	pthread_mutex_unlock(&update_cycle_mutex);
+	
+	return 0;
+}
+
+/**
+*   @brief  Run a single audio update cycle on the calling thread, when the audio service
+*			runs with the null audio driver (no audio device, e.g. offline benchmarking).
+*   @param  none
+*   @return 0 if done; -1 if the audio service is not running with the null driver
+*/
+int AudioManager::run_offline_update_cycle()
+{
+	if (!audio_service_started || (audio_driver != _AUDIO_NULL))
+	{
+		return -1;
+	}
+	
+	pthread_mutex_lock(&update_cycle_mutex);
+	update_voices_render_pool(true);
+	run_audio_update_cycle();
+	pthread_mutex_unlock(&update_cycle_mutex);
+	
+	return 0;
+}
+
 /**
 *   @brief  Main audio-block processing update thread
 *   @param  arg a pointer to a void argument (not in use)
@@ -707,69 +1166,43 @@ void AudioManager::register_callback_audio_update_cycle_end_tasks(func_ptr_void_
 */
 void* AUDMNG_update_thread(void *arg)
 {
-	int lockCount = 0, voice, count;
-	int ID;
-	int core, utilization;
-	struct timeval start_ts, prv_start_ts;
-	struct timeval stop_ts;
-	
+	int count = 0;
 	unsigned long period_time_us;
 	
+	AudioManager *audio_manager = AudioManager::get_instance();
+	AudioVoiceRenderPool *render_pool = AudioVoiceRenderPool::get_instance();
+	
 	while (update_thread_is_running)
 	{
 		
 		pthread_mutex_lock(&update_thread_mutex);
-		pthread_cond_wait(&update_thread_cv, &update_thread_mutex);
-		pthread_mutex_unlock(&update_thread_mutex);
-			
-		// Activate update cycle start tasks (e.g. ModSynth::update_tasks() )
-		if (AudioManager::callback_audio_update_cycle_start_tasks_ptr)
+		while ((update_cycles_pending == 0) && update_thread_is_running)
 		{
-			AudioManager::callback_audio_update_cycle_start_tasks_ptr(0); // 0 - dummy param
+			pthread_cond_wait(&update_thread_cv, &update_thread_mutex);
 		}
-
-		prv_start_ts.tv_usec = start_ts.tv_usec;
-		gettimeofday(&start_ts, NULL);
-
-		//fprintf(stderr, "Time from last block: %i Time from prev block end time [us]: %i\n", startts.tv_usec- prvStartts.tv_usec, startts.tv_usec - stopts.tv_usec);
-
-		//omp_set_num_threads(4/*Synthesizer::numOfCores*/);
-				
-		int i;
-/*
-#pragma omp parallel if (AdjSynth::num_of_cores > 1) //private(voice)
+		
+		if (update_cycles_pending > 0)
 		{
-#pragma omp for schedule(static)	
-			for (voice = 0; voice < mod_synth_get_synthesizer_num_of_polyphonic_voices(); voice++)
-			{
-
-				////			if(AdjSynth::synth_voice[voice]->audioVoice->isVoiceActive() ||
-				////				AdjSynth::synth_voice[voice]->audioVoice->isVoiceWaitForNotActive())
-
-				{
-					//ID = omp_get_thread_num();
-					//core = sched_getcpu();
-					// Bellow should be in the callback
-					////AdjSynth::synth_voice[voice]->updateAll();
-
-					// Activate each voice update
-					if (AudioManager::callback_audio_voice_update_ptr)
-					{
-						AudioManager::callback_audio_voice_update_ptr(voice);
-					}
-										
-					//gettimeofday(&stopts, NULL);
-					//printf("Core: %i Th: %i  voice: %i  : %i \n", core, ID, voice, stopts.tv_usec-startts.tv_usec);
-				}
-			}
-			
-		}//#pragma omp parallel
-*/		
-		// Update common blocks: poly-mixer, reverb, stereo-output	
-		if (AudioManager::callback_audio_update_cycle_end_tasks_ptr)
+			update_cycles_pending--;
+		}
+		pthread_mutex_unlock(&update_thread_mutex);
+		
+		if (!update_thread_is_running)
 		{
-			AudioManager::callback_audio_update_cycle_end_tasks_ptr(0); // 0 - dummy param
+			break;
 		}
+		
+		if (audio_manager->jack_render_in_callback_is_active())
+		{
+			// Cycles are run by the JACK process callback
+			continue;
+		}
+
+		pthread_mutex_lock(&update_cycle_mutex);
+		// Start or stop the voices rendering workers when the multi-core mode changes
+		audio_manager->update_voices_render_pool(true);
+		audio_manager->run_audio_update_cycle();
+		pthread_mutex_unlock(&update_cycle_mutex);
 		// Below should be in the above callback
 ////		AudioBlockFloat *p;
 ////		for (p = *AdjSynth::get_instance()->audioPolyMixer->audio_first_update; p; p = p->audio_next_update)
@@ -777,12 +1210,10 @@ void* AUDMNG_update_thread(void *arg)
 ////			p->update();
 ////		}
 
-		gettimeofday(&stop_ts, NULL);		
-
 		count++;
 		if ((count % 40) == 0)
 		{
-			period_time_us = AudioManager::get_instance()->get_period_time_us();
+			period_time_us = audio_manager->get_period_time_us();
 		
 			if (period_time_us < 1000)
 			{
@@ -791,16 +1222,15 @@ void* AUDMNG_update_thread(void *arg)
 				exit(1);
 			}			
 			
-			utilization = (int)(float(stop_ts.tv_usec - start_ts.tv_usec) / (float)period_time_us * 100.0);
-			//callback_update_utilization_bar(utilization);
-			//printf("time= %i\n", stopts.tv_usec - startts.tv_usec);
 			count = 0;
 		}
-
-		lockCount = 0;
-
 	}
 	
+	// Release the rendering workers
+	pthread_mutex_lock(&update_cycle_mutex);
+	render_pool->stop();
+	pthread_mutex_unlock(&update_cycle_mutex);
+	
 	return NULL;
 }
 
@@ -878,13 +1308,63 @@ void *AUDMNG_try_connect_jack(void *threadid) {
 	return NULL;
 }
 
+/**
+*   @brief  Request update cycles from the audio update thread.
+*   @param  num_of_cycles	number of cycles to add to the pending cycles
+*	@param	max_pending		the pending cycles are limited to this number
+*	@param	wait			true - block on the update thread mutex; false - give up if it is busy
+*							(real-time callbacks)
+*   @return the number of cycles that were pending before the request; -1 if not requested
+*/
+int AUDMNG_request_update_cycles(int num_of_cycles, int max_pending, bool wait)
+{
+	int pending;
+	
+	if (wait)
+	{
+		pthread_mutex_lock(&update_thread_mutex);
+	}
+	else if (pthread_mutex_trylock(&update_thread_mutex) != 0)
+	{
+		return -1;
+	}
+	
+	pending = update_cycles_pending;
+	update_cycles_pending += num_of_cycles;
+	if (update_cycles_pending > max_pending)
+	{
+		update_cycles_pending = max_pending;
+	}
+	
+	// Signal update thread
+	pthread_cond_signal(&update_thread_cv);
+	pthread_mutex_unlock(&update_thread_mutex);
+	
+	return pending;
+}
+
+/**
+*   @brief  Periodic update timer thread: paces the update cycles when the audio driver
+*			is not driving them (ALSA, headless runs).
+*			Sleeps to absolute deadlines on CLOCK_MONOTONIC, so the processing time and the
+*			wake-up jitter do not accumulate. The period is derived from the sample-rate and
+*			block size in nSec, so it does not drift by the period uSec rounding either.
+*   @param  threadid	not in use
+*   @return void*
+*/
 void *AUDMNG_periodic_update_timer_thread(void *threadid)
 {
+	AudioManager *audio_manager = AudioManager::get_instance();
 	unsigned long period_time_us;
+	long long period_ns, late_ns;
+	struct timespec deadline, now;
+	int missed, pending, cycles, sample_rate;
+	
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
 	
 	while (periodic_update_timer_thread_is_running)
 	{
-		period_time_us = AudioManager::get_instance()->get_period_time_us();
+		period_time_us = audio_manager->get_period_time_us();
 		
 		if (period_time_us < 1000)
 		{
@@ -893,14 +1373,74 @@ void *AUDMNG_periodic_update_timer_thread(void *threadid)
 			exit(1);
 		}
 		
-		usleep(period_time_us);
+		sample_rate = audio_manager->get_sample_rate();
+		if (sample_rate > 0)
+		{
+			period_ns = ((long long)audio_manager->get_audio_block_size() * 1000000000LL) / sample_rate;
+		}
+		else
+		{
+			period_ns = 0;
+		}
+		
+		if (period_ns <= 0)
+		{
+			// Sample-rate or block size not set - use the uSec period
+			period_ns = (long long)period_time_us * 1000;
+		}
+		
+		// Next deadline
+		deadline.tv_nsec += period_ns;
+		while (deadline.tv_nsec >= 1000000000L)
+		{
+			deadline.tv_nsec -= 1000000000L;
+			deadline.tv_sec++;
+		}
+		
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR) ;
+		
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		late_ns = (now.tv_sec - deadline.tv_sec) * 1000000000LL + (now.tv_nsec - deadline.tv_nsec);
+		
+		// Number of whole periods passed since the deadline
+		missed = (late_ns > 0) ? (int)(late_ns / period_ns) : 0;
+		cycles = 1;
+		
+		if (missed > 0)
+		{
+			if (audio_manager->get_update_timer_catch_up_state() && (missed < _UPDATE_TIMER_MAX_CATCH_UP_CYCLES))
+			{
+				// Run the missed cycles too and stay on the original deadlines grid
+				cycles += missed;
+				deadline.tv_sec += (time_t)((missed * period_ns) / 1000000000LL);
+				deadline.tv_nsec += (long)((missed * period_ns) % 1000000000LL);
+				if (deadline.tv_nsec >= 1000000000L)
+				{
+					deadline.tv_nsec -= 1000000000L;
+					deadline.tv_sec++;
+				}
+			}
+			else
+			{
+				// Skip the missed cycles - resynchronize to now
+				deadline = now;
+			}
+		}
 
 		// Triger update process
-		if (pthread_mutex_trylock(&update_thread_mutex) == 0)
+		pending = AUDMNG_request_update_cycles(cycles, 
+			audio_manager->get_update_timer_catch_up_state() ? _UPDATE_TIMER_MAX_CATCH_UP_CYCLES : 1, 
+			true);
+		
+		if (pending > 0)
+		{
+			// The previous cycle was not started on time (update thread overrun)
+			missed++;
+		}
+		
+		if (missed > 0)
 		{
-			// Signal update thread
-			pthread_cond_signal(&update_thread_cv);
-			pthread_mutex_unlock(&update_thread_mutex);
+			audio_manager->add_update_timer_missed_deadlines(missed);
 		}
 	}
 
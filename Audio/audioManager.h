@@ -46,6 +46,7 @@ public:
 	static AudioManager *get_instance();
 	
 	int create_audio_shared_memory(int seed);
+	int create_audio_output_direct_buffer();
 	
 	AudioVoiceFloat *get_audio_voice(int voice_num = 0);
 	
@@ -77,6 +78,12 @@ public:
 	int start_update_process_periodic_timer();
 	int stop_update_process_periodic_timer();
 	
+	void set_update_timer_catch_up_state(bool state);
+	bool get_update_timer_catch_up_state();
+	unsigned long get_update_timer_missed_deadlines();
+	void reset_update_timer_missed_deadlines();
+	void add_update_timer_missed_deadlines(int missed);
+	
 	void callback_audio_update_cycle_start_tasks(int param);
 	void register_callback_audio_update_cycle_start_tasks(func_ptr_void_int_t ptr);
 	
@@ -85,6 +92,35 @@ public:
 	
 	void callback_audio_update_cycle_end_tasks(int param);
 	void register_callback_audio_update_cycle_end_tasks(func_ptr_void_int_t ptr);
+	
+	int callback_audio_voice_core(int voice_num);
+	void register_callback_audio_voice_core(func_ptr_int_int_t ptr);
+	
+	int set_multi_core_voices_rendering_state(bool state);
+	bool get_multi_core_voices_rendering_state();
+	bool voices_render_pool_is_available();
+	
+	int set_num_of_render_cores(int num);
+	int get_num_of_render_cores();
+	
+	void set_audio_blocks_arena_state(bool state);
+	bool get_audio_blocks_arena_state();
+	
+	void set_jack_direct_output_state(bool state);
+	bool get_jack_direct_output_state();
+	bool jack_direct_output_is_active();
+	
+	void set_jack_render_in_callback_state(bool state);
+	bool get_jack_render_in_callback_state();
+	bool jack_render_in_callback_is_active();
+	
+	int get_audio_driver_type();
+	
+	void update_voices_render_pool(bool pin_caller);
+	void update_voices_render_pool_in_callback_mode();
+	void run_audio_update_cycle();
+	int run_audio_update_cycle_in_callback();
+	int run_offline_update_cycle();
 
 	//	AlsaLibHandle alsa_handler;
 	
@@ -106,11 +142,15 @@ public:
 	
 	shared_memory_audio_block_float_stereo_struct_t *audio_block_stereo_float_shared_memory_outputs;
 	
+	// Stereo output triple buffer read directly by the JACK process callback
+	audio_output_triple_buffer_t *audio_output_direct_buffer;
+	
 	AudioConnectionsManagerFloat *connections_manager;
 	
 	static func_ptr_void_int_t callback_audio_update_cycle_start_tasks_ptr;
 	static func_ptr_void_int_t callback_audio_voice_update_ptr;
 	static func_ptr_void_int_t callback_audio_update_cycle_end_tasks_ptr;
+	static func_ptr_int_int_t callback_audio_voice_core_ptr;
 	
 	
 private:
@@ -140,6 +180,25 @@ private:
 
 	bool audio_service_started;
 	
+	/* When true, voices are rendered in parallel by the AudioVoiceRenderPool workers */
+	bool multi_core_voices_rendering;
+	/* When true, the render workers could not be started and voices are rendered serially */
+	bool voices_render_pool_unavailable;
+	/* Number of cores voices are rendered on in multi-core mode */
+	int num_of_render_cores;
+	/* When true, audio blocks are allocated from a per update cycle arena */
+	bool audio_blocks_arena;
+	/* When true, the output is handed to the JACK callback through the direct output triple buffer */
+	bool jack_direct_output;
+	/* Active audio driver - _AUDIO_JACK or _AUDIO_ALSA */
+	int audio_driver;
+	/* When true, the update cycle is run inside the JACK process callback */
+	bool jack_render_in_callback;
+	/* When true, cycles of missed update timer deadlines are run back to back */
+	bool update_timer_catch_up;
+	/* Number of update timer deadlines missed since last reset */
+	unsigned long update_timer_missed_deadlines;
+	
 };
 
 // Main thread running audio updates 
@@ -150,3 +209,5 @@ void *AUDMNG_run_alsa(void *threadid);
 void *AUDMNG_try_connect_jack(void *threadid);
 
 void *AUDMNG_periodic_update_timer_thread(void *threadid);
+
+int AUDMNG_request_update_cycles(int num_of_cycles, int max_pending, bool wait);
@@ -0,0 +1,150 @@
+/**
+*	@file		audioMixKernel.h
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0
+*
+*	@History	1.0	17-Oct-2026	1st version
+*
+*	@brief		Vectorized voice mixing kernel used by the poly-mixer.
+*
+*				Mixes a voice control sub-block (ch1 and ch2) into the Left, Right,
+*				send-Left and send-Right accumulators, using 8 gain coefficients that are
+*				constant over the sub-block.
+*				ARM NEON (Raspberry Pi) and SSE/AVX (x86) versions process 4/8 samples per
+*				instruction; a scalar loop handles the remaining samples and other targets.
+*				Buffers do not have to be aligned.
+*/
+
+#pragma once
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define _AUDIO_MIX_KERNEL_NEON
+#elif defined(__AVX__)
+#include <immintrin.h>
+#define _AUDIO_MIX_KERNEL_AVX
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#define _AUDIO_MIX_KERNEL_SSE
+#endif
+
+/* Mixing gain coefficients indexes */
+#define _MIX_GAIN_LEFT_1			0
+#define _MIX_GAIN_LEFT_2			1
+#define _MIX_GAIN_RIGHT_1			2
+#define _MIX_GAIN_RIGHT_2			3
+#define _MIX_GAIN_SEND_LEFT_1		4
+#define _MIX_GAIN_SEND_LEFT_2		5
+#define _MIX_GAIN_SEND_RIGHT_1		6
+#define _MIX_GAIN_SEND_RIGHT_2		7
+
+#define _MIX_NUM_OF_GAINS			8
+
+/**
+*   @brief  Accumulate a voice sub-block into the mixer outputs:
+*			out_L += in_1 * gain[LEFT_1] + in_2 * gain[LEFT_2] (and the same for R, send-L and send-R)
+*   @param  in_1	a pointer to the voice ch1 samples
+*   @param  in_2	a pointer to the voice ch2 samples
+*   @param  gain	an array of _MIX_NUM_OF_GAINS gain coefficients
+*   @param  out_L	a pointer to the Left accumulator
+*   @param  out_R	a pointer to the Right accumulator
+*   @param  send_L	a pointer to the send Left accumulator
+*   @param  send_R	a pointer to the send Right accumulator
+*   @param  size	number of samples
+*   @return void
+*/
+static inline void audio_mix_voice_sub_block(
+	const float *in_1,
+	const float *in_2,
+	const float *gain,
+	float *out_L,
+	float *out_R,
+	float *send_L,
+	float *send_R,
+	int size)
+{
+	int i = 0;
+
+#if defined(_AUDIO_MIX_KERNEL_NEON)
+	float32x4_t left_1 = vdupq_n_f32(gain[_MIX_GAIN_LEFT_1]);
+	float32x4_t left_2 = vdupq_n_f32(gain[_MIX_GAIN_LEFT_2]);
+	float32x4_t right_1 = vdupq_n_f32(gain[_MIX_GAIN_RIGHT_1]);
+	float32x4_t right_2 = vdupq_n_f32(gain[_MIX_GAIN_RIGHT_2]);
+	float32x4_t send_left_1 = vdupq_n_f32(gain[_MIX_GAIN_SEND_LEFT_1]);
+	float32x4_t send_left_2 = vdupq_n_f32(gain[_MIX_GAIN_SEND_LEFT_2]);
+	float32x4_t send_right_1 = vdupq_n_f32(gain[_MIX_GAIN_SEND_RIGHT_1]);
+	float32x4_t send_right_2 = vdupq_n_f32(gain[_MIX_GAIN_SEND_RIGHT_2]);
+	float32x4_t x1, x2;
+
+	for (; i + 4 <= size; i += 4)
+	{
+		x1 = vld1q_f32(in_1 + i);
+		x2 = vld1q_f32(in_2 + i);
+
+		vst1q_f32(out_L + i, vmlaq_f32(vmlaq_f32(vld1q_f32(out_L + i), x1, left_1), x2, left_2));
+		vst1q_f32(out_R + i, vmlaq_f32(vmlaq_f32(vld1q_f32(out_R + i), x1, right_1), x2, right_2));
+		vst1q_f32(send_L + i, vmlaq_f32(vmlaq_f32(vld1q_f32(send_L + i), x1, send_left_1), x2, send_left_2));
+		vst1q_f32(send_R + i, vmlaq_f32(vmlaq_f32(vld1q_f32(send_R + i), x1, send_right_1), x2, send_right_2));
+	}
+#elif defined(_AUDIO_MIX_KERNEL_AVX)
+	__m256 left_1 = _mm256_set1_ps(gain[_MIX_GAIN_LEFT_1]);
+	__m256 left_2 = _mm256_set1_ps(gain[_MIX_GAIN_LEFT_2]);
+	__m256 right_1 = _mm256_set1_ps(gain[_MIX_GAIN_RIGHT_1]);
+	__m256 right_2 = _mm256_set1_ps(gain[_MIX_GAIN_RIGHT_2]);
+	__m256 send_left_1 = _mm256_set1_ps(gain[_MIX_GAIN_SEND_LEFT_1]);
+	__m256 send_left_2 = _mm256_set1_ps(gain[_MIX_GAIN_SEND_LEFT_2]);
+	__m256 send_right_1 = _mm256_set1_ps(gain[_MIX_GAIN_SEND_RIGHT_1]);
+	__m256 send_right_2 = _mm256_set1_ps(gain[_MIX_GAIN_SEND_RIGHT_2]);
+	__m256 x1, x2;
+
+	for (; i + 8 <= size; i += 8)
+	{
+		x1 = _mm256_loadu_ps(in_1 + i);
+		x2 = _mm256_loadu_ps(in_2 + i);
+
+		_mm256_storeu_ps(out_L + i, _mm256_add_ps(_mm256_loadu_ps(out_L + i),
+			_mm256_add_ps(_mm256_mul_ps(x1, left_1), _mm256_mul_ps(x2, left_2))));
+		_mm256_storeu_ps(out_R + i, _mm256_add_ps(_mm256_loadu_ps(out_R + i),
+			_mm256_add_ps(_mm256_mul_ps(x1, right_1), _mm256_mul_ps(x2, right_2))));
+		_mm256_storeu_ps(send_L + i, _mm256_add_ps(_mm256_loadu_ps(send_L + i),
+			_mm256_add_ps(_mm256_mul_ps(x1, send_left_1), _mm256_mul_ps(x2, send_left_2))));
+		_mm256_storeu_ps(send_R + i, _mm256_add_ps(_mm256_loadu_ps(send_R + i),
+			_mm256_add_ps(_mm256_mul_ps(x1, send_right_1), _mm256_mul_ps(x2, send_right_2))));
+	}
+#elif defined(_AUDIO_MIX_KERNEL_SSE)
+	__m128 left_1 = _mm_set1_ps(gain[_MIX_GAIN_LEFT_1]);
+	__m128 left_2 = _mm_set1_ps(gain[_MIX_GAIN_LEFT_2]);
+	__m128 right_1 = _mm_set1_ps(gain[_MIX_GAIN_RIGHT_1]);
+	__m128 right_2 = _mm_set1_ps(gain[_MIX_GAIN_RIGHT_2]);
+	__m128 send_left_1 = _mm_set1_ps(gain[_MIX_GAIN_SEND_LEFT_1]);
+	__m128 send_left_2 = _mm_set1_ps(gain[_MIX_GAIN_SEND_LEFT_2]);
+	__m128 send_right_1 = _mm_set1_ps(gain[_MIX_GAIN_SEND_RIGHT_1]);
+	__m128 send_right_2 = _mm_set1_ps(gain[_MIX_GAIN_SEND_RIGHT_2]);
+	__m128 x1, x2;
+
+	for (; i + 4 <= size; i += 4)
+	{
+		x1 = _mm_loadu_ps(in_1 + i);
+		x2 = _mm_loadu_ps(in_2 + i);
+
+		_mm_storeu_ps(out_L + i, _mm_add_ps(_mm_loadu_ps(out_L + i),
+			_mm_add_ps(_mm_mul_ps(x1, left_1), _mm_mul_ps(x2, left_2))));
+		_mm_storeu_ps(out_R + i, _mm_add_ps(_mm_loadu_ps(out_R + i),
+			_mm_add_ps(_mm_mul_ps(x1, right_1), _mm_mul_ps(x2, right_2))));
+		_mm_storeu_ps(send_L + i, _mm_add_ps(_mm_loadu_ps(send_L + i),
+			_mm_add_ps(_mm_mul_ps(x1, send_left_1), _mm_mul_ps(x2, send_left_2))));
+		_mm_storeu_ps(send_R + i, _mm_add_ps(_mm_loadu_ps(send_R + i),
+			_mm_add_ps(_mm_mul_ps(x1, send_right_1), _mm_mul_ps(x2, send_right_2))));
+	}
+#endif
+
+	// Remaining samples
+	for (; i < size; i++)
+	{
+		out_L[i] += in_1[i] * gain[_MIX_GAIN_LEFT_1] + in_2[i] * gain[_MIX_GAIN_LEFT_2];
+		out_R[i] += in_1[i] * gain[_MIX_GAIN_RIGHT_1] + in_2[i] * gain[_MIX_GAIN_RIGHT_2];
+		send_L[i] += in_1[i] * gain[_MIX_GAIN_SEND_LEFT_1] + in_2[i] * gain[_MIX_GAIN_SEND_LEFT_2];
+		send_R[i] += in_1[i] * gain[_MIX_GAIN_SEND_RIGHT_1] + in_2[i] * gain[_MIX_GAIN_SEND_RIGHT_2];
+	}
+}
@@ -1,11 +1,13 @@
 /**
 *	@file		audioOutput.cpp
 *	@author		Nahum Budin
-*	@date		2-Oct-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion.
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Adding direct output triple buffer (handed to JACK with a single copy into the port buffer).
 *					
-*	@version	29-Jan-2021	1.1 
+*	@version	2-Oct-2024	1.2 
+*					1. Code refactoring and notaion.
+*				29-Jan-2021	1.1 
 *					1. Code refactoring and notaion.
 *					2. Adding bloc-size settings
 *				11-Nov-2019	1.0 revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 May 17, 2017.
@@ -17,8 +19,6 @@
 #include "audioManager.h"
 #include "../commonDefs.h"
 
-extern pthread_mutex_t voice_mem_blocks_allocation_control_mutex;
-
 AudioManager *_oaudio_manager = NULL;
 
 /**
@@ -42,6 +42,7 @@ AudioOutputFloat::AudioOutputFloat(
 			stage) 
 {
 	audio_block_stereo_float_shared_memory = shared_memory;
+	direct_output_buffer = NULL;
 	master_gain = 0.2f;
 	set_audio_block_size(block_size);
 }
@@ -98,9 +99,70 @@ float AudioOutputFloat::get_master_volume()
 	return master_gain;
 }
 
+/**
+*   @brief  Set the triple buffer the output is written into when the JACK direct output is active.
+*   @param  buffer	a pointer to an audio_output_triple_buffer_t; NULL - not used
+*   @return void
+*/
+void AudioOutputFloat::set_direct_output_buffer(audio_output_triple_buffer_t *buffer)
+{
+	direct_output_buffer = buffer;
+}
+
+/**
+*   @brief  Write the scaled input samples into the direct output writer buffer, then 
+*			publish it to the JACK process callback (the previously published buffer, 
+*			which is not being read, becomes the writer buffer).
+*   @param  in_L	left input block (NULL - silence)
+*   @param  in_R	right input block (NULL - silence)
+*   @return void
+*/
+void AudioOutputFloat::write_direct_output(audio_block_float_mono_t *in_L, audio_block_float_mono_t *in_R)
+{
+	int buf = direct_output_buffer->write_index;
+	float *out_L, *out_R;
+	int size = audio_block_size;
+	
+	if (size > (int)direct_output_buffer->size)
+	{
+		size = direct_output_buffer->size;
+	}
+	
+	out_L = direct_output_buffer->data[buf][_LEFT];
+	out_R = direct_output_buffer->data[buf][_RIGHT];
+	
+	if (in_L)
+	{
+		for (int i = 0; i < size; i++)
+		{
+			out_L[i] = in_L->data[i] * master_gain;
+		}
+	}
+	else
+	{
+		memset(out_L, 0, size * sizeof(float));
+	}
+	
+	if (in_R)
+	{
+		for (int i = 0; i < size; i++)
+		{
+			out_R[i] = in_R->data[i] * master_gain;
+		}
+	}
+	else
+	{
+		memset(out_R, 0, size * sizeof(float));
+	}
+	
+	direct_output_buffer->write_index = direct_output_buffer->published.exchange(
+		buf | _AUDIO_OUTPUT_BUFFER_NEW, std::memory_order_acq_rel) & _AUDIO_OUTPUT_BUFFER_INDEX_MASK;
+}
+
 /**
 *   @brief  Execute an update cycle - get input samples, process and 
-*			write it into the shared memory.
+*			write it into the shared memory, or into the direct output
+*			buffer when the JACK direct output is active.
 *   @param  none
 *   @return void
 */
@@ -112,6 +174,32 @@ void AudioOutputFloat::update(void) {
 
 	//	fprintf(stderr, "Update Output\n");
 	
+	if (direct_output_buffer && AudioManager::get_instance()->jack_direct_output_is_active())
+	{
+		in[_LEFT] = receive_audio_block_read_only(_LEFT);
+		in[_RIGHT] = receive_audio_block_read_only(_RIGHT);
+		
+		write_direct_output(in[_LEFT], in[_RIGHT]);
+		
+		if (in[_LEFT])
+		{		
+			release_audio_block(in[_LEFT]);
+		}
+		
+		if (in[_RIGHT])
+		{		
+			release_audio_block(in[_RIGHT]);
+		}
+		
+		return;
+	}
+	
+	if (direct_output_buffer)
+	{
+		// Output is transfered through the shared memory - a published block is not read later
+		direct_output_buffer->published.fetch_and(_AUDIO_OUTPUT_BUFFER_INDEX_MASK, std::memory_order_release);
+	}
+	
 	// Get input samples
 	in[_LEFT] = receive_audio_block_read_only(_LEFT);
 	if (in[_LEFT]) 
@@ -154,7 +242,6 @@ void AudioOutputFloat::update(void) {
 	//	if ((id % (int)(10000000/_PERIOD_TIME_USEC)) == 0)
 	//		printf("#transfers: %u  %i sec \n\r", id, (id / (1000000/_PERIOD_TIME_USEC)));
 
-	pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);	
 	if (in[_LEFT])
 	{		
 		release_audio_block(in[_LEFT]);
@@ -164,6 +251,5 @@ void AudioOutputFloat::update(void) {
 	{		
 		release_audio_block(in[_RIGHT]);
 	}			
-	pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 	//	fprintf(stderr, "RO %i\n", in[channel]->memory_pool_index);	
 }
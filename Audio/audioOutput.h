@@ -1,11 +1,13 @@
 /**
 *	@file		audioOutput.h
 *	@author		Nahum Budin
-*	@date		2-Oct-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion.
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Adding direct output triple buffer (handed to JACK with a single copy into the port buffer).
 *					
-*	@version	29-Jan-2021	1.1 
+*	@version	2-Oct-2024	1.2 
+*					1. Code refactoring and notaion.
+*				29-Jan-2021	1.1 
 *					1. Code refactoring and notaion.
 *					2. Adding bloc-size settings
 *				11-Nov-2019	1.0 revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 May 17, 2017.
@@ -32,6 +34,8 @@ public:
 	
 	void set_master_volume(float vol);
 	float get_master_volume();
+	
+	void set_direct_output_buffer(audio_output_triple_buffer_t *buffer);
 		
 	virtual void update(void);
 				
@@ -40,6 +44,11 @@ private:
 	audio_block_float_mono_t *input_queue_array[2];
 	// Shared memory for transfering data to audio driver
 	shared_memory_audio_block_float_stereo_struct_t *audio_block_stereo_float_shared_memory;
+	// Triple buffer for transfering data directly to the JACK process callback, which copies
+	// it once into the JACK port buffers (NULL if not used)
+	audio_output_triple_buffer_t *direct_output_buffer;
+	
+	void write_direct_output(audio_block_float_mono_t *in_L, audio_block_float_mono_t *in_R);
 
 	float master_gain;
 	
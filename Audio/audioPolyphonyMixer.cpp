@@ -8,6 +8,10 @@
 *					3. Adding midi maping mode settings (midi/sketch)
 *					4. Adding voice-status settings (null, not-active, wait-for-not-active, active)
 *					
+*	@version	1.2	17-Oct-2026
+*					1. Vectorized per control sub-block voices mixing.
+*					2. Packed voices states bitmasks.
+*					
 *	@version	1.0		11-Nov-2019 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 May 17, 2017)
 *
 *	@brief		Mix audio ch1 and ch2 of all voices into stereo Left and Right output signals 
@@ -15,12 +19,11 @@
 
 #include "audioPolyphonyMixer.h"
 #include "audioManager.h"
+#include "audioMixKernel.h"
 
 #include "../commonDefs.h"
 #include "../utils/utils.h"
 
-extern pthread_mutex_t voice_mem_blocks_allocation_control_mutex;
-
 AudioManager *poly_mixer_manager; // = AudioManager::get_instance();
 
 /* Used to set individual output level/pan for non program operation*/
@@ -29,8 +32,12 @@ float master_level_1, master_level_2, master_pan_1, master_pan_2, master_send_1,
 AudioPolyMixerFloat* AudioPolyMixerFloat::audio_poly_mixer_instance = NULL;
 int AudioPolyMixerFloat::inputs = 1;
 
-bool AudioPolyMixerFloat::voice_active[_SYNTH_MAX_NUM_OF_VOICES];
-bool AudioPolyMixerFloat::voice_wait_for_not_active[_SYNTH_MAX_NUM_OF_VOICES];
+#if (_SYNTH_MAX_NUM_OF_VOICES > 64)
+	Error - voices states masks are limited to 64 voices
+#endif
+
+std::atomic<uint64_t> AudioPolyMixerFloat::voice_active_mask(0);
+std::atomic<uint64_t> AudioPolyMixerFloat::voice_wait_for_not_active_mask(0);
 
 /* Used to set individual output level/pan for each program */
 float program_level_1[_SYNTH_MAX_NUM_OF_PROGRAMS], program_level_2[_SYNTH_MAX_NUM_OF_PROGRAMS];
@@ -91,10 +98,10 @@ AudioPolyMixerFloat::AudioPolyMixerFloat(int stage,
 		preserved_pan_2[i] = pan2[i];
 		preserved_send_1[i] = send1[i];
 		preserved_send_2[i] = send2[i];
-		
-		voice_active[i] = false;
-		voice_wait_for_not_active[i] = false;
 	}
+	
+	voice_active_mask.store(0);
+	voice_wait_for_not_active_mask.store(0);
 
 	master_level_1 = master_level_2 = 0.5f;
 	master_pan_1 = master_pan_2 = 0.f;
@@ -291,7 +298,7 @@ void AudioPolyMixerFloat::set_voice_active(int voice)
 {
 	if ((voice >= 0) && (voice < _SYNTH_MAX_NUM_OF_VOICES))
 	{
-		voice_active[voice] = true;
+		voice_active_mask.fetch_or(1ULL << voice);
 	}
 }
 
@@ -304,7 +311,7 @@ void AudioPolyMixerFloat::set_voice_not_active(int voice)
 {
 	if ((voice >= 0) && (voice < _SYNTH_MAX_NUM_OF_VOICES))
 	{
-		voice_active[voice] = false;
+		voice_active_mask.fetch_and(~(1ULL << voice));
 	}
 }
 
@@ -317,7 +324,7 @@ bool AudioPolyMixerFloat::voice_is_active(int voice)
 {
 	if ((voice >= 0) && (voice < _SYNTH_MAX_NUM_OF_VOICES))
 	{
-		return voice_active[voice];
+		return (voice_active_mask.load(std::memory_order_relaxed) >> voice) & 1;
 	}
 	else
 	{
@@ -325,6 +332,17 @@ bool AudioPolyMixerFloat::voice_is_active(int voice)
 	}
 }
 
+/**
+*   @brief  Returns a packed mask of the playing voices (active or waiting for not active)
+*	@param	none
+*   @return playing voices mask; bit n is set if voice n is playing
+*/
+uint64_t AudioPolyMixerFloat::get_playing_voices_mask()
+{
+	return voice_active_mask.load(std::memory_order_acquire) | 
+		voice_wait_for_not_active_mask.load(std::memory_order_acquire);
+}
+
 /**
 *   @brief  Set voice state to wait for not active
 *	@param	voice_num	voice number
@@ -334,7 +352,7 @@ void AudioPolyMixerFloat::set_voice_wait_for_not_active(int voice)
 {
 	if ((voice >= 0) && (voice < _SYNTH_MAX_NUM_OF_VOICES))
 	{
-		voice_wait_for_not_active[voice] = true;
+		voice_wait_for_not_active_mask.fetch_or(1ULL << voice);
 	}
 }
 
@@ -347,7 +365,7 @@ void AudioPolyMixerFloat::reset_voice_wait_for_not_active(int voice)
 {
 	if ((voice >= 0) && (voice < _SYNTH_MAX_NUM_OF_VOICES))
 	{
-		voice_wait_for_not_active[voice] = false;
+		voice_wait_for_not_active_mask.fetch_and(~(1ULL << voice));
 	}
 }
 
@@ -360,7 +378,7 @@ bool AudioPolyMixerFloat::voice_waits_for_not_active(int voice)
 {
 	if ((voice >= 0) && (voice < _SYNTH_MAX_NUM_OF_VOICES))
 	{
-		return voice_wait_for_not_active[voice];
+		return (voice_wait_for_not_active_mask.load(std::memory_order_relaxed) >> voice) & 1;
 	}
 	else
 	{
@@ -1571,11 +1589,14 @@ void AudioPolyMixerFloat::set_amp_2_pan_mod_lfo_level(int lev)
 void AudioPolyMixerFloat::update()
 {
 	audio_block_float_mono_t *block_out_L, *block_out_R, *block_send_L, *block_send_R;
-	int voice, i;
+	shared_memory_audio_block_float_stereo_struct_t *voice_output;
+	int voice, i, j, start, sub_block_size;
+	uint64_t playing_voices;
+	float voice_level;
+	float gain[_MIX_NUM_OF_GAINS];
 
 	float amp_1_pan_mod_samp[_AUDIO_MAX_BUF_SIZE / _CONTROL_SUB_SAMPLING + 1];
 	float amp_2_pan_mod_samp[_AUDIO_MAX_BUF_SIZE / _CONTROL_SUB_SAMPLING + 1];
-	int j;
 
 	for (j = 0; j < audio_block_size / _CONTROL_SUB_SAMPLING + 1; j++)
 	{
@@ -1585,21 +1606,14 @@ void AudioPolyMixerFloat::update()
 	if (active)
 	{
 		// Allocate output blocks
-		pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 		block_out_L = allocate_audio_block();
 		block_out_R = allocate_audio_block();
 		block_send_L = allocate_audio_block();
 		block_send_R = allocate_audio_block();
-		pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
-
-		float left_gain_1, left_gain_2, right_gain_1, right_gain_2;
-		float left_send_1, left_send_2, right_send_1, right_send_2;
-
 
 		if (!block_out_L || !block_out_R || !block_send_L || !block_send_R)
 		{
 			// unable to allocate memory, so we'll send nothing
-			pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 			if (block_out_L)
 			{
 				release_audio_block(block_out_L);
@@ -1617,119 +1631,72 @@ void AudioPolyMixerFloat::update()
 			{
 				release_audio_block(block_send_R);
 			}
-			pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 
 			return;
 		}
 
-		j = 0;
+		for (i = 0; i < audio_block_size; i++)
+		{
+			block_out_L->data[i] = 0;
+			block_out_R->data[i] = 0;
+			block_send_L->data[i] = 0;
+			block_send_R->data[i] = 0;
+		}
 		
-		// voice 0
-		if (voice_is_active(0) || voice_waits_for_not_active(0))
+		// Send levels are taken from voice 0 and are not modulated by the LFOs: same for all voices and sub-blocks
+		if (midi_mapping_mode == _MIDI_MAPPING_MODE_MAPPING)
 		{
-			for (i = 0; i < audio_block_size; i++) 
-			{
-				// Update modulation factors
-				if ((i % _CONTROL_SUB_SAMPLING) == 0)
-				{
-					left_gain_1 = *gain1[0] * (1 - *pan1[0]) * (1 - amp_1_pan_mod_samp[j]) * master_level_1 * 0.1f;
-					left_gain_2 = *gain2[0] * (1 - *pan2[0]) * (1 - amp_2_pan_mod_samp[j]) * master_level_2 * 0.1f;
-					right_gain_1 = *gain1[0] * (1 + *pan1[0]) * (1 + amp_1_pan_mod_samp[j]) * master_level_1 * 0.1f;
-					right_gain_2 = *gain2[0] * (1 + *pan2[0]) * (1 + amp_2_pan_mod_samp[j]) * master_level_2 * 0.1f;
-
-					if (midi_mapping_mode == _MIDI_MAPPING_MODE_MAPPING)
-					{
-						left_send_1 = *send1[0] * (1 - *pan1[0]) * (1 - amp_1_pan_mod) * master_level_1 * 0.1f;
-						left_send_2 = *send2[0] * (1 - *pan2[0]) * (1 - amp_2_pan_mod) * master_level_2 * 0.1f;
-						right_send_1 = *send1[0] * (1 + *pan1[0]) * (1 + amp_1_pan_mod) * master_send_1 * 0.1f;
-						right_send_2 = *send2[0] * (1 + *pan2[0]) * (1 + amp_2_pan_mod) * master_send_2 * 0.1f;
-					}
-					else
-					{
-						left_send_1 = master_send_1 * (1 - master_pan_1) * (1 - amp_1_pan_mod) * 0.1f;
-						left_send_2 = master_send_2 * (1 - master_pan_2) * (1 - amp_2_pan_mod) * 0.1f;
-						right_send_1 = master_send_1 * (1 + master_pan_1) * (1 + amp_1_pan_mod) * 0.1f;
-						right_send_2 = master_send_2 * (1 + master_pan_2) * (1 + amp_2_pan_mod) * 0.1f;
-					}
-					
-					j++;
-				}
-				
-				block_out_L->data[i] =
-					poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[0]->data[_LEFT][i] * left_gain_1 +
-					poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[0]->data[_RIGHT][i] * left_gain_2;
-				block_out_R->data[i] =
-					poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[0]->data[_LEFT][i] * right_gain_1 +
-					poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[0]->data[_RIGHT][i] * right_gain_2;
-
-				block_send_L->data[i] =
-					poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[0]->data[_LEFT][i] * left_send_1 +
-					poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[0]->data[_RIGHT][i] * left_send_2;
-				block_send_R->data[i] =
-					poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[0]->data[_LEFT][i] * right_send_1 +
-					poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[0]->data[_RIGHT][i] * right_send_2;
-			}
+			gain[_MIX_GAIN_SEND_LEFT_1] = *send1[0] * (1 - *pan1[0]) * (1 - amp_1_pan_mod) * master_level_1 * 0.1f;
+			gain[_MIX_GAIN_SEND_LEFT_2] = *send2[0] * (1 - *pan2[0]) * (1 - amp_2_pan_mod) * master_level_2 * 0.1f;
+			gain[_MIX_GAIN_SEND_RIGHT_1] = *send1[0] * (1 + *pan1[0]) * (1 + amp_1_pan_mod) * master_send_1 * 0.1f;
+			gain[_MIX_GAIN_SEND_RIGHT_2] = *send2[0] * (1 + *pan2[0]) * (1 + amp_2_pan_mod) * master_send_2 * 0.1f;
 		}
 		else
 		{
-			// voice not active - zero values output
-			for (i = 0; i < audio_block_size; i++)
-			{
-				block_out_L->data[i] = 0;
-				block_out_R->data[i] = 0;
-				block_send_L->data[i] = 0;
-				block_send_R->data[i] = 0;
-			}
+			gain[_MIX_GAIN_SEND_LEFT_1] = master_send_1 * (1 - master_pan_1) * (1 - amp_1_pan_mod) * 0.1f;
+			gain[_MIX_GAIN_SEND_LEFT_2] = master_send_2 * (1 - master_pan_2) * (1 - amp_2_pan_mod) * 0.1f;
+			gain[_MIX_GAIN_SEND_RIGHT_1] = master_send_1 * (1 + master_pan_1) * (1 + amp_1_pan_mod) * 0.1f;
+			gain[_MIX_GAIN_SEND_RIGHT_2] = master_send_2 * (1 + master_pan_2) * (1 + amp_2_pan_mod) * 0.1f;
+		}
+		
+		// Accumulate the active (or waiting for not active) voices only
+		playing_voices = get_playing_voices_mask();
+		if (inputs < 64)
+		{
+			playing_voices &= (1ULL << inputs) - 1;
 		}
 		
-		// All other voices: accumulate samples values to voice[0] samples or to 0 if voice[0] was not active.
-		for (voice = 1; voice < inputs; voice++)
+		while (playing_voices)
 		{
-			j = 0;
-			if (voice_is_active(voice) || voice_waits_for_not_active(voice))
+			voice = __builtin_ctzll(playing_voices);
+			playing_voices &= playing_voices - 1;
+			
+			voice_output = poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[voice];
+			voice_level = (voice == 0) ? 0.1f : 0.2f;
+			
+			for (start = 0, j = 0; start < audio_block_size; start += _CONTROL_SUB_SAMPLING, j++)
 			{
-				for (i = 0; i < audio_block_size; i++)
+				sub_block_size = audio_block_size - start;
+				if (sub_block_size > _CONTROL_SUB_SAMPLING)
 				{
-					// Update modulation factors
-					if ((i % _CONTROL_SUB_SAMPLING) == 0)
-					{
-						left_gain_1 = *gain1[voice] * (1 - *pan1[voice]) * (1 - amp_1_pan_mod_samp[j]) * master_level_1 * 0.2f;
-						left_gain_2 = *gain2[voice] * (1 - *pan2[voice]) * (1 - amp_2_pan_mod_samp[j]) * master_level_2 * 0.2f;
-						right_gain_1 = *gain1[voice] * (1 + *pan1[voice]) * (1 + amp_1_pan_mod_samp[j]) * master_level_1 * 0.2f;
-						right_gain_2 = *gain2[voice] * (1 + *pan2[voice]) * (1 + amp_2_pan_mod_samp[j]) * master_level_2 * 0.2f;
-
-						if (midi_mapping_mode == _MIDI_MAPPING_MODE_MAPPING)
-						{
-							left_send_1 = *send1[0] * (1 - *pan1[0]) * (1 - amp_1_pan_mod) * master_level_1 * 0.1f;
-							left_send_2 = *send2[0] * (1 - *pan2[0]) * (1 - amp_2_pan_mod) * master_level_2 * 0.1f;
-							right_send_1 = *send1[0] * (1 + *pan1[0]) * (1 + amp_1_pan_mod) * master_send_1 * 0.1f;
-							right_send_2 = *send2[0] * (1 + *pan2[0]) * (1 + amp_2_pan_mod) * master_send_2 * 0.1f;
-						}
-						else
-						{
-							left_send_1 = master_send_1 * (1 - master_pan_1) * (1 - amp_1_pan_mod) * 0.1f;
-							left_send_2 = master_send_2 * (1 - master_pan_2) * (1 - amp_2_pan_mod) * 0.1f;
-							right_send_1 = master_send_1 * (1 + master_pan_1) * (1 + amp_1_pan_mod) * 0.1f;
-							right_send_2 = master_send_2 * (1 + master_pan_2) * (1 + amp_2_pan_mod) * 0.1f;
-						}
-
-						j++;
-					}
-					
-					block_out_L->data[i] +=
-						poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[voice]->data[_LEFT][i] * left_gain_1 +
-						poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[voice]->data[_RIGHT][i] * left_gain_2;
-					block_out_R->data[i] +=
-						poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[voice]->data[_LEFT][i] * right_gain_1 +
-						poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[voice]->data[_RIGHT][i] * right_gain_2;
-
-					block_send_L->data[i] +=
-						poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[voice]->data[_LEFT][i] * left_send_1 +
-						poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[voice]->data[_RIGHT][i] * left_send_2;
-					block_send_R->data[i] +=
-						poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[voice]->data[_LEFT][i] * right_send_1 +
-						poly_mixer_manager->audio_block_stereo_float_shared_memory_voices_output[voice]->data[_RIGHT][i] * right_send_2;
+					sub_block_size = _CONTROL_SUB_SAMPLING;
 				}
+				
+				// Update modulation factors
+				gain[_MIX_GAIN_LEFT_1] = *gain1[voice] * (1 - *pan1[voice]) * (1 - amp_1_pan_mod_samp[j]) * master_level_1 * voice_level;
+				gain[_MIX_GAIN_LEFT_2] = *gain2[voice] * (1 - *pan2[voice]) * (1 - amp_2_pan_mod_samp[j]) * master_level_2 * voice_level;
+				gain[_MIX_GAIN_RIGHT_1] = *gain1[voice] * (1 + *pan1[voice]) * (1 + amp_1_pan_mod_samp[j]) * master_level_1 * voice_level;
+				gain[_MIX_GAIN_RIGHT_2] = *gain2[voice] * (1 + *pan2[voice]) * (1 + amp_2_pan_mod_samp[j]) * master_level_2 * voice_level;
+				
+				audio_mix_voice_sub_block(
+					&voice_output->data[_LEFT][start],
+					&voice_output->data[_RIGHT][start],
+					gain,
+					&block_out_L->data[start],
+					&block_out_R->data[start],
+					&block_send_L->data[start],
+					&block_send_R->data[start],
+					sub_block_size);
 			}
 		}
 		// Recording TODO:
@@ -1753,12 +1720,10 @@ void AudioPolyMixerFloat::update()
 		transmit_audio_block(block_out_R, _RIGHT);
 		transmit_audio_block(block_send_L, _SEND_LEFT);
 		transmit_audio_block(block_send_R, _SEND_RIGHT);
-		pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 		release_audio_block(block_out_L);
 		release_audio_block(block_out_R);
 		release_audio_block(block_send_L);
 		release_audio_block(block_send_R);
-		pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 	}
 }
 
@@ -8,6 +8,10 @@
 *					3. Adding midi maping mode settings (midi/sketch)
 *					4. Adding voice-status settings (null, not-active, wait-for-not-active, active)
 *					
+*	@version	1.2	17-Oct-2026
+*					1. Vectorized per control sub-block voices mixing.
+*					2. Packed voices states bitmasks.
+*					
 *	@version	1.0		11-Nov-2019 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 May 17, 2017)
 *
 *	@brief		Mix audio ch1 and ch2 of all voices into stereo Left and Right output signals 
@@ -15,6 +19,9 @@
 
 #pragma once
 
+#include <stdint.h>
+#include <atomic>
+
 #include "audioBlock.h"
 #include "../DSP/dspOsc.h"		// for LFOs
 #include "../LibAPI/synthesizer.h"
@@ -60,6 +67,8 @@ public:
 	static void set_voice_wait_for_not_active(int voice);
 	static void reset_voice_wait_for_not_active(int voice);
 	static bool voice_waits_for_not_active(int voice);
+	
+	static uint64_t get_playing_voices_mask();
 
 	void set_active();
 
@@ -193,8 +202,9 @@ private:
 	
 	int audio_block_size;
 	int midi_mapping_mode;
-	static bool voice_active[_SYNTH_MAX_NUM_OF_VOICES];
-	static bool voice_wait_for_not_active[_SYNTH_MAX_NUM_OF_VOICES];
+	/* Voices states packed bitmasks: bit n is voice n state */
+	static std::atomic<uint64_t> voice_active_mask;
+	static std::atomic<uint64_t> voice_wait_for_not_active_mask;
 
 	static AudioPolyMixerFloat* audio_poly_mixer_instance;
 };
@@ -18,8 +18,6 @@
 #include "audioReverb.h"
 #include "../utils/utils.h"
 
-extern pthread_mutex_t voice_mem_blocks_allocation_control_mutex;
-
 /**
 *   @brief  Create an AudioReverb object instance.
 *   @param	audio_first_update_ptr  a pointer to an audio block object instance
@@ -128,9 +126,7 @@ void AudioReverb::update(void)
 	in_block_R = receive_audio_block_read_only(_RIGHT);
 	if (!in_block_R)
 	{
-		pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 		release_audio_block(in_block_L);
-		pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 		return;
 	}
 
@@ -139,35 +135,25 @@ void AudioReverb::update(void)
 		// Both reverb models are disabled - Pass through
 		transmit_audio_block(in_block_L, _LEFT);
 		transmit_audio_block(in_block_R, _RIGHT);
-		pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 		release_audio_block(in_block_L);
 		release_audio_block(in_block_R);
-		pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 	}
 	else
 	{
-		pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 		out_block_L = allocate_audio_block();
 		out_block_R = allocate_audio_block();
-		pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 		if (!out_block_L || !out_block_R)
 		{
 			// one or all output blocks not allocated
-			pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 			release_audio_block(in_block_L);
 			release_audio_block(in_block_R);
-			pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 			if (out_block_L)
 			{
-				pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 				release_audio_block(out_block_L);
-				pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 			}
 			if (out_block_R)
 			{
-				pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 				release_audio_block(out_block_R);
-				pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 			}
 			return;
 		}
@@ -205,11 +191,9 @@ void AudioReverb::update(void)
 
 		transmit_audio_block(out_block_L, _LEFT);
 		transmit_audio_block(out_block_R, _RIGHT);
-		pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 		release_audio_block(out_block_L);
 		release_audio_block(out_block_R);
 		release_audio_block(in_block_L);
 		release_audio_block(in_block_R);
-		pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 	}
 }
@@ -1,8 +1,15 @@
 /**
 *	@file		audioVoice.cpp
 *	@author		Nahum Budin
-*	@date		1-Oct-2024
-*	@version	1.2 
+*	@date		17-Oct-2026
+*	@version	1.3
+*					1. Modulation profiling counters.
+*					2. Block based DSP voice rendering.
+*					3. Output level of the last block.
+*					4. Stolen voices fade out and load governor voices fade out.
+*					5. Free a pending stolen voice of a voice that ended.
+*					
+*	@version	1.2	1-Oct-2024
 *					1. Code refactoring and notaion.
 *					2. Adding callbacks to indicate activity changes (replacing direct objects calls)
 *					
@@ -14,15 +21,13 @@
 
 #include <mutex>
 #include <functional>
+#include <math.h>
 
 #include "audioVoice.h"
 //#include "audioPoliphonyMixer.h"
 #include "../commonDefs.h"
 //#include "../synthesizer/adjSynth.h"
 
-// Mutex to controll audio memory blocks allocation 
-extern pthread_mutex_t voice_mem_blocks_allocation_control_mutex;
-
 /**
 *   @brief  Create an AudioVoiceFloat object instance.
 *   @param  stage	audio update sequence stage number
@@ -58,6 +63,11 @@ AudioVoiceFloat::AudioVoiceFloat(
 	reset_voice_wait_for_not_active_callback_ptr = reset_voice_wait_for_not_active_clbk_ptr;
 	free_voice_callback_ptr = free_voice_clbk_ptr;
 	
+	output_level = 0.0f;
+	stolen_dsp_voice = NULL;
+	stolen_magnitude = 0.0f;
+	fade_out_requested = false;
+	
 	//	dsp_voice->register_voice_end_event_callback(std::mem_fn(&AudioVoiceFloat::set_inactive));
 	
 	set_sample_rate(samp_rate);
@@ -150,6 +160,8 @@ void AudioVoiceFloat::init_poly()
 	wait_for_not_active = false;
 	timestamp = 0;
 	note = -1;
+	// All the pooled DSP voices are freed by the synthesizer
+	stolen_dsp_voice = NULL;
 	if (dsp_voice)
 	{
 		dsp_voice->reset_wait_for_not_active();
@@ -191,6 +203,7 @@ void AudioVoiceFloat::set_voice_num(int v_num)
 void AudioVoiceFloat::set_active() 
 { 
 	active = true; 
+	fade_out_requested = false;
 	if (dsp_voice)
 	{
 		dsp_voice->set_voice_active();
@@ -373,6 +386,119 @@ float AudioVoiceFloat::get_magnitude()
 	return magnitude; 
 }
 
+/**
+*   @brief  Return the voice last block output peak level
+*   @param  none
+*   @return the last block output peak level (including the magnitude)
+*/
+float AudioVoiceFloat::get_output_level() 
+{ 
+	return output_level; 
+}
+
+/**
+*   @brief  Fade out a stolen voice: the stolen voice DSP voice (that is replaced by a new
+*			note DSP voice) is rendered and faded out over the 1st control block of the next
+*			block, to avoid a click. Its pooled DSP voice is freed when the fade out is done.
+*			If a previous stolen voice is still pending, the new one is freed with no fade out.
+*   @param  stolen_voice	a pointer to the stolen voice DSP voice
+*   @return void
+*/
+void AudioVoiceFloat::fade_out_stolen_voice(DSP_Voice *stolen_voice)
+{
+	if (stolen_voice == NULL)
+	{
+		return;
+	}
+	
+	if (stolen_dsp_voice != NULL)
+	{
+		stolen_voice->not_in_use();
+		return;
+	}
+	
+	stolen_magnitude = magnitude;
+	stolen_dsp_voice = stolen_voice;
+}
+
+/**
+*   @brief  Request to end the voice (e.g. polyphony governor voices cap reduction):
+*			the next block is faded out over its 1st control block and the voice is ended.
+*   @param  none
+*   @return void
+*/
+void AudioVoiceFloat::request_fade_out()
+{
+	if (active || wait_for_not_active)
+	{
+		fade_out_requested = true;
+	}
+}
+
+/**
+*   @brief  Return the fade out request state
+*   @param  none
+*   @return true if the voice is going to be faded out and ended
+*/
+bool AudioVoiceFloat::is_fade_out_requested() 
+{ 
+	return fade_out_requested; 
+}
+
+/**
+*   @brief  Add the stolen voice output, faded out over a control block, to the block
+*			1st control block samples, and free the stolen pooled DSP voice.
+*   @param  out_1	a pointer to the channel 1 output block
+*   @param  out_2	a pointer to the channel 2 output block
+*   @return void
+*/
+void AudioVoiceFloat::mix_stolen_voice_fade_out(float *out_1, float *out_2)
+{
+	float fade_1[_CONTROL_SUB_SAMPLING], fade_2[_CONTROL_SUB_SAMPLING];
+	DSP_Voice *stolen_voice = stolen_dsp_voice;
+	int i, size = audio_block_size < _CONTROL_SUB_SAMPLING ? audio_block_size : _CONTROL_SUB_SAMPLING;
+	float gain;
+	
+	stolen_dsp_voice = NULL;
+	
+	stolen_voice->render_fade_out_block(fade_1, fade_2, size);
+	
+	for (i = 0; i < size; i++)
+	{
+		gain = stolen_magnitude * (float)(size - 1 - i) / (float)(size - 1);
+		out_1[i] += fade_1[i] * gain;
+		out_2[i] += fade_2[i] * gain;
+	}
+	
+	// The stolen pooled DSP voice can now be bound to a new note
+	stolen_voice->not_in_use();
+}
+
+/**
+*   @brief  Fade out the block over its 1st control block; the rest of the block is silent.
+*   @param  out_1	a pointer to the channel 1 output block
+*   @param  out_2	a pointer to the channel 2 output block
+*   @return void
+*/
+void AudioVoiceFloat::apply_fade_out(float *out_1, float *out_2)
+{
+	int i, size = audio_block_size < _CONTROL_SUB_SAMPLING ? audio_block_size : _CONTROL_SUB_SAMPLING;
+	float gain;
+	
+	for (i = 0; i < size; i++)
+	{
+		gain = (float)(size - 1 - i) / (float)(size - 1);
+		out_1[i] *= gain;
+		out_2[i] *= gain;
+	}
+	
+	for (i = size; i < audio_block_size; i++)
+	{
+		out_1[i] = 0.0f;
+		out_2[i] = 0.0f;
+	}
+}
+
 /**
 *   @brief  Execute an update cycle - generate the voice audio block and 
 *			send it to next audio block stage.
@@ -382,70 +508,101 @@ float AudioVoiceFloat::get_magnitude()
 void AudioVoiceFloat::update()
 {
 	audio_block_float_mono_t *block_out1, *block_out2; 
-	volatile int i, j = 0;
-	float samp1, samp2;
+	DSP_Voice *voice_dsp = dsp_voice;
+	int i;
+	uint64_t start_ticks = 0;
+	float peak = 0.0f;
 	
 	// Verify
-	if (!dsp_voice)
+	if (!voice_dsp)
 	{	
 		return;
 	}
 	
 	if (!active)
 	{	
+		if (stolen_dsp_voice != NULL)
+		{
+			// The voice ended before the stolen voice was faded out - just free it
+			stolen_dsp_voice->not_in_use();
+			stolen_dsp_voice = NULL;
+		}
+		
 		return;
 	}
 	
 	// Get audio out blocks
-	pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 	block_out1 = allocate_audio_block();
 	block_out2 = allocate_audio_block();
-	pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 	if (!block_out1 || !block_out2) 
 	{
 		// unable to allocate memory, so we'll send nothing
 		if (block_out1)
 		{
 			// release if the only one
-			pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 			release_audio_block(block_out1);
-			pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 		}
 		if (block_out2)
 		{
 			// release if the only one
-			pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 			release_audio_block(block_out2);
-			pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
 		}
 		// Unfortuneatlly, that's it
 		return;
 	}
 
-	dsp_voice->calc_next_modulation_values();
+	// The DSP voice is kept locally: a voice that ends during the block is reassigned its own DSP voice
+	voice_dsp->begin_profile_block();
+	
+	if (voice_dsp->profiling_active)
+	{
+		start_ticks = AudioVoiceProfiler::get_ticks();
+	}
 
-	for (i = 0; i < audio_block_size; i++) 
+	voice_dsp->calc_next_modulation_values();
+	
+	if (voice_dsp->profiling_active)
 	{
-		// Update modulation factors - updated only every _CONTROL_SUB_SAMPLING samples
-		if ((i % _CONTROL_SUB_SAMPLING) == 0)
-		{
-			dsp_voice->calc_next_modulation_values();
-			dsp_voice->update_voice_modulation(voice_num);
-		}
+		voice_dsp->profile_mark(_VOICE_PROFILE_MODULE_MODULATION, start_ticks);
+	}
 
-		dsp_voice->calc_next_oscilators_output_value();
+	// Render the block; modulation factors are updated every _CONTROL_SUB_SAMPLING samples
+	voice_dsp->render_block(block_out1->data, block_out2->data, audio_block_size, voice_num);
 
-		// magnitude - Note scaled volume (see kbd)
+	// magnitude - Note scaled volume (see kbd)
+	for (i = 0; i < audio_block_size; i++) 
+	{
+		block_out1->data[i] *= magnitude;
+		block_out2->data[i] *= magnitude; 
+		peak = fmaxf(peak, fmaxf(fabsf(block_out1->data[i]), fabsf(block_out2->data[i])));
+	}
+	
+	output_level = peak;
+	
+	if (stolen_dsp_voice)
+	{
+		mix_stolen_voice_fade_out(block_out1->data, block_out2->data);
+	}
+	
+	if (fade_out_requested)
+	{
+		apply_fade_out(block_out1->data, block_out2->data);
+		fade_out_requested = false;
 		
-		block_out1->data[i] = dsp_voice->get_next_output_value_ch_1() * magnitude;
-		block_out2->data[i] = dsp_voice->get_next_output_value_ch_2() * magnitude; 
+		if (active)
+		{
+			voice_dsp->end_voice(voice_num);
+		}
 	}
+	
+	voice_dsp->end_profile_block();
 		
 	transmit_audio_block(block_out1, _SYNTH_VOICE_OUT_1);	
 	transmit_audio_block(block_out2, _SYNTH_VOICE_OUT_2);
-	pthread_mutex_lock(&voice_mem_blocks_allocation_control_mutex);
 	release_audio_block(block_out1);
 	release_audio_block(block_out2);
-	pthread_mutex_unlock(&voice_mem_blocks_allocation_control_mutex);
+	
+	// A voice that ended during the block can now be bound to a new note
+	voice_dsp->free_if_ended();
 }
 
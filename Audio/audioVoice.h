@@ -1,8 +1,12 @@
 /**
 *	@file		audioVoice.h
 *	@author		Nahum Budin
-*	@date		1-Oct-2024
-*	@version	1.1 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Output level of the last block.
+*					2. Stolen voices fade out and load governor voices fade out.
+*					
+*	@version	1.2	1-Oct-2024 
 *					1. Code refactoring and notaion.
 *					2. Adding callbacks to indicate activity changes (replacing direct objects calls)
 *					
@@ -77,6 +81,12 @@ public:
 	void set_magnitude(float mag);
 	float get_magnitude();
 	
+	float get_output_level();
+	
+	void fade_out_stolen_voice(DSP_Voice *stolen_voice);
+	void request_fade_out();
+	bool is_fade_out_requested();
+	
 	virtual void update(void);
 	
 private:
@@ -93,6 +103,17 @@ private:
 	int note;
 	/* Last activation time [us] - elapsed time from program start */
 	uint64_t timestamp;
+	/* Last block output peak level (including magnitude) */
+	float output_level;
+	
+	/* A stolen voice DSP voice that is faded out over the 1st control block of the next block */
+	DSP_Voice *stolen_dsp_voice;
+	float stolen_magnitude;
+	/* When true, the voice is faded out over the 1st control block of the next block and ended */
+	bool fade_out_requested;
+	
+	void mix_stolen_voice_fade_out(float *out_1, float *out_2);
+	void apply_fade_out(float *out_1, float *out_2);
 	
 	int sample_rate, audio_block_size;
 	
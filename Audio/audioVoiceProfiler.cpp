@@ -0,0 +1,315 @@
+/**
+*	@file		audioVoiceProfiler.cpp
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0
+*
+*	@History	1.0	17-Oct-2026	1st version
+*
+*	@brief		Voices rendering profiling counters.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "audioVoiceProfiler.h"
+#include "audioBlock.h"
+
+#if (_VOICE_PROFILE_NUM_OF_STAGES != _MAX_STAGE_NUM)
+	Error - _VOICE_PROFILE_NUM_OF_STAGES must be equal to _MAX_STAGE_NUM
+#endif
+
+/* A pointer to the singleton AudioVoiceProfiler instance */
+AudioVoiceProfiler *AudioVoiceProfiler::voice_profiler_instance = NULL;
+
+std::atomic<bool> AudioVoiceProfiler::profiling_enabled(false);
+
+AudioVoiceProfiler::_thread_counters_t AudioVoiceProfiler::threads_counters[_VOICE_PROFILE_MAX_NUM_OF_THREADS];
+
+/* The counters table slot owned by a thread; released when the thread exits */
+struct voice_profiler_thread_slot
+{
+	int slot = -1;
+	bool claimed = false;
+	std::atomic<bool> *slot_in_use = NULL;
+
+	~voice_profiler_thread_slot()
+	{
+		if (slot_in_use)
+		{
+			slot_in_use->store(false, std::memory_order_release);
+		}
+	}
+};
+
+static thread_local voice_profiler_thread_slot profiler_thread_slot;
+
+/**
+*   @brief  Create and return a pointer to the singleton AudioVoiceProfiler instance.
+*   @param  none
+*   @return a pointer to the singleton AudioVoiceProfiler instance
+*/
+AudioVoiceProfiler *AudioVoiceProfiler::get_instance()
+{
+	if (!voice_profiler_instance)
+	{
+		voice_profiler_instance = new AudioVoiceProfiler();
+	}
+
+	return voice_profiler_instance;
+}
+
+/**
+*   @brief  Create an AudioVoiceProfiler object instance.
+*   @param  none
+*   @return none
+*/
+AudioVoiceProfiler::AudioVoiceProfiler()
+{
+	voice_profiler_instance = this;
+
+	ticks_frequency = calibrate_ticks_frequency();
+
+	reset_stats();
+}
+
+/**
+*   @brief  Returns the CPU timer ticks frequency.
+*			On x86 the TSC is measured against the raw monotonic clock for 10mSec.
+*   @param  none
+*   @return ticks frequency [Hz]
+*/
+uint64_t AudioVoiceProfiler::calibrate_ticks_frequency()
+{
+#if defined(__aarch64__)
+	uint64_t freq;
+	asm volatile("mrs %0, cntfrq_el0" : "=r"(freq));
+	return freq;
+#elif defined(__x86_64__) || defined(__i386__)
+	struct timespec start_ts, stop_ts, sleep_ts = { 0, 10000000 };
+	uint64_t start_ticks, stop_ticks;
+	long long elapsed_ns;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &start_ts);
+	start_ticks = get_ticks();
+	nanosleep(&sleep_ts, NULL);
+	clock_gettime(CLOCK_MONOTONIC_RAW, &stop_ts);
+	stop_ticks = get_ticks();
+
+	elapsed_ns = (long long)(stop_ts.tv_sec - start_ts.tv_sec) * 1000000000LL +
+		(stop_ts.tv_nsec - start_ts.tv_nsec);
+	if (elapsed_ns <= 0)
+	{
+		return 1000000000ULL;
+	}
+
+	return (uint64_t)((double)(stop_ticks - start_ticks) * 1.0e9 / (double)elapsed_ns);
+#else
+	return 1000000000ULL;
+#endif
+}
+
+/**
+*   @brief  Enables or disables the voices profiling.
+*   @param  state	true - enabled; false - disabled
+*   @return void
+*/
+void AudioVoiceProfiler::set_profiling_state(bool state)
+{
+	profiling_enabled.store(state, std::memory_order_relaxed);
+}
+
+/**
+*   @brief  Returns the voices profiling enable state.
+*   @param  none
+*   @return true - enabled; false - disabled
+*/
+bool AudioVoiceProfiler::get_profiling_state()
+{
+	return is_enabled();
+}
+
+/**
+*   @brief  Returns the calling thread counters table; claims a free one on 1st call.
+*   @param  none
+*   @return a pointer to the thread counters table; NULL if all tables are in use
+*/
+AudioVoiceProfiler::_thread_counters_t *AudioVoiceProfiler::get_thread_counters()
+{
+	bool free_slot;
+
+	if (!profiler_thread_slot.claimed)
+	{
+		profiler_thread_slot.claimed = true;
+
+		for (int slot = 0; slot < _VOICE_PROFILE_MAX_NUM_OF_THREADS; slot++)
+		{
+			free_slot = false;
+			if (threads_counters[slot].in_use.compare_exchange_strong(free_slot, true, std::memory_order_acquire))
+			{
+				profiler_thread_slot.slot = slot;
+				profiler_thread_slot.slot_in_use = &threads_counters[slot].in_use;
+				break;
+			}
+		}
+
+		if (profiler_thread_slot.slot < 0)
+		{
+			fprintf(stderr, "Voices profiler: no free thread counters table; thread is not profiled\n");
+		}
+	}
+
+	if (profiler_thread_slot.slot < 0)
+	{
+		return NULL;
+	}
+
+	return &threads_counters[profiler_thread_slot.slot];
+}
+
+/**
+*   @brief  Adds a voice stage chain audio block update time to the calling thread counters.
+*   @param  voice	voice number
+*   @param  stage	audio update stage
+*   @param  ticks	update time [ticks]
+*   @return void
+*/
+void AudioVoiceProfiler::add_stage_ticks(int voice, int stage, uint64_t ticks)
+{
+	_thread_counters_t *counters = get_thread_counters();
+	std::atomic<uint64_t> *counter;
+
+	if (!counters || (voice < 0) || (voice >= _SYNTH_MAX_NUM_OF_VOICES) ||
+		(stage < 0) || (stage >= _VOICE_PROFILE_NUM_OF_STAGES))
+	{
+		return;
+	}
+
+	// Single writer: a plain load and store is enough
+	counter = &counters->stage_ticks[voice][stage];
+	counter->store(counter->load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+}
+
+/**
+*   @brief  Adds a voice DSP sub-modules times, accumulated over a block, to the calling thread counters.
+*   @param  voice			voice number
+*   @param  modules_ticks	an array of _VOICE_PROFILE_NUM_OF_MODULES modules times [ticks]
+*   @return void
+*/
+void AudioVoiceProfiler::add_modules_ticks(int voice, uint64_t *modules_ticks)
+{
+	_thread_counters_t *counters = get_thread_counters();
+	std::atomic<uint64_t> *counter;
+
+	if (!counters || !modules_ticks || (voice < 0) || (voice >= _SYNTH_MAX_NUM_OF_VOICES))
+	{
+		return;
+	}
+
+	for (int module = 0; module < _VOICE_PROFILE_NUM_OF_MODULES; module++)
+	{
+		counter = &counters->module_ticks[voice][module];
+		counter->store(counter->load(std::memory_order_relaxed) + modules_ticks[module], std::memory_order_relaxed);
+	}
+}
+
+/**
+*   @brief  Counts a profiled voice update cycle.
+*   @param  voice	voice number
+*   @return void
+*/
+void AudioVoiceProfiler::add_voice_update(int voice)
+{
+	_thread_counters_t *counters = get_thread_counters();
+	std::atomic<uint64_t> *counter;
+
+	if (!counters || (voice < 0) || (voice >= _SYNTH_MAX_NUM_OF_VOICES))
+	{
+		return;
+	}
+
+	counter = &counters->updates[voice];
+	counter->store(counter->load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+/**
+*   @brief  Sums all the threads counters tables.
+*   @param  sums	a pointer to a _voice_profile_stats_t struct to be filled (in ticks)
+*   @return void
+*/
+void AudioVoiceProfiler::sum_counters(_voice_profile_stats_t *sums)
+{
+	memset(sums, 0, sizeof(_voice_profile_stats_t));
+
+	for (int slot = 0; slot < _VOICE_PROFILE_MAX_NUM_OF_THREADS; slot++)
+	{
+		for (int voice = 0; voice < _SYNTH_MAX_NUM_OF_VOICES; voice++)
+		{
+			for (int stage = 0; stage < _VOICE_PROFILE_NUM_OF_STAGES; stage++)
+			{
+				sums->stage_ns[voice][stage] +=
+					threads_counters[slot].stage_ticks[voice][stage].load(std::memory_order_relaxed);
+			}
+
+			for (int module = 0; module < _VOICE_PROFILE_NUM_OF_MODULES; module++)
+			{
+				sums->module_ns[voice][module] +=
+					threads_counters[slot].module_ticks[voice][module].load(std::memory_order_relaxed);
+			}
+
+			sums->num_of_updates[voice] += threads_counters[slot].updates[voice].load(std::memory_order_relaxed);
+		}
+	}
+}
+
+/**
+*   @brief  Returns a snapshot of the profiling counters since the last reset.
+*   @param  stats	a pointer to a _voice_profile_stats_t struct to be filled
+*   @return 0 if done; -1 if stats is NULL
+*/
+int AudioVoiceProfiler::get_stats(_voice_profile_stats_t *stats)
+{
+	double ns_per_tick;
+
+	if (!stats)
+	{
+		return -1;
+	}
+
+	sum_counters(stats);
+
+	ns_per_tick = 1.0e9 / (double)ticks_frequency;
+
+	for (int voice = 0; voice < _SYNTH_MAX_NUM_OF_VOICES; voice++)
+	{
+		for (int stage = 0; stage < _VOICE_PROFILE_NUM_OF_STAGES; stage++)
+		{
+			stats->stage_ns[voice][stage] = (unsigned long long)((double)
+				(stats->stage_ns[voice][stage] - reset_baseline.stage_ns[voice][stage]) * ns_per_tick);
+		}
+
+		for (int module = 0; module < _VOICE_PROFILE_NUM_OF_MODULES; module++)
+		{
+			stats->module_ns[voice][module] = (unsigned long long)((double)
+				(stats->module_ns[voice][module] - reset_baseline.module_ns[voice][module]) * ns_per_tick);
+		}
+
+		stats->num_of_updates[voice] -= reset_baseline.num_of_updates[voice];
+	}
+
+	stats->ticks_frequency = ticks_frequency;
+
+	return 0;
+}
+
+/**
+*   @brief  Resets the profiling counters.
+*			The counters are owned by the rendering threads, so the current sums are kept
+*			as a baseline that is subtracted from the following snapshots.
+*   @param  none
+*   @return void
+*/
+void AudioVoiceProfiler::reset_stats()
+{
+	sum_counters(&reset_baseline);
+}
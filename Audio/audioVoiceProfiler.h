@@ -0,0 +1,115 @@
+/**
+*	@file		audioVoiceProfiler.h
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0
+*
+*	@History	1.0	17-Oct-2026	1st version
+*
+*	@brief		Voices rendering profiling counters.
+*
+*				Accumulates, for each voice, the processing time of each of its stages chains
+*				audio blocks update() and of each of its DSP_Voice sub-modules (oscillators,
+*				noise, Karplus-Strong, MSO, wavetable, filters, distortion and modulation).
+*
+*				Each thread that renders voices (render pool workers, the update thread or the
+*				JACK process callback) owns a counters table slot it is the only writer of, so
+*				no locks or read-modify-write atomics are used. Snapshots sum all the slots.
+*
+*				Time is measured in CPU timer ticks (cntvct_el0 on ARM64, TSC on x86) that are
+*				converted to nSec when a snapshot is taken.
+*
+*				When disabled (default) the enable flag is checked once per voice block, and
+*				no time is read.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "../LibAPI/audio.h"
+#include "../LibAPI/synthesizer.h"
+
+// Max number of threads that render voices at the same time (render pool workers, update thread, JACK callback)
+#define _VOICE_PROFILE_MAX_NUM_OF_THREADS	(_SYNTH_MAX_NUM_OF_CORES + 2)
+
+class AudioVoiceProfiler
+{
+public:
+
+	static AudioVoiceProfiler *get_instance();
+
+	void set_profiling_state(bool state);
+	bool get_profiling_state();
+
+	int get_stats(_voice_profile_stats_t *stats);
+	void reset_stats();
+
+	/**
+	*   @brief  Returns the profiling enable state (checked once per voice block).
+	*   @param  none
+	*   @return true if enabled
+	*/
+	static inline bool is_enabled()
+	{
+		return profiling_enabled.load(std::memory_order_relaxed);
+	}
+
+	/**
+	*   @brief  Returns the CPU timer ticks counter.
+	*   @param  none
+	*   @return ticks counter
+	*/
+	static inline uint64_t get_ticks()
+	{
+#if defined(__aarch64__)
+		uint64_t ticks;
+		asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+		return ticks;
+#elif defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+		return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+	}
+
+	static void add_stage_ticks(int voice, int stage, uint64_t ticks);
+	static void add_modules_ticks(int voice, uint64_t *modules_ticks);
+	static void add_voice_update(int voice);
+
+private:
+
+	AudioVoiceProfiler();
+
+	static AudioVoiceProfiler *voice_profiler_instance;
+
+	/* A thread counters table; written by the owning thread only */
+	typedef struct _thread_counters
+	{
+		std::atomic<bool> in_use;
+		std::atomic<uint64_t> stage_ticks[_SYNTH_MAX_NUM_OF_VOICES][_VOICE_PROFILE_NUM_OF_STAGES];
+		std::atomic<uint64_t> module_ticks[_SYNTH_MAX_NUM_OF_VOICES][_VOICE_PROFILE_NUM_OF_MODULES];
+		std::atomic<uint64_t> updates[_SYNTH_MAX_NUM_OF_VOICES];
+	} _thread_counters_t;
+
+	static _thread_counters_t *get_thread_counters();
+	static void sum_counters(_voice_profile_stats_t *sums);
+	static uint64_t calibrate_ticks_frequency();
+
+	static std::atomic<bool> profiling_enabled;
+
+	static _thread_counters_t threads_counters[_VOICE_PROFILE_MAX_NUM_OF_THREADS];
+
+	/* Counters sums at the last reset (in ticks) */
+	_voice_profile_stats_t reset_baseline;
+
+	uint64_t ticks_frequency;
+};
@@ -0,0 +1,553 @@
+/**
+*	@file		audioVoiceRenderPool.cpp
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.1
+*					1. Per-voice measured processing cost.
+*					2. Work stealing between the workers voices queues.
+*
+*	@History	1.0	17-Oct-2026	1st version
+*
+*	@brief		A pool of pinned real-time worker threads that renders the polyphonic
+*				voices in parallel, one worker per core.
+*/
+
+#include <sched.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "audioVoiceRenderPool.h"
+#include "audioManager.h"
+#include "audioBlock.h"
+#include "../Misc/priorities.h"
+
+/* Weight of a new measurement in the voice processing cost moving average */
+#define _VOICE_PROCESSING_COST_AVERAGING_FACTOR		0.0625f
+
+/* A pointer to the singleton AudioVoiceRenderPool instance */
+AudioVoiceRenderPool *AudioVoiceRenderPool::render_pool_instance = NULL;
+
+/**
+*   @brief  Create and return a pointer to the singleton AudioVoiceRenderPool instance.
+*   @param  none
+*   @return a pointer to the singleton AudioVoiceRenderPool instance
+*/
+AudioVoiceRenderPool *AudioVoiceRenderPool::get_instance()
+{
+	if (!render_pool_instance)
+	{
+		render_pool_instance = new AudioVoiceRenderPool();
+	}
+
+	return render_pool_instance;
+}
+
+/**
+*   @brief  Create an AudioVoiceRenderPool object instance.
+*   @param  none
+*   @return none
+*/
+AudioVoiceRenderPool::AudioVoiceRenderPool()
+{
+	render_pool_instance = this;
+
+	workers_running.store(false);
+	num_of_cores = 1;
+	
+	pthread_mutex_init(&workers_gate_mutex, NULL);
+	pthread_cond_init(&workers_gate_cv, NULL);
+	workers_gate_open = false;
+	pinned_thread_affinity_saved = false;
+
+	for (int voice = 0; voice < _SYNTH_MAX_NUM_OF_VOICES; voice++)
+	{
+		voice_processing_cost[voice].store(0, std::memory_order_relaxed);
+	}
+	
+	for (int core = 0; core < _SYNTH_MAX_NUM_OF_CORES; core++)
+	{
+		core_queue_range[core].store(0);
+	}
+}
+
+AudioVoiceRenderPool::~AudioVoiceRenderPool()
+{
+	if (workers_running)
+	{
+		stop();
+	}
+	
+	pthread_cond_destroy(&workers_gate_cv);
+	pthread_mutex_destroy(&workers_gate_mutex);
+}
+
+/**
+*   @brief  Start the voices rendering worker threads.
+*			Must not be called concurrently with an update cycle, and never from a real-time
+*			audio callback. The thread running the update cycles becomes the core 0 worker.
+*			If a worker thread cannot be created, the workers already created are stopped
+*			and the voices keep being rendered serially.
+*   @param  num_of_cores	number of cores to render the voices on (2 to _SYNTH_MAX_NUM_OF_CORES)
+*	@param	pin_caller		true - the caller is the thread running the update cycles: pin it
+*							to core 0 (its affinity is restored when stopped)
+*   @return 0 if OK; -1 otherwise
+*/
+int AudioVoiceRenderPool::start(int num_of_cores, bool pin_caller)
+{
+	int ret, core, policy;
+	pthread_attr_t tattr;
+	struct sched_param params;
+
+	if (workers_running)
+	{
+		return 0;
+	}
+
+	if ((num_of_cores < 2) || (num_of_cores > _SYNTH_MAX_NUM_OF_CORES))
+	{
+		return -1;
+	}
+
+	this->num_of_cores = num_of_cores;
+
+	// The update thread takes part in both barriers
+	pthread_barrier_init(&cycle_start_barrier, NULL, num_of_cores);
+	pthread_barrier_init(&cycle_end_barrier, NULL, num_of_cores);
+	
+	// Workers are held at the gate until all of them are created
+	pthread_mutex_lock(&workers_gate_mutex);
+	workers_gate_open = false;
+	pthread_mutex_unlock(&workers_gate_mutex);
+
+	// initialized with default attributes
+	ret = pthread_attr_init(&tattr);
+	// safe to get existing scheduling param
+	ret = pthread_attr_getschedparam(&tattr, &params);
+	// set the priority; others are unchanged
+	params.sched_priority = sched_get_priority_max(SCHED_RR) - _THREAD_PRIORITY_VOICE_RENDER;
+	ret = pthread_attr_setinheritsched(&tattr, PTHREAD_EXPLICIT_SCHED);
+	policy = SCHED_RR;
+	ret = pthread_attr_setschedpolicy(&tattr, policy);
+	// setting the new scheduling param
+	ret = pthread_attr_setschedparam(&tattr, &params);
+	if (ret != 0)
+	{
+		// Print the error
+		fprintf(stderr, "Voice render pool: Unsuccessful in setting render threads realtime prio\n");
+	}
+
+	workers_running = true;
+
+	for (core = 1; core < num_of_cores; core++)
+	{
+		worker_core[core] = core;
+		ret = pthread_create(&worker_thread_id[core], &tattr, AUDVRP_render_worker_thread, &worker_core[core]);
+		if (ret != 0)
+		{
+			// Probably not permitted to use realtime scheduling - run with inherited scheduling
+			ret = pthread_create(&worker_thread_id[core], NULL, AUDVRP_render_worker_thread, &worker_core[core]);
+		}
+		
+		if (ret != 0)
+		{
+			fprintf(stderr, "Voice render pool: Unsuccessful in creating render thread %i - rendering voices serially\n", core);
+			pthread_attr_destroy(&tattr);
+			release_started_workers(core - 1);
+			
+			return -1;
+		}
+
+		pthread_setname_np(worker_thread_id[core], "aud_vrp_render_thread");
+		set_thread_affinity(worker_thread_id[core], core);
+	}
+
+	pthread_attr_destroy(&tattr);
+	
+	if (pin_caller)
+	{
+		// Keep the update thread affinity, to be restored when stopped
+		pinned_thread_id = pthread_self();
+		pinned_thread_affinity_saved = 
+			pthread_getaffinity_np(pinned_thread_id, sizeof(cpu_set_t), &pinned_thread_saved_cpuset) == 0;
+		set_thread_affinity(pinned_thread_id, 0);
+	}
+	
+	pthread_mutex_lock(&workers_gate_mutex);
+	workers_gate_open = true;
+	pthread_cond_broadcast(&workers_gate_cv);
+	pthread_mutex_unlock(&workers_gate_mutex);
+
+	return 0;
+}
+
+/**
+*   @brief  Stop the voices rendering worker threads and wait for them to exit.
+*			Must not be called concurrently with an update cycle, and never from a real-time
+*			audio callback.
+*   @param  none
+*   @return 0
+*/
+int AudioVoiceRenderPool::stop()
+{
+	if (!workers_running)
+	{
+		return 0;
+	}
+
+	workers_running = false;
+
+	// Release the workers waiting for the next cycle; they see workers_running is false and exit.
+	pthread_barrier_wait(&cycle_start_barrier);
+
+	for (int core = 1; core < num_of_cores; core++)
+	{
+		pthread_join(worker_thread_id[core], NULL);
+	}
+
+	pthread_barrier_destroy(&cycle_start_barrier);
+	pthread_barrier_destroy(&cycle_end_barrier);
+
+	// Restore the update thread affinity it had before it was pinned
+	if (pinned_thread_affinity_saved)
+	{
+		pthread_setaffinity_np(pinned_thread_id, sizeof(cpu_set_t), &pinned_thread_saved_cpuset);
+		pinned_thread_affinity_saved = false;
+	}
+
+	num_of_cores = 1;
+
+	return 0;
+}
+
+/**
+*   @brief  Stop the workers created by start() before a worker thread creation failed.
+*			The workers are released from the gate without entering the cycle barriers.
+*   @param  num_of_started	number of workers created
+*   @return none
+*/
+void AudioVoiceRenderPool::release_started_workers(int num_of_started)
+{
+	workers_running = false;
+	
+	pthread_mutex_lock(&workers_gate_mutex);
+	workers_gate_open = true;
+	pthread_cond_broadcast(&workers_gate_cv);
+	pthread_mutex_unlock(&workers_gate_mutex);
+	
+	for (int core = 1; core <= num_of_started; core++)
+	{
+		pthread_join(worker_thread_id[core], NULL);
+	}
+	
+	pthread_barrier_destroy(&cycle_start_barrier);
+	pthread_barrier_destroy(&cycle_end_barrier);
+	
+	num_of_cores = 1;
+}
+
+/**
+*   @brief  Returns the workers running state.
+*   @param  none
+*   @return true if the rendering workers are running
+*/
+bool AudioVoiceRenderPool::is_running() { return workers_running; }
+
+/**
+*   @brief  Returns the number of cores voices are rendered on.
+*   @param  none
+*   @return number of cores voices are rendered on (1 when workers are not running)
+*/
+int AudioVoiceRenderPool::get_num_of_cores() { return num_of_cores; }
+
+/**
+*   @brief  Render all voices of one update cycle on all cores.
+*			Called by the thread running the update cycles; returns when all voices are rendered.
+*   @param  none
+*   @return none
+*/
+void AudioVoiceRenderPool::render_voices()
+{
+	int voice, core, pos;
+	int queue_length[_SYNTH_MAX_NUM_OF_CORES] = { 0 };
+	float cost;
+
+	// Queue the voices once per cycle so a voice allocated meanwhile is not rendered twice
+	for (voice = 0; voice < _SYNTH_MAX_NUM_OF_VOICES; voice++)
+	{
+		core = voice % num_of_cores;
+		if (AudioManager::callback_audio_voice_core_ptr)
+		{
+			core = AudioManager::callback_audio_voice_core_ptr(voice);
+			if (core < 0)
+			{
+				// Not playing
+				continue;
+			}
+			else if (core >= num_of_cores)
+			{
+				core = voice % num_of_cores;
+			}
+		}
+
+		// Insert sorted - heaviest first, so thieves take the lighter voices from the tail
+		cost = voice_processing_cost[voice].load(std::memory_order_relaxed);
+		pos = queue_length[core]++;
+		while ((pos > 0) && 
+			(voice_processing_cost[core_queue[core][pos - 1]].load(std::memory_order_relaxed) < cost))
+		{
+			core_queue[core][pos] = core_queue[core][pos - 1];
+			pos--;
+		}
+		
+		core_queue[core][pos] = voice;
+	}
+	
+	for (core = 0; core < num_of_cores; core++)
+	{
+		core_queue_range[core].store((uint32_t)queue_length[core] << 16, std::memory_order_relaxed);
+	}
+
+	pthread_barrier_wait(&cycle_start_barrier);
+
+	render_core_voices(0);
+
+	pthread_barrier_wait(&cycle_end_barrier);
+}
+
+/**
+*   @brief  Render all playing voices of one update cycle on the calling thread.
+*   @param  none
+*   @return none
+*/
+void AudioVoiceRenderPool::render_voices_serially()
+{
+	for (int voice = 0; voice < _SYNTH_MAX_NUM_OF_VOICES; voice++)
+	{
+		if (AudioManager::callback_audio_voice_core_ptr && 
+			(AudioManager::callback_audio_voice_core_ptr(voice) < 0))
+		{
+			// Not playing
+			continue;
+		}
+		
+		render_voice(voice);
+	}
+}
+
+/**
+*   @brief  Render the voices queued on a core, then help the other cores by 
+*			stealing voices from the busiest queue until all queues are empty.
+*   @param  core	core number
+*   @return none
+*/
+void AudioVoiceRenderPool::render_core_voices(int core)
+{
+	int voice, victim;
+	
+	while ((voice = take_queued_voice(core, false)) >= 0)
+	{
+		render_voice(voice);
+	}
+	
+	while ((victim = get_busiest_queue()) >= 0)
+	{
+		voice = take_queued_voice(victim, true);
+		if (voice >= 0)
+		{
+			render_voice(voice);
+		}
+	}
+}
+
+/**
+*   @brief  Render a single voice and update its processing cost moving average.
+*   @param  voice	voice number
+*   @return none
+*/
+void AudioVoiceRenderPool::render_voice(int voice)
+{
+	struct timespec start_ts, stop_ts;
+	float cost, average;
+	
+	if (AudioManager::callback_audio_voice_update_ptr == NULL)
+	{
+		return;
+	}
+	
+	clock_gettime(CLOCK_MONOTONIC, &start_ts);
+	
+	AudioManager::callback_audio_voice_update_ptr(voice);
+	
+	clock_gettime(CLOCK_MONOTONIC, &stop_ts);
+	
+	cost = (float)(stop_ts.tv_sec - start_ts.tv_sec) * 1000000.0f +
+		(float)(stop_ts.tv_nsec - start_ts.tv_nsec) / 1000.0f;
+	
+	// Only the thread rendering the voice updates its average
+	average = voice_processing_cost[voice].load(std::memory_order_relaxed);
+	average += (cost - average) * _VOICE_PROCESSING_COST_AVERAGING_FACTOR;
+	voice_processing_cost[voice].store(average, std::memory_order_relaxed);
+}
+
+/**
+*   @brief  Returns the measured processing cost of a voice update.
+*   @param  voice	voice number
+*   @return moving average of the voice update processing time [uSec]; -1 if voice is out of range
+*/
+float AudioVoiceRenderPool::get_voice_processing_cost(int voice)
+{
+	if ((voice < 0) || (voice >= _SYNTH_MAX_NUM_OF_VOICES))
+	{
+		return -1;
+	}
+	
+	return voice_processing_cost[voice].load(std::memory_order_relaxed);
+}
+
+/**
+*   @brief  Sets the estimated processing cost of a voice update, e.g. when a voice is
+*			allocated to a program with a known cost. Further measurements refine it.
+*   @param  voice	voice number
+*   @param	cost	voice update processing time [uSec]
+*   @return none
+*/
+void AudioVoiceRenderPool::set_voice_processing_cost(int voice, float cost)
+{
+	if ((voice >= 0) && (voice < _SYNTH_MAX_NUM_OF_VOICES) && (cost >= 0))
+	{
+		voice_processing_cost[voice].store(cost, std::memory_order_relaxed);
+	}
+}
+
+/**
+*   @brief  Take the next voice to render from a core queue.
+*			The queue owner takes from the head (heaviest), thieves take from the tail.
+*   @param  core	queue core number
+*   @param	steal	true when taken by another core
+*   @return voice number; -1 if the queue is empty
+*/
+int AudioVoiceRenderPool::take_queued_voice(int core, bool steal)
+{
+	uint32_t range, new_range, head, tail;
+	
+	range = core_queue_range[core].load(std::memory_order_acquire);
+	do
+	{
+		head = range & 0xffff;
+		tail = range >> 16;
+		if (head >= tail)
+		{
+			return -1;
+		}
+		
+		if (steal)
+		{
+			new_range = head | ((tail - 1) << 16);
+		}
+		else
+		{
+			new_range = (head + 1) | (tail << 16);
+		}
+	} while (!core_queue_range[core].compare_exchange_weak(range, new_range, 
+		std::memory_order_acq_rel, std::memory_order_acquire));
+	
+	return steal ? core_queue[core][tail - 1] : core_queue[core][head];
+}
+
+/**
+*   @brief  Returns the core with the most voices still waiting to be rendered.
+*   @param  none
+*   @return core number; -1 if all queues are empty
+*/
+int AudioVoiceRenderPool::get_busiest_queue()
+{
+	int core, busiest = -1, pending, max_pending = 0;
+	uint32_t range;
+	
+	for (core = 0; core < num_of_cores; core++)
+	{
+		range = core_queue_range[core].load(std::memory_order_relaxed);
+		pending = (int)(range >> 16) - (int)(range & 0xffff);
+		if (pending > max_pending)
+		{
+			max_pending = pending;
+			busiest = core;
+		}
+	}
+	
+	return busiest;
+}
+
+/**
+*   @brief  Pin a thread to a core.
+*   @param  thread_id	thread id
+*   @param	core		core number
+*   @return 0 if OK
+*/
+int AudioVoiceRenderPool::set_thread_affinity(pthread_t thread_id, int core)
+{
+	int ret;
+	cpu_set_t cpuset;
+
+	CPU_ZERO(&cpuset);
+	CPU_SET(core, &cpuset);
+
+	ret = pthread_setaffinity_np(thread_id, sizeof(cpu_set_t), &cpuset);
+	if (ret != 0)
+	{
+		fprintf(stderr, "Voice render pool: Unsuccessful in pinning thread to core %i\n", core);
+	}
+
+	return ret;
+}
+
+/**
+*   @brief  Voices rendering worker thread
+*   @param  arg a pointer to the worker core number
+*   @return void*
+*/
+void *AUDVRP_render_worker_thread(void *arg)
+{
+	return AudioVoiceRenderPool::get_instance()->render_worker(*(int *)arg);
+}
+
+/**
+*   @brief  A voices rendering worker loop: renders its core voices every cycle until stopped.
+*   @param  core	worker core number
+*   @return NULL
+*/
+void *AudioVoiceRenderPool::render_worker(int core)
+{
+	// Wait until all the workers are created
+	pthread_mutex_lock(&workers_gate_mutex);
+	while (!workers_gate_open)
+	{
+		pthread_cond_wait(&workers_gate_cv, &workers_gate_mutex);
+	}
+	pthread_mutex_unlock(&workers_gate_mutex);
+	
+	if (!workers_running)
+	{
+		// Stopped because another worker could not be created
+		return NULL;
+	}
+	
+	while (true)
+	{
+		pthread_barrier_wait(&cycle_start_barrier);
+
+		if (!workers_running)
+		{
+			break;
+		}
+
+		render_core_voices(core);
+
+		pthread_barrier_wait(&cycle_end_barrier);
+	}
+	
+	// Return this worker cached free audio blocks to the pool
+	AudioBlockFloat::flush_thread_audio_blocks_cache();
+
+	return NULL;
+}
@@ -0,0 +1,97 @@
+/**
+*	@file		audioVoiceRenderPool.h
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.1
+*					1. Per-voice measured processing cost.
+*					2. Work stealing between the workers voices queues.
+*
+*	@History	1.0	17-Oct-2026	1st version
+*
+*	@brief		A pool of pinned real-time worker threads that renders the polyphonic
+*				voices in parallel, one worker per core.
+*
+*				The thread running the update cycles (the audio update thread, or the JACK
+*				process callback) acts as the core 0 worker. The workers are created in advance,
+*				never by the JACK process callback. Each cycle it queues every
+*				playing voice on its core (heaviest first), releases the workers through a start 
+*				barrier, renders its own share and then waits on an end barrier, so all voices 
+*				outputs are ready before the poly-mixer runs the audio update cycle end tasks.
+*				A worker that empties its own queue steals voices from the tail of the busiest
+*				queue left.
+*/
+
+#pragma once
+
+#include <pthread.h>
+#include <atomic>
+
+#include "../LibAPI/synthesizer.h"
+#include "../LibAPI/types.h"
+
+class AudioVoiceRenderPool
+{
+public:
+
+	~AudioVoiceRenderPool();
+
+	static AudioVoiceRenderPool *get_instance();
+
+	int start(int num_of_cores, bool pin_caller = true);
+	int stop();
+	bool is_running();
+	int get_num_of_cores();
+
+	void render_voices();
+	void render_voices_serially();
+	void render_core_voices(int core);
+	void render_voice(int voice);
+	void *render_worker(int core);
+	
+	float get_voice_processing_cost(int voice);
+	void set_voice_processing_cost(int voice, float cost);
+
+	std::atomic<bool> workers_running;
+
+	pthread_barrier_t cycle_start_barrier;
+	pthread_barrier_t cycle_end_barrier;
+
+private:
+
+	AudioVoiceRenderPool();
+
+	static AudioVoiceRenderPool *render_pool_instance;
+
+	int set_thread_affinity(pthread_t thread_id, int core);
+	void release_started_workers(int num_of_started);
+	int take_queued_voice(int core, bool steal);
+	int get_busiest_queue();
+
+	/* Number of cores voices are rendered on, including the update thread (core 0) */
+	int num_of_cores;
+
+	pthread_t worker_thread_id[_SYNTH_MAX_NUM_OF_CORES];
+	int worker_core[_SYNTH_MAX_NUM_OF_CORES];
+	
+	/* Workers wait on this gate until all the workers are created (or creation failed) */
+	pthread_mutex_t workers_gate_mutex;
+	pthread_cond_t workers_gate_cv;
+	bool workers_gate_open;
+	
+	/* The thread pinned to core 0 by start(), and its affinity before, restored by stop() */
+	pthread_t pinned_thread_id;
+	cpu_set_t pinned_thread_saved_cpuset;
+	bool pinned_thread_affinity_saved;
+
+	/* Per core queue of the voices to render in the current cycle, heaviest first */
+	int core_queue[_SYNTH_MAX_NUM_OF_CORES][_SYNTH_MAX_NUM_OF_VOICES];
+	/* Queue pending range: head in the low 16 bits (owner takes), tail in the high 16 bits (thieves take) */
+	std::atomic<uint32_t> core_queue_range[_SYNTH_MAX_NUM_OF_CORES];
+	
+	/* Moving average of each voice update processing time [uSec] (written by the workers,
+	 * read by the scheduler) */
+	std::atomic<float> voice_processing_cost[_SYNTH_MAX_NUM_OF_VOICES];
+};
+
+// Voices rendering worker thread
+void *AUDVRP_render_worker_thread(void *arg);
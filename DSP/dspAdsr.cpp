@@ -1,11 +1,13 @@
 /**
 * @file		dspAdsr.h
 *	@author		Nahum Budin
-*	@date		14-Sep-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion.
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Remaining release time estimate.
 *	
-*	@History	23_Jan-2021 1.1
+*	@History	14-Sep-2024	1.2
+*					1. Code refactoring and notaion.
+*				23_Jan-2021 1.1
 *					1. Code refactoring and notaion.
 *					2. Adding update interval parameter as a setting parameter
 *				30-Oct-2019	1.0 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1)
@@ -428,6 +430,23 @@ float DSP_ADSR::get_send_level_2() { return send_level_2; }
 */
 uint32_t DSP_ADSR::get_note_on_elapsed_time() { return note_on_elapsed_time;  }
 
+/**
+*	@brief	Returns an estimate of the time left until a released envelope decays to zero
+*	@param none
+*	@return remaining release time in sec; 0 if the envelope is not in the release state
+*/
+float DSP_ADSR::get_remaining_release_time()
+{
+	float step = release_step * (((float)sustain_level_precentages + 1) / 100.0);
+	
+	if ((state != ADSR_STATE_RELEASE) || (step <= 0.0f))
+	{
+		return 0.0f;
+	}
+	
+	return output_val / step * update_interval_sec;
+}
+
 
 /** 
  *	@brief	Calculate the next Output value 0-1.0
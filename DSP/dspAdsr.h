@@ -1,11 +1,13 @@
 /**
 * @file		dspAdsr.h
 *	@author		Nahum Budin
-*	@date		14-Sep-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion.
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Remaining release time estimate.
 *	
-*	@History	23_Jan-2021 1.1
+*	@History	14-Sep-2024	1.2
+*					1. Code refactoring and notaion.
+*				23_Jan-2021 1.1
 *					1. Code refactoring and notaion.
 *					2. Adding update interval parameter as a setting parameter
 *				30-Oct-2019	1.0 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1)
@@ -67,6 +69,7 @@ public:
 	void set_note_off();
 
 	uint32_t get_note_on_elapsed_time();
+	float get_remaining_release_time();
 	
 	float calc_next_envelope_val();	
 
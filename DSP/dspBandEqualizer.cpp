@@ -2,6 +2,11 @@
 *	@file		dspBandEqualizer.cpp
 *	@author		Nahum Budin
 *	@date		3-Oct-2024
+*	@version	1.3	17-Oct-2026
+*					1. Structure-of-arrays vectorized bands filters bank.
+*					2. Block processing.
+*					3. Sample-rate aware bands coefficients; configurable bands.
+*					
 *	@version	1.2 
 *					1. Code refactoring and notaion.
 *					
@@ -14,7 +19,39 @@
 */
 
 #include <math.h>
+#include <string.h>
+#include <mutex>
+
 #include "dspBandEqualizer.h"
+#include "../utils/utils.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define _IIR_FILTER_BANK_NEON
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#define _IIR_FILTER_BANK_SSE
+#endif
+
+// Max number of cached bands coefficients sets (sample rate and bands configurations)
+#define _BAND_EQUALIZER_COEFFICIENTS_CACHE_SIZE		8
+
+/* A calculated bands coefficients set */
+typedef struct _band_equalizer_coefficients
+{
+	int samp_rate;
+	int num_of_bands;
+	float q;
+	float frequencies[_IIR_FILTER_BANK_NUM_OF_BANDS];
+	float alfa[_IIR_FILTER_BANK_NUM_OF_BANDS];
+	float beta[_IIR_FILTER_BANK_NUM_OF_BANDS];
+	float gama[_IIR_FILTER_BANK_NUM_OF_BANDS];
+} _band_equalizer_coefficients_t;
+
+static _band_equalizer_coefficients_t coefficients_cache[_BAND_EQUALIZER_COEFFICIENTS_CACHE_SIZE];
+static int coefficients_cache_count = 0;
+static int coefficients_cache_next = 0;
+static std::mutex coefficients_cache_mutex;
 
 /**
 *	@brief	Creates an IIR filter instance of provided frequency band
@@ -61,23 +98,473 @@ float IIRbandpassFilter::get_filter_output(float in)
 }
 
 /**
-*	@brief	Creates an equilizer instance
-*	@param	none.
+*	@brief	Creates a bands filters bank instance; all lanes are silent
+*	@param	none
 *	@return none
 */
-DSP_BandEqualizer::DSP_BandEqualizer()
+IIRbandpassFilterBank::IIRbandpassFilterBank()
+{
+	for (int lane = 0; lane < _IIR_FILTER_BANK_NUM_OF_LANES; lane++)
+	{
+		alfa_2[lane] = 0.f;
+		beta_2[lane] = 0.f;
+		gama_2[lane] = 0.f;
+		gain[lane] = 0.f;
+	}
+	
+	set_num_of_bands(_IIR_FILTER_BANK_NUM_OF_BANDS);
+	reset();
+}
+
+/**
+*	@brief	Set the number of processed bands; the unused lanes are silenced
+*	@param	num	number of bands (1 to _IIR_FILTER_BANK_NUM_OF_BANDS)
+*	@return void
+*/
+void IIRbandpassFilterBank::set_num_of_bands(int num)
+{
+	if (num < 1)
+	{
+		num = 1;
+	}
+	else if (num > _IIR_FILTER_BANK_NUM_OF_BANDS)
+	{
+		num = _IIR_FILTER_BANK_NUM_OF_BANDS;
+	}
+	
+	for (int lane = num; lane < _IIR_FILTER_BANK_NUM_OF_LANES; lane++)
+	{
+		alfa_2[lane] = 0.f;
+		beta_2[lane] = 0.f;
+		gama_2[lane] = 0.f;
+		gain[lane] = 0.f;
+		y_n_1[lane] = 0.f;
+		y_n_2[lane] = 0.f;
+	}
+	
+	num_of_bands = num;
+	num_of_vectors = (num + 3) / 4;
+}
+
+/**
+*	@brief	Returns the number of processed bands
+*	@param	none
+*	@return number of bands
+*/
+int IIRbandpassFilterBank::get_num_of_bands() { return num_of_bands; }
+
+/**
+*	@brief	Set a band filter coefficients
+*	@param	band	band lane (0 to _IIR_FILTER_BANK_NUM_OF_BANDS - 1)
+*	@param	alfa	filter alfa coefficient
+*	@param	beta	filter beta coefficient
+*	@param	gama	filter gama coefficient
+*	@return void
+*/
+void IIRbandpassFilterBank::set_band_coefficients(int band, float alfa, float beta, float gama)
+{
+	if ((band < 0) || (band >= num_of_bands))
+	{
+		return;
+	}
+	
+	alfa_2[band] = 2.f * alfa;
+	beta_2[band] = 2.f * beta;
+	gama_2[band] = 2.f * gama;
+}
+
+/**
+*	@brief	Set a band output gain
+*	@param	band	band lane (0 to _IIR_FILTER_BANK_NUM_OF_BANDS - 1)
+*	@param	gn		band output gain
+*	@return void
+*/
+void IIRbandpassFilterBank::set_band_gain(int band, float gn)
+{
+	if ((band < 0) || (band >= num_of_bands))
+	{
+		return;
+	}
+	
+	gain[band] = gn;
+}
+
+/**
+*	@brief	Clear the filters state
+*	@param	none
+*	@return void
+*/
+void IIRbandpassFilterBank::reset()
+{
+	for (int lane = 0; lane < _IIR_FILTER_BANK_NUM_OF_LANES; lane++)
+	{
+		y_n_1[lane] = 0.f;
+		y_n_2[lane] = 0.f;
+	}
+	
+	x_n_1 = 0.f;
+	x_n_2 = 0.f;
+}
+
+/**
+*	@brief	Returns the bank next output value (the sum of all bands outputs multiplied by their gains)
+*	@param	in	new input sample
+*	@return bank next output value
+*/
+float IIRbandpassFilterBank::get_bank_output(float in)
+{
+	float out;
+	
+	get_bank_output_block(&in, &out, 1);
+	
+	return out;
+}
+
+/**
+*	@brief	Process a block of samples through all the bands filters.
+*			Each sample is processed by all the bands in parallel (4 lanes per vector);
+*			the states are kept in registers over the block.
+*	@param	in		a pointer to a size samples input buffer
+*	@param	out		a pointer to a size samples output buffer (may be the input buffer)
+*	@param	size	number of samples
+*	@return void
+*/
+void IIRbandpassFilterBank::get_bank_output_block(const float *in, float *out, int size)
+{
+	float x_1 = x_n_1, x_2 = x_n_2, x_0;
+	int i, v, vectors = num_of_vectors;
+	
+#if defined(_IIR_FILTER_BANK_NEON)
+	float32x4_t alfa_v[_IIR_FILTER_BANK_NUM_OF_VECTORS], beta_v[_IIR_FILTER_BANK_NUM_OF_VECTORS];
+	float32x4_t gama_v[_IIR_FILTER_BANK_NUM_OF_VECTORS], gain_v[_IIR_FILTER_BANK_NUM_OF_VECTORS];
+	float32x4_t y_1[_IIR_FILTER_BANK_NUM_OF_VECTORS], y_2[_IIR_FILTER_BANK_NUM_OF_VECTORS];
+	float32x4_t x, y, acc;
+	
+	for (v = 0; v < vectors; v++)
+	{
+		alfa_v[v] = vld1q_f32(&alfa_2[v * 4]);
+		beta_v[v] = vld1q_f32(&beta_2[v * 4]);
+		gama_v[v] = vld1q_f32(&gama_2[v * 4]);
+		gain_v[v] = vld1q_f32(&gain[v * 4]);
+		y_1[v] = vld1q_f32(&y_n_1[v * 4]);
+		y_2[v] = vld1q_f32(&y_n_2[v * 4]);
+	}
+	
+	for (i = 0; i < size; i++)
+	{
+		x_0 = in[i];
+		x = vdupq_n_f32(x_0 - x_2);
+		acc = vdupq_n_f32(0.f);
+		
+		for (v = 0; v < vectors; v++)
+		{
+			y = vmlsq_f32(vmlaq_f32(vmulq_f32(alfa_v[v], x), gama_v[v], y_1[v]), beta_v[v], y_2[v]);
+			y_2[v] = y_1[v];
+			y_1[v] = y;
+			acc = vmlaq_f32(acc, y, gain_v[v]);
+		}
+		
+		x_2 = x_1;
+		x_1 = x_0;
+#if defined(__aarch64__)
+		out[i] = vaddvq_f32(acc);
+#else
+		out[i] = vgetq_lane_f32(acc, 0) + vgetq_lane_f32(acc, 1) + vgetq_lane_f32(acc, 2) + vgetq_lane_f32(acc, 3);
+#endif
+	}
+	
+	for (v = 0; v < vectors; v++)
+	{
+		vst1q_f32(&y_n_1[v * 4], y_1[v]);
+		vst1q_f32(&y_n_2[v * 4], y_2[v]);
+	}
+#elif defined(_IIR_FILTER_BANK_SSE)
+	__m128 alfa_v[_IIR_FILTER_BANK_NUM_OF_VECTORS], beta_v[_IIR_FILTER_BANK_NUM_OF_VECTORS];
+	__m128 gama_v[_IIR_FILTER_BANK_NUM_OF_VECTORS], gain_v[_IIR_FILTER_BANK_NUM_OF_VECTORS];
+	__m128 y_1[_IIR_FILTER_BANK_NUM_OF_VECTORS], y_2[_IIR_FILTER_BANK_NUM_OF_VECTORS];
+	__m128 x, y, acc;
+	
+	for (v = 0; v < vectors; v++)
+	{
+		alfa_v[v] = _mm_load_ps(&alfa_2[v * 4]);
+		beta_v[v] = _mm_load_ps(&beta_2[v * 4]);
+		gama_v[v] = _mm_load_ps(&gama_2[v * 4]);
+		gain_v[v] = _mm_load_ps(&gain[v * 4]);
+		y_1[v] = _mm_load_ps(&y_n_1[v * 4]);
+		y_2[v] = _mm_load_ps(&y_n_2[v * 4]);
+	}
+	
+	for (i = 0; i < size; i++)
+	{
+		x_0 = in[i];
+		x = _mm_set1_ps(x_0 - x_2);
+		acc = _mm_setzero_ps();
+		
+		for (v = 0; v < vectors; v++)
+		{
+			y = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(alfa_v[v], x), _mm_mul_ps(gama_v[v], y_1[v])), 
+				_mm_mul_ps(beta_v[v], y_2[v]));
+			y_2[v] = y_1[v];
+			y_1[v] = y;
+			acc = _mm_add_ps(acc, _mm_mul_ps(y, gain_v[v]));
+		}
+		
+		x_2 = x_1;
+		x_1 = x_0;
+		// Horizontal sum
+		acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+		acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+		out[i] = _mm_cvtss_f32(acc);
+	}
+	
+	for (v = 0; v < vectors; v++)
+	{
+		_mm_store_ps(&y_n_1[v * 4], y_1[v]);
+		_mm_store_ps(&y_n_2[v * 4], y_2[v]);
+	}
+#else
+	float y, acc;
+	int lane;
+	
+	(void)vectors;
+	
+	for (i = 0; i < size; i++)
+	{
+		x_0 = in[i];
+		acc = 0.f;
+		
+		for (lane = 0; lane < num_of_bands; lane++)
+		{
+			y = alfa_2[lane] * (x_0 - x_2) + gama_2[lane] * y_n_1[lane] - beta_2[lane] * y_n_2[lane];
+			y_n_2[lane] = y_n_1[lane];
+			y_n_1[lane] = y;
+			acc += y * gain[lane];
+		}
+		
+		x_2 = x_1;
+		x_1 = x_0;
+		out[i] = acc;
+	}
+#endif
+	
+	x_n_1 = x_1;
+	x_n_2 = x_2;
+}
+
+/**
+*	@brief	Creates an equilizer instance with the default bands
+*	@param	samp_rate	sample rate
+*	@return none
+*/
+DSP_BandEqualizer::DSP_BandEqualizer(int samp_rate)
 {
 	total_gain = 0.f;
+	sample_rate = _DEFAULT_SAMPLE_RATE;
+	num_of_bands = _IIR_FILTER_BANK_NUM_OF_BANDS;
+	bands_q = _BAND_EQUALIZER_DEFAULT_Q;
 	
 	for (int i = 0; i <= _band_16000_hz; i++)
 	{
-		filters[i] = new IIRbandpassFilter((iir_filter_bands)i);
-		set_band_level((iir_filter_bands)i, 0);
-		//	totalGain += bandsLevels[i];
+		bands_frequencies[i] = bands_center_frequencies[i];
 		bands_levels[i] = 1.f;
 	}
 
 	total_gain = 1.f;
+	set_sample_rate(samp_rate);
+}
+
+/**
+*	@brief	Calculates a bandpass filter coefficients (AN2110): 
+*			y(n) = 2 * (alfa * (x(n) - x(n-2)) + gama * y(n-1) - beta * y(n-2))
+*	@param	center_frequency	band center frequency [Hz]
+*	@param	q					band quality factor
+*	@param	samp_rate			sample rate
+*	@param	alfa				a pointer to the returned alfa coefficient
+*	@param	beta				a pointer to the returned beta coefficient
+*	@param	gama				a pointer to the returned gama coefficient
+*	@return void
+*/
+void DSP_BandEqualizer::calc_band_coefficients(float center_frequency, float q, int samp_rate,
+	float *alfa, float *beta, float *gama)
+{
+	double theta, tan_half_bw;
+	
+	if (center_frequency > _BAND_EQUALIZER_MAX_RELATIVE_FREQ * samp_rate)
+	{
+		center_frequency = _BAND_EQUALIZER_MAX_RELATIVE_FREQ * samp_rate;
+	}
+	
+	theta = 2.0 * M_PI * center_frequency / samp_rate;
+	tan_half_bw = tan(theta / (2.0 * q));
+	
+	*beta = (float)(0.5 * (1.0 - tan_half_bw) / (1.0 + tan_half_bw));
+	*gama = (float)((0.5 + *beta) * cos(theta));
+	*alfa = (float)((0.5 - *beta) / 2.0);
+}
+
+/**
+*	@brief	Sets the bands filters coefficients for the sample rate and bands configuration.
+*			Calculated coefficients sets are cached, so switching back to a sample rate 
+*			(or the other channel equalizer) does not recalculate them.
+*	@param	none
+*	@return void
+*/
+void DSP_BandEqualizer::update_bands_coefficients()
+{
+	_band_equalizer_coefficients_t *coefficients = NULL;
+	int entry, band;
+	
+	std::lock_guard<std::mutex> lock(coefficients_cache_mutex);
+	
+	for (entry = 0; entry < coefficients_cache_count; entry++)
+	{
+		if ((coefficients_cache[entry].samp_rate == sample_rate) &&
+			(coefficients_cache[entry].num_of_bands == num_of_bands) &&
+			(coefficients_cache[entry].q == bands_q) &&
+			(memcmp(coefficients_cache[entry].frequencies, bands_frequencies, num_of_bands * sizeof(float)) == 0))
+		{
+			coefficients = &coefficients_cache[entry];
+			break;
+		}
+	}
+	
+	if (!coefficients)
+	{
+		// Not cached - replace the oldest entry
+		coefficients = &coefficients_cache[coefficients_cache_next];
+		coefficients_cache_next = (coefficients_cache_next + 1) % _BAND_EQUALIZER_COEFFICIENTS_CACHE_SIZE;
+		if (coefficients_cache_count < _BAND_EQUALIZER_COEFFICIENTS_CACHE_SIZE)
+		{
+			coefficients_cache_count++;
+		}
+		
+		coefficients->samp_rate = sample_rate;
+		coefficients->num_of_bands = num_of_bands;
+		coefficients->q = bands_q;
+		
+		for (band = 0; band < num_of_bands; band++)
+		{
+			coefficients->frequencies[band] = bands_frequencies[band];
+			calc_band_coefficients(bands_frequencies[band], bands_q, sample_rate,
+				&coefficients->alfa[band], &coefficients->beta[band], &coefficients->gama[band]);
+		}
+	}
+	
+	filters_bank.set_num_of_bands(num_of_bands);
+	
+	for (band = 0; band < num_of_bands; band++)
+	{
+		filters_bank.set_band_coefficients(band, coefficients->alfa[band], coefficients->beta[band], coefficients->gama[band]);
+	}
+	
+	filters_bank.reset();
+}
+
+/**
+*	@brief	Sets the sample-rate and recalculates the bands coefficients
+*	@param	samp_rate	sample rate: _SAMPLE_RATE_44 (44100Hz) or _SAMPLE_RATE_48 (48000Hz)
+*						if non of the above, sample rate is set to _DEFAULT_SAMPLE_RATE (44100).
+*	@return set sample-rate
+*/
+int DSP_BandEqualizer::set_sample_rate(int samp_rate)
+{
+	if (!is_valid_sample_rate(samp_rate))
+	{
+		sample_rate = _DEFAULT_SAMPLE_RATE;
+	}
+	else
+	{
+		sample_rate = samp_rate;
+	}
+	
+	update_bands_coefficients();
+	update_bands_gains();
+	
+	return sample_rate;
+}
+
+/**
+*	@brief	Returns the set sample-rate
+*	@param	none
+*	@return set sample-rate
+*/
+int DSP_BandEqualizer::get_sample_rate() { return sample_rate; }
+
+/**
+*	@brief	Sets the equalizer bands. Fewer bands use less CPU.
+*			Bands levels are kept by band index.
+*	@param	num					number of bands (1 to _IIR_FILTER_BANK_NUM_OF_BANDS)
+*	@param	center_frequencies	an array of num bands center frequencies [Hz];
+*								NULL for the default bands frequencies
+*	@param	q					bands quality factor
+*	@return 0 if done; -1 if parameters are out of range
+*/
+int DSP_BandEqualizer::set_bands(int num, const float *center_frequencies, float q)
+{
+	int band;
+	
+	if ((num < 1) || (num > _IIR_FILTER_BANK_NUM_OF_BANDS) || (q <= 0.f))
+	{
+		return -1;
+	}
+	
+	for (band = 0; band < num; band++)
+	{
+		if (center_frequencies && (center_frequencies[band] <= 0.f))
+		{
+			return -1;
+		}
+	}
+	
+	for (band = 0; band < num; band++)
+	{
+		bands_frequencies[band] = center_frequencies ? center_frequencies[band] : bands_center_frequencies[band];
+	}
+	
+	num_of_bands = num;
+	bands_q = q;
+	
+	update_bands_coefficients();
+	normalize_bands_levels();
+	
+	return 0;
+}
+
+/**
+*	@brief	Returns the number of equalizer bands
+*	@param	none
+*	@return number of bands
+*/
+int DSP_BandEqualizer::get_num_of_bands() { return num_of_bands; }
+
+/**
+*	@brief	Returns a band center frequency
+*	@param	band	band index
+*	@return band center frequency [Hz]; -1 if band is out of range
+*/
+float DSP_BandEqualizer::get_band_center_frequency(int band)
+{
+	if ((band < 0) || (band >= num_of_bands))
+	{
+		return -1.f;
+	}
+	
+	return bands_frequencies[band];
+}
+
+/**
+*	@brief	Sets the filters bank bands gains: the bands levels normalized by the total gain
+*	@param	none
+*	@return void
+*/
+void DSP_BandEqualizer::update_bands_gains()
+{
+	float inv_total_gain = 1.f / total_gain;
+	
+	for (int band = 0; band < num_of_bands; band++)
+	{
+		filters_bank.set_band_gain(band, bands_levels[band] * inv_total_gain);
+	}
 }
 
 /**
@@ -88,8 +575,6 @@ DSP_BandEqualizer::DSP_BandEqualizer()
 */
 void DSP_BandEqualizer::set_band_level(enum iir_filter_bands band, int level)
 {
-	int i;
-
 	if (level > 50)
 	{
 		level = 50;
@@ -100,19 +585,33 @@ void DSP_BandEqualizer::set_band_level(enum iir_filter_bands band, int level)
 	}
 	// Level is in db: 0db-> 1.0; +20db->10; -20db->0.1
 	bands_levels[band] = pow(10.0, (double)level / 20.0);
-	// Normalize
+	
+	normalize_bands_levels();
+}
+
+/**
+*	@brief	Normalizes the bands levels by their average and sets the bands gains
+*	@param	none
+*	@return void
+*/
+void DSP_BandEqualizer::normalize_bands_levels()
+{
+	int i;
+	
 	total_gain = 0.f;
-	for (i = _band_31_hz; i <= _band_16000_hz; i++)
+	for (i = 0; i < num_of_bands; i++)
 	{
 		total_gain += bands_levels[i];
 	}
 
-	total_gain /= 10.0;
+	total_gain /= (float)num_of_bands;
 
 	if (total_gain < 0.1f)
 	{
 		total_gain = 0.1f;
 	}
+	
+	update_bands_gains();
 }
 
 /**
@@ -141,13 +640,17 @@ void DSP_BandEqualizer::set_preset(int prst)
 */
 float DSP_BandEqualizer::get_equalizer_next_output(float in)
 {
-	int band;
-	float out = 0.f;
-
-	for (band = _band_31_hz; band <= _band_16000_hz; band++)
-	{
-		out += filters[band]->get_filter_output(in) * bands_levels[band];
-	}
+	return filters_bank.get_bank_output(in);
+}
 
-	return out / total_gain;
+/**
+*	@brief	Process a block of samples through the equilizer
+*	@param	in		a pointer to a size samples input buffer
+*	@param	out		a pointer to a size samples output buffer (may be the input buffer)
+*	@param	size	number of samples
+*	@return void
+*/
+void DSP_BandEqualizer::get_equalizer_next_output_block(const float *in, float *out, int size)
+{
+	filters_bank.get_bank_output_block(in, out, size);
 }
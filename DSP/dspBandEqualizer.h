@@ -2,6 +2,11 @@
 *	@file		dspBandEqualizer.h
 *	@author		Nahum Budin
 *	@date		3-Oct-2024
+*	@version	1.3	17-Oct-2026
+*					1. Structure-of-arrays vectorized bands filters bank.
+*					2. Block processing.
+*					3. Sample-rate aware bands coefficients; configurable bands.
+*					
 *	@version	1.2 
 *					1. Code refactoring and notaion.
 *					
@@ -15,6 +20,8 @@
 
 #pragma once
 
+#include "../LibAPI/audio.h"
+
 #define _BAND_EQUALIZER_PRESET_USER			0;
 #define _BAND_EQUALIZER_PRESET_FLAT			1;
 
@@ -32,6 +39,16 @@ enum iir_filter_bands
 	_band_16000_hz
 };
 
+// Default bands center frequencies [Hz]
+const float bands_center_frequencies[] = {
+	31.25f, 62.5f, 125.f, 250.f, 500.f, 1000.f, 2000.f, 4000.f, 8000.f, 16000.f
+};
+
+#define _BAND_EQUALIZER_DEFAULT_Q			1.4f
+// Max band center frequency relative to the sample rate
+#define _BAND_EQUALIZER_MAX_RELATIVE_FREQ	0.45f
+
+// Fixed 48KHz coefficients (IIRbandpassFilter); DSP_BandEqualizer calculates them for its sample rate
 //					31Hz			62Hz		....
 const float bands_alfa[] = {
 	0.000723575,
@@ -84,17 +101,72 @@ private:
 	float x_n_1, x_n_2, y_n_1, y_n_2;
 };
 
+// Bank lanes: the bands are padded to a multiple of 4 (NEON/SSE vector size); padding lanes are silent
+#define _IIR_FILTER_BANK_NUM_OF_BANDS		(_band_16000_hz + 1)
+#define _IIR_FILTER_BANK_NUM_OF_VECTORS		((_IIR_FILTER_BANK_NUM_OF_BANDS + 3) / 4)
+#define _IIR_FILTER_BANK_NUM_OF_LANES		(_IIR_FILTER_BANK_NUM_OF_VECTORS * 4)
+
+static_assert(_EQUALIZER_MAX_NUM_OF_BANDS == _IIR_FILTER_BANK_NUM_OF_BANDS,
+	"_EQUALIZER_MAX_NUM_OF_BANDS must be equal to the number of iir_filter_bands");
+
+/* All the equalizer bands IIR filters, stored as a structure of arrays (one lane per band) and
+   processed in parallel; the filters share the same input and their outputs are summed by
+   each band gain. */
+class IIRbandpassFilterBank
+{
+public:
+	IIRbandpassFilterBank();
+	void set_num_of_bands(int num);
+	int get_num_of_bands();
+	void set_band_coefficients(int band, float alfa, float beta, float gama);
+	void set_band_gain(int band, float gn);
+	void reset();
+	float get_bank_output(float in);
+	void get_bank_output_block(const float *in, float *out, int size);
+
+private:
+	// Coefficients are stored multiplied by 2
+	alignas(16) float alfa_2[_IIR_FILTER_BANK_NUM_OF_LANES];
+	alignas(16) float beta_2[_IIR_FILTER_BANK_NUM_OF_LANES];
+	alignas(16) float gama_2[_IIR_FILTER_BANK_NUM_OF_LANES];
+	alignas(16) float gain[_IIR_FILTER_BANK_NUM_OF_LANES];
+	alignas(16) float y_n_1[_IIR_FILTER_BANK_NUM_OF_LANES];
+	alignas(16) float y_n_2[_IIR_FILTER_BANK_NUM_OF_LANES];
+	// The input history is common to all bands
+	float x_n_1, x_n_2;
+	// Processed bands and vectors
+	int num_of_bands, num_of_vectors;
+};
+
 class DSP_BandEqualizer
 {
 public:
-	DSP_BandEqualizer();
+	DSP_BandEqualizer(int samp_rate = _DEFAULT_SAMPLE_RATE);
+	int set_sample_rate(int samp_rate);
+	int get_sample_rate();
+	int set_bands(int num, const float *center_frequencies, float q = _BAND_EQUALIZER_DEFAULT_Q);
+	int get_num_of_bands();
+	float get_band_center_frequency(int band);
 	void set_band_level(enum iir_filter_bands band, int level);
 	float get_band_level(enum iir_filter_bands band);
 	void set_preset(int prst);
 	float get_equalizer_next_output(float in);
+	void get_equalizer_next_output_block(const float *in, float *out, int size);
+	
+	static void calc_band_coefficients(float center_frequency, float q, int samp_rate,
+		float *alfa, float *beta, float *gama);
 
 private:
-	IIRbandpassFilter *filters[_band_16000_hz + 1];
+	void update_bands_coefficients();
+	void normalize_bands_levels();
+	void update_bands_gains();
+	
+	int sample_rate;
+	int num_of_bands;
+	float bands_frequencies[_band_16000_hz + 1];
+	float bands_q;
+	
+	IIRbandpassFilterBank filters_bank;
 	float bands_levels[_band_16000_hz + 1];
 	int preset;
 	float total_gain;
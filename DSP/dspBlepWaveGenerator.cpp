@@ -0,0 +1,452 @@
+/**
+*	@file		dspBlepWaveGenerator.cpp
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0
+*
+*	@History	17-Oct-2026	1.0	1st version
+*
+*	@brief		Band-limited (PolyBLEP) Saw, Square/Pulse and Triangle Wave Oscilator.
+*/
+
+#include "dspBlepWaveGenerator.h"
+#include "../libAdjRaspi5Synth_1_1.h"
+#include "../utils/utils.h"
+
+/**
+*	@brief	Returns the PolyBLEP residual of a discontinuity at phase 0 of a +2 step
+*	@param	t	phase distance from the discontinuity (0 to 1)
+*	@param	dt	phase increment per sample
+*	@return the residual to be added to the naive waveform
+*/
+static inline float poly_blep(float t, float dt)
+{
+	float x;
+
+	if (t < dt)
+	{
+		// The sample following the discontinuity
+		x = t / dt;
+		return x + x - x * x - 1.0f;
+	}
+	else if (t > 1.0f - dt)
+	{
+		// The sample preceding the discontinuity
+		x = (t - 1.0f) / dt;
+		return x * x + x + x + 1.0f;
+	}
+
+	return 0.0f;
+}
+
+/**
+*	@brief	Returns the PolyBLAMP residual (the integrated PolyBLEP) of a slope change at phase 0
+*	@param	t	phase distance from the slope change (0 to 1)
+*	@param	dt	phase increment per sample
+*	@return the residual, to be scaled by the slope change and dt
+*/
+static inline float poly_blamp(float t, float dt)
+{
+	float x;
+
+	if (t < dt)
+	{
+		x = 1.0f - t / dt;
+		return x * x * x * (1.0f / 3.0f);
+	}
+	else if (t > 1.0f - dt)
+	{
+		x = (t - 1.0f) / dt + 1.0f;
+		return x * x * x * (1.0f / 3.0f);
+	}
+
+	return 0.0f;
+}
+
+/**
+ *	@brief	Creates and returns a band-limited Wave Oscilator object instance
+ *	@param	samp_rate	sample rate in Hz _SAMPLE_RATE_44 (44100Hz) or _SAMPLE_RATE_48 (48000Hz)
+ *	@param	pw			Pulse width / Triangle asymetry 0.05 - 0.95 (use PWM dutycycle)
+ *	@return	a band-limited Wave Generator instance
+*/
+DSP_BlepWaveGenerator::DSP_BlepWaveGenerator(int samp_rate, float pw)
+{
+	set_sample_rate(samp_rate);
+	set_pulse_width(pw);
+	set_waveform(_OSC_WAVEFORM_SQUARE);
+	sync();
+	cycle_restarted = false;
+}
+
+/**
+*	@brief	Sets the sample-rate
+*	@param	sample  rate: _SAMPLE_RATE_44 (44100Hz) or _SAMPLE_RATE_48 (48000Hz)
+*					if non of the above, sample rate is set to _DEFAULT_SAMPLE_RATE (44100).
+*	@return set sample-rate
+*/
+int DSP_BlepWaveGenerator::set_sample_rate(int samp_rate)
+{
+	if (!is_valid_sample_rate(samp_rate))
+	{
+		sample_rate = _DEFAULT_SAMPLE_RATE;
+	}
+	else
+	{
+		sample_rate = samp_rate;
+	}
+
+	inv_sample_rate = 1.0f / (float)sample_rate;
+
+	return sample_rate;
+}
+
+/**
+*	@brief	Returns the set sample-rate
+*	@param	none
+*	@return set sample-rate
+*/
+int DSP_BlepWaveGenerator::get_sample_rate() { return sample_rate; }
+
+/**
+*	@brief	Returns true if the waveform is generated by the band-limited oscilator
+*	@param	wform	waveform
+*	@return true if wform is _OSC_WAVEFORM_SQUARE, _OSC_WAVEFORM_PULSE, _OSC_WAVEFORM_TRIANGLE
+*			or _OSC_WAVEFORM_SAW
+*/
+bool DSP_BlepWaveGenerator::is_supported_waveform(int wform)
+{
+	return (wform == _OSC_WAVEFORM_SQUARE) || (wform == _OSC_WAVEFORM_PULSE) ||
+		(wform == _OSC_WAVEFORM_TRIANGLE) || (wform == _OSC_WAVEFORM_SAW);
+}
+
+/**
+*	@brief	Sets the waveform
+*	@param	wform	_OSC_WAVEFORM_SQUARE, _OSC_WAVEFORM_PULSE, _OSC_WAVEFORM_TRIANGLE or _OSC_WAVEFORM_SAW
+*	@return set waveform if OK; -1 if param out of range
+*/
+int DSP_BlepWaveGenerator::set_waveform(int wform)
+{
+	return_val_if_true(!is_supported_waveform(wform), -1);
+
+	waveform = wform;
+
+	return waveform;
+}
+
+/**
+*	@brief	Returns the waveform
+*	@param	none
+*	@return waveform
+*/
+int DSP_BlepWaveGenerator::get_waveform() { return waveform; }
+
+/**
+ *	@brief	Sets the Pulse width / Triangle asymetry. The phase is not reset.
+ *	@param	pw	Pulse width / Triangle asymetry 0.05 - 0.95 (use PWM d cycle)
+ *	@return	set pulse width
+*/
+float DSP_BlepWaveGenerator::set_pulse_width(float pw)
+{
+	pulse_width = pw;
+
+	if (pulse_width > 0.95f)
+	{
+		pulse_width = 0.95f;
+	}
+	else if (pulse_width < 0.05f)
+	{
+		pulse_width = 0.05f;
+	}
+
+	triangle_corner_factor = 1.0f / (pulse_width * (1.0f - pulse_width));
+
+	return pulse_width;
+}
+
+/**
+ *	@brief	Returns the Pulse width / Triangle asymetry
+ *	@param	none
+ *	@return	pulse width 0.05 - 0.95
+*/
+float DSP_BlepWaveGenerator::get_pulse_width() { return pulse_width; }
+
+/**
+*	@brief	Sync osc by zeroing the phase (not band-limited; used by sample by sample sync)
+*	@param	none
+*	@return	none
+*/
+void DSP_BlepWaveGenerator::sync()
+{
+	phase = 0.0f;
+	pending_correction = 0.0f;
+	synced_last_sample = false;
+}
+
+/**
+*	@brief	Return the osc cycle restart sync state event
+*	@param	none
+*	@return	true when a cycle restarted during the last generated sample or block.
+*/
+bool DSP_BlepWaveGenerator::get_cycle_restarted_sync_state() { return cycle_restarted; }
+
+/**
+*	@brief	Returns the naive (not band-limited) waveform value
+*	@param	ph	phase 0 to 1
+*	@return	waveform value
+*/
+float DSP_BlepWaveGenerator::get_naive_val(float ph)
+{
+	float q;
+
+	switch (waveform)
+	{
+		case _OSC_WAVEFORM_SAW:
+			return (ph + ph - 1.0f) * _BLEP_SQUARE_SAW_LEVEL;
+
+		case _OSC_WAVEFORM_TRIANGLE:
+			// Phase 0 is the rising zero crossing (same as DSP_TriangleWaveGenerator)
+			q = ph + pulse_width * 0.5f;
+			if (q >= 1.0f)
+			{
+				q -= 1.0f;
+			}
+
+			if (q < pulse_width)
+			{
+				return -1.0f + 2.0f * q / pulse_width;
+			}
+			else
+			{
+				return 1.0f - 2.0f * (q - pulse_width) / (1.0f - pulse_width);
+			}
+
+		default:
+			return ph < pulse_width ? _BLEP_SQUARE_SAW_LEVEL : -_BLEP_SQUARE_SAW_LEVEL;
+	}
+}
+
+/**
+*	@brief	Returns the naive triangle slope (per cycle phase unit); 0 for other waveforms
+*	@param	ph	phase 0 to 1
+*	@return	waveform slope
+*/
+float DSP_BlepWaveGenerator::get_naive_slope(float ph)
+{
+	float q;
+
+	return_val_if_true(waveform != _OSC_WAVEFORM_TRIANGLE, 0.0f);
+
+	q = ph + pulse_width * 0.5f;
+	if (q >= 1.0f)
+	{
+		q -= 1.0f;
+	}
+
+	return q < pulse_width ? 2.0f / pulse_width : -2.0f / (1.0f - pulse_width);
+}
+
+/**
+*	@brief	Returns the band-limited waveform value
+*	@param	ph		phase 0 to 1
+*	@param	dt		phase increment per sample
+*	@param	synced	true if the previous sample was followed by a sync reset: the phase 0
+*					discontinuity is then corrected by the sync correction
+*	@return	waveform value
+*/
+float DSP_BlepWaveGenerator::get_corrected_val(float ph, float dt, bool synced)
+{
+	float val, t, q;
+
+	switch (waveform)
+	{
+		case _OSC_WAVEFORM_SAW:
+			val = ph + ph - 1.0f;
+			if (!synced || (ph >= dt))
+			{
+				val -= poly_blep(ph, dt);
+			}
+			return val * _BLEP_SQUARE_SAW_LEVEL;
+
+		case _OSC_WAVEFORM_TRIANGLE:
+			q = ph + pulse_width * 0.5f;
+			if (q >= 1.0f)
+			{
+				q -= 1.0f;
+			}
+
+			t = q - pulse_width;
+			if (t < 0.0f)
+			{
+				t += 1.0f;
+			}
+
+			return get_naive_val(ph) + triangle_corner_factor * dt * (poly_blamp(q, dt) - poly_blamp(t, dt));
+
+		default:
+			val = ph < pulse_width ? 1.0f : -1.0f;
+			if (!synced || (ph >= dt))
+			{
+				val += poly_blep(ph, dt);
+			}
+
+			t = ph - pulse_width;
+			if (t < 0.0f)
+			{
+				t += 1.0f;
+			}
+			val -= poly_blep(t, dt);
+
+			return val * _BLEP_SQUARE_SAW_LEVEL;
+	}
+}
+
+/**
+*	@brief	Generates a block of band-limited samples.
+*			The phase increment is calculated once per block.
+*	@param	out				a pointer to a block of size samples output buffer
+*	@param	size			number of samples
+*	@param	freq			frequency (Hz)
+*	@param	sync_in			sync reset positions (sample index + fraction, ascending); NULL if not synced
+*	@param	num_of_syncs_in	number of sync reset positions
+*	@param	sync_out		a pointer to an up to size entries buffer of this osc cycles restarts
+*							positions (sample index + fraction); NULL if not used
+*	@return number of cycles restarts positions written into sync_out
+*/
+int DSP_BlepWaveGenerator::render_block(float *out, int size, float freq,
+	const float *sync_in, int num_of_syncs_in, float *sync_out)
+{
+	float dt = freq * inv_sample_rate;
+	float val, frac, sync_phase, step, slope_change, pre, post;
+	int next_sync = 0, num_of_syncs_out = 0;
+	bool synced;
+
+	if (dt < 0.0f)
+	{
+		dt = 0.0f;
+	}
+	else if (dt > _BLEP_MAX_PHASE_INCREMENT)
+	{
+		dt = _BLEP_MAX_PHASE_INCREMENT;
+	}
+
+	cycle_restarted = false;
+
+	for (int i = 0; i < size; i++)
+	{
+		val = get_corrected_val(phase, dt, synced_last_sample) + pending_correction;
+		pending_correction = 0.0f;
+		synced_last_sample = false;
+
+		synced = false;
+		if (sync_in && (next_sync < num_of_syncs_in) && (sync_in[next_sync] <= (float)(i + 1)))
+		{
+			// Sync reset between this sample and the next one
+			frac = sync_in[next_sync] - (float)i;
+			if (frac < 0.0f)
+			{
+				frac = 0.0f;
+			}
+			else if (frac > 1.0f)
+			{
+				frac = 1.0f;
+			}
+
+			// Skip resets that fall in the same sample interval
+			while ((next_sync < num_of_syncs_in) && (sync_in[next_sync] <= (float)(i + 1)))
+			{
+				next_sync++;
+			}
+
+			sync_phase = phase + frac * dt;
+			if (sync_phase >= 1.0f)
+			{
+				sync_phase -= 1.0f;
+			}
+
+			// Band-limited step: (1-f)^2 before the reset, -f^2 after it
+			step = 0.5f * (get_naive_val(0.0f) - get_naive_val(sync_phase));
+			pre = 1.0f - frac;
+			post = frac;
+			val += step * pre * pre;
+			pending_correction = -step * post * post;
+
+			if (waveform == _OSC_WAVEFORM_TRIANGLE)
+			{
+				// Band-limited slope change: (1-f)^3/3 before the reset, f^3/3 after it
+				slope_change = 0.5f * dt * (get_naive_slope(0.0f) - get_naive_slope(sync_phase)) * (1.0f / 3.0f);
+				val += slope_change * pre * pre * pre;
+				pending_correction += slope_change * post * post * post;
+			}
+
+			phase = (1.0f - frac) * dt;
+			synced_last_sample = true;
+			cycle_restarted = true;
+			synced = true;
+		}
+
+		if (!synced)
+		{
+			phase += dt;
+			if (phase >= 1.0f)
+			{
+				phase -= 1.0f;
+				cycle_restarted = true;
+
+				if (sync_out)
+				{
+					// The cycle restarted (1 - phase / dt) after this sample
+					sync_out[num_of_syncs_out++] = (float)(i + 1) - phase / dt;
+				}
+			}
+		}
+
+		out[i] = val;
+	}
+
+	return num_of_syncs_out;
+}
+
+/**
+*	@brief	Calculate the next output value (a block of 1 sample)
+*	@param	freq	Oscillator frequency [Hz]
+*	@return	output value
+*/
+float DSP_BlepWaveGenerator::get_next_val(float freq)
+{
+	float val;
+
+	render_block(&val, 1, freq, NULL, 0, NULL);
+
+	return val;
+}
+
+/**
+*	@brief	Return a block of next output values
+*	@param	out				a pointer to a block of size samples output buffer
+*	@param	size			number of samples
+*	@param	freq			frequency (Hz)
+*	@param	sync_offsets	a pointer to an up to size entries buffer of the cycles restarts
+*							positions (sample index + fraction) to sync other oscilators;
+*							NULL if not used
+*	@return number of cycles restarts positions written into sync_offsets
+*/
+int DSP_BlepWaveGenerator::get_next_block(float *out, int size, float freq, float *sync_offsets)
+{
+	return render_block(out, size, freq, NULL, 0, sync_offsets);
+}
+
+/**
+*	@brief	Return a block of next output values, hard synced on a master oscilator
+*	@param	out				a pointer to a block of size samples output buffer
+*	@param	size			number of samples
+*	@param	freq			frequency (Hz)
+*	@param	sync_offsets	the master oscilator cycles restarts positions returned by its
+*							get_next_block() for the same block
+*	@param	num_of_syncs	number of sync_offsets positions
+*	@return void
+*/
+void DSP_BlepWaveGenerator::get_next_synced_block(float *out, int size, float freq,
+	const float *sync_offsets, int num_of_syncs)
+{
+	render_block(out, size, freq, sync_offsets, num_of_syncs, NULL);
+}
@@ -0,0 +1,76 @@
+/**
+*	@file		dspBlepWaveGenerator.h
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0
+*
+*	@History	17-Oct-2026	1.0	1st version
+*
+*	@brief		Band-limited (PolyBLEP) Saw, Square/Pulse and Triangle Wave Oscilator.
+*
+*				Saw and Square/Pulse discontinuities are corrected by a 2 samples polynomial
+*				band-limited step (PolyBLEP); the Triangle corners are corrected by its
+*				integral (PolyBLAMP).
+*				Blocks of samples are generated with a phase increment calculated once per block.
+*				Hard sync is supported: a master oscillator block returns the fractional sample
+*				positions of its cycles restarts, and a synced oscillator block resets its phase
+*				at these positions with a band-limited correction of the reset discontinuity.
+*/
+
+#pragma once
+
+#include <stddef.h>
+
+// Square and Saw peak level (same as DSP_SquareWaveGenerator)
+#define _BLEP_SQUARE_SAW_LEVEL				0.7f
+// Max phase increment (frequency / sample-rate)
+#define _BLEP_MAX_PHASE_INCREMENT			0.45f
+
+class DSP_BlepWaveGenerator
+{
+public:
+	DSP_BlepWaveGenerator(int samp_rate, float pw);
+
+	int set_sample_rate(int samp_rate);
+	int get_sample_rate();
+
+	int set_waveform(int wform);
+	int get_waveform();
+	static bool is_supported_waveform(int wform);
+
+	float set_pulse_width(float pw);
+	float get_pulse_width();
+
+	void sync();
+	bool get_cycle_restarted_sync_state();
+
+	float get_next_val(float freq);
+	int get_next_block(float *out, int size, float freq, float *sync_offsets = NULL);
+	void get_next_synced_block(float *out, int size, float freq, const float *sync_offsets, int num_of_syncs);
+
+private:
+	int render_block(float *out, int size, float freq,
+		const float *sync_in, int num_of_syncs_in, float *sync_out);
+
+	float get_naive_val(float ph);
+	float get_naive_slope(float ph);
+	float get_corrected_val(float ph, float dt, bool skip_wrap_correction);
+
+	// Waveform: _OSC_WAVEFORM_SQUARE, _OSC_WAVEFORM_PULSE, _OSC_WAVEFORM_TRIANGLE or _OSC_WAVEFORM_SAW
+	int waveform;
+	// Cycle phase 0 to 1
+	float phase;
+	// Pulse width / triangle rise time 0.05 - 0.95 of a cycle
+	float pulse_width;
+	// Triangle slope change at its corners / 2 (1 / (pw * (1 - pw)))
+	float triangle_corner_factor;
+	// Correction of the sample following a sync reset (added to the next sample)
+	float pending_correction;
+	// True when the last sample was followed by a sync reset
+	bool synced_last_sample;
+	// Indicates a new cycle has just restarted
+	bool cycle_restarted;
+
+	int sample_rate;
+	float inv_sample_rate;
+};
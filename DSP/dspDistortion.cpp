@@ -107,3 +107,17 @@ float DSP_Distortion::get_next_output_val(float in)
 
 	return output;
 }
+
+/**
+*	@brief	Process a block of samples in place
+*	@param	in_out	a pointer to a block of size samples input and output buffer
+*	@param	size	number of samples
+*	@return void
+*/
+void DSP_Distortion::get_next_output_block(float *in_out, int size)
+{
+	for (int i = 0; i < size; i++)
+	{
+		in_out[i] = get_next_output_val(in_out[i]);
+	}
+}
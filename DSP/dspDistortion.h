@@ -25,6 +25,7 @@ public:
 	void set_range(float rng);
 	void set_blend(float bln);
 	float get_next_output_val(float in);
+	void get_next_output_block(float *in_out, int size);
 	void enable_auto_gain() { auto_gain = true; }	
 	void disable_auto_gain() { auto_gain = false; }
 
@@ -0,0 +1,66 @@
+/**
+*	@file		dspFastMath.h
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.1
+*
+*	@History	1.1	17-Oct-2026	Denormals flushing
+*				1.0	17-Oct-2026	1st version
+*
+*	@brief		Fast single precision math approximations for the audio path.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+// Recursive states below this level are flushed to zero (~ -300dB, well above the denormals range)
+#define _DSP_DENORMAL_FLUSH_LEVEL		1e-15f
+
+/**
+*	@brief	Fast 2^x approximation: the integer part sets the float exponent and the
+*			fractional part is a 5th order polynomial (relative error < 2e-7).
+*	@param	x	exponent (clamped to -126 to +126)
+*	@return 2^x
+*/
+static inline float dsp_fast_exp2f(float x)
+{
+	float int_part, frac, poly;
+	int32_t exponent;
+	uint32_t bits;
+
+	if (x < -126.0f)
+	{
+		x = -126.0f;
+	}
+	else if (x > 126.0f)
+	{
+		x = 126.0f;
+	}
+
+	int_part = floorf(x);
+	frac = x - int_part;
+
+	poly = 0.9999999269f + frac * (0.6931529682f + frac * (0.2401545299f +
+		frac * (0.0558236045f + frac * (0.0089925840f + frac * 0.0018762330f))));
+
+	exponent = (int32_t)int_part + 127;
+	bits = (uint32_t)exponent << 23;
+	memcpy(&int_part, &bits, sizeof(float));
+
+	return poly * int_part;
+}
+
+/**
+*	@brief	Flush a (decaying) recursive state value to zero before it becomes a denormal.
+*			Denormals arithmetic is very slow on some CPUs, and near silent voices
+*			filters and delay lines states decay into the denormals range.
+*	@param	x	state value
+*	@return x, or 0 if |x| is below _DSP_DENORMAL_FLUSH_LEVEL
+*/
+static inline float dsp_flush_denormal(float x)
+{
+	return (fabsf(x) < _DSP_DENORMAL_FLUSH_LEVEL) ? 0.0f : x;
+}
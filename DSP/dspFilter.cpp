@@ -2,6 +2,12 @@
 *	@file		dspFilter.h
 *	@author		Nahum Budin
 *	@date		14-Sep-2024
+*	@version	1.3	17-Oct-2026
+*					1. Block filtering with a control rate frequency multiplier.
+*					2. Fast exp2 frequency modulation.
+*					3. Zero-delay-feedback SVF and 4-pole ladder models.
+*					4. Block states denormals flushing.
+*					
 *	@version	1.2 
 *					1. Code refactoring and notaion.
 *					
@@ -10,11 +16,12 @@
 *								2. Adding sample-rate settings
 *				31-Oct-201991.0 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1)
 *
-*	@brief		State variable filter.
+*	@brief		State variable filter (Chamberlin, ZDF) and 4-pole ZDF ladder filter.
 */
 
 
 #include "dspFilter.h"
+#include "dspFastMath.h"
 
 #include "../LibAPI/synthesizer.h"
 #include "../LibAPI/audio.h"
@@ -23,9 +30,14 @@
 float DSP_Filter::max_setting_fcenter;
 float DSP_Filter::max_setting_fmult;
 
+float DSP_Filter::tan_table[_FILTER_TAN_TABLE_SIZE + 2];
+bool DSP_Filter::tan_table_initialized = false;
+
 DSP_Filter::DSP_Filter(int iD, int samp_rate)
 {
 	id = iD;
+	init_tan_table();
+	filter_model = _FILTER_MODEL_SVF;
 	// Default values
 	set_sample_rate(samp_rate);
 	set_frequency(440.0f);
@@ -39,9 +51,6 @@ DSP_Filter::DSP_Filter(int iD, int samp_rate)
 	filters_balance = 50;
 	kbd_track = 1.0f;
 	set_kbd_freq(get_filter_max_center_frequency()); // TODO: ; must be after setting kbd tracking
-	lowpass_tmp = 0.0f;
-	bandpass_tmp = 0.0f;
-	highpass_tmp = 0.0f;
 	
 	max_setting_fcenter = (float(samp_rate) / 2.5 * (3.141592654 / (float(samp_rate) * 2.0)));
 	max_setting_fmult = sinf((float(samp_rate) / 2.5) * (3.141592654 / (float(samp_rate) * 2.0)));
@@ -55,6 +64,32 @@ void DSP_Filter::clear()
 	state_input_prev = 0.0f;
 	state_lowpass = 0.0f;
 	state_bandpass = 0.0f;
+	state_ic1eq = 0.0f;
+	state_ic2eq = 0.0f;
+	for (int stage = 0; stage < 4; stage++)
+	{
+		state_ladder[stage] = 0.0f;
+	}
+	block_fmult = -1.0f;
+}
+
+/**
+*	@brief	Flush the decaying filter states to zero before they become denormals
+*			(near silent input). Called once per block.
+*	@param	none
+*	@return void
+*/
+void DSP_Filter::flush_denormals()
+{
+	state_input_prev = dsp_flush_denormal(state_input_prev);
+	state_lowpass = dsp_flush_denormal(state_lowpass);
+	state_bandpass = dsp_flush_denormal(state_bandpass);
+	state_ic1eq = dsp_flush_denormal(state_ic1eq);
+	state_ic2eq = dsp_flush_denormal(state_ic2eq);
+	for (int stage = 0; stage < 4; stage++)
+	{
+		state_ladder[stage] = dsp_flush_denormal(state_ladder[stage]);
+	}
 }
 
 /**
@@ -168,6 +203,29 @@ void DSP_Filter::set_band(int bnd)
 	}
 }
 
+/**
+*	@brief	Set filter model
+*	@param	mdl model _FILTER_MODEL_SVF, _FILTER_MODEL_ZDF_SVF, _FILTER_MODEL_LADDER
+*	@return void
+*/
+void DSP_Filter::set_model(int mdl)
+{
+	if (((mdl == _FILTER_MODEL_SVF) || (mdl == _FILTER_MODEL_ZDF_SVF) ||
+		(mdl == _FILTER_MODEL_LADDER)) && (mdl != filter_model))
+	{
+		filter_model = mdl;
+		// The models states are not compatible
+		clear();
+	}
+}
+
+/**
+*	@brief	Returns filter model
+*	@param	none
+*	@return filter model
+*/
+int DSP_Filter::get_model() { return filter_model; }
+
 /**
 *	@brief	Set keyboard frequency
 *	@param	frq _FILTER_MIN_CENTER_FREQ to _FILTER_MAX_CENTER_FREQ (Hz)
@@ -227,6 +285,250 @@ void DSP_Filter::set_kbd_track_relative(int kbdt)
 	set_kbd_track((float)kbdt / 100.0f);
 }
 
+/**
+*	@brief	Process a sample through the state variable filter (2x oversampled)
+*	@param	input		input sample
+*	@param	fmult		frequency multiplier
+*	@param	damp		damping factor
+*	@param	band		_FILTER_BAND_LPF, _FILTER_BAND_HPF or _FILTER_BAND_BPF
+*	@param	input_prev	a reference to the previous input sample state
+*	@param	lowpass		a reference to the lowpass state
+*	@param	bandpass	a reference to the bandpass state
+*	@return filter output sample
+*/
+static inline float state_variable_filter_process(float input, float fmult, float damp, int band,
+	float &input_prev, float &lowpass, float &bandpass)
+{
+	float highpass, lowpass_tmp, bandpass_tmp, highpass_tmp;
+	
+	lowpass = lowpass + fmult * bandpass;
+	highpass = ((input + input_prev) / 2.0f) - lowpass - damp * bandpass;
+	input_prev = input;
+	bandpass = bandpass + fmult * highpass;
+	lowpass_tmp = lowpass;
+	bandpass_tmp = bandpass;
+	highpass_tmp = highpass;
+	lowpass = lowpass + fmult * bandpass;
+	highpass = input - lowpass - damp * bandpass;
+	bandpass = bandpass + fmult * highpass;
+	
+	switch (band)
+	{				
+		case _FILTER_BAND_HPF:
+			return highpass + highpass_tmp;
+						
+		case _FILTER_BAND_BPF:
+			return bandpass + bandpass_tmp;
+			
+		case _FILTER_BAND_LPF:
+		default:
+			return lowpass + lowpass_tmp;
+	}
+}
+
+/**
+*	@brief	Return the filter frequency multiplier
+*	@param	fmod frequency modulation factor
+*	@return frequency multiplier
+*/
+float DSP_Filter::calc_fmult(float fmod)
+{
+	float fmult = setting_fmult * dsp_fast_exp2f(setting_octave_mult + fmod) + setting_kbd_fmult;
+	
+	if (fmult > max_setting_fmult)
+	{
+		fmult = max_setting_fmult;
+	}
+	
+	return fmult;
+}
+
+/**
+*	@brief	Initializes the tan(pi * f / fs) lookup table (once, for all filters)
+*	@param	none
+*	@return void
+*/
+void DSP_Filter::init_tan_table()
+{
+	if (tan_table_initialized)
+	{
+		return;
+	}
+	
+	for (int i = 0; i <= _FILTER_TAN_TABLE_SIZE + 1; i++)
+	{
+		double norm_freq = 0.5 * (double)i / _FILTER_TAN_TABLE_SIZE;
+		
+		if (norm_freq > _FILTER_ZDF_MAX_NORM_FREQ)
+		{
+			norm_freq = _FILTER_ZDF_MAX_NORM_FREQ;
+		}
+		
+		tan_table[i] = (float)tan(M_PI * norm_freq);
+	}
+	
+	tan_table_initialized = true;
+}
+
+/**
+*	@brief	Returns tan(pi * f / fs) (linear interpolation of the lookup table)
+*	@param	norm_freq	normalized frequency f / fs (limited to _FILTER_ZDF_MAX_NORM_FREQ)
+*	@return tan(pi * norm_freq)
+*/
+float DSP_Filter::lookup_tan(float norm_freq)
+{
+	float pos;
+	int index;
+	
+	if (norm_freq < 0.0f)
+	{
+		norm_freq = 0.0f;
+	}
+	else if (norm_freq > _FILTER_ZDF_MAX_NORM_FREQ)
+	{
+		norm_freq = _FILTER_ZDF_MAX_NORM_FREQ;
+	}
+	
+	pos = norm_freq * (2.0f * _FILTER_TAN_TABLE_SIZE);
+	index = (int)pos;
+	
+	return tan_table[index] + (tan_table[index + 1] - tan_table[index]) * (pos - (float)index);
+}
+
+/**
+*	@brief	Returns the ladder feedback gain: 0 at min Q (max damping) to 
+*			_FILTER_LADDER_MAX_FEEDBACK at max Q
+*	@param	none
+*	@return feedback gain
+*/
+float DSP_Filter::calc_ladder_feedback()
+{
+	float feedback = _FILTER_LADDER_MAX_FEEDBACK * (1.0f - _FILTER_MIN_Q * setting_damp);
+	
+	if (feedback < 0.0f)
+	{
+		feedback = 0.0f;
+	}
+	
+	return feedback;
+}
+
+/**
+*	@brief	Calculates the zero-delay-feedback models coefficients of a frequency multiplier.
+*			The cutoff frequency matches the (2x oversampled) Chamberlin SVF one: 
+*			fmult = 2 * sin(pi * f / (2 * fs)), approximated as f / fs = fmult / pi.
+*	@param	fmult			frequency multiplier
+*	@param	coefficients	a pointer to the returned coefficients
+*	@return void
+*/
+void DSP_Filter::calc_zdf_coefficients(float fmult, _filter_zdf_coefficients_t *coefficients)
+{
+	float g = lookup_tan(fmult * (float)(1.0 / M_PI));
+	float g_4;
+	
+	if (filter_model == _FILTER_MODEL_LADDER)
+	{
+		coefficients->c1 = g / (1.0f + g);
+		coefficients->c2 = 1.0f - coefficients->c1;
+		g_4 = coefficients->c1 * coefficients->c1 * coefficients->c1 * coefficients->c1;
+		coefficients->c3 = 1.0f / (1.0f + calc_ladder_feedback() * g_4);
+	}
+	else
+	{
+		coefficients->c1 = 1.0f / (1.0f + g * (g + setting_damp));
+		coefficients->c2 = g * coefficients->c1;
+		coefficients->c3 = g * coefficients->c2;
+	}
+}
+
+/**
+*	@brief	Process a sample through the zero-delay-feedback state variable filter (TPT)
+*	@param	input	input sample
+*	@param	a1		a1 coefficient
+*	@param	a2		a2 coefficient
+*	@param	a3		a3 coefficient
+*	@param	damp	damping factor (1/Q)
+*	@param	band	_FILTER_BAND_LPF, _FILTER_BAND_HPF or _FILTER_BAND_BPF
+*	@param	ic1eq	a reference to the 1st integrator state
+*	@param	ic2eq	a reference to the 2nd integrator state
+*	@return filter output sample
+*/
+static inline float zdf_state_variable_filter_process(float input, float a1, float a2, float a3, float damp, 
+	int band, float &ic1eq, float &ic2eq)
+{
+	float v1, v2, v3;
+	
+	v3 = input - ic2eq;
+	v1 = a1 * ic1eq + a2 * v3;
+	v2 = ic2eq + a2 * ic1eq + a3 * v3;
+	ic1eq = 2.0f * v1 - ic1eq;
+	ic2eq = 2.0f * v2 - ic2eq;
+	
+	switch (band)
+	{
+		case _FILTER_BAND_HPF:
+			return input - damp * v1 - v2;
+			
+		case _FILTER_BAND_BPF:
+			return v1;
+			
+		case _FILTER_BAND_LPF:
+		default:
+			return v2;
+	}
+}
+
+/**
+*	@brief	Process a sample through the 4-pole zero-delay-feedback ladder filter (linear, TPT 
+*			one-pole stages; the feedback loop is solved for the current sample)
+*	@param	input		input sample
+*	@param	gain		stages gain G = g / (1 + g)
+*	@param	state_gain	stages states gain 1 - G
+*	@param	norm		feedback normalization 1 / (1 + r * G^4)
+*	@param	feedback	feedback gain r
+*	@param	band		_FILTER_BAND_LPF, _FILTER_BAND_HPF or _FILTER_BAND_BPF
+*	@param	state		a pointer to the 4 stages integrators states
+*	@return filter output sample
+*/
+static inline float ladder_filter_process(float input, float gain, float state_gain, float norm, 
+	float feedback, int band, float *state)
+{
+	float sigma, u, v, y[4], x;
+	int stage;
+	
+	if (band == _FILTER_BAND_LPF)
+	{
+		// Input gain compensation of the passband loss at high resonance
+		input *= 1.0f + 0.5f * feedback;
+	}
+	
+	sigma = state_gain * (gain * (gain * (gain * state[0] + state[1]) + state[2]) + state[3]);
+	y[3] = (gain * gain * gain * gain * input + sigma) * norm;
+	u = input - feedback * y[3];
+	
+	x = u;
+	for (stage = 0; stage < 4; stage++)
+	{
+		v = (x - state[stage]) * gain;
+		y[stage] = v + state[stage];
+		state[stage] = y[stage] + v;
+		x = y[stage];
+	}
+	
+	switch (band)
+	{
+		case _FILTER_BAND_HPF:
+			return u - 4.0f * y[0] + 6.0f * y[1] - 4.0f * y[2] + y[3];
+			
+		case _FILTER_BAND_BPF:
+			return 4.0f * (y[1] - 2.0f * y[2] + y[3]);
+			
+		case _FILTER_BAND_LPF:
+		default:
+			return y[3];
+	}
+}
+
 /**
 *	@brief	Return next filter output sample
 *	@param	input input sample
@@ -236,66 +538,190 @@ void DSP_Filter::set_kbd_track_relative(int kbdt)
 */
 float DSP_Filter::filter_output(float input, float fmod)
 {
-	int i;	
-	float input_prev;
-	float lowpass, bandpass, highpass;
-	float lowpass_tmp, bandpasstmp, highpass_tmp;
-	float fmult, damp, modulate, out;
-
+	_filter_zdf_coefficients_t coefficients;
+	
 	if (filter_band == _FILTER_BAND_PASS_ALL)
 	{
 		return input;
 	}
 
-	modulate = setting_fmult * pow(2.0, (double)(setting_octave_mult + fmod));
+	block_fmult = calc_fmult(fmod);
 	
-	fmult = modulate + setting_kbd_fmult;
-	if (fmult > max_setting_fmult)
+	switch (filter_model)
 	{
-		fmult = max_setting_fmult;
+		case _FILTER_MODEL_ZDF_SVF:
+			calc_zdf_coefficients(block_fmult, &coefficients);
+			return zdf_state_variable_filter_process(input, coefficients.c1, coefficients.c2, coefficients.c3,
+				setting_damp, filter_band, state_ic1eq, state_ic2eq);
+			
+		case _FILTER_MODEL_LADDER:
+			calc_zdf_coefficients(block_fmult, &coefficients);
+			return ladder_filter_process(input, coefficients.c1, coefficients.c2, coefficients.c3,
+				calc_ladder_feedback(), filter_band, state_ladder);
+			
+		case _FILTER_MODEL_SVF:
+		default:
+			return state_variable_filter_process(input, block_fmult, setting_damp, filter_band,
+				state_input_prev, state_lowpass, state_bandpass);
 	}
+}
 
-	// TODO: fmult(mod)
+/**
+*	@brief	Filter a block of samples in place.
+*			The frequency modulation is updated at control rate (once per block): the 
+*			frequency multiplier (or the model coefficients) is calculated once, and linearly 
+*			interpolated from the previous block value over the block, to avoid zipper noise.
+*	@param	in_out	a pointer to a block of size samples input and output buffer
+*	@param	size	number of samples
+*	@param	fmod	frequency modulation factor
+*	@return void
+*/
+void DSP_Filter::filter_output_block(float *in_out, int size, float fmod)
+{
+	float start_fmult, target_fmult;
 	
-	damp = setting_damp;
-	input_prev = state_input_prev;
-	lowpass = state_lowpass;
-	bandpass = state_bandpass;
-				
-	lowpass = lowpass + fmult * bandpass;
-	highpass = ((input + input_prev) / 2.0f) - lowpass - damp * bandpass;
-	input_prev = input;
-	bandpass = bandpass + fmult * highpass;
-	lowpass_tmp = lowpass;
-	bandpass_tmp = bandpass;
-	highpass_tmp = highpass;
-	lowpass = lowpass + fmult * bandpass;
-	highpass = input - lowpass - damp * bandpass;
-	bandpass = bandpass + fmult * highpass;
-	lowpass_tmp = lowpass + lowpass_tmp;
-	bandpass_tmp = bandpass + bandpass_tmp;
-	highpass_tmp = highpass + highpass_tmp;
+	if ((filter_band == _FILTER_BAND_PASS_ALL) || (size <= 0))
+	{
+		return;
+	}
 	
-	switch (filter_band)
-	{				
-		case _FILTER_BAND_LPF:
-			out = lowpass_tmp;
+	target_fmult = calc_fmult(fmod);
+	start_fmult = block_fmult < 0.0f ? target_fmult : block_fmult;
+	block_fmult = target_fmult;
+	
+	switch (filter_model)
+	{
+		case _FILTER_MODEL_ZDF_SVF:
+			filter_zdf_svf_block(in_out, size, start_fmult, target_fmult);
 			break;
-						
-		case _FILTER_BAND_HPF:
-			out = highpass_tmp;
+			
+		case _FILTER_MODEL_LADDER:
+			filter_ladder_block(in_out, size, start_fmult, target_fmult);
 			break;
-						
-		case _FILTER_BAND_BPF:
-			out = bandpasstmp;
+			
+		case _FILTER_MODEL_SVF:
+		default:
+			filter_svf_block(in_out, size, start_fmult, target_fmult);
 			break;
 	}
-		
+	
+	flush_denormals();
+}
+
+/**
+*	@brief	Filter a block of samples in place - Chamberlin state variable filter
+*	@param	in_out			a pointer to a block of size samples input and output buffer
+*	@param	size			number of samples
+*	@param	start_fmult		block start frequency multiplier
+*	@param	target_fmult	block end frequency multiplier
+*	@return void
+*/
+void DSP_Filter::filter_svf_block(float *in_out, int size, float start_fmult, float target_fmult)
+{
+	float fmult = start_fmult;
+	float fmult_step = (target_fmult - start_fmult) / (float)size;
+	float damp = setting_damp;
+	float input_prev = state_input_prev;
+	float lowpass = state_lowpass;
+	float bandpass = state_bandpass;
+	int band = filter_band;
+	
+	for (int i = 0; i < size; i++)
+	{
+		fmult += fmult_step;
+		in_out[i] = state_variable_filter_process(in_out[i], fmult, damp, band, input_prev, lowpass, bandpass);
+	}
+	
 	state_input_prev = input_prev;
 	state_lowpass = lowpass;
 	state_bandpass = bandpass;
+}
+
+/**
+*	@brief	Filter a block of samples in place - zero-delay-feedback state variable filter.
+*			The coefficients are calculated for the block start and end, and linearly interpolated.
+*	@param	in_out			a pointer to a block of size samples input and output buffer
+*	@param	size			number of samples
+*	@param	start_fmult		block start frequency multiplier
+*	@param	target_fmult	block end frequency multiplier
+*	@return void
+*/
+void DSP_Filter::filter_zdf_svf_block(float *in_out, int size, float start_fmult, float target_fmult)
+{
+	_filter_zdf_coefficients_t start, target;
+	float a1, a2, a3, a1_step, a2_step, a3_step;
+	float damp = setting_damp;
+	float ic1eq = state_ic1eq;
+	float ic2eq = state_ic2eq;
+	int band = filter_band;
+	
+	calc_zdf_coefficients(start_fmult, &start);
+	calc_zdf_coefficients(target_fmult, &target);
+	
+	a1 = start.c1;
+	a2 = start.c2;
+	a3 = start.c3;
+	a1_step = (target.c1 - start.c1) / (float)size;
+	a2_step = (target.c2 - start.c2) / (float)size;
+	a3_step = (target.c3 - start.c3) / (float)size;
+	
+	for (int i = 0; i < size; i++)
+	{
+		a1 += a1_step;
+		a2 += a2_step;
+		a3 += a3_step;
+		in_out[i] = zdf_state_variable_filter_process(in_out[i], a1, a2, a3, damp, band, ic1eq, ic2eq);
+	}
+	
+	state_ic1eq = ic1eq;
+	state_ic2eq = ic2eq;
+}
+
+/**
+*	@brief	Filter a block of samples in place - 4-pole zero-delay-feedback ladder filter.
+*			The coefficients are calculated for the block start and end, and linearly interpolated.
+*	@param	in_out			a pointer to a block of size samples input and output buffer
+*	@param	size			number of samples
+*	@param	start_fmult		block start frequency multiplier
+*	@param	target_fmult	block end frequency multiplier
+*	@return void
+*/
+void DSP_Filter::filter_ladder_block(float *in_out, int size, float start_fmult, float target_fmult)
+{
+	_filter_zdf_coefficients_t start, target;
+	float gain, state_gain, norm, gain_step, state_gain_step, norm_step, feedback;
+	float state[4];
+	int stage, band = filter_band;
+	
+	calc_zdf_coefficients(start_fmult, &start);
+	calc_zdf_coefficients(target_fmult, &target);
+	
+	feedback = calc_ladder_feedback();
 	
-	return out;
+	gain = start.c1;
+	state_gain = start.c2;
+	norm = start.c3;
+	gain_step = (target.c1 - start.c1) / (float)size;
+	state_gain_step = (target.c2 - start.c2) / (float)size;
+	norm_step = (target.c3 - start.c3) / (float)size;
+	
+	for (stage = 0; stage < 4; stage++)
+	{
+		state[stage] = state_ladder[stage];
+	}
+	
+	for (int i = 0; i < size; i++)
+	{
+		gain += gain_step;
+		state_gain += state_gain_step;
+		norm += norm_step;
+		in_out[i] = ladder_filter_process(in_out[i], gain, state_gain, norm, feedback, band, state);
+	}
+	
+	for (stage = 0; stage < 4; stage++)
+	{
+		state_ladder[stage] = state[stage];
+	}
 }
 
 /**
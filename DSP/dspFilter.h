@@ -2,6 +2,12 @@
 *	@file		dspFilter.h
 *	@author		Nahum Budin
 *	@date		14-Sep-2024
+*	@version	1.3	17-Oct-2026
+*					1. Block filtering with a control rate frequency multiplier.
+*					2. Fast exp2 frequency modulation.
+*					3. Zero-delay-feedback SVF and 4-pole ladder models.
+*					4. Block states denormals flushing.
+*					
 *	@version	1.2 
 *					1. Code refactoring and notaion.
 *					
@@ -10,19 +16,35 @@
 *								2. Adding sample-rate settings
 *				31-Oct-201991.0 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1)
 *
-*	@brief		State variable filter.
+*	@brief		State variable filter (Chamberlin, ZDF) and 4-pole ZDF ladder filter.
 */
 
 #pragma once
 
 #include <math.h>
 
+// tan(pi * f / fs) lookup table size (normalized frequency 0 to 0.5)
+#define _FILTER_TAN_TABLE_SIZE			2048
+// Max normalized (f / fs) cutoff frequency of the zero-delay-feedback models
+#define _FILTER_ZDF_MAX_NORM_FREQ		0.45f
+// Ladder feedback gain at max resonance (self oscillation at 4)
+#define _FILTER_LADDER_MAX_FEEDBACK		3.9f
+
+/* Zero-delay-feedback models coefficients, calculated at control rate */
+typedef struct _filter_zdf_coefficients
+{
+	// ZDF SVF: a1 = 1/(1 + g(g + k)), a2 = g * a1, a3 = g * a2
+	// Ladder: c1 = G = g/(1 + g), c2 = 1 - G, c3 = 1/(1 + r * G^4)
+	float c1, c2, c3;
+} _filter_zdf_coefficients_t;
+
 class DSP_Filter
 {
 public:
 	DSP_Filter(int iD, int samp_rate);
 	
 	void clear();
+	void flush_denormals();
 	void set_frequency(float fr);
 	void set_frequency_relative(int fr);
 	void set_octave(float oct);
@@ -30,6 +52,8 @@ public:
 	void set_resonance(float res);
 	void set_resonance_relative(int res);
 	void set_band(int bnd);
+	void set_model(int mdl);
+	int get_model();
 	void set_kbd_freq(float frq);
 	void set_kbd_freq_relative(int frq);
 	void set_kbd_track(float kbdt);
@@ -41,8 +65,22 @@ public:
 	float get_filter_max_center_frequency();
 	
 	float filter_output(float input, float fmod = 1.0f);
+	void filter_output_block(float *in_out, int size, float fmod = 1.0f);
 		
 private:
+	float calc_fmult(float fmod);
+	float calc_ladder_feedback();
+	void calc_zdf_coefficients(float fmult, _filter_zdf_coefficients_t *coefficients);
+	
+	void filter_svf_block(float *in_out, int size, float start_fmult, float target_fmult);
+	void filter_zdf_svf_block(float *in_out, int size, float start_fmult, float target_fmult);
+	void filter_ladder_block(float *in_out, int size, float start_fmult, float target_fmult);
+	
+	static void init_tan_table();
+	static float lookup_tan(float norm_freq);
+	
+	int filter_model;
+	
 	int filter_band;
 	int filters_balance;
 	
@@ -55,14 +93,22 @@ private:
 	float state_lowpass;
 	float state_highpass;
 	float state_bandpass;
+	// ZDF SVF integrators states
+	float state_ic1eq, state_ic2eq;
+	// Ladder stages integrators states
+	float state_ladder[4];
 	float setting_kbd_fcenter;
 	float setting_kbd_fmult;
 	float kbd_track;
-	float lowpass_tmp, bandpass_tmp, highpass_tmp;
+	/* The last block frequency multiplier (block start point of the next block); < 0 if none */
+	float block_fmult;
 	
 	int sample_rate;
 	
 	static float max_setting_fcenter;
 	static float max_setting_fmult;
+	
+	static float tan_table[_FILTER_TAN_TABLE_SIZE + 2];
+	static bool tan_table_initialized;
 };
 
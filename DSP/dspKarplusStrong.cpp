@@ -1,11 +1,14 @@
 /**
 *	@file		dspKarplusStrong.h
 *	@author		Nahum Budin
-*	@date		21-Seo-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion. 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Delay line denormals flushing and state clearing.
+*					2. Destructor.
 *					
-*	@History	23-Jan-2021 1.1
+*	@History	21-Sep-2024	1.2
+*					1. Code refactoring and notaion. 
+*				23-Jan-2021 1.1
 *					1. Code refactoring and notaion. 
 *					2. Add audio sample-rate settings
 *				2-Nov-2019	1.0 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1)
@@ -19,6 +22,7 @@
 #include <stdlib.h>
 
 #include "dspKarplusStrong.h"
+#include "dspFastMath.h"
 #include "../utils/utils.h"
 
 uint16_t DSP_KarplusStrong::instance_count = 0;
@@ -79,6 +83,19 @@ DSP_KarplusStrong::DSP_KarplusStrong(int voice, int samp_rate)
 	energy = 0;
 }
 
+/**
+*	@brief	Destroys a Karplus Strong generator instance
+*	@param	none
+*	@return void
+*/
+DSP_KarplusStrong::~DSP_KarplusStrong()
+{
+	if (buffer != NULL)
+	{
+		delete[] buffer;
+	}
+}
+
 /**
 *	@brief	Sets sample-rate
 *	@param	sample  rate: _SAMPLE_RATE_44 (44100Hz) or _SAMPLE_RATE_48 (48000Hz)
@@ -178,6 +195,22 @@ float DSP_KarplusStrong::get_energy()
 	return energy; 
 }
 
+/**
+*	@brief	Clear the string delay line and the filters states (silent string)
+*	@param	none
+*	@return void
+*/
+void DSP_KarplusStrong::clear_state()
+{
+	for (int i = 0; i < buffer_len; i++)
+	{
+		buffer[i] = 0.0f;
+	}
+	
+	prior_samp = 0.0f;
+	energy = 0.0f;
+}
+
 /**
 *	@brief	Set excitation waveform variations level
 *	@param	wv excitation waveform variations level (0-100)
@@ -913,7 +946,7 @@ float DSP_KarplusStrong::get_next_output_value()
 	float in, out = 0;	
 	in = buffer[buffer_index];
 	out = low_pass(prior_samp, in, lpf_smoothing_factor); // * normDecay;//decay; 
-	buffer[buffer_index] = out * active_decay;
+	buffer[buffer_index] = dsp_flush_denormal(out * active_decay);
 	
 	if (++buffer_index >= buffer_len)
 	{
@@ -931,6 +964,22 @@ float DSP_KarplusStrong::get_next_output_value()
 	return out * 4.f;	
 }
 
+/**
+*	@brief	Return a block of next output values
+*	@param	out		a pointer to a block of size samples output buffer
+*	@param	size	number of samples
+*	@return void
+*/
+void DSP_KarplusStrong::get_next_output_block(float *out, int size)
+{
+	for (int i = 0; i < size; i++)
+	{
+		out[i] = get_next_output_value();
+	}
+	
+	energy = dsp_flush_denormal(energy);
+}
+
 /**
 *	@brief	Resonate
 *	@param	none
@@ -1,11 +1,14 @@
 /**
 *	@file		dspKarplusStrong.h
 *	@author		Nahum Budin
-*	@date		21-Seo-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion. 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Delay line denormals flushing and state clearing.
+*					2. Destructor.
 *					
-*	@History	23-Jan-2021 1.1
+*	@History	21-Sep-2024	1.2
+*					1. Code refactoring and notaion. 
+*				23-Jan-2021 1.1
 *					1. Code refactoring and notaion. 
 *					2. Add audio sample-rate settings
 *				2-Nov-2019	1.0 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1)
@@ -26,6 +29,7 @@ class DSP_KarplusStrong
 {
 public:
 	DSP_KarplusStrong(int voice, int samp_rate = _DEFAULT_SAMPLE_RATE);
+	~DSP_KarplusStrong();
 	
 	int set_sample_rate(int samp_rate);
 	int get_sample_rate();
@@ -79,7 +83,9 @@ public:
 	void init_excitation_samples();
 	
 	float get_next_output_value();
+	void get_next_output_block(float *out, int size);
 	float get_energy();	
+	void clear_state();
 	
 	
 private:
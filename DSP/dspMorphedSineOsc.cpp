@@ -1,12 +1,16 @@
 /**
 *	@file		dspMorphedSineOsc.cpp
 *	@author		Nahum Budin
-*	@date		23_Jan-2021
-*	@version	1.1 
+*	@date		17-Oct-2026
+*	@version	1.2 
+*					1. Fixed-point phase accumulator.
+*					2. Wavetable setting (pooled voices binding).
+*					3. WTAB segments settings copy and generating parameters key (shared WTABs).
+*					
+*	@History	23_Jan-2021	1.1 
 *					1. Code refactoring and notaion. 
 *					2. Adding sample-rate settings
-*					
-*	@History	31-Oct-2019	1.0 (dspWaveformLUT) (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 19-Jul-2018)
+*				31-Oct-2019	1.0 (dspWaveformLUT) (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 19-Jul-2018)
 *
 *	@brief		An oscilator that uses waveform table to generate segmented sinusudial modulated waveforms.	
 */
@@ -145,6 +149,57 @@ int DSP_MorphingSinusOscWTAB::init_waveform_tables(int samp_rate)
 	return 0;
 }
 
+/**
+*	@brief	Copy the segments positions and morphing symetry settings of another WTAB
+*			(the waveform tables are not copied).
+*	@param	source	a pointer to the source DSP_MorphingSinusOscWTAB object
+*	@return void
+*/
+void DSP_MorphingSinusOscWTAB::copy_segments_settings(DSP_MorphingSinusOscWTAB *source)
+{
+	if (source == NULL)
+	{
+		return;
+	}
+	
+	base_segment_positions = source->base_segment_positions;
+	morphed_segment_positions = source->morphed_segment_positions;
+	base_segment_lengths = source->base_segment_lengths;
+	morphed_segment_lengths = source->morphed_segment_lengths;
+	morphing_symetry = source->morphing_symetry;
+}
+
+/**
+*	@brief	Return the WTAB generating parameters as a raw bytes blob: base segments positions, 
+*			morphing symetry, WTAB length and sample-rate.
+*	@param	params	a pointer to a string that will hold the parameters blob
+*	@return void
+*/
+void DSP_MorphingSinusOscWTAB::get_generating_params(std::string *params)
+{
+	params->clear();
+	params->append((const char*)&base_segment_positions, sizeof(base_segment_positions));
+	params->append((const char*)&morphing_symetry, sizeof(morphing_symetry));
+	params->append((const char*)&waveform_tab_len, sizeof(waveform_tab_len));
+	params->append((const char*)&sample_rate, sizeof(sample_rate));
+}
+
+/**
+*	@brief	Calculate the base and the morphed waveform tables from the base segments 
+*			positions and the morphing symetry.
+*	@param	none
+*	@return void
+*/
+void DSP_MorphingSinusOscWTAB::calc_base_and_morphed_wtabs()
+{
+	calc_segments_lengths(&base_segment_lengths, &base_segment_positions);
+	calc_wtab(base_waveform_tab, &base_segment_lengths, &base_segment_positions);
+	
+	set_morphing_symetry(morphing_symetry);
+	calc_segments_lengths(&morphed_segment_lengths, &morphed_segment_positions);
+	calc_wtab(morphed_waveform_tab, &morphed_segment_lengths, &morphed_segment_positions);
+}
+
 /**
 *	@brief	Set a segment position
 *	@param	pos (enPositions) which position
@@ -532,8 +587,22 @@ DSP_MorphingSinusOsc::DSP_MorphingSinusOsc(
 	set_freq_detune_cents(detCnts);
 	set_magnitude(mag);
 	
-	wtab_index = 0;
 	wtab = lutptr;
+	phase_accumulator.set_phase(0);
+}
+
+/**
+*	@brief	Set the DSP_MorphingSinusOscWTAB wavetable object (e.g. a pooled voice is bound 
+*			to a program MSO wavetable).
+*	@param	wtab_ptr	a pointer to a DSP_MorphingSinusOscWTAB wavetable object
+*	@return void
+*/
+void DSP_MorphingSinusOsc::set_wavetable(DSP_MorphingSinusOscWTAB *wtab_ptr)
+{
+	if (wtab_ptr != NULL)
+	{
+		wtab = wtab_ptr;
+	}
 }
 
 /**
@@ -546,6 +615,22 @@ DSP_MorphingSinusOscWTAB *DSP_MorphingSinusOsc::get_wavetable()
 	return wtab;
 }
 
+/**
+*	@brief	Update the wavetable phase increment; the increment is recalculated only
+*			when the frequency (or the wavetable) is changed.
+*	@param	freq MSO frequency (Hz)
+*	@return void
+*/
+void DSP_MorphingSinusOsc::update_phase_increment(float freq)
+{
+	int wtab_length = wtab->morphed_waveform_tab->get_wtab_length();
+	
+	phase_accumulator.set_table_length(wtab_length);
+	// A full table cycle per sample
+	phase_accumulator.set_cycle_rate(wtab->get_fundemental_frequency() * (float)wtab_length);
+	phase_accumulator.set_frequency(freq);
+}
+
 /**
 *	@brief	Return next MSO LUT sample
 *	@param	freq MSO frequency (Hz)
@@ -554,31 +639,31 @@ DSP_MorphingSinusOscWTAB *DSP_MorphingSinusOsc::get_wavetable()
 */
 float DSP_MorphingSinusOsc::get_next_mso_wtab_val(float freq, int offset)
 {
-	float ofst_index, val;
-	
-	wtab_index += freq  / wtab->get_fundemental_frequency();
-	// Wrap
-	while ((int)wtab_index >= wtab->morphed_waveform_tab->get_wtab_length()) 
-	{
-		wtab_index -= wtab->morphed_waveform_tab->get_wtab_length();
-	}
+	update_phase_increment(freq);
+	phase_accumulator.advance();
 
-	if (offset > 0)
+	return phase_accumulator.read_truncated(wtab->morphed_waveform_tab->get_wtab_ptr(),
+		phase_accumulator.get_index_phase(offset)) * magnitude;
+}
+
+/**
+*	@brief	Return a block of next MSO output values
+*	@param	out		a pointer to a block of size samples output buffer
+*	@param	size	number of samples
+*	@param	freq	frequency (Hz)
+*	@return void
+*/
+void DSP_MorphingSinusOsc::get_next_mso_wtab_block(float *out, int size, float freq)
+{
+	const float *wtab_samples = wtab->morphed_waveform_tab->get_wtab_ptr();
+	
+	update_phase_increment(freq);
+	
+	for (int i = 0; i < size; i++)
 	{
-		ofst_index = wtab_index + (float)offset;
-		// Wrap
-		while ((int)ofst_index >= wtab->morphed_waveform_tab->get_wtab_length()) 
-		{
-			ofst_index -= wtab->morphed_waveform_tab->get_wtab_length();
-		}
-		val = wtab->morphed_waveform_tab->get_wtab_val((int)ofst_index);
+		phase_accumulator.advance();
+		out[i] = phase_accumulator.read_truncated(wtab_samples) * magnitude;
 	}
-	else
-	{
-		val = wtab->morphed_waveform_tab->get_wtab_val((int)wtab_index);
-	}	
-
-	return val * magnitude;
 }
 
 /**
@@ -1,19 +1,26 @@
 /**
 *	@file		dspMorphedSineOsc.h
 *	@author		Nahum Budin
-*	@date		23_Jan-2021
-*	@version	1.1 
+*	@date		17-Oct-2026
+*	@version	1.2 
+*					1. Fixed-point phase accumulator.
+*					2. Wavetable setting (pooled voices binding).
+*					3. WTAB segments settings copy and generating parameters key (shared WTABs).
+*					
+*	@History	23_Jan-2021	1.1 
 *					1. Code refactoring and notaion. 
 *					2. Adding sample-rate settings
-*					
-*	@History	31-Oct-2019	1.0 (dspWaveformLUT) (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 19-Jul-2018)
+*				31-Oct-2019	1.0 (dspWaveformLUT) (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 19-Jul-2018)
 *
 *	@brief		An oscilator that uses waveform table to generate segmented sinusudial modulated waveforms.	
 */
 
 #pragma once
 
+#include <string>
+
 #include "dspWaveformTable.h"
+#include "dspPhaseAccumulator.h"
 #include "../LibAPI/audio.h"
 
 // Waveform segments
@@ -103,6 +110,10 @@ public:
 	int get_morphing_symetry();
 	void calc_segments_lengths(st_segments_length *seglens, st_positions *positions);
 	int calc_wtab(DSP_WaveformTab *wtab, st_segments_length *seglens, st_positions *position);
+	void calc_base_and_morphed_wtabs();
+	
+	void copy_segments_settings(DSP_MorphingSinusOscWTAB *source);
+	void get_generating_params(std::string *params);
 
 	// Waveform tables
 	DSP_WaveformTab *base_waveform_tab, *morphed_waveform_tab;
@@ -149,6 +160,7 @@ public:
 		float mag = 1.0f);
 
 	float get_next_mso_wtab_val(float freq, int offset = 0);
+	void get_next_mso_wtab_block(float *out, int size, float freq);
 
 	int get_id();
 
@@ -180,13 +192,17 @@ public:
 	float get_send_level_1();
 	float get_send_level_2();
 	
+	void set_wavetable(DSP_MorphingSinusOscWTAB *wtab_ptr);
 	DSP_MorphingSinusOscWTAB *get_wavetable();
 
 private:
 
+	void update_phase_increment(float freq);
+
 	int id;
 	
-	float wtab_index;
+	// Wavetable index phase
+	DSP_PhaseAccumulator phase_accumulator;
 
 	DSP_MorphingSinusOscWTAB *wtab;
 
@@ -180,3 +180,45 @@ float DSP_Noise::get_next_noise_val()
 	return val * level;
 }
 
+/**
+*	@brief	Return a block of next noise output values
+*	@param	out		a pointer to a block of size samples output buffer
+*	@param	size	number of samples
+*	@return void
+*/
+void DSP_Noise::get_next_noise_block(float *out, int size)
+{
+	int i;
+	
+	switch (noise_type)
+	{		
+		case _WHITE_NOISE:
+			for (i = 0; i < size; i++)
+			{
+				out[i] = get_next_white_noise_val() * level;
+			}
+			break;
+					
+		case _PINK_NOISE:
+			for (i = 0; i < size; i++)
+			{
+				out[i] = get_next_pink_noise_val() * level;
+			}
+			break;
+					
+		case _BROWN_NOISE:
+			for (i = 0; i < size; i++)
+			{
+				out[i] = get_next_brown_noise_val() * level;
+			}
+			break;
+			
+		default:
+			for (i = 0; i < size; i++)
+			{
+				out[i] = 0.0f;
+			}
+			break;
+	}
+}
+
@@ -31,6 +31,7 @@ public:
 	float get_next_pink_noise_val();
 	float get_next_brown_noise_val();
 	float get_next_noise_val();
+	void get_next_noise_block(float *out, int size);
 	
 private:
 	int voice_id;
@@ -1,12 +1,17 @@
 /**
 *	@file		dspOsc.cpp
 *	@author		Nahum Budin
-*	@date		27-Sep_2024
-*	@version	1.2 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Band-limited (PolyBLEP) Saw, Square/Pulse and Triangle waveforms
+*					2. Sample accurate hard sync of band-limited waveforms blocks
+*					3. Sine harmonies mip-map mode
+*					4. Destructor
+*					
+*	@History	27-Sep-2024	1.2
 *					1. Code refactoring and notaion.
 *					2. Removing dependencies on block-size
-*					
-*	@History	25-Jan-2021	1.1
+*				25-Jan-2021	1.1
 *					1. Code refactoring and notaion. 
 *					2. Adding sample-rate settings
 *				31-Oct-2019	1.0 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 19-Jul-2018)
@@ -71,6 +76,9 @@ DSP_Osc::DSP_Osc(int iD,
 	triangle_wave = new DSP_TriangleWaveGenerator(sample_rate, (float)pwmDc / 100.0f);
 	square_wave = new DSP_SquareWaveGenerator(sample_rate, (float)pwmDc / 100.0f);
 	sample_hold_wave = new DSP_SampleHoldWaveGenerator(sample_rate);
+	blep_wave = new DSP_BlepWaveGenerator(sample_rate, (float)pwmDc / 100.0f);
+	
+	band_limited = false;
 	
 	id = iD;
 	res = set_waveform(form);
@@ -113,6 +121,20 @@ DSP_Osc::DSP_Osc(int iD,
 	set_magnitude(mag);
 }
 
+/**
+*	@brief	Destroys an oscilator instance and its waveforms generators
+*	@param	none
+*	@return	none
+*/
+DSP_Osc::~DSP_Osc()
+{
+	delete sine_wave;
+	delete triangle_wave;
+	delete square_wave;
+	delete sample_hold_wave;
+	delete blep_wave;
+}
+
 /**
 *	@brief	Sets the sample-rate
 *	@param	sample  rate: _SAMPLE_RATE_44 (44100Hz) or _SAMPLE_RATE_48 (48000Hz)
@@ -152,6 +174,11 @@ int DSP_Osc::set_sample_rate(int samp_rate)
 		sample_hold_wave->set_sample_rate(sample_rate);
 	}
 
+	if (blep_wave)
+	{
+		blep_wave->set_sample_rate(sample_rate);
+	}
+
 	return sample_rate;
 }
 
@@ -193,6 +220,11 @@ int DSP_Osc::init(int samp_rate)
 		sample_hold_wave->set_sample_rate(sample_rate);
 	}
 
+	if (blep_wave)
+	{
+		blep_wave->set_sample_rate(sample_rate);
+	}
+
 	return res;
 }
 
@@ -213,9 +245,15 @@ int DSP_Osc::get_id()
 */
 int DSP_Osc::set_waveform(int wform)
 {
-	if ((wform >= _OSC_WAVEFORM_SINE) && (wform <= _OSC_WAVEFORM_SAMPHOLD))
+	if ((wform >= _OSC_WAVEFORM_SINE) && (wform <= _OSC_WAVEFORM_SAW))
 	{
 		waveform = wform;
+		
+		if (DSP_BlepWaveGenerator::is_supported_waveform(waveform))
+		{
+			blep_wave->set_waveform(waveform);
+		}
+		
 		return waveform;
 	}
 	else
@@ -288,6 +326,11 @@ int DSP_Osc::set_pwm_dcycle(int dc)
 		triangle_wave->set_asymetry((float)pwm_percents / 100.0f);
 	}
 	
+	if (blep_wave)
+	{
+		blep_wave->set_pulse_width((float)pwm_percents / 100.0f);
+	}
+	
 	return pwm_percents;
 }
 
@@ -469,6 +512,62 @@ bool DSP_Osc::get_track_state()
 	return track_is_on; 
 }
 
+/**
+*	@brief	Set OSC band-limited state. When on, the Square, Pulse and Triangle waveforms
+*			are generated by the band-limited (PolyBLEP) oscilator (audio oscilators).
+*			When off, the naive generators are used (LFOs). The Saw waveform is always
+*			band-limited.
+*	@param bl true - band-limited on
+*	@return void
+*/
+void DSP_Osc::set_band_limited_state(bool bl)
+{
+	band_limited = bl;
+}
+
+/**
+*	@brief	Return OSC band-limited state
+*	@param none
+*	@return true - band-limited on
+*/
+bool DSP_Osc::get_band_limited_state()
+{
+	return band_limited;
+}
+
+/**
+*	@brief	Return true if the current waveform is generated by the band-limited oscilator
+*			(supports sample accurate sync blocks)
+*	@param none
+*	@return true if the band-limited oscilator is used
+*/
+bool DSP_Osc::is_band_limited_waveform()
+{
+	return (waveform == _OSC_WAVEFORM_SAW) ||
+		(band_limited && DSP_BlepWaveGenerator::is_supported_waveform(waveform));
+}
+
+/**
+*	@brief	Set OSC sine harmonies mip-map mode: bakeable harmonies settings are played
+*			from a band-limited mip-map instead of summing the harmonies.
+*	@param mode true - mip-map mode on
+*	@return void
+*/
+void DSP_Osc::set_sine_mip_map_mode(bool mode)
+{
+	sine_wave->set_mip_map_mode(mode);
+}
+
+/**
+*	@brief	Return OSC sine harmonies mip-map mode
+*	@param none
+*	@return true - mip-map mode on
+*/
+bool DSP_Osc::get_sine_mip_map_mode()
+{
+	return sine_wave->get_mip_map_mode();
+}
+
 /**
 *	@brief	Return OSC next output value
 *	@param	freq frequency (Hz)
@@ -477,6 +576,11 @@ bool DSP_Osc::get_track_state()
 float DSP_Osc::get_next_output_val(float freq)
 {
 	float val = 0;
+	
+	if (is_band_limited_waveform())
+	{
+		return blep_wave->get_next_val(freq) * magnitude;
+	}
 		
 	switch (waveform) 
 	{		
@@ -501,6 +605,104 @@ float DSP_Osc::get_next_output_val(float freq)
 	return val * magnitude;
 }
 
+/**
+*	@brief	Return a block of OSC next output values.
+*			The waveform is selected once per block.
+*	@param	out		a pointer to a block of size samples output buffer
+*	@param	size	number of samples
+*	@param	freq	frequency (Hz)
+*	@return void
+*/
+void DSP_Osc::get_next_output_block(float *out, int size, float freq)
+{
+	int i;
+	
+	if (is_band_limited_waveform())
+	{
+		get_next_sync_master_output_block(out, size, freq, NULL);
+		return;
+	}
+	
+	switch (waveform) 
+	{		
+		case _OSC_WAVEFORM_SQUARE:					
+		case _OSC_WAVEFORM_PULSE:				
+			square_wave->get_next_square_gen_out_block(out, size, freq);
+			break;
+						
+		case _OSC_WAVEFORM_TRIANGLE:					
+			triangle_wave->get_next_triangle_gen_out_block(out, size, freq);
+			break;
+							
+		case _OSC_WAVEFORM_SINE:					
+			sine_wave->get_next_sine_wtab_block(out, size, freq);				
+			break;
+				
+		case _OSC_WAVEFORM_SAMPHOLD:
+			sample_hold_wave->get_next_sample_hold_gen_out_block(out, size, freq);
+			break;
+			
+		default:
+			for (i = 0; i < size; i++)
+			{
+				out[i] = 0.0f;
+			}
+			break;
+	}
+	
+	for (i = 0; i < size; i++)
+	{
+		out[i] *= magnitude;
+	}
+}
+
+/**
+*	@brief	Return a block of band-limited OSC next output values and the positions of
+*			the cycles restarts, used to hard sync other oscilators.
+*			The phase increment is calculated once per block.
+*			Must be used only when is_band_limited_waveform() is true.
+*	@param	out				a pointer to a block of size samples output buffer
+*	@param	size			number of samples
+*	@param	freq			frequency (Hz)
+*	@param	sync_offsets	a pointer to an up to size entries buffer of the cycles restarts
+*							positions (sample index + fraction); NULL if not used
+*	@return number of cycles restarts positions written into sync_offsets
+*/
+int DSP_Osc::get_next_sync_master_output_block(float *out, int size, float freq, float *sync_offsets)
+{
+	int num_of_syncs = blep_wave->get_next_block(out, size, freq, sync_offsets);
+	
+	for (int i = 0; i < size; i++)
+	{
+		out[i] *= magnitude;
+	}
+	
+	return num_of_syncs;
+}
+
+/**
+*	@brief	Return a block of band-limited OSC next output values, hard synced at the
+*			sample accurate cycles restarts positions of a master oscilator.
+*			Must be used only when is_band_limited_waveform() is true.
+*	@param	out				a pointer to a block of size samples output buffer
+*	@param	size			number of samples
+*	@param	freq			frequency (Hz)
+*	@param	sync_offsets	the master cycles restarts positions returned by its
+*							get_next_sync_master_output_block() for the same block
+*	@param	num_of_syncs	number of sync_offsets positions
+*	@return void
+*/
+void DSP_Osc::get_next_synced_output_block(float *out, int size, float freq,
+	const float *sync_offsets, int num_of_syncs)
+{
+	blep_wave->get_next_synced_block(out, size, freq, sync_offsets, num_of_syncs);
+	
+	for (int i = 0; i < size; i++)
+	{
+		out[i] *= magnitude;
+	}
+}
+
 /**
 *	@brief Force a Sync (on a higher pitch Osc) by reseting the phase of the Osc
 *		(usually by a lower pitch Osc)
@@ -509,6 +711,12 @@ float DSP_Osc::get_next_output_val(float freq)
 */
 void DSP_Osc::sync()
 {
+	if (is_band_limited_waveform())
+	{
+		blep_wave->sync();
+		return;
+	}
+	
 	switch (waveform) 
 	{		
 		case _OSC_WAVEFORM_SQUARE:					
@@ -539,6 +747,11 @@ bool DSP_Osc::get_cycle_restarted_sync_state()
 {
 	bool res = false;
 	
+	if (is_band_limited_waveform())
+	{
+		return blep_wave->get_cycle_restarted_sync_state();
+	}
+	
 	switch (waveform) 
 	{		
 		case _OSC_WAVEFORM_SQUARE:					
@@ -1,12 +1,17 @@
 /**
 *	@file		dspOsc.h
 *	@author		Nahum Budin
-*	@date		13-Sep2024
-*	@version	1.1 
+*	@date		17-Oct-2026
+*	@version	1.2 
+*					1. Band-limited (PolyBLEP) Saw, Square/Pulse and Triangle waveforms
+*					2. Sample accurate hard sync of band-limited waveforms blocks
+*					3. Sine harmonies mip-map mode
+*					4. Destructor
+*					
+*	@History	13-Sep-2024	1.1
 *					1. Code refactoring and notaion. 
 *					2. Removing dependencies on block-size
-*					
-*	@History	25_Jan-2021	1.1 
+*				25_Jan-2021	1.1 
 *					1. Code refactoring and notaion. 
 *					2. Adding sample-rate settings
 *				31-Oct-2019 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 19-Jul-2018)
@@ -22,6 +27,7 @@
 #include "dspSquareWaveGenerator.h"
 #include "dspTriangleWaveGenerator.h"
 #include "dspSampleHoldWaveformGenerator.h"
+#include "dspBlepWaveGenerator.h"
 
 class DSP_SineWaveGenerator;
 
@@ -43,6 +49,8 @@ public:
 		float mag = 1.0f,
 		int samp_rate = _DEFAULT_SAMPLE_RATE);
 	
+	~DSP_Osc();
+	
 	int set_sample_rate(int samp_rate);
 	int get_sample_rate();
 	
@@ -76,7 +84,18 @@ public:
 	void set_track_state(bool trk);
 	bool get_track_state();
 	
+	void set_band_limited_state(bool bl);
+	bool get_band_limited_state();
+	bool is_band_limited_waveform();
+	
+	void set_sine_mip_map_mode(bool mode);
+	bool get_sine_mip_map_mode();
+	
 	float get_next_output_val(float freq);
+	void get_next_output_block(float *out, int size, float freq);
+	int get_next_sync_master_output_block(float *out, int size, float freq, float *sync_offsets);
+	void get_next_synced_output_block(float *out, int size, float freq, 
+		const float *sync_offsets, int num_of_syncs);
 	
 	float set_harmonies_detune(float det);
 	float set_harmonies_detune(int det);
@@ -132,6 +151,9 @@ private:
 	float magnitude;
 	
 	int sample_rate;
+	
+	// Square, Pulse and Triangle are band-limited (audio oscilators)
+	bool band_limited;
 
 	// Output send level
 	float send_level_1;
@@ -141,4 +163,5 @@ private:
 	DSP_TriangleWaveGenerator *triangle_wave = NULL;
 	DSP_SquareWaveGenerator *square_wave = NULL;
 	DSP_SampleHoldWaveGenerator *sample_hold_wave = NULL;
+	DSP_BlepWaveGenerator *blep_wave = NULL;
 };
@@ -0,0 +1,275 @@
+/**
+*	@file		dspPhaseAccumulator.h
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0
+*
+*	@History	1.0	17-Oct-2026	1st version
+*
+*	@brief		32-bit fixed-point phase accumulator for wavetable and waveform generators.
+*
+*				A full cycle is 2^32, so the phase wraps by the unsigned integer overflow
+*				(no compare and subtract loops). Tables lengths must be a power of 2: the table
+*				index is the upper log2(length) phase bits and the interpolation fraction is the
+*				remaining lower bits, so a 1M samples table still has 12 fraction bits.
+*				The phase increment is calculated only when the frequency changes (once per
+*				block), leaving a single integer add per sample.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <math.h>
+
+#define _PHASE_ACC_INTERPOLATION_NONE			0
+#define _PHASE_ACC_INTERPOLATION_LINEAR			1
+#define _PHASE_ACC_INTERPOLATION_CUBIC			2
+
+// A full cycle phase (2^32)
+#define _PHASE_ACC_FULL_CYCLE					4294967296.0
+#define _PHASE_ACC_MIN_TABLE_LENGTH				2
+
+class DSP_PhaseAccumulator
+{
+public:
+	DSP_PhaseAccumulator()
+	{
+		phase = 0;
+		increment = 0;
+		frequency = 0.0f;
+		cycle_rate = 1.0f;
+		interpolation = _PHASE_ACC_INTERPOLATION_NONE;
+		table_length = 0;
+		index_shift = 31;
+		index_mask = 0;
+		frac_mask = 0;
+		frac_scale = 0.0f;
+		set_table_length(_PHASE_ACC_MIN_TABLE_LENGTH);
+	}
+
+	/**
+	*	@brief	Set the table length
+	*	@param	len	table length - must be a power of 2 (at least _PHASE_ACC_MIN_TABLE_LENGTH)
+	*	@return table length if OK; -1 if len is not a power of 2
+	*/
+	int set_table_length(int len)
+	{
+		int bits = 0;
+
+		if ((len < _PHASE_ACC_MIN_TABLE_LENGTH) || (len & (len - 1)))
+		{
+			return -1;
+		}
+
+		if (len == table_length)
+		{
+			return table_length;
+		}
+
+		while ((1 << bits) < len)
+		{
+			bits++;
+		}
+
+		table_length = len;
+		index_shift = 32 - bits;
+		index_mask = (uint32_t)len - 1;
+		frac_mask = ((uint32_t)1 << index_shift) - 1;
+		frac_scale = (float)(1.0 / (double)((uint32_t)1 << index_shift));
+
+		return table_length;
+	}
+
+	int get_table_length() { return table_length; }
+
+	/**
+	*	@brief	Set the table reading interpolation mode
+	*	@param	mode	_PHASE_ACC_INTERPOLATION_NONE, _PHASE_ACC_INTERPOLATION_LINEAR or
+	*					_PHASE_ACC_INTERPOLATION_CUBIC
+	*	@return mode if OK; -1 if param out of range
+	*/
+	int set_interpolation(int mode)
+	{
+		if ((mode < _PHASE_ACC_INTERPOLATION_NONE) || (mode > _PHASE_ACC_INTERPOLATION_CUBIC))
+		{
+			return -1;
+		}
+
+		interpolation = mode;
+
+		return interpolation;
+	}
+
+	int get_interpolation() { return interpolation; }
+
+	/**
+	*	@brief	Set the rate of the phase advance: a frequency equal to the cycle rate advances
+	*			a full cycle per sample (the sample-rate for waveform generators).
+	*	@param	rate	cycle rate [Hz]
+	*	@return void
+	*/
+	void set_cycle_rate(float rate)
+	{
+		if ((rate > 0.0f) && (rate != cycle_rate))
+		{
+			cycle_rate = rate;
+			increment = calc_increment((double)frequency / (double)cycle_rate);
+		}
+	}
+
+	float get_cycle_rate() { return cycle_rate; }
+
+	/**
+	*	@brief	Set the frequency; the phase increment is recalculated only when it changes
+	*	@param	freq	frequency [Hz]
+	*	@return void
+	*/
+	void set_frequency(float freq)
+	{
+		if (freq != frequency)
+		{
+			frequency = freq;
+			increment = calc_increment((double)frequency / (double)cycle_rate);
+		}
+	}
+
+	float get_frequency() { return frequency; }
+
+	/**
+	*	@brief	Return the phase increment of a given cycles per sample step
+	*	@param	cycles_per_sample	cycle fraction advanced per sample (-1 to +1)
+	*	@return phase increment
+	*/
+	static uint32_t calc_increment(double cycles_per_sample)
+	{
+		return (uint32_t)(int64_t)llrint(cycles_per_sample * _PHASE_ACC_FULL_CYCLE);
+	}
+
+	void set_increment(uint32_t inc)
+	{
+		increment = inc;
+		frequency = (float)((double)(int32_t)inc * (double)cycle_rate / _PHASE_ACC_FULL_CYCLE);
+	}
+
+	uint32_t get_increment() { return increment; }
+
+	void set_phase(uint32_t ph) { phase = ph; }
+	uint32_t get_phase() { return phase; }
+
+	/**
+	*	@brief	Set the phase as a cycle fraction
+	*	@param	frac	cycle fraction 0 to 1
+	*	@return void
+	*/
+	void set_phase_fraction(float frac)
+	{
+		phase = (uint32_t)(int64_t)((double)(frac - floorf(frac)) * _PHASE_ACC_FULL_CYCLE);
+	}
+
+	/**
+	*	@brief	Return the phase as a cycle fraction
+	*	@param	none
+	*	@return cycle fraction 0 to 1
+	*/
+	float get_phase_fraction() { return (float)phase * (float)(1.0 / _PHASE_ACC_FULL_CYCLE); }
+
+	/**
+	*	@brief	Advance the phase by the increment
+	*	@param	none
+	*	@return true if a new cycle has started (phase wrapped)
+	*/
+	bool advance()
+	{
+		uint32_t prev = phase;
+
+		phase += increment;
+
+		return phase < prev;
+	}
+
+	/**
+	*	@brief	Return the table index of the phase
+	*	@param	offset	phase offset (e.g. 0x80000000 reads half a cycle away)
+	*	@return table index
+	*/
+	int get_index(uint32_t offset = 0) { return (int)((phase + offset) >> index_shift); }
+
+	/**
+	*	@brief	Return the phase of a table index
+	*	@param	index	table index
+	*	@return phase (offset) of the index
+	*/
+	uint32_t get_index_phase(int index) { return ((uint32_t)index & index_mask) << index_shift; }
+
+	/**
+	*	@brief	Return the table value at the phase using the set interpolation mode
+	*	@param	table	a pointer to a table of table-length samples
+	*	@param	offset	phase offset
+	*	@return table value
+	*/
+	float read(const float *table, uint32_t offset = 0)
+	{
+		if (interpolation == _PHASE_ACC_INTERPOLATION_LINEAR)
+		{
+			return read_linear(table, offset);
+		}
+		else if (interpolation == _PHASE_ACC_INTERPOLATION_CUBIC)
+		{
+			return read_cubic(table, offset);
+		}
+		else
+		{
+			return read_truncated(table, offset);
+		}
+	}
+
+	float read_truncated(const float *table, uint32_t offset = 0)
+	{
+		return table[(phase + offset) >> index_shift];
+	}
+
+	float read_linear(const float *table, uint32_t offset = 0)
+	{
+		uint32_t ph = phase + offset;
+		uint32_t index = ph >> index_shift;
+		float frac = (float)(ph & frac_mask) * frac_scale;
+		float y0 = table[index];
+		float y1 = table[(index + 1) & index_mask];
+
+		return y0 + frac * (y1 - y0);
+	}
+
+	/* 4 points, 3rd order Hermite (Catmull-Rom) */
+	float read_cubic(const float *table, uint32_t offset = 0)
+	{
+		uint32_t ph = phase + offset;
+		uint32_t index = ph >> index_shift;
+		float frac = (float)(ph & frac_mask) * frac_scale;
+		float ym1 = table[(index - 1) & index_mask];
+		float y0 = table[index];
+		float y1 = table[(index + 1) & index_mask];
+		float y2 = table[(index + 2) & index_mask];
+		float c1 = 0.5f * (y1 - ym1);
+		float c2 = ym1 - 2.5f * y0 + 2.0f * y1 - 0.5f * y2;
+		float c3 = 0.5f * (y2 - ym1) + 1.5f * (y0 - y1);
+
+		return ((c3 * frac + c2) * frac + c1) * frac + y0;
+	}
+
+private:
+	// Cycle phase 0 to 2^32 - 1
+	uint32_t phase;
+	// Phase step per sample
+	uint32_t increment;
+	float frequency;
+	float cycle_rate;
+	int interpolation;
+
+	int table_length;
+	// Table index = phase >> index_shift
+	int index_shift;
+	uint32_t index_mask;
+	// Interpolation fraction = (phase & frac_mask) * frac_scale
+	uint32_t frac_mask;
+	float frac_scale;
+};
@@ -1,11 +1,12 @@
 /**
 *	@file		dspSampleHoldWaveformGenerator.cpp
 *	@author		Nahum Budin
-*	@date		13-Sep2024
-*	@version	1.1 
-*					1. Code refactoring and notaion. 
+*	@date		17-Oct-2026
+*	@version	1.2 
+*					1. Fixed-point phase accumulator. 
 *					
-*	@History	25_Jan-2021	1.1 
+*	@History	13-Sep2024	1.1 Code refactoring and notaion. 
+*				25_Jan-2021	1.1 
 *					1. Code refactoring and notaion. 
 *					2. Adding sample-rate settings
 *				31-Oct-2019 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 19-Jul-2018)
@@ -48,7 +49,8 @@ int DSP_SampleHoldWaveGenerator::set_sample_rate(int samp_rate)
 		sample_rate = samp_rate;
 	}
 	
-	pos = 0;
+	phase_accumulator.set_cycle_rate((float)sample_rate);
+	phase_accumulator.set_phase(0);
 	cycle_restarted = false;
 	sample = 0;
 	
@@ -69,33 +71,34 @@ int DSP_SampleHoldWaveGenerator::get_sample_rate() { return sample_rate; }
 */
 float DSP_SampleHoldWaveGenerator::get_next_sample_hold_gen_out_val(float freq)
 {
-	float freq_step = freq / (float)sample_rate;
-	
-	cycle_restarted = false;
+	// The phase increment is recalculated only when the frequency is changed
+	phase_accumulator.set_frequency(freq);
+	// A new sample is taken when the phase wraps to 0
+	cycle_restarted = phase_accumulator.advance();
 	
-	if (pos > 1)
-	{
-		// pos only 0 to 1
-		pos -= 1;
-		if (pos < freq_step)
-		{
-			sample = -0.8f + 1.6f * (float)(rand() % 99999) / 100000.0f;
-		}
-		cycle_restarted = true;
-	}
-	else
+	if (cycle_restarted)
 	{
-		if (pos < 0)
-		{
-			pos += 1;
-		}
+		sample = -0.8f + 1.6f * (float)(rand() % 99999) / 100000.0f;
 	}
 	
-	pos += freq_step;
-	
 	return sample;
 }
 
+/**
+*	@brief	Return a block of next sample and hold output values
+*	@param	out		a pointer to a block of size samples output buffer
+*	@param	size	number of samples
+*	@param	freq	frequency (Hz)
+*	@return void
+*/
+void DSP_SampleHoldWaveGenerator::get_next_sample_hold_gen_out_block(float *out, int size, float freq)
+{
+	for (int i = 0; i < size; i++)
+	{
+		out[i] = get_next_sample_hold_gen_out_val(freq);
+	}
+}
+
 /**
 *	@brief	Sync S&H generator by zeroing the phase
 *	@param	none
@@ -103,7 +106,7 @@ float DSP_SampleHoldWaveGenerator::get_next_sample_hold_gen_out_val(float freq)
 */
 void DSP_SampleHoldWaveGenerator::sync()
 {
-	pos = 0;
+	phase_accumulator.set_phase(0);
 }
 
 /**
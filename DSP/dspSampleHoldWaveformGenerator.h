@@ -1,11 +1,12 @@
 /**
 *	@file		dspSampleHoldWaveformGenerator.h
 *	@author		Nahum Budin
-*	@date		13-Sep2024
-*	@version	1.1 
-*					1. Code refactoring and notaion. 
+*	@date		17-Oct-2026
+*	@version	1.2 
+*					1. Fixed-point phase accumulator. 
 *					
-*	@History	25_Jan-2021	1.1 
+*	@History	13-Sep2024	1.1 Code refactoring and notaion. 
+*				25_Jan-2021	1.1 
 *					1. Code refactoring and notaion. 
 *					2. Adding sample-rate settings
 *				31-Oct-2019 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 19-Jul-2018)
@@ -14,6 +15,9 @@
 */
 
 #pragma once
+
+#include "dspPhaseAccumulator.h"
+
 class DSP_SampleHoldWaveGenerator
 {
 public:	
@@ -26,13 +30,15 @@ public:
 	bool get_cycle_restarted_sync_state();
 	
 	float get_next_sample_hold_gen_out_val(float freq);	
+	void get_next_sample_hold_gen_out_block(float *out, int size, float freq);
 	
 private:
 	
 	int init();
 	
 	
-	float pos;
+	// Sampling cycle phase
+	DSP_PhaseAccumulator phase_accumulator;
 	float sample;
 	bool cycle_restarted;
 	
@@ -0,0 +1,430 @@
+/**
+*	@file		dspSineMipMap.cpp
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0
+*
+*	@History	17-Oct-2026	1.0	1st version
+*
+*	@brief		Sine oscilator harmonies mip-mapped wavetables.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "dspSineMipMap.h"
+#include "dspSineWaveGenerator.h"
+#include "../utils/FFTwrapper.h"
+#include "../utils/utils.h"
+
+#define _SINE_MIP_MAP_RAW_SIZE		(_SINE_MIP_MAP_TABLE_SIZE * _SINE_MIP_MAP_RAW_OVERSAMPLING)
+
+/* A pointer to the singleton DSP_SineMipMapBuilder instance */
+DSP_SineMipMapBuilder *DSP_SineMipMapBuilder::mip_map_builder_instance = NULL;
+
+/**
+*   @brief  Create and return a pointer to the singleton DSP_SineMipMapBuilder instance.
+*			Must be first called before the audio starts (DSP_Osc creation).
+*   @param  none
+*   @return a pointer to the singleton DSP_SineMipMapBuilder instance
+*/
+DSP_SineMipMapBuilder *DSP_SineMipMapBuilder::get_instance()
+{
+	if (!mip_map_builder_instance)
+	{
+		mip_map_builder_instance = new DSP_SineMipMapBuilder();
+	}
+
+	return mip_map_builder_instance;
+}
+
+/**
+*   @brief  Create a DSP_SineMipMapBuilder object instance.
+*			The builder thread is started on the 1st request.
+*   @param  none
+*   @return none
+*/
+DSP_SineMipMapBuilder::DSP_SineMipMapBuilder()
+{
+	mip_map_builder_instance = this;
+
+	pthread_mutex_init(&builder_mutex, NULL);
+	pthread_cond_init(&request_cv, NULL);
+	pthread_cond_init(&done_cv, NULL);
+
+	builder_thread_running = false;
+	building_for = NULL;
+
+	for (int i = 0; i < _SINE_MIP_MAP_CACHE_SIZE; i++)
+	{
+		cache[i] = NULL;
+	}
+}
+
+/**
+*   @brief  Returns a monotonic time stamp
+*   @param  none
+*   @return time [mSec]
+*/
+uint64_t DSP_SineMipMapBuilder::get_time_ms()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+/**
+*   @brief  Returns the mip-map level to be used for a base frequency: the lowest level
+*			whose highest harmony is below the Nyquist frequency.
+*   @param  base_freq	mip-map base cycle frequency [Hz]
+*   @param  samp_rate	sample rate [Hz]
+*   @return mip-map level 0 to _SINE_MIP_MAP_NUM_OF_LEVELS - 1
+*/
+int DSP_SineMipMapBuilder::get_mip_map_level(float base_freq, int samp_rate)
+{
+	// Max base frequency of level 0
+	float max_freq = (float)samp_rate / (float)_SINE_MIP_MAP_TABLE_SIZE;
+	int level = 0;
+
+	while ((level < _SINE_MIP_MAP_NUM_OF_LEVELS - 1) && (base_freq > max_freq))
+	{
+		max_freq *= 2.0f;
+		level++;
+	}
+
+	return level;
+}
+
+/**
+*   @brief  Requests a mip-map for a generator (called when its harmonies parameters change).
+*			The generator is switched to its harmonies path until the mip-map is ready.
+*			If the mip-map is cached it is used at once; otherwise it is built by the
+*			builder thread.
+*   @param  gen		a pointer to the generator
+*   @param  key		a pointer to the generator new mip-map parameters
+*   @return void
+*/
+void DSP_SineMipMapBuilder::request_mip_map(DSP_SineWaveGenerator *gen, _sine_mip_map_key_t *key)
+{
+	_sine_mip_map_t *mip_map;
+	int ret;
+
+	pthread_mutex_lock(&builder_mutex);
+
+	if (gen->mip_map_owned && (memcmp(&gen->mip_map_owned->key, key, sizeof(_sine_mip_map_key_t)) == 0))
+	{
+		// No change
+		gen->mip_map_active.store(gen->mip_map_owned, std::memory_order_release);
+		pthread_mutex_unlock(&builder_mutex);
+		return;
+	}
+
+	release_owned_mip_map(gen);
+
+	gen->mip_map_pending_key = *key;
+
+	mip_map = find_mip_map(key);
+	if (mip_map)
+	{
+		mip_map->ref_count++;
+		gen->mip_map_owned = mip_map;
+		gen->mip_map_active.store(mip_map, std::memory_order_release);
+	}
+	else if (!gen->mip_map_request_pending)
+	{
+		gen->mip_map_request_pending = true;
+		requests.push_back(gen);
+
+		if (!builder_thread_running)
+		{
+			ret = pthread_create(&builder_thread_id, NULL, builder_thread, this);
+			if (ret != 0)
+			{
+				fprintf(stderr, "Sine mip-map builder: thread creation error %i\n", ret);
+			}
+			else
+			{
+				pthread_setname_np(builder_thread_id, "sine_mip_map");
+				builder_thread_running = true;
+			}
+		}
+
+		pthread_cond_signal(&request_cv);
+	}
+
+	pthread_mutex_unlock(&builder_mutex);
+}
+
+/**
+*   @brief  Releases a generator mip-map and cancels its pending request; the generator uses its
+*			harmonies path. Waits if a mip-map is being built for the generator.
+*   @param  gen		a pointer to the generator
+*   @return void
+*/
+void DSP_SineMipMapBuilder::release_mip_map(DSP_SineWaveGenerator *gen)
+{
+	pthread_mutex_lock(&builder_mutex);
+
+	while (building_for == gen)
+	{
+		pthread_cond_wait(&done_cv, &builder_mutex);
+	}
+
+	for (std::deque<DSP_SineWaveGenerator*>::iterator it = requests.begin(); it != requests.end(); it++)
+	{
+		if (*it == gen)
+		{
+			requests.erase(it);
+			break;
+		}
+	}
+
+	gen->mip_map_request_pending = false;
+	release_owned_mip_map(gen);
+
+	pthread_mutex_unlock(&builder_mutex);
+}
+
+/**
+*   @brief  Releases a generator owned mip-map (builder mutex must be locked)
+*   @param  gen		a pointer to the generator
+*   @return void
+*/
+void DSP_SineMipMapBuilder::release_owned_mip_map(DSP_SineWaveGenerator *gen)
+{
+	gen->mip_map_active.store(NULL, std::memory_order_release);
+
+	if (gen->mip_map_owned)
+	{
+		gen->mip_map_owned->ref_count--;
+		if (gen->mip_map_owned->ref_count == 0)
+		{
+			gen->mip_map_owned->release_time_ms = get_time_ms();
+		}
+
+		gen->mip_map_owned = NULL;
+	}
+}
+
+/**
+*   @brief  Looks for a cached mip-map (builder mutex must be locked)
+*   @param  key		a pointer to the mip-map parameters
+*   @return a pointer to the cached mip-map; NULL if not found
+*/
+_sine_mip_map_t *DSP_SineMipMapBuilder::find_mip_map(_sine_mip_map_key_t *key)
+{
+	for (int i = 0; i < _SINE_MIP_MAP_CACHE_SIZE; i++)
+	{
+		if (cache[i] && (memcmp(&cache[i]->key, key, sizeof(_sine_mip_map_key_t)) == 0))
+		{
+			return cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+*   @brief  Adds a mip-map to the cache (builder mutex must be locked).
+*			When the cache is full, the least recently released mip-map that is not referenced
+*			for more than _SINE_MIP_MAP_EVICT_GRACE_MS is evicted.
+*   @param  mip_map		a pointer to a new mip-map
+*   @return mip_map if added; NULL if the cache is full
+*/
+_sine_mip_map_t *DSP_SineMipMapBuilder::add_mip_map(_sine_mip_map_t *mip_map)
+{
+	uint64_t now = get_time_ms();
+	int slot = -1;
+
+	for (int i = 0; i < _SINE_MIP_MAP_CACHE_SIZE; i++)
+	{
+		if (cache[i] == NULL)
+		{
+			slot = i;
+			break;
+		}
+
+		if ((cache[i]->ref_count == 0) &&
+			(now - cache[i]->release_time_ms > _SINE_MIP_MAP_EVICT_GRACE_MS) &&
+			((slot < 0) || (cache[i]->release_time_ms < cache[slot]->release_time_ms)))
+		{
+			slot = i;
+		}
+	}
+
+	return_val_if_true(slot < 0, NULL);
+
+	if (cache[slot])
+	{
+		delete cache[slot];
+	}
+
+	cache[slot] = mip_map;
+
+	return mip_map;
+}
+
+/**
+*   @brief  Bakes the harmonies into a raw cycle and band-limits it per mip-map level.
+*   @param  mip_map		a pointer to the mip-map, with its key set
+*   @param  raw			a pointer to a _SINE_MIP_MAP_RAW_SIZE samples buffer
+*   @param  freqs		a pointer to a _SINE_MIP_MAP_RAW_SIZE / 2 bins fft_t spectrum buffer
+*   @return void
+*/
+void DSP_SineMipMapBuilder::build_mip_map(_sine_mip_map_t *mip_map, float *raw, void *freqs)
+{
+	static FFTwrapper raw_fft(_SINE_MIP_MAP_RAW_SIZE);
+	static FFTwrapper table_fft(_SINE_MIP_MAP_TABLE_SIZE);
+	fft_t *spectrum = (fft_t*)freqs;
+	fft_t *level_spectrum = spectrum + _SINE_MIP_MAP_RAW_SIZE / 2;
+	_sine_mip_map_key_t *key = &mip_map->key;
+	double normalize = 0, value, phase, index, distort = key->distortion;
+	int harmony, sample, bin, max_bin;
+
+	for (harmony = 0; harmony < _NUM_OF_HARMONIES; harmony++)
+	{
+		if (key->multiples[harmony] > 0)
+		{
+			normalize += key->levels[harmony];
+		}
+	}
+
+	if (normalize == 0)
+	{
+		normalize = 1.0;
+	}
+
+	// One base cycle; each harmony index is distorted as in get_sine_wtab_val()
+	for (sample = 0; sample < _SINE_MIP_MAP_RAW_SIZE; sample++)
+	{
+		value = 0;
+
+		for (harmony = 0; harmony < _NUM_OF_HARMONIES; harmony++)
+		{
+			if (key->multiples[harmony] == 0)
+			{
+				continue;
+			}
+
+			phase = (double)sample * key->multiples[harmony] / _SINE_MIP_MAP_RAW_SIZE;
+			index = (phase - floor(phase)) * _SINE_MIP_MAP_TABLE_SIZE;
+			index = distort * index + index * index * (1.0 - distort) / _SINE_MIP_MAP_TABLE_SIZE;
+			index = sin(2.0 * M_PI * index / _SINE_MIP_MAP_TABLE_SIZE);
+
+			if (key->square)
+			{
+				value += index > 0 ? key->levels[harmony] : -key->levels[harmony];
+			}
+			else
+			{
+				value += index * key->levels[harmony];
+			}
+		}
+
+		raw[sample] = (float)(value / normalize);
+	}
+
+	raw_fft.smps2freqs(raw, spectrum);
+
+	for (int level = 0; level < _SINE_MIP_MAP_NUM_OF_LEVELS; level++)
+	{
+		max_bin = (_SINE_MIP_MAP_TABLE_SIZE / 2) >> level;
+
+		for (bin = 0; bin < _SINE_MIP_MAP_TABLE_SIZE / 2; bin++)
+		{
+			level_spectrum[bin] = bin <= max_bin ? spectrum[bin] / (double)_SINE_MIP_MAP_RAW_SIZE : fft_t(0, 0);
+		}
+
+		table_fft.freqs2smps(level_spectrum, mip_map->tables[level]);
+		mip_map->tables[level][_SINE_MIP_MAP_TABLE_SIZE] = mip_map->tables[level][0];
+	}
+}
+
+/**
+*   @brief  The builder thread
+*   @param  arg		a pointer to the DSP_SineMipMapBuilder instance
+*   @return NULL
+*/
+void *DSP_SineMipMapBuilder::builder_thread(void *arg)
+{
+	((DSP_SineMipMapBuilder*)arg)->run_builder();
+
+	return NULL;
+}
+
+/**
+*   @brief  Builds the requested mip-maps and hands them to the generators
+*   @param  none
+*   @return void
+*/
+void DSP_SineMipMapBuilder::run_builder()
+{
+	float *raw = new float[_SINE_MIP_MAP_RAW_SIZE];
+	fft_t *freqs = new fft_t[_SINE_MIP_MAP_RAW_SIZE / 2 + _SINE_MIP_MAP_TABLE_SIZE / 2];
+	DSP_SineWaveGenerator *gen;
+	_sine_mip_map_t *mip_map, *built;
+	_sine_mip_map_key_t key;
+	bool cache_full_reported = false;
+
+	pthread_mutex_lock(&builder_mutex);
+
+	while (true)
+	{
+		while (requests.empty())
+		{
+			pthread_cond_wait(&request_cv, &builder_mutex);
+		}
+
+		gen = requests.front();
+		requests.pop_front();
+		gen->mip_map_request_pending = false;
+		key = gen->mip_map_pending_key;
+
+		mip_map = find_mip_map(&key);
+		if (!mip_map)
+		{
+			building_for = gen;
+			pthread_mutex_unlock(&builder_mutex);
+
+			built = new _sine_mip_map_t;
+			built->key = key;
+			built->ref_count = 0;
+			built->release_time_ms = get_time_ms();
+			build_mip_map(built, raw, freqs);
+
+			pthread_mutex_lock(&builder_mutex);
+			building_for = NULL;
+			pthread_cond_broadcast(&done_cv);
+
+			mip_map = add_mip_map(built);
+			if (!mip_map)
+			{
+				delete built;
+
+				if (!cache_full_reported)
+				{
+					fprintf(stderr, "Sine mip-map builder: cache is full; harmonies path is used\n");
+					cache_full_reported = true;
+				}
+			}
+		}
+
+		// Use it only if the generator parameters did not change meanwhile
+		if (mip_map && !gen->mip_map_owned &&
+			(memcmp(&gen->mip_map_pending_key, &key, sizeof(_sine_mip_map_key_t)) == 0))
+		{
+			mip_map->ref_count++;
+			gen->mip_map_owned = mip_map;
+			gen->mip_map_active.store(mip_map, std::memory_order_release);
+		}
+	}
+
+	pthread_mutex_unlock(&builder_mutex);
+
+	delete[] raw;
+	delete[] freqs;
+}
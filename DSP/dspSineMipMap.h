@@ -0,0 +1,105 @@
+/**
+*	@file		dspSineMipMap.h
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0
+*
+*	@History	17-Oct-2026	1.0	1st version
+*
+*	@brief		Sine oscilator harmonies mip-mapped wavetables.
+*
+*				The active harmonies levels, frequencies multiples and the harmonies
+*				distortion of a DSP_SineWaveGenerator are baked into a single cycle wavetable,
+*				band-limited per octave (one table per mip-map level), so the audio path does a
+*				single interpolated read per sample instead of summing up to _NUM_OF_HARMONIES
+*				lookups.
+*				Mip-maps are built by a builder thread (off the audio thread) and shared between
+*				all the generators that use the same parameters.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <pthread.h>
+#include <stdint.h>
+
+#include "../LibAPI/synthesizer.h"
+
+// Base cycle table length (same as the sine wavetable)
+#define _SINE_MIP_MAP_TABLE_SIZE				2048
+// Level 0 holds harmonies up to _SINE_MIP_MAP_TABLE_SIZE / 2; each level holds half of the previous
+#define _SINE_MIP_MAP_NUM_OF_LEVELS				11
+// The raw waveform is sampled at a higher rate before band-limiting
+#define _SINE_MIP_MAP_RAW_OVERSAMPLING			4
+// Max number of cached mip-maps
+#define _SINE_MIP_MAP_CACHE_SIZE				32
+// An unreferenced mip-map may be evicted only after this time (no audio thread reads it)
+#define _SINE_MIP_MAP_EVICT_GRACE_MS			2000
+// Max relative deviation of a harmony frequency from an integer multiple of the base frequency
+#define _SINE_MIP_MAP_MAX_RATIO_ERROR			0.0012f
+
+class DSP_SineWaveGenerator;
+
+/* Mip-map generating parameters */
+typedef struct sine_mip_map_key
+{
+	// Harmonies frequencies as multiples of the base frequency (0: harmony not used)
+	uint8_t multiples[_NUM_OF_HARMONIES];
+	float levels[_NUM_OF_HARMONIES];
+	// Base cycle frequency / fundemental frequency
+	float base_ratio;
+	float distortion;
+	int32_t square;
+} _sine_mip_map_key_t;
+
+/* An immutable band-limited mip-map */
+typedef struct sine_mip_map
+{
+	_sine_mip_map_key_t key;
+	// Each level has a guard sample for interpolation
+	float tables[_SINE_MIP_MAP_NUM_OF_LEVELS][_SINE_MIP_MAP_TABLE_SIZE + 1];
+	// Number of generators using the mip-map (guarded by the builder mutex)
+	int ref_count;
+	// Time the mip-map became unreferenced [mSec]
+	uint64_t release_time_ms;
+} _sine_mip_map_t;
+
+class DSP_SineMipMapBuilder
+{
+public:
+	static DSP_SineMipMapBuilder *get_instance();
+
+	void request_mip_map(DSP_SineWaveGenerator *gen, _sine_mip_map_key_t *key);
+	void release_mip_map(DSP_SineWaveGenerator *gen);
+
+	static int get_mip_map_level(float base_freq, int samp_rate);
+
+private:
+	DSP_SineMipMapBuilder();
+
+	static void *builder_thread(void *arg);
+	void run_builder();
+
+	_sine_mip_map_t *find_mip_map(_sine_mip_map_key_t *key);
+	_sine_mip_map_t *add_mip_map(_sine_mip_map_t *mip_map);
+	void release_owned_mip_map(DSP_SineWaveGenerator *gen);
+	static void build_mip_map(_sine_mip_map_t *mip_map, float *raw, void *freqs);
+
+	static uint64_t get_time_ms();
+
+	static DSP_SineMipMapBuilder *mip_map_builder_instance;
+
+	pthread_mutex_t builder_mutex;
+	pthread_cond_t request_cv;
+	pthread_cond_t done_cv;
+	pthread_t builder_thread_id;
+	bool builder_thread_running;
+
+	// Generators waiting for a mip-map
+	std::deque<DSP_SineWaveGenerator*> requests;
+	// The generator the builder thread is building a mip-map for
+	DSP_SineWaveGenerator *building_for;
+
+	_sine_mip_map_t *cache[_SINE_MIP_MAP_CACHE_SIZE];
+};
@@ -1,13 +1,16 @@
 /**
 *	@file		dspSineWaveGenerator.h
 *	@author		Nahum Budin
-*	@date		13-Sep2024
-*	@version	1.1 
+*	@date		17-Oct-2026
+*	@version	1.2 
+*					1. Harmonies mip-map mode.
+*					2. One index step division for all the harmonies.
+*					
+*	@History	13-Sep-2024	1.1
 *					1. Code refactoring and notaion. 
 *					2. Change wavefor table length to _SINE_WAVETABLE_SIZE (2048)
 *					    and not based on the audio-block length.
-*					
-*	@History	24_Jan-2021	1.1 
+*				24_Jan-2021	1.1 
 *					1. Code refactoring and notaion. 
 *					2. Adding sample-rate settings
 *				31-Oct-2019 (dspWaveformLUT) (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 19-Jul-2018)
@@ -15,6 +18,8 @@
 *	@brief		Sine Wave Oscilator.
 */
 
+#include <string.h>
+
 #include "dspSineWaveGenerator.h"
 #include "../utils/utils.h"
 #include "../LibAPI/synthesizer.h"
@@ -43,9 +48,22 @@ DSP_SineWaveGenerator::DSP_SineWaveGenerator(int samp_rate)
 	
 	square = false;
 	
+	mip_map_mode = false;
+	mip_map_active.store(NULL);
+	mip_map_owned = NULL;
+	mip_map_request_pending = false;
+	
 	set_harmonizig_frequencies(unison_mode, harmonies_detune_factor);	
 }
 
+DSP_SineWaveGenerator::~DSP_SineWaveGenerator()
+{
+	if (mip_map_mode)
+	{
+		DSP_SineMipMapBuilder::get_instance()->release_mip_map(this);
+	}
+}
+
 /**
 *	@brief	Sets the sample-rate
 *	@param	sample rate: _SAMPLE_RATE_44 (44100Hz) or _SAMPLE_RATE_48 (48000Hz)
@@ -140,6 +158,7 @@ int DSP_SineWaveGenerator::set_unison_mode(int mod)
 	{
 		unison_mode = mod;
 		set_harmonizig_frequencies(mod, harmonies_detune_factor);
+		update_mip_map();
 		return unison_mode;
 	}
 	else
@@ -167,6 +186,8 @@ float DSP_SineWaveGenerator::set_harmoies_distortion_factor(float dist)
 		harmonies_dist_factor = _MIN_HARMONIES_DISTORTION_FACTOR;
 	}
 	
+	update_mip_map();
+	
 	return harmonies_dist_factor;
 }
 
@@ -197,6 +218,7 @@ float DSP_SineWaveGenerator::set_harmonies_detune_factor(float harm)
 	}
 	
 	set_harmonizig_frequencies(unison_mode, harmonies_detune_factor);
+	update_mip_map();
 	
 	return harmonies_detune_factor;
 }
@@ -232,6 +254,8 @@ float DSP_SineWaveGenerator::set_harmony_level(int har, float lev)
 		harmonies_levels[har] = 1.0f;
 	}
 	
+	update_mip_map();
+	
 	return harmonies_levels[har];
 }
 
@@ -267,12 +291,44 @@ bool DSP_SineWaveGenerator::get_fund_harm_cycle_restarted_state() { return cycle
 */	 
 float DSP_SineWaveGenerator::get_next_sine_wtab_val(float freq)
 {
+	_sine_mip_map_t *mip_map = mip_map_active.load(std::memory_order_acquire);
+	
+	if (mip_map)
+	{
+		float val;
+		get_next_mip_map_block(mip_map, &val, 1, freq);
+		return val;
+	}
+	
 	float value = get_sine_wtab_val(&fl_harmonies_wtab_indexes[0], harmonies_dist_factor);
 	// update sine wavetable indexes 
 	calc_sin_wtab_index(&fl_harmonies_wtab_indexes[0], harmonies_dist_factor, freq);
 	return value;
 }
 
+/**
+ *	@brief	Return a block of next output values from the Sine LUT including harmonies
+ *	@param	out		a pointer to a block of size samples output buffer
+ *	@param	size	number of samples
+ *	@param	freq	frequency (Hz)
+ *	@return	void
+*/
+void DSP_SineWaveGenerator::get_next_sine_wtab_block(float *out, int size, float freq)
+{
+	_sine_mip_map_t *mip_map = mip_map_active.load(std::memory_order_acquire);
+	
+	if (mip_map)
+	{
+		get_next_mip_map_block(mip_map, out, size, freq);
+		return;
+	}
+	
+	for (int i = 0; i < size; i++)
+	{
+		out[i] = get_next_sine_wtab_val(freq);
+	}
+}
+
 /**
  *	@brief	Get a value from the Sine LUT including harmonies; applly distortion 
  *	@param	hrmoniesIndexes		a pointer to an array to harmonies indexes into LUT
@@ -363,13 +419,15 @@ float DSP_SineWaveGenerator::get_sine_wtab_val(float *hrmonies_indexes, float di
 void DSP_SineWaveGenerator::calc_sin_wtab_index(float *hrmonies_indexes, float detune, float freq)
 {
 	float index;
+	// Fundemental index step (one division for all harmonies)
+	float step = freq / fundemental_frequency;
 
 	for (int harmony = 0; harmony < _NUM_OF_HARMONIES; harmony++) 
 	{ 
 		if ((harmonies_levels[harmony] > 0) && harmonies_active[harmony])
 		{
 			index = hrmonies_indexes[harmony];
-			index += freq * harmonizing_frequencies[harmony] / fundemental_frequency;
+			index += step * harmonizing_frequencies[harmony];
 			while ((int)index >= sine_wavetable_size) 
 			{
 				index -= sine_wavetable_size;
@@ -465,7 +523,9 @@ void DSP_SineWaveGenerator::set_harominies_active(uint16_t mask)
 		{
 			harmonies_active[i] = false;
 		}
-	}	
+	}
+	
+	update_mip_map();
 }
 
 /**
@@ -498,14 +558,22 @@ bool DSP_SineWaveGenerator::get_cycle_restarted_sync_state() { return cycle_rest
 *	@param  none
 *	@return	void
 */
-void DSP_SineWaveGenerator::enable_unison_square() { square = true; }
+void DSP_SineWaveGenerator::enable_unison_square() 
+{ 
+	square = true; 
+	update_mip_map();
+}
 
 /**
 *	@brief	Disable unison square wave state
 *	@param  none
 *	@return	void
 */
-void DSP_SineWaveGenerator::disable_unison_square() { square = false; }
+void DSP_SineWaveGenerator::disable_unison_square() 
+{ 
+	square = false; 
+	update_mip_map();
+}
 
 /**
 *	@brief	Returnse unison square wave state
@@ -514,3 +582,158 @@ void DSP_SineWaveGenerator::disable_unison_square() { square = false; }
 */
 bool DSP_SineWaveGenerator::get_unison_square_state() { return square; }
 
+
+/**
+*	@brief	Set the harmonies mip-map mode. When on, and the active harmonies frequencies are
+*			integer multiples of harmony 0 frequency (no harmonies detune), the harmonies are
+*			baked into a band-limited mip-map (built off the audio thread) and played with a
+*			single interpolated read per sample; otherwise the harmonies are summed.
+*	@param  mode	true - mip-map mode on
+*	@return	void
+*/
+void DSP_SineWaveGenerator::set_mip_map_mode(bool mode)
+{
+	if (mode == mip_map_mode)
+	{
+		return;
+	}
+	
+	mip_map_mode = mode;
+	
+	if (mip_map_mode)
+	{
+		update_mip_map();
+	}
+	else
+	{
+		DSP_SineMipMapBuilder::get_instance()->release_mip_map(this);
+	}
+}
+
+/**
+*	@brief	Returns the harmonies mip-map mode
+*	@param  none
+*	@return	true - mip-map mode on
+*/
+bool DSP_SineWaveGenerator::get_mip_map_mode() { return mip_map_mode; }
+
+/**
+*	@brief	Returns the mip-map parameters of the current harmonies settings
+*	@param  key		a pointer to a _sine_mip_map_key_t struct to be filled
+*	@return	true if the harmonies can be baked into a mip-map; false if harmonies are
+*			detuned, a harmony is not an integer multiple of harmony 0 or no harmony is active
+*/
+bool DSP_SineWaveGenerator::get_mip_map_key(_sine_mip_map_key_t *key)
+{
+	float multiple;
+	int rounded;
+	bool used = false;
+	
+	// Zero the padding too, keys are compared as memory blocks
+	memset(key, 0, sizeof(_sine_mip_map_key_t));
+	
+	return_val_if_true((harmonies_detune_factor > _MIN_HARMONIES_DETUNE_FACTOR) || 
+		(sine_wavetable_size != _SINE_MIP_MAP_TABLE_SIZE), false);
+	
+	key->base_ratio = harmonizing_frequencies[0];
+	key->distortion = harmonies_dist_factor;
+	key->square = square ? 1 : 0;
+	
+	for (int harmony = 0; harmony < _NUM_OF_HARMONIES; harmony++)
+	{
+		if ((harmonies_levels[harmony] > 0) && harmonies_active[harmony])
+		{
+			multiple = harmonizing_frequencies[harmony] / key->base_ratio;
+			rounded = (int)lroundf(multiple);
+			
+			return_val_if_true((rounded < 1) || (rounded > 255) ||
+				(fabsf(multiple - (float)rounded) > _SINE_MIP_MAP_MAX_RATIO_ERROR * (float)rounded), false);
+			
+			key->multiples[harmony] = (uint8_t)rounded;
+			key->levels[harmony] = harmonies_levels[harmony];
+			used = true;
+		}
+	}
+	
+	return used;
+}
+
+/**
+*	@brief	Requests a mip-map for the current harmonies settings (mip-map mode only).
+*			The harmonies are summed until the mip-map is ready.
+*	@param  none
+*	@return	void
+*/
+void DSP_SineWaveGenerator::update_mip_map()
+{
+	_sine_mip_map_key_t key;
+	
+	if (!mip_map_mode)
+	{
+		return;
+	}
+	
+	if (get_mip_map_key(&key))
+	{
+		DSP_SineMipMapBuilder::get_instance()->request_mip_map(this, &key);
+	}
+	else
+	{
+		DSP_SineMipMapBuilder::get_instance()->release_mip_map(this);
+	}
+}
+
+/**
+ *	@brief	Return a block of next output values from a harmonies mip-map.
+ *			The mip-map level and the index step are calculated once per block.
+ *			Harmony 0 wavetable index is the mip-map index; the other harmonies indexes
+ *			are kept in phase for switching back to the harmonies path.
+ *	@param	mip_map	a pointer to the mip-map
+ *	@param	out		a pointer to a block of size samples output buffer
+ *	@param	size	number of samples
+ *	@param	freq	frequency (Hz)
+ *	@return	void
+*/
+void DSP_SineWaveGenerator::get_next_mip_map_block(_sine_mip_map_t *mip_map, float *out, int size, float freq)
+{
+	float base_freq = freq * mip_map->key.base_ratio;
+	float step = base_freq / fundemental_frequency;
+	float index = fl_harmonies_wtab_indexes[0];
+	float frac, harmony_index;
+	const float *table;
+	int pos;
+	
+	table = mip_map->tables[DSP_SineMipMapBuilder::get_mip_map_level(base_freq, sample_rate)];
+	
+	cycle_restarted = false;
+	
+	for (int i = 0; i < size; i++)
+	{
+		pos = (int)index;
+		frac = index - (float)pos;
+		out[i] = table[pos] + frac * (table[pos + 1] - table[pos]);
+		
+		index += step;
+		if (index >= (float)_SINE_MIP_MAP_TABLE_SIZE)
+		{
+			index -= (float)_SINE_MIP_MAP_TABLE_SIZE;
+			cycle_restarted = true;
+		}
+		else if (index < 0.0f)
+		{
+			index += (float)_SINE_MIP_MAP_TABLE_SIZE;
+		}
+	}
+	
+	fl_harmonies_wtab_indexes[0] = index;
+	
+	for (int harmony = 1; harmony < _NUM_OF_HARMONIES; harmony++)
+	{
+		if (mip_map->key.multiples[harmony] > 0)
+		{
+			harmony_index = index * (float)mip_map->key.multiples[harmony];
+			fl_harmonies_wtab_indexes[harmony] = harmony_index - (float)_SINE_MIP_MAP_TABLE_SIZE *
+				floorf(harmony_index / (float)_SINE_MIP_MAP_TABLE_SIZE);
+		}
+	}
+}
@@ -1,13 +1,15 @@
 /**
 *	@file		dspSineWaveGenerator.h
 *	@author		Nahum Budin
-*	@date		13-Sep2024
-*	@version	1.1 
+*	@date		17-Oct-2026
+*	@version	1.2 
+*					1. Harmonies mip-map mode.
+*					
+*	@History	13-Sep-2024	1.1
 *					1. Code refactoring and notaion. 
 *					2. Change wavefor table length to _SINE_WAVETABLE_SIZE (2048)
 *					    and not based on the audio-block length.
-*					
-*	@History	24_Jan-2021	1.1 
+*				24_Jan-2021	1.1 
 *					1. Code refactoring and notaion. 
 *					2. Adding sample-rate settings
 *				31-Oct-2019 (dspWaveformLUT) (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 19-Jul-2018)
@@ -19,10 +21,12 @@
 
 #include <math.h>
 #include <stdint.h>
+#include <atomic>
 
 #include "../libAdjRaspi5Synth_1_1.h"
 #include "../Audio/audioCommons.h"
 #include "../LibAPI/synthesizer.h"
+#include "dspSineMipMap.h"
 
 //#include "../defs.h"
 
@@ -42,6 +46,7 @@ class DSP_SineWaveGenerator
 {
 public:
 	DSP_SineWaveGenerator(int samp_rate = _DEFAULT_SAMPLE_RATE);
+	~DSP_SineWaveGenerator();
 	
 	int set_sample_rate(int samp_rate);
 	int get_sample_rate();
@@ -62,6 +67,7 @@ public:
 	float get_harmony_level(int har);
 	bool get_fund_harm_cycle_restarted_state();
 	float get_next_sine_wtab_val(float freq); 
+	void get_next_sine_wtab_block(float *out, int size, float freq);
 	float get_sine_wtab_val(float *hrmon_indexes, float distort);
 	void calc_sin_wtab_index(float *hrmon_indexes, float detune, float freq);
 	
@@ -75,7 +81,17 @@ public:
 	void disable_unison_square();
 	bool get_unison_square_state();
 	
+	void set_mip_map_mode(bool mode);
+	bool get_mip_map_mode();
+	
 private:
+	friend class DSP_SineMipMapBuilder;
+	
+	bool get_mip_map_key(_sine_mip_map_key_t *key);
+	void update_mip_map();
+	void get_next_mip_map_block(_sine_mip_map_t *mip_map, float *out, int size, float freq);
+	
+
 	int num_of_active_haromnies;
 	int unison_mode;
 	float  harmonies_dist_factor;
@@ -99,6 +115,15 @@ private:
 	float max_frequency;
 	float min_frequency;
 	float wtab_phase_step;
+	
+	// When true, bakeable harmonies settings are played from a mip-map
+	bool mip_map_mode;
+	// The mip-map used by the audio path (NULL: harmonies path)
+	std::atomic<_sine_mip_map_t*> mip_map_active;
+	// The referenced mip-map and the requested parameters (guarded by the builder mutex)
+	_sine_mip_map_t *mip_map_owned;
+	_sine_mip_map_key_t mip_map_pending_key;
+	bool mip_map_request_pending;
 }
 ;
 
@@ -1,11 +1,12 @@
 /**
 *	@file		dspSquareWaveGenerator.cpp
 *	@author		Nahum Budin
-*	@date		13-Sep2024
-*	@version	1.1 
-*					1. Code refactoring and notaion. 
+*	@date		17-Oct-2026
+*	@version	1.2 
+*					1. Fixed-point phase accumulator. 
 *					
-*	@History	24_Jan-2021	1.1 
+*	@History	13-Sep2024	1.1 Code refactoring and notaion. 
+*				24_Jan-2021	1.1 
 *					1. Code refactoring and notaion. 
 *					2. Adding sample-rate settings
 *				31-Oct-2019 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 19-Jul-2018)
@@ -48,6 +49,8 @@ int DSP_SquareWaveGenerator::set_sample_rate(int samp_rate)
 		sample_rate = samp_rate;
 	}
 	
+	phase_accumulator.set_cycle_rate((float)sample_rate);
+	
 	return sample_rate;
 }
 
@@ -78,7 +81,7 @@ float DSP_SquareWaveGenerator::set_pwm(float asym)
 	
 	cycle_restarted = false;
 	pt1 = asym;	
-	pos = 0;
+	phase_accumulator.set_phase(0);
 	
 	return pt1;
 }
@@ -100,6 +103,7 @@ float DSP_SquareWaveGenerator::get_square_val()
 	// Avoid zero slope clicks
 	float edge = 0.01f;
 	float dy = 1.4f / 0.01f;
+	float pos = phase_accumulator.get_phase_fraction();
     	
 	if (pos < edge)
 	{
@@ -130,7 +134,7 @@ float DSP_SquareWaveGenerator::get_square_val()
 */
 void DSP_SquareWaveGenerator::sync()
 {
-	pos = 0;
+	phase_accumulator.set_phase(0);
 }
 
 /**
@@ -148,26 +152,32 @@ bool DSP_SquareWaveGenerator::get_cycle_restarted_sync_state() { return cycle_re
  */
 float DSP_SquareWaveGenerator::get_next_square_gen_out_val(float freq)
 {
-	float freq_step = freq / (float)sample_rate;
-	float res = 0;
-	// clear after 1 cycle
-	cycle_restarted = false;
-	// Clip pos to 0 upto +1 
-	if (pos > 1) 
-	{
-		pos -= 1; 
-		res = get_square_val();
-		cycle_restarted = true;
-	}
-	else 
+	// The phase increment is recalculated only when the frequency is changed
+	phase_accumulator.set_frequency(freq);
+	// The phase wraps to 0 at a cycle end
+	cycle_restarted = phase_accumulator.advance();
+	
+	return get_square_val();
+}
+
+/**
+*	@brief	Return a block of next square wave output values
+*	@param	out		a pointer to a block of size samples output buffer
+*	@param	size	number of samples
+*	@param	freq	frequency (Hz)
+*	@return void
+*/
+void DSP_SquareWaveGenerator::get_next_square_gen_out_block(float *out, int size, float freq)
+{
+	bool restarted = false;
+	
+	phase_accumulator.set_frequency(freq);
+	
+	for (int i = 0; i < size; i++)
 	{
-		if (pos < 0)
-		{
-			pos += 1;
-		}
-		res = get_square_val();
+		restarted |= phase_accumulator.advance();
+		out[i] = get_square_val();
 	}
-	pos += freq_step;
 	
-	return res;
+	cycle_restarted = restarted;
 }
@@ -1,11 +1,12 @@
 /**
 *	@file		dspTriangleWaveGenerator.h
 *	@author		Nahum Budin
-*	@date		13-Sep2024
-*	@version	1.1 
-*					1. Code refactoring and notaion. 
+*	@date		17-Oct-2026
+*	@version	1.2 
+*					1. Fixed-point phase accumulator. 
 *					
-*	@History	24_Jan-2021	1.1 
+*	@History	13-Sep2024	1.1 Code refactoring and notaion. 
+*				24_Jan-2021	1.1 
 *					1. Code refactoring and notaion. 
 *					2. Adding sample-rate settings
 *				31-Oct-2019 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1 19-Jul-2018)
@@ -15,6 +16,8 @@
 
 #pragma once
 
+#include "dspPhaseAccumulator.h"
+
 class DSP_TriangleWaveGenerator
 {
 public:	
@@ -29,14 +32,15 @@ public:
 	void sync();
 	bool get_cycle_restarted_sync_state();
 	float get_next_triangle_gen_out_val(float freq);
+	void get_next_triangle_gen_out_block(float *out, int size, float freq);
 	
 private:
 	// Triangle heads
 	float pt1, pt2;
 	// Trinagle slopes
 	float dy1, dy2;
-	// Triangle wave cycle step / index 0 to 1 
-	float pos;
+	// Triangle wave cycle phase
+	DSP_PhaseAccumulator phase_accumulator;
 	// Indicates a new cycle has just restarted 
 	bool cycle_restarted;
 	//asymetric value 0.5-0.95
@@ -1,12 +1,21 @@
 /**
 *	@file		dspVoice.cpp
 *	@author		Nahum Budin
-*	@date		16-Oct-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion. 
-
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Sub-modules profiling counters. 
+*					2. Block based rendering.
+*					3. Sample accurate band-limited OSC 2 sync on OSC 1.
+*					4. OSCs sine harmonies mip-map mode.
+*					5. Compiled modulation matrix and cached detune factors.
+*					6. Output silence detector (frees near silent voices early).
+*					7. Stolen voices fade out rendering.
+*					8. Destructor (releases the voice DSP modules).
+*					9. MSO and PAD wavetables setting (pooled voices binding).
 *					
 *	@History	
+*				version 1.2	16-Oct-2024
+*					1. Code refactoring and notaion. 
 *				version 1.1	25_Jan-2021
 *					1. Code refactoring and notaion. 
 *					2. Adding sample-rate and bloc-size settings
@@ -20,6 +29,12 @@
 #include "dspVoice.h"
 #include "../commonDefs.h"
 #include "../AdjSynth/adjSynth.h"
+#include "../Audio/audioDspLoadMeter.h"
+#include "../Audio/audioVoiceRenderPool.h"
+
+std::atomic<int> DSP_Voice::silence_threshold_db(_DEFAULT_VOICE_SILENCE_THRESHOLD_DB);
+std::atomic<float> DSP_Voice::silence_threshold(powf(10.0f, _DEFAULT_VOICE_SILENCE_THRESHOLD_DB / 20.0f));
+std::atomic<int> DSP_Voice::silence_hold_time_ms(_DEFAULT_VOICE_SILENCE_HOLD_MS);
 
 /**
 *   @brief  Initializes a DSP_Voice object instance.
@@ -197,20 +212,33 @@ DSP_Voice::DSP_Voice(
 	, amp_1_pan_mod_lfo_delay(0)
 	, amp_2_pan_mod_lfo_delay(0)
 	, used(false)
+	, ended(false)
 	, mso_wtab_1(mso_wtab)
 	, original_mso_wtab_1(mso_wtab)
 	, pad_wavetable_1(synth_pad_wavetable)
 	, original_pad_wavetable_1(synth_pad_wavetable)
 	, voice_end_event_callback_ptr(voice_end_event_callback_pointer)
 {	
-	for (int i = 0; i < _NUM_OF_LFOS; i++)
+	for (int i = 0; i < _VOICE_MOD_NUM_OF_SOURCES; i++)
 	{
-		lfo_out[i] = 0;
+		modulation_sources[i] = 0;
 	}
 	
-	for (int i = 0; i < _NUM_OF_ADSRS; i++)
+	num_of_modulation_routes = 0;
+	modulation_matrix_changed = true;
+	zero_modulation_level = 0.0f;
+	
+	osc_1_detune_cache.valid = false;
+	osc_2_detune_cache.valid = false;
+	mso_1_detune_cache.valid = false;
+	pad_1_detune_cache.valid = false;
+	
+	silent_samples = 0;
+	
+	profiling_active = false;
+	for (int i = 0; i < _VOICE_PROFILE_NUM_OF_MODULES; i++)
 	{
-		adsr_out[i] = 0;
+		profile_ticks[i] = 0;
 	}
 		
 	osc_1 = new DSP_Osc(voice + 100,
@@ -226,6 +254,9 @@ DSP_Voice::DSP_Voice(
 		0,
 		_OSC_UNISON_MODE_12345678);
 	
+	osc_1->set_band_limited_state(true);
+	osc_1->set_sine_mip_map_mode(true);
+	
 	set_osc_1_send_filter_1_level(0);
 	set_osc_1_send_filter_2_level(0);
 	set_osc_1_freq_mod_lfo(_LFO_NONE);
@@ -254,6 +285,9 @@ DSP_Voice::DSP_Voice(
 		0,
 		0);
 	
+	osc_2->set_band_limited_state(true);
+	osc_2->set_sine_mip_map_mode(true);
+	
 	set_osc_2_send_filter_1_level(0);
 	set_osc_2_send_filter_2_level(0);
 	set_osc_2_freq_mod_lfo(_LFO_NONE);
@@ -462,6 +496,39 @@ DSP_Voice::DSP_Voice(
 	set_audio_block_size(block_size);
 }
 
+/**
+*	@brief	Destroys a DSP voice and its DSP modules instances.
+*			The MSO and PAD wavetables are not owned by the voice and are not deleted.
+*	@param	none
+*	@return	none
+*/
+DSP_Voice::~DSP_Voice()
+{
+	delete osc_1;
+	delete osc_2;
+	delete noise_1;
+	delete karplus_1;
+	delete mso_1;
+	delete wavetable_1;
+	delete filter_1;
+	delete filter_2;
+	delete distortion_1;
+	delete distortion_2;
+	delete out_amp_1;
+	delete lfo_1;
+	delete lfo_2;
+	delete lfo_3;
+	delete lfo_4;
+	delete lfo_5;
+	delete lfo_6;
+	delete adsr_1;
+	delete adsr_2;
+	delete adsr_3;
+	delete adsr_4;
+	delete adsr_5;
+	delete adsr_6;
+}
+
 /**
 *	@brief	Sets the sample-rate
 *	@param	sample  rate: _SAMPLE_RATE_44 (44100Hz) or _SAMPLE_RATE_48 (48000Hz)
@@ -700,169 +767,170 @@ int DSP_Voice::init_lfo_delays()
 
 /**
 *   @brief  Copy the state to a target DSP_Voice object.
-*   @param  target	a target DSP_Voice object	
+*   @param  target	a pointer to a target DSP_Voice object	
 *   @return void
 */
-void DSP_Voice::copy_my_state_to(DSP_Voice target)
+void DSP_Voice::copy_my_state_to(DSP_Voice *target)
 {
-	target.amp_1_pan_mod = this->amp_1_pan_mod;
-	target.amp_2_pan_mod = this->amp_2_pan_mod;
-	target.osc_1_freq_mod_lfo_delay = this->osc_1_freq_mod_lfo_delay;
-	target.osc_1_pwm_mod_lfo_delay = this->osc_1_pwm_mod_lfo_delay;
-	target.osc_1_amp_mod_lfo_delay = this->osc_1_amp_mod_lfo_delay;
-	target.osc_2_freq_mod_lfo_delay = this->osc_2_freq_mod_lfo_delay;
-	target.osc_2_pwm_mod_lfo_delay = this->osc_2_pwm_mod_lfo_delay;
-	target.osc_2_amp_mod_lfo_delay = this->osc_2_amp_mod_lfo_delay;
-	target.noise_1_amp_mod_lfo_delay = this->noise_1_amp_mod_lfo_delay;
-	target.mso_1_freq_mod_lfo_delay = this->mso_1_freq_mod_lfo_delay;
-	target.mso_1_pwm_mod_lfo_delay = this->mso_1_pwm_mod_lfo_delay;
-	target.mso_1_amp_mod_lfo_delay = this->mso_1_amp_mod_lfo_delay;
-	target.wavetable_1_freq_mod_lfo_delay = this->wavetable_1_freq_mod_lfo_delay;
-	target.wavetable_1_amp_mod_lfo_delay = this->wavetable_1_amp_mod_lfo_delay;
-	target.filter_1_freq_mod_lfo_delay = this->filter_1_freq_mod_lfo_delay;
-	target.filter_2_freq_mod_lfo_delay = this->filter_2_freq_mod_lfo_delay;
-	target.amp_1_pan_mod_lfo_delay = this->amp_1_pan_mod_lfo_delay;
-	target.amp_2_pan_mod_lfo_delay = this->amp_2_pan_mod_lfo_delay;
-	target.used = this->used;
-	target.voice = this->voice;
-	target.voice_active = this->voice_active;
-	target.frequency = this->frequency;
-	target.osc_1_freq_mod_lfo = this->osc_1_freq_mod_lfo;
-	target.osc_1_pwm_mod_lfo = this->osc_1_pwm_mod_lfo;
-	target.osc_1_amp_mod_lfo = this->osc_1_amp_mod_lfo;
-	target.osc_1_freq_mod_lfo_level = this->osc_1_freq_mod_lfo_level;
-	target.osc_1_pwm_mod_lfo_level = this->osc_1_pwm_mod_lfo_level;
-	target.osc_1_amp_mod_lfo_level = this->osc_1_amp_mod_lfo_level;
-	target.osc_1_freq_mod_env = this->osc_1_freq_mod_env;
-	target.osc_1_pwm_mod_env = this->osc_1_pwm_mod_env;
-	target.osc_1_amp_mod_env = this->osc_1_amp_mod_env;
-	target.osc_1_freq_mod_env_level = this->osc_1_freq_mod_env_level;
-	target.osc_1_pwm_mod_env_level = this->osc_1_pwm_mod_env_level;
-	target.osc_1_amp_mod_env_level = this->osc_1_amp_mod_env_level;
-	target.osc_2_freq_mod_lfo = this->osc_2_freq_mod_lfo;
-	target.osc_2_pwm_mod_lfo = this->osc_2_pwm_mod_lfo;
-	target.osc_2_amp_mod_lfo = this->osc_2_amp_mod_lfo;
-	target.osc_2_freq_mod_lfo_level = this->osc_2_freq_mod_lfo_level;
-	target.osc_2_pwm_mod_lfo_level = this->osc_2_pwm_mod_lfo_level;
-	target.osc_2_amp_mod_lfo_level = this->osc_2_amp_mod_lfo_level;
-	target.osc_2_freq_mod_env = this->osc_2_freq_mod_env;
-	target.osc_2_pwm_mod_env = this->osc_2_pwm_mod_env;
-	target.osc_2_amp_mod_env = this->osc_2_amp_mod_env;
-	target.osc_2_freq_mod_env_level = this->osc_2_freq_mod_env_level;
-	target.osc_2_pwm_mod_env_level = this->osc_2_pwm_mod_env_level;
-	target.osc_2_amp_mod_env_level = this->osc_2_amp_mod_env_level;
-	target.mso_1_freq_mod_lfo = this->mso_1_freq_mod_lfo;
-	target.mso_1_pwm_mod_lfo = this->mso_1_pwm_mod_lfo;
-	target.mso_1_amp_mod_lfo = this->mso_1_amp_mod_lfo;
-	target.mso_1_freq_mod_lfo_level = this->mso_1_freq_mod_lfo_level;
-	target.mso_1_pwm_mod_lfo_level = this->mso_1_pwm_mod_lfo_level;
-	target.mso_1_amp_mod_lfo_level = this->mso_1_amp_mod_lfo_level;
-	target.mso_1_freq_mod_env = this->mso_1_freq_mod_env;
-	target.mso_1_pwm_mod_env = this->mso_1_pwm_mod_env;
-	target.mso_1_amp_mod_env = this->mso_1_amp_mod_env;
-	target.mso_1_freq_mod_env_level = this->mso_1_freq_mod_env_level;
-	target.mso_1_pwm_mod_env_level = this->mso_1_pwm_mod_env_level;
-	target.mso_1_amp_mod_env_level = this->mso_1_amp_mod_env_level;
-	target.wavetable_1_freq_mod_lfo = this->wavetable_1_freq_mod_lfo;
-	target.wavetable_1_amp_mod_lfo = this->wavetable_1_amp_mod_lfo;
-	target.wavetable_1_freq_mod_lfo_level = this->wavetable_1_freq_mod_lfo_level;
-	target.wavetable_1_amp_mod_lfo_level = this->wavetable_1_amp_mod_lfo_level;
-	target.wavetable_1_freq_mod_env = this->wavetable_1_freq_mod_env;
-	target.wavetable_1_amp_mod_env = this->wavetable_1_amp_mod_env;
-	target.wavetable_1_freq_mod_env_level = this->wavetable_1_freq_mod_env_level;
-	target.wavetable_1_amp_mod_env_level = this->wavetable_1_amp_mod_env_level;
-	target.noise_1_amp_mod_lfo = this->noise_1_amp_mod_lfo;
-	target.noise_1_amp_mod_env = this->noise_1_amp_mod_env;
-	target.noise_1_amp_mod_lfo_level = this->noise_1_amp_mod_lfo_level;
-	target.noise_1_amp_mod_env_level = this->noise_1_amp_mod_env_level;
-	target.filter_1_freq_mod_lfo = this->filter_1_freq_mod_lfo;
-	target.filter_1_freq_mod_env = this->filter_1_freq_mod_env;
-	target.filter_2_freq_mod_lfo = this->filter_2_freq_mod_lfo;
-	target.filter_2_freq_mod_env = this->filter_2_freq_mod_env;
-	target.filter_1_freq_mod_lfo_level = this->filter_1_freq_mod_lfo_level;
-	target.filter_1_freq_mod_env_level = this->filter_1_freq_mod_env_level;
-	target.filter_2_freq_mod_lfo_level = this->filter_2_freq_mod_lfo_level;
-	target.filter_2_freq_mod_env_level = this->filter_2_freq_mod_env_level;
-	target.amp_1_pan_mod_lfo = this->amp_1_pan_mod_lfo;
-	target.amp_2_pan_mod_lfo = this->amp_2_pan_mod_lfo;
-	target.amp_1_pan_mod_lfo_level = this->amp_1_pan_mod_lfo_level;
-	target.amp_2_pan_mod_lfo_level = this->amp_2_pan_mod_lfo_level;
-	target.lfo_1_actual_freq = this->lfo_1_actual_freq;
-	target.lfo_2_actual_freq = this->lfo_2_actual_freq;
-	target.lfo_3_actual_freq = this->lfo_3_actual_freq;
-	target.lfo_4_actual_freq = this->lfo_4_actual_freq;
-	target.lfo_5_actual_freq = this->lfo_5_actual_freq;
-	target.osc_1_send_filter_1_level = this->osc_1_send_filter_1_level;
-	target.osc_1_send_filter_2_level = this->osc_1_send_filter_2_level;
-	target.osc_1_amp_lfo_modulation = this->osc_1_amp_lfo_modulation;
-	target.osc_1_amp_env_modulation = this->osc_1_amp_env_modulation;
-	target.osc_1_pwm_lfo_modulation = this->osc_1_pwm_lfo_modulation;
-	target.osc_1_pwm_env_modulation = this->osc_1_pwm_env_modulation;
-	target.osc_1_freq_lfo_modulation = this->osc_1_freq_lfo_modulation;
-	target.osc_1_freq_env_modulation = this->osc_1_freq_env_modulation;
-	target.osc_1_active = this->osc_1_active;
-	target.osc_2_send_filter_1_level = this->osc_2_send_filter_1_level;
-	target.osc_2_send_filter_2_level = this->osc_2_send_filter_2_level;
-	target.osc_2_amp_lfo_modulation = this->osc_2_amp_lfo_modulation;
-	target.osc_2_amp_env_modulation = this->osc_2_amp_env_modulation;
-	target.osc_2_pwm_lfo_modulation = this->osc_2_pwm_lfo_modulation;
-	target.osc_2_pwm_env_modulation = this->osc_2_pwm_env_modulation;
-	target.osc_2_freq_lfo_modulation = this->osc_2_freq_lfo_modulation;
-	target.osc_2_freq_env_modulation = this->osc_2_freq_env_modulation;
-	target.osc_2_active = this->osc_2_active;
-	target.osc_2_sync_on_osc_1 = this->osc_2_sync_on_osc_1;
-	target.mso_1_send_filter_1_level = this->mso_1_send_filter_1_level;
-	target.mso_1_send_filter_2_level = this->mso_1_send_filter_2_level;
-	target.mso_1_amp_lfo_modulation = this->mso_1_amp_lfo_modulation;
-	target.mso_1_amp_env_modulation = this->mso_1_amp_env_modulation;
-	target.mso_1_pwm_lfo_modulation = this->mso_1_pwm_lfo_modulation;
-	target.mso_1_pwm_env_modulation = this->mso_1_pwm_env_modulation;
-	target.mso_1_freq_lfo_modulation = this->mso_1_freq_lfo_modulation;
-	target.mso_1_freq_env_modulation = this->mso_1_freq_env_modulation;
-	target.mso_1_active = this->mso_1_active;
-	target.wavetable_1_send_filter_1_level = this->wavetable_1_send_filter_1_level;
-	target.wavetable_1_send_filter_2_level = this->wavetable_1_send_filter_2_level;
-	target.wavetable_1_amp_lfo_modulation = this->wavetable_1_amp_lfo_modulation;
-	target.wavetable_1_amp_env_modulation = this->wavetable_1_amp_env_modulation;
-	target.wavetable_1_freq_lfo_modulation = this->wavetable_1_freq_lfo_modulation;
-	target.wavetable_1_freq_env_modulation = this->wavetable_1_freq_env_modulation;
-	target.wavetable_1_active = this->wavetable_1_active;
-	target.noise_1_send_filter_1_level = this->noise_1_send_filter_1_level;
-	target.noise_1_send_filter_2_level = this->noise_1_send_filter_2_level;
-	target.noise_1_amp_lfo_modulation = this->noise_1_amp_lfo_modulation;
-	target.noise_1_amp_env_modulation = this->noise_1_amp_env_modulation;
-	target.noise_1_active = this->noise_1_active;
-	target.karplus_1_send_filter_1_level = this->karplus_1_send_filter_1_level;
-	target.karplus_1_send_filter_2_level = this->karplus_1_send_filter_2_level;
-	target.karplus_1_active = this->karplus_1_active;
-	//	target.drawbars1active = this->drawbars1active;
-	target.filter_1_freq_lfo_modulation = this->filter_1_freq_lfo_modulation;
-	target.filter_1_freq_env_modulation = this->filter_1_freq_env_modulation;
-	target.filter_2_freq_lfo_modulation = this->filter_2_freq_lfo_modulation;
-	target.filter_2_freq_env_modulation = this->filter_2_freq_env_modulation;
-	target.freq_mod_osc_1 = this->freq_mod_osc_1;
-	target.freq_mod_osc_2 = this->freq_mod_osc_2;
-	target.freq_mod_mso_1 = this->freq_mod_mso_1;
-	target.freq_mod_pad_1 = this->freq_mod_pad_1;
-	target.osc_1_detune = this->osc_1_detune;
-	target.osc_2_detune = this->osc_2_detune;
-	target.mso_1_detune = this->mso_1_detune;
-	target.pad_1_detune = this->pad_1_detune;
-	target.act_freq_osc_1 = this->act_freq_osc_1;
-	target.act_freq_osc_2 = this->act_freq_osc_2;
-	target.act_freq_mso_1 = this->act_freq_mso_1;
-	target.act_freq_pad_1 = this->act_freq_pad_1;
-	target.pwm_mod_osc_1 = this->pwm_mod_osc_1;
-	target.pwm_mod_osc_2 = this->pwm_mod_osc_2;
-	target.pwm_mod_mso_1 = this->pwm_mod_mso_1;
-	target.mag_modulation_osc_1 = this->mag_modulation_osc_1;
-	target.mag_modulation_osc_2 = this->mag_modulation_osc_2;
-	target.mag_modulation_mso_1 = this->mag_modulation_mso_1;
-	target.mag_modulation_pad_1 = this->mag_modulation_pad_1;
-	target.filter_1_freq_mod = this->filter_1_freq_mod;
-	target.filter_2_freq_mod = this->filter_2_freq_mod;
-	target.distortion_1_active = this->distortion_1_active;
-	target.distortion_2_active = this->distortion_2_active;
+	target->amp_1_pan_mod = this->amp_1_pan_mod;
+	target->amp_2_pan_mod = this->amp_2_pan_mod;
+	target->osc_1_freq_mod_lfo_delay = this->osc_1_freq_mod_lfo_delay;
+	target->osc_1_pwm_mod_lfo_delay = this->osc_1_pwm_mod_lfo_delay;
+	target->osc_1_amp_mod_lfo_delay = this->osc_1_amp_mod_lfo_delay;
+	target->osc_2_freq_mod_lfo_delay = this->osc_2_freq_mod_lfo_delay;
+	target->osc_2_pwm_mod_lfo_delay = this->osc_2_pwm_mod_lfo_delay;
+	target->osc_2_amp_mod_lfo_delay = this->osc_2_amp_mod_lfo_delay;
+	target->noise_1_amp_mod_lfo_delay = this->noise_1_amp_mod_lfo_delay;
+	target->mso_1_freq_mod_lfo_delay = this->mso_1_freq_mod_lfo_delay;
+	target->mso_1_pwm_mod_lfo_delay = this->mso_1_pwm_mod_lfo_delay;
+	target->mso_1_amp_mod_lfo_delay = this->mso_1_amp_mod_lfo_delay;
+	target->wavetable_1_freq_mod_lfo_delay = this->wavetable_1_freq_mod_lfo_delay;
+	target->wavetable_1_amp_mod_lfo_delay = this->wavetable_1_amp_mod_lfo_delay;
+	target->filter_1_freq_mod_lfo_delay = this->filter_1_freq_mod_lfo_delay;
+	target->filter_2_freq_mod_lfo_delay = this->filter_2_freq_mod_lfo_delay;
+	target->amp_1_pan_mod_lfo_delay = this->amp_1_pan_mod_lfo_delay;
+	target->amp_2_pan_mod_lfo_delay = this->amp_2_pan_mod_lfo_delay;
+	target->used = this->used.load();
+	target->voice = this->voice;
+	target->voice_active = this->voice_active;
+	target->frequency = this->frequency;
+	target->osc_1_freq_mod_lfo = this->osc_1_freq_mod_lfo;
+	target->osc_1_pwm_mod_lfo = this->osc_1_pwm_mod_lfo;
+	target->osc_1_amp_mod_lfo = this->osc_1_amp_mod_lfo;
+	target->osc_1_freq_mod_lfo_level = this->osc_1_freq_mod_lfo_level;
+	target->osc_1_pwm_mod_lfo_level = this->osc_1_pwm_mod_lfo_level;
+	target->osc_1_amp_mod_lfo_level = this->osc_1_amp_mod_lfo_level;
+	target->osc_1_freq_mod_env = this->osc_1_freq_mod_env;
+	target->osc_1_pwm_mod_env = this->osc_1_pwm_mod_env;
+	target->osc_1_amp_mod_env = this->osc_1_amp_mod_env;
+	target->osc_1_freq_mod_env_level = this->osc_1_freq_mod_env_level;
+	target->osc_1_pwm_mod_env_level = this->osc_1_pwm_mod_env_level;
+	target->osc_1_amp_mod_env_level = this->osc_1_amp_mod_env_level;
+	target->osc_2_freq_mod_lfo = this->osc_2_freq_mod_lfo;
+	target->osc_2_pwm_mod_lfo = this->osc_2_pwm_mod_lfo;
+	target->osc_2_amp_mod_lfo = this->osc_2_amp_mod_lfo;
+	target->osc_2_freq_mod_lfo_level = this->osc_2_freq_mod_lfo_level;
+	target->osc_2_pwm_mod_lfo_level = this->osc_2_pwm_mod_lfo_level;
+	target->osc_2_amp_mod_lfo_level = this->osc_2_amp_mod_lfo_level;
+	target->osc_2_freq_mod_env = this->osc_2_freq_mod_env;
+	target->osc_2_pwm_mod_env = this->osc_2_pwm_mod_env;
+	target->osc_2_amp_mod_env = this->osc_2_amp_mod_env;
+	target->osc_2_freq_mod_env_level = this->osc_2_freq_mod_env_level;
+	target->osc_2_pwm_mod_env_level = this->osc_2_pwm_mod_env_level;
+	target->osc_2_amp_mod_env_level = this->osc_2_amp_mod_env_level;
+	target->mso_1_freq_mod_lfo = this->mso_1_freq_mod_lfo;
+	target->mso_1_pwm_mod_lfo = this->mso_1_pwm_mod_lfo;
+	target->mso_1_amp_mod_lfo = this->mso_1_amp_mod_lfo;
+	target->mso_1_freq_mod_lfo_level = this->mso_1_freq_mod_lfo_level;
+	target->mso_1_pwm_mod_lfo_level = this->mso_1_pwm_mod_lfo_level;
+	target->mso_1_amp_mod_lfo_level = this->mso_1_amp_mod_lfo_level;
+	target->mso_1_freq_mod_env = this->mso_1_freq_mod_env;
+	target->mso_1_pwm_mod_env = this->mso_1_pwm_mod_env;
+	target->mso_1_amp_mod_env = this->mso_1_amp_mod_env;
+	target->mso_1_freq_mod_env_level = this->mso_1_freq_mod_env_level;
+	target->mso_1_pwm_mod_env_level = this->mso_1_pwm_mod_env_level;
+	target->mso_1_amp_mod_env_level = this->mso_1_amp_mod_env_level;
+	target->wavetable_1_freq_mod_lfo = this->wavetable_1_freq_mod_lfo;
+	target->wavetable_1_amp_mod_lfo = this->wavetable_1_amp_mod_lfo;
+	target->wavetable_1_freq_mod_lfo_level = this->wavetable_1_freq_mod_lfo_level;
+	target->wavetable_1_amp_mod_lfo_level = this->wavetable_1_amp_mod_lfo_level;
+	target->wavetable_1_freq_mod_env = this->wavetable_1_freq_mod_env;
+	target->wavetable_1_amp_mod_env = this->wavetable_1_amp_mod_env;
+	target->wavetable_1_freq_mod_env_level = this->wavetable_1_freq_mod_env_level;
+	target->wavetable_1_amp_mod_env_level = this->wavetable_1_amp_mod_env_level;
+	target->noise_1_amp_mod_lfo = this->noise_1_amp_mod_lfo;
+	target->noise_1_amp_mod_env = this->noise_1_amp_mod_env;
+	target->noise_1_amp_mod_lfo_level = this->noise_1_amp_mod_lfo_level;
+	target->noise_1_amp_mod_env_level = this->noise_1_amp_mod_env_level;
+	target->filter_1_freq_mod_lfo = this->filter_1_freq_mod_lfo;
+	target->filter_1_freq_mod_env = this->filter_1_freq_mod_env;
+	target->filter_2_freq_mod_lfo = this->filter_2_freq_mod_lfo;
+	target->filter_2_freq_mod_env = this->filter_2_freq_mod_env;
+	target->filter_1_freq_mod_lfo_level = this->filter_1_freq_mod_lfo_level;
+	target->filter_1_freq_mod_env_level = this->filter_1_freq_mod_env_level;
+	target->filter_2_freq_mod_lfo_level = this->filter_2_freq_mod_lfo_level;
+	target->filter_2_freq_mod_env_level = this->filter_2_freq_mod_env_level;
+	target->amp_1_pan_mod_lfo = this->amp_1_pan_mod_lfo;
+	target->amp_2_pan_mod_lfo = this->amp_2_pan_mod_lfo;
+	target->amp_1_pan_mod_lfo_level = this->amp_1_pan_mod_lfo_level;
+	target->amp_2_pan_mod_lfo_level = this->amp_2_pan_mod_lfo_level;
+	target->modulation_matrix_changed = true;
+	target->lfo_1_actual_freq = this->lfo_1_actual_freq;
+	target->lfo_2_actual_freq = this->lfo_2_actual_freq;
+	target->lfo_3_actual_freq = this->lfo_3_actual_freq;
+	target->lfo_4_actual_freq = this->lfo_4_actual_freq;
+	target->lfo_5_actual_freq = this->lfo_5_actual_freq;
+	target->osc_1_send_filter_1_level = this->osc_1_send_filter_1_level;
+	target->osc_1_send_filter_2_level = this->osc_1_send_filter_2_level;
+	target->osc_1_amp_lfo_modulation = this->osc_1_amp_lfo_modulation;
+	target->osc_1_amp_env_modulation = this->osc_1_amp_env_modulation;
+	target->osc_1_pwm_lfo_modulation = this->osc_1_pwm_lfo_modulation;
+	target->osc_1_pwm_env_modulation = this->osc_1_pwm_env_modulation;
+	target->osc_1_freq_lfo_modulation = this->osc_1_freq_lfo_modulation;
+	target->osc_1_freq_env_modulation = this->osc_1_freq_env_modulation;
+	target->osc_1_active = this->osc_1_active;
+	target->osc_2_send_filter_1_level = this->osc_2_send_filter_1_level;
+	target->osc_2_send_filter_2_level = this->osc_2_send_filter_2_level;
+	target->osc_2_amp_lfo_modulation = this->osc_2_amp_lfo_modulation;
+	target->osc_2_amp_env_modulation = this->osc_2_amp_env_modulation;
+	target->osc_2_pwm_lfo_modulation = this->osc_2_pwm_lfo_modulation;
+	target->osc_2_pwm_env_modulation = this->osc_2_pwm_env_modulation;
+	target->osc_2_freq_lfo_modulation = this->osc_2_freq_lfo_modulation;
+	target->osc_2_freq_env_modulation = this->osc_2_freq_env_modulation;
+	target->osc_2_active = this->osc_2_active;
+	target->osc_2_sync_on_osc_1 = this->osc_2_sync_on_osc_1;
+	target->mso_1_send_filter_1_level = this->mso_1_send_filter_1_level;
+	target->mso_1_send_filter_2_level = this->mso_1_send_filter_2_level;
+	target->mso_1_amp_lfo_modulation = this->mso_1_amp_lfo_modulation;
+	target->mso_1_amp_env_modulation = this->mso_1_amp_env_modulation;
+	target->mso_1_pwm_lfo_modulation = this->mso_1_pwm_lfo_modulation;
+	target->mso_1_pwm_env_modulation = this->mso_1_pwm_env_modulation;
+	target->mso_1_freq_lfo_modulation = this->mso_1_freq_lfo_modulation;
+	target->mso_1_freq_env_modulation = this->mso_1_freq_env_modulation;
+	target->mso_1_active = this->mso_1_active;
+	target->wavetable_1_send_filter_1_level = this->wavetable_1_send_filter_1_level;
+	target->wavetable_1_send_filter_2_level = this->wavetable_1_send_filter_2_level;
+	target->wavetable_1_amp_lfo_modulation = this->wavetable_1_amp_lfo_modulation;
+	target->wavetable_1_amp_env_modulation = this->wavetable_1_amp_env_modulation;
+	target->wavetable_1_freq_lfo_modulation = this->wavetable_1_freq_lfo_modulation;
+	target->wavetable_1_freq_env_modulation = this->wavetable_1_freq_env_modulation;
+	target->wavetable_1_active = this->wavetable_1_active;
+	target->noise_1_send_filter_1_level = this->noise_1_send_filter_1_level;
+	target->noise_1_send_filter_2_level = this->noise_1_send_filter_2_level;
+	target->noise_1_amp_lfo_modulation = this->noise_1_amp_lfo_modulation;
+	target->noise_1_amp_env_modulation = this->noise_1_amp_env_modulation;
+	target->noise_1_active = this->noise_1_active;
+	target->karplus_1_send_filter_1_level = this->karplus_1_send_filter_1_level;
+	target->karplus_1_send_filter_2_level = this->karplus_1_send_filter_2_level;
+	target->karplus_1_active = this->karplus_1_active;
+	//	target->drawbars1active = this->drawbars1active;
+	target->filter_1_freq_lfo_modulation = this->filter_1_freq_lfo_modulation;
+	target->filter_1_freq_env_modulation = this->filter_1_freq_env_modulation;
+	target->filter_2_freq_lfo_modulation = this->filter_2_freq_lfo_modulation;
+	target->filter_2_freq_env_modulation = this->filter_2_freq_env_modulation;
+	target->freq_mod_osc_1 = this->freq_mod_osc_1;
+	target->freq_mod_osc_2 = this->freq_mod_osc_2;
+	target->freq_mod_mso_1 = this->freq_mod_mso_1;
+	target->freq_mod_pad_1 = this->freq_mod_pad_1;
+	target->osc_1_detune = this->osc_1_detune;
+	target->osc_2_detune = this->osc_2_detune;
+	target->mso_1_detune = this->mso_1_detune;
+	target->pad_1_detune = this->pad_1_detune;
+	target->act_freq_osc_1 = this->act_freq_osc_1;
+	target->act_freq_osc_2 = this->act_freq_osc_2;
+	target->act_freq_mso_1 = this->act_freq_mso_1;
+	target->act_freq_pad_1 = this->act_freq_pad_1;
+	target->pwm_mod_osc_1 = this->pwm_mod_osc_1;
+	target->pwm_mod_osc_2 = this->pwm_mod_osc_2;
+	target->pwm_mod_mso_1 = this->pwm_mod_mso_1;
+	target->mag_modulation_osc_1 = this->mag_modulation_osc_1;
+	target->mag_modulation_osc_2 = this->mag_modulation_osc_2;
+	target->mag_modulation_mso_1 = this->mag_modulation_mso_1;
+	target->mag_modulation_pad_1 = this->mag_modulation_pad_1;
+	target->filter_1_freq_mod = this->filter_1_freq_mod;
+	target->filter_2_freq_mod = this->filter_2_freq_mod;
+	target->distortion_1_active = this->distortion_1_active;
+	target->distortion_2_active = this->distortion_2_active;
 }
 
 /**
@@ -870,21 +938,69 @@ void DSP_Voice::copy_my_state_to(DSP_Voice target)
 *   @param  none
 *   @return void
 */
-void DSP_Voice::in_use() { used = true; }
+void DSP_Voice::in_use() 
+{ 
+	ended = false;
+	used.store(true, std::memory_order_release); 
+}
 
 /**
 *   @brief  Set voice status to Not-in-use.
 *   @param  none
 *   @return void
 */
-void DSP_Voice::not_in_use() { used = false; }
+void DSP_Voice::not_in_use() { used.store(false, std::memory_order_release); }
 
 /**
 *   @brief  Return voice In-use status.
 *   @param  none
 *   @return true if in-use; false otherwise
 */
-bool DSP_Voice::is_in_use() { return used; }
+bool DSP_Voice::is_in_use() { return used.load(std::memory_order_acquire); }
+
+/**
+*   @brief  Set voice status to Not-in-use if the voice ended (see end_voice()).
+*			Called by the rendering thread when it is done with the voice block, so the
+*			voice is not bound to a new note while it is still in use.
+*   @param  none
+*   @return void
+*/
+void DSP_Voice::free_if_ended()
+{
+	if (ended)
+	{
+		ended = false;
+		not_in_use();
+	}
+}
+
+/**
+*   @brief  Set the MSO wavetable (a pooled voice is bound to its program MSO wavetable).
+*   @param  mso_wtab	a pointer to a DSP_MorphingSinusOscWTAB object
+*   @return void
+*/
+void DSP_Voice::set_mso_wavetable(DSP_MorphingSinusOscWTAB *mso_wtab)
+{
+	if (mso_wtab != NULL)
+	{
+		mso_wtab_1 = mso_wtab;
+		mso_1->set_wavetable(mso_wtab);
+	}
+}
+
+/**
+*   @brief  Set the PAD wavetable (a pooled voice is bound to its program PAD wavetable).
+*   @param  synth_pad_wavetable	a pointer to a Wavetable object
+*   @return void
+*/
+void DSP_Voice::set_pad_wavetable(Wavetable *synth_pad_wavetable)
+{
+	if (synth_pad_wavetable != NULL)
+	{
+		pad_wavetable_1 = synth_pad_wavetable;
+		wavetable_1->set_wavetable(synth_pad_wavetable);
+	}
+}
 
 /**
 *	@brief	Enable Osc_1
@@ -1059,6 +1175,7 @@ float DSP_Voice::get_voice_frequency() { return frequency; }
 void DSP_Voice::set_voice_active() 
 { 
 	voice_active = true; 
+	silent_samples = 0;
 }
 
 /**
@@ -1144,311 +1261,53 @@ float DSP_Voice::detune_frequency_factor(int detune_oct, int detune_semitones, f
 
 /**
 *	@brief	Calculate next modulation values.
+*			Only the active routes of the compiled modulation matrix are evaluated.
 *	@param	none
 *	@return void
 */
 void DSP_Voice::calc_next_modulation_values()
 {
-	lfo_out[0] = lfo_1->get_next_output_val(lfo_1_actual_freq);
-	lfo_out[1] = lfo_2->get_next_output_val(lfo_2_actual_freq);
-	lfo_out[2] = lfo_3->get_next_output_val(lfo_3_actual_freq);
-	lfo_out[3] = lfo_4->get_next_output_val(lfo_4_actual_freq);
-	lfo_out[4] = lfo_5->get_next_output_val(lfo_5_actual_freq);
+	voice_modulation_route_t *route;
+	
+	modulation_sources[_VOICE_MOD_SOURCE_LFO_1] = lfo_1->get_next_output_val(lfo_1_actual_freq);
+	modulation_sources[_VOICE_MOD_SOURCE_LFO_1 + 1] = lfo_2->get_next_output_val(lfo_2_actual_freq);
+	modulation_sources[_VOICE_MOD_SOURCE_LFO_1 + 2] = lfo_3->get_next_output_val(lfo_3_actual_freq);
+	modulation_sources[_VOICE_MOD_SOURCE_LFO_1 + 3] = lfo_4->get_next_output_val(lfo_4_actual_freq);
+	modulation_sources[_VOICE_MOD_SOURCE_LFO_1 + 4] = lfo_5->get_next_output_val(lfo_5_actual_freq);
 					
 	//	fprintf(stderr, "note on time : %i %i %i\n", adsr1->getNoteToneElapsedTime(),
 	//	adsr2->getNoteToneElapsedTime(),adsr3->getNoteToneElapsedTime());
 
 	adsr_1->calc_next_envelope_val();
-	adsr_out[0] = adsr_1->get_output_val();
+	modulation_sources[_VOICE_MOD_SOURCE_ENV_1] = adsr_1->get_output_val();
 
 	adsr_2->calc_next_envelope_val();
-	adsr_out[1] = adsr_2->get_output_val();
+	modulation_sources[_VOICE_MOD_SOURCE_ENV_1 + 1] = adsr_2->get_output_val();
 
 	adsr_3->calc_next_envelope_val();
-	adsr_out[2] = adsr_3->get_output_val();
+	modulation_sources[_VOICE_MOD_SOURCE_ENV_1 + 2] = adsr_3->get_output_val();
 
 	adsr_4->calc_next_envelope_val();
-	adsr_out[3] = adsr_4->get_output_val();
+	modulation_sources[_VOICE_MOD_SOURCE_ENV_1 + 3] = adsr_4->get_output_val();
 
 	adsr_5->calc_next_envelope_val();
-	adsr_out[4] = adsr_5->get_output_val();
-
-	if (osc_1_freq_mod_lfo > _LFO_NONE)
-	{
-		set_osc_1_freq_lfo_modulation(osc_1_freq_mod_lfo_level, lfo_out[osc_1_freq_mod_lfo - 1]);
-	}
-	else
-	{
-		osc_1_freq_lfo_modulation = 0.f;
-	}
-
-	if (osc_1_freq_mod_env > _ENV_NONE)
-	{
-		set_osc_1_freq_env_modulation(osc_1_freq_mod_env_level, adsr_out[osc_1_freq_mod_env - 1]);
-	}
-	else
-	{
-		set_osc_1_freq_env_modulation(osc_1_freq_mod_env_level, 0.0f);
-	}
-
-	if (osc_1_pwm_mod_lfo > _LFO_NONE)
-	{
-		set_osc_1_pwm_lfo_modulation(osc_1_pwm_mod_lfo_level, lfo_out[osc_1_pwm_mod_lfo - 1]);
-	}
-	else
-	{
-		osc_1_pwm_lfo_modulation = 0.f;
-	}
-
-	if (osc_1_pwm_mod_env > _ENV_NONE)
-	{
-		set_osc_1_pwm_env_modulation(osc_1_pwm_mod_env_level, adsr_out[osc_1_pwm_mod_env - 1]);
-	}
-	else
-	{
-		set_osc_1_pwm_env_modulation(osc_1_pwm_mod_env_level, 0.0f);
-	}
-
-	if (osc_1_amp_mod_lfo > _LFO_NONE)
-	{
-		set_osc_1_amp_lfo_modulation(osc_1_amp_mod_lfo_level, lfo_out[osc_1_amp_mod_lfo - 1]);
-	}
-	else
-	{
-		osc_1_amp_lfo_modulation = 1.f;
-	}
-
-	if (osc_1_amp_mod_env > _ENV_NONE)
-	{
-		set_osc_1_amp_env_modulation(osc_1_amp_mod_env_level, adsr_out[osc_1_amp_mod_env - 1]);
-	}
-	else
-	{
-		set_osc_1_amp_env_modulation(osc_1_amp_mod_env_level, 0.0f);
-	}
-
-	if (amp_1_pan_mod_lfo > _LFO_NONE)
-	{
-		set_amp_1_ch_1_pan_lfo_modulation(amp_1_pan_mod_lfo_level, lfo_out[amp_1_pan_mod_lfo - 1]);
-	}
-	else
-	{
-		set_amp_1_ch_1_pan_lfo_modulation(0.0f, 0.0f);
-	}
-	
-
-	if (osc_2_freq_mod_lfo > _LFO_NONE)
-	{
-		set_osc_2_freq_lfo_modulation(osc_2_freq_mod_lfo_level, lfo_out[osc_2_freq_mod_lfo - 1]);
-	}
-	else
-	{
-		osc_2_freq_lfo_modulation = 0.f;
-	}
-
-	if (osc_2_freq_mod_env > _ENV_NONE)
-	{
-		set_osc_2_freq_env_modulation(osc_2_freq_mod_env_level, adsr_out[osc_2_freq_mod_env - 1]);
-	}
-	else
-	{
-		set_osc_2_freq_env_modulation(osc_2_freq_mod_env_level, 0.0f);
-	}
-
-	if (osc_2_pwm_mod_lfo > _LFO_NONE)
-	{
-		set_osc_2_pwm_lfo_modulation(osc_2_pwm_mod_lfo_level, lfo_out[osc_2_pwm_mod_lfo - 1]);
-	}
-	else
-	{
-		osc_2_pwm_lfo_modulation = 0.f;
-	}
-
-	if (osc_2_pwm_mod_env > _ENV_NONE)
-	{
-		set_osc_2_pwm_env_modulation(osc_2_pwm_mod_env_level, adsr_out[osc_2_pwm_mod_env - 1]);
-	}
-	else
-	{
-		set_osc_2_pwm_env_modulation(osc_2_pwm_mod_env_level, 0.0f);
-	}
-
-	if (osc_2_amp_mod_lfo > _LFO_NONE)
-	{
-		set_osc_2_amp_lfo_modulation(osc_2_amp_mod_lfo_level, lfo_out[osc_2_amp_mod_lfo - 1]);
-	}
-	else
-	{
-		osc_2_amp_lfo_modulation = 1.f;
-	}
-
-	if (osc_2_amp_mod_env > _ENV_NONE)
-	{
-		set_osc_2_amp_env_modulation(osc_2_amp_mod_env_level, adsr_out[osc_2_amp_mod_env - 1]);
-	}
-	else
-	{
-		set_osc_2_amp_env_modulation(osc_2_amp_mod_env, 0.0f);
-	}
-
-	if (amp_2_pan_mod_lfo > _LFO_NONE)
-	{
-		set_amp_1_ch_2_pan_lfo_modulation(amp_2_pan_mod_lfo_level, lfo_out[amp_2_pan_mod_lfo - 1]);
-	}
-	else
-	{
-		set_amp_1_ch_2_pan_lfo_modulation(0.0f, 0.0f);
-	}
-
+	modulation_sources[_VOICE_MOD_SOURCE_ENV_1 + 4] = adsr_5->get_output_val();
 	
-	if (noise_1_amp_mod_lfo > _LFO_NONE)
-	{
-		set_noise_1_amp_lfo_modulation(noise_1_amp_env_modulation, lfo_out[noise_1_amp_mod_lfo - 1]);
-	}
-	else
-	{
-		noise_1_amp_lfo_modulation = 1.f;
-	}
-
-	if (noise_1_amp_mod_env > _ENV_NONE)
-	{
-		set_noise_1_amp_env_modulation(noise_1_amp_mod_env_level, adsr_out[noise_1_amp_mod_env - 1]);
-	}
-	else
-	{
-		set_noise_1_amp_env_modulation(noise_1_amp_mod_env_level, 0.0f);
-	}
-
-	if (mso_1_freq_mod_lfo > _LFO_NONE)
-	{
-		set_mso_1_freq_lfo_modulation(mso_1_freq_mod_lfo_level, lfo_out[mso_1_freq_mod_lfo - 1]);
-	}
-	else
-	{
-		mso_1_freq_lfo_modulation = 0.f;
-	}
-
-	if (mso_1_freq_mod_env > _ENV_NONE)
-	{
-		set_mso_1_freq_env_modulation(mso_1_freq_mod_env_level, adsr_out[mso_1_freq_mod_env - 1]);
-	}
-	else
-	{
-		set_mso_1_freq_env_modulation(mso_1_freq_mod_env_level, 0.0f);
-	}
-
-	if (mso_1_pwm_mod_lfo > _LFO_NONE)
-	{
-		set_mso_1_pwm_lfo_modulation(mso_1_pwm_mod_lfo_level, lfo_out[mso_1_pwm_mod_lfo - 1]);
-	}
-	else
-	{
-		mso_1_pwm_lfo_modulation = 0.f;
-	}
-
-	if (mso_1_pwm_mod_env > _ENV_NONE)
+	if (modulation_matrix_changed)
 	{
-		set_mso_1_pwm_env_modulation(mso_1_pwm_mod_env_level, adsr_out[mso_1_pwm_mod_env - 1]);
-	}
-	else
-	{
-		set_mso_1_pwm_env_modulation(mso_1_pwm_mod_env_level, 0.0f);
-	}
-
-	if (mso_1_amp_mod_lfo > _LFO_NONE)
-	{
-		set_mso_1_amp_lfo_modulation(mso_1_amp_mod_lfo_level, lfo_out[mso_1_amp_mod_lfo - 1]);
-	}
-	else
-	{
-		mso_1_amp_lfo_modulation = 1.f;
-	}
-
-	if (mso_1_amp_mod_env > _ENV_NONE)
-	{
-		set_mso_1_amp_env_modulation(mso_1_amp_mod_env_level, adsr_out[mso_1_amp_mod_env - 1]);
-	}
-	else
-	{
-		set_mso_1_amp_env_modulation(mso_1_amp_mod_env_level, 0.0f);
-	}
-
-	if (wavetable_1_freq_mod_lfo > _LFO_NONE)
-	{
-		set_pad_1_freq_lfo_modulation(wavetable_1_freq_mod_lfo_level, lfo_out[wavetable_1_freq_mod_lfo - 1]);
-	}
-	else
-	{
-		wavetable_1_freq_lfo_modulation = 0.f;
-	}
-
-	if (wavetable_1_freq_mod_env > _ENV_NONE)
-	{
-		set_pad_1_freq_env_modulation(wavetable_1_freq_mod_env_level, adsr_out[wavetable_1_freq_mod_env - 1]);
-	}
-	else
-	{
-		set_pad_1_freq_env_modulation(wavetable_1_freq_mod_env_level, 0.0f);
+		compile_modulation_matrix();
 	}
 
-	if (wavetable_1_amp_mod_lfo > _LFO_NONE)
-	{
-		set_pad_1_amp_lfo_modulation(wavetable_1_amp_mod_lfo_level, lfo_out[wavetable_1_amp_mod_lfo - 1]);
-	}
-	else
+	for (int i = 0; i < num_of_modulation_routes; i++)
 	{
-		wavetable_1_amp_lfo_modulation = 1.f;
-	}
-
-	if (wavetable_1_amp_mod_env > _ENV_NONE)
-	{
-		set_pad_1_amp_env_modulation(wavetable_1_amp_mod_env_level, adsr_out[wavetable_1_amp_mod_env - 1]);
-	}
-	else
-	{
-		set_pad_1_amp_env_modulation(wavetable_1_amp_mod_env_level, 0.0f);
-	}
-
-	if (filter_1_freq_mod_lfo > _LFO_NONE)
-	{
-		set_filter_1_freq_lfo_modulation(filter_1_freq_mod_lfo_level, lfo_out[filter_1_freq_mod_lfo - 1]);
-	}
-	else
-	{
-		filter_1_freq_lfo_modulation = 0.f;
-	}
-
-	if (filter_1_freq_mod_env > _ENV_NONE)
-	{
-		set_filter_1_freq_env_modulation(filter_1_freq_mod_env_level, adsr_out[filter_1_freq_mod_env - 1]);
-	}
-	else
-	{
-		set_filter_1_freq_env_modulation(filter_1_freq_mod_env_level, 0.0f);
-	}
-
-	if (filter_2_freq_mod_lfo > _LFO_NONE)
-	{
-		set_filter_2_freq_lfo_modulation(filter_2_freq_mod_lfo_level, lfo_out[filter_2_freq_mod_lfo - 1]);
-	}
-	else
-	{
-		filter_2_freq_lfo_modulation = 0.f;
-	}
-
-	if (filter_2_freq_mod_env > _ENV_NONE)
-	{
-		set_filter_2_freq_env_modulation(filter_2_freq_mod_env_level, adsr_out[filter_2_freq_mod_env - 1]);
-	}
-	else
-	{
-		set_filter_2_freq_env_modulation(filter_2_freq_mod_env_level, 0.0f);
+		route = &modulation_routes[i];
+		(this->*route->apply)(this->*route->depth, modulation_sources[route->source]);
 	}
 }
 
 /**
 *	@brief	Update modulation factors
-*	@param	voice	voice number to be updated
+*	@param	voice	voice number to be updated (-1: a stolen voice that is not assigned to a voice)
 *	@return void
 */
 void DSP_Voice::update_voice_modulation(int voice)
@@ -1495,26 +1354,31 @@ void DSP_Voice::update_voice_modulation(int voice)
 		freq_mod_pad_1 = 1.0f;
 	}
 	
-	osc_1_detune = detune_frequency_factor(
+	// The detune factors are recalculated only when the detune settings are changed
+	osc_1_detune = cached_detune_frequency_factor(
+		&osc_1_detune_cache,
 		osc_1->get_freq_detune_oct(),
 		osc_1->get_freq_detune_semitones(),
 		osc_1->get_freq_detune_cents(),
 		freq_mod_osc_1);
 	
-	osc_2_detune = detune_frequency_factor(
+	osc_2_detune = cached_detune_frequency_factor(
+		&osc_2_detune_cache,
 		osc_2->get_freq_detune_oct(),
 		osc_2->get_freq_detune_semitones(),
 		osc_2->get_freq_detune_cents(),
 		freq_mod_osc_2);
 
-	mso_1_detune = detune_frequency_factor(
+	mso_1_detune = cached_detune_frequency_factor(
+		&mso_1_detune_cache,
 		mso_1->get_freq_detune_oct(),
 		mso_1->get_freq_detune_semitones(),
 		mso_1->get_freq_detune_cents(),
 		freq_mod_mso_1);
 
-	pad_1_detune = detune_frequency_factor
-		(wavetable_1->get_freq_detune_oct(),
+	pad_1_detune = cached_detune_frequency_factor(
+		&pad_1_detune_cache,
+		wavetable_1->get_freq_detune_oct(),
 		wavetable_1->get_freq_detune_semitones(),
 		wavetable_1->get_freq_detune_cents(),
 		freq_mod_pad_1);
@@ -1585,20 +1449,14 @@ void DSP_Voice::update_voice_modulation(int voice)
 		(!wavetable_1_active || (wavetable_1_amp_env_modulation < 0.05f) || ((wavetable_1_send_filter_1_level < 0.05f) && (wavetable_1_send_filter_2_level < 0.05f))) &&
 		(!noise_1_active || (noise_1_amp_env_modulation < 0.05f) || ((noise_1_send_filter_1_level < 0.05f) && (noise_1_send_filter_2_level < 0.05f))) &&
 		(!karplus_1_active || (karplus_1->get_energy() < 0.000005) || ((karplus_1_send_filter_1_level < 0.05f) && (karplus_1_send_filter_2_level < 0.05f))) &&
-		voice_waits_for_not_active)
+		voice_waits_for_not_active && (voice >= 0))
 	{
 		//		if (voice_end_event_callback_ptr)
 		//		{
 		//			voice_end_event_callback_ptr(voice);
 		//		}
 
-		AdjSynth::get_instance()->synth_voice[voice]->audio_voice->set_inactive();
-		AdjSynth::get_instance()->synth_voice[voice]->audio_voice->reset_wait_for_not_active();
-		AdjSynth::get_instance()->synth_voice[voice]->assign_dsp_voice(AdjSynth::get_instance()->get_original_main_dsp_voices(voice));
-		AdjSynth::get_instance()->synth_voice[voice]->mso_wtab = original_mso_wtab_1;	
-		AdjSynth::get_instance()->synth_voice[voice]->pad_wavetable = original_pad_wavetable_1;
-		AdjSynth::get_instance()->audio_poly_mixer->restore_gain_pan(voice);
-
+		end_voice(voice);
 	}
 	
 	// Filter freq
@@ -1623,6 +1481,26 @@ void DSP_Voice::update_voice_modulation(int voice)
 	}
 }
 
+/**
+*	@brief	End the voice: set its synth voice inactive (free it), restore the synth voice
+*			original DSP voice, wavetables and poly-mixer gain and pan, and mark this 
+*			(pooled) DSP voice ended. It is freed by free_if_ended() when the rendered 
+*			block is done.
+*	@param	voice	the synth voice this DSP voice is assigned to
+*	@return void
+*/
+void DSP_Voice::end_voice(int voice)
+{
+	AdjSynth::get_instance()->synth_voice[voice]->audio_voice->set_inactive();
+	AdjSynth::get_instance()->synth_voice[voice]->audio_voice->reset_wait_for_not_active();
+	AdjSynth::get_instance()->synth_voice[voice]->assign_dsp_voice(AdjSynth::get_instance()->get_original_main_dsp_voices(voice));
+	AdjSynth::get_instance()->synth_voice[voice]->mso_wtab = original_mso_wtab_1;	
+	AdjSynth::get_instance()->synth_voice[voice]->pad_wavetable = original_pad_wavetable_1;
+	AdjSynth::get_instance()->audio_poly_mixer->restore_gain_pan(voice);
+	// The pooled render voice can be bound to a new note when its block is done
+	ended = true;
+}
+
 /**
 *	@brief	Calculate oscilators and generator next output values
 *	@param	none
@@ -1630,9 +1508,20 @@ void DSP_Voice::update_voice_modulation(int voice)
 */
 void DSP_Voice::calc_next_oscilators_output_value()
 {
+	uint64_t ticks = 0;
+	
+	if (profiling_active)
+	{
+		ticks = AudioVoiceProfiler::get_ticks();
+	}
+	
 	if (osc_1_active)
 	{
 		osc_1_out = osc_1->get_next_output_val(act_freq_osc_1) * mag_modulation_osc_1;
+		if (profiling_active)
+		{
+			ticks = profile_mark(_VOICE_PROFILE_MODULE_OSC_1, ticks);
+		}
 	}
 	// Sync
 	if (osc_2_sync_on_osc_1)
@@ -1646,21 +1535,37 @@ void DSP_Voice::calc_next_oscilators_output_value()
 	if (osc_2_active)
 	{
 		osc_2_out = osc_2->get_next_output_val(act_freq_osc_2) * mag_modulation_osc_2;
+		if (profiling_active)
+		{
+			ticks = profile_mark(_VOICE_PROFILE_MODULE_OSC_2, ticks);
+		}
 	}
 
 	if (noise_1_active)
 	{
 		noise_1_out = noise_1->get_next_noise_val() * noise_1_amp_lfo_modulation * noise_1_amp_env_modulation;
+		if (profiling_active)
+		{
+			ticks = profile_mark(_VOICE_PROFILE_MODULE_NOISE_1, ticks);
+		}
 	}
 	
 	if (karplus_1_active)
 	{
 		karplus_1_out = karplus_1->get_next_output_value();
+		if (profiling_active)
+		{
+			ticks = profile_mark(_VOICE_PROFILE_MODULE_KARPLUS_1, ticks);
+		}
 	}
 
 	if (mso_1_active)
 	{
 		mso_1_out = mso_1->get_next_mso_wtab_val(act_freq_mso_1, 0) * mag_modulation_mso_1;
+		if (profiling_active)
+		{
+			ticks = profile_mark(_VOICE_PROFILE_MODULE_MSO_1, ticks);
+		}
 	}
 
 	if (wavetable_1_active)
@@ -1669,6 +1574,10 @@ void DSP_Voice::calc_next_oscilators_output_value()
 		wavetable_1->get_next_wavetable_value(&wavetable_1_out_1, &wavetable_1_out_2);
 		wavetable_1_out_1 *= mag_modulation_pad_1;
 		wavetable_1_out_2 *= mag_modulation_pad_1;
+		if (profiling_active)
+		{
+			profile_mark(_VOICE_PROFILE_MODULE_WAVETABLE_1, ticks);
+		}
 	}
 }
 
@@ -1686,12 +1595,27 @@ float DSP_Voice::get_next_output_value_ch_1()
 				 mso_1_out * mso_1_send_filter_1_level +
 				 wavetable_1_out_1 * wavetable_1_send_filter_1_level;
 
+	uint64_t ticks = 0;
+	
+	if (profiling_active)
+	{
+		ticks = AudioVoiceProfiler::get_ticks();
+	}
+
 	if (distortion_1_active)
 	{
 		sig_1 = distortion_1->get_next_output_val(sig_1);
+		if (profiling_active)
+		{
+			ticks = profile_mark(_VOICE_PROFILE_MODULE_DISTORTION, ticks);
+		}
 	}
 	
 	float filter_out = filter_1->filter_output(sig_1, filter_1_freq_mod);
+	if (profiling_active)
+	{
+		profile_mark(_VOICE_PROFILE_MODULE_FILTERS, ticks);
+	}
 	
 	return filter_out;
 }
@@ -1710,18 +1634,569 @@ float DSP_Voice::get_next_output_value_ch_2()
 				 mso_1_out * mso_1_send_filter_2_level +
 				 wavetable_1_out_2 * wavetable_1_send_filter_2_level;
 
+	uint64_t ticks = 0;
+	
+	if (profiling_active)
+	{
+		ticks = AudioVoiceProfiler::get_ticks();
+	}
+
 	if (distortion_2_active)
 	{
 		sig_2 = distortion_2->get_next_output_val(sig_2);
+		if (profiling_active)
+		{
+			ticks = profile_mark(_VOICE_PROFILE_MODULE_DISTORTION, ticks);
+		}
 	}
 
-	float filter_out = filter_1->filter_output(sig_2, filter_2_freq_mod);
+	float filter_out = filter_2->filter_output(sig_2, filter_2_freq_mod);
+	if (profiling_active)
+	{
+		profile_mark(_VOICE_PROFILE_MODULE_FILTERS, ticks);
+	}
 
 	return filter_out;
 }
 
 
 
+/**
+*	@brief	Mix a generator control sub-block into the two voice channels
+*	@param	src		a pointer to the generator sub-block; NULL if the generator is not active
+*	@param	held	the generator last output value, mixed when src is NULL
+*	@param	gain_1	channel 1 gain (modulation * send level)
+*	@param	gain_2	channel 2 gain (modulation * send level)
+*	@param	sig_1	a pointer to the channel 1 sub-block
+*	@param	sig_2	a pointer to the channel 2 sub-block
+*	@param	size	number of samples
+*	@return void
+*/
+static inline void mix_source_block(const float *src, float held, float gain_1, float gain_2,
+	float *sig_1, float *sig_2, int size)
+{
+	int i;
+	
+	if (src)
+	{
+		for (i = 0; i < size; i++)
+		{
+			sig_1[i] += src[i] * gain_1;
+			sig_2[i] += src[i] * gain_2;
+		}
+	}
+	else if (held != 0.0f)
+	{
+		// A disabled generator keeps contributing its last output value (as the per sample path)
+		gain_1 *= held;
+		gain_2 *= held;
+		for (i = 0; i < size; i++)
+		{
+			sig_1[i] += gain_1;
+			sig_2[i] += gain_2;
+		}
+	}
+}
+
+/**
+*	@brief	Render a control sub-block (up to _CONTROL_SUB_SAMPLING samples) of both voice channels.
+*			The modulation values are constant over the sub-block: each active generator renders
+*			its sub-block, the generators are mixed by their send levels, and each channel is
+*			processed by its distortion and filter.
+*	@param	out_1	a pointer to a size samples channel 1 output buffer
+*	@param	out_2	a pointer to a size samples channel 2 output buffer
+*	@param	size	number of samples (up to _CONTROL_SUB_SAMPLING)
+*	@return void
+*/
+void DSP_Voice::render_sub_block(float *out_1, float *out_2, int size)
+{
+	float *block_1 = source_block[0];
+	float *block_2 = source_block[1];
+	float sync_offsets[_CONTROL_SUB_SAMPLING];
+	uint64_t ticks = 0;
+	int i, num_of_syncs;
+	
+	if (profiling_active)
+	{
+		ticks = AudioVoiceProfiler::get_ticks();
+	}
+	
+	for (i = 0; i < size; i++)
+	{
+		out_1[i] = 0.0f;
+		out_2[i] = 0.0f;
+	}
+	
+	if (osc_1_active && osc_2_active && osc_2_sync_on_osc_1 &&
+		osc_1->is_band_limited_waveform() && osc_2->is_band_limited_waveform())
+	{
+		// OSC 2 is reset at the sample accurate positions of OSC 1 cycles restarts
+		num_of_syncs = osc_1->get_next_sync_master_output_block(block_1, size, act_freq_osc_1, sync_offsets);
+		osc_2->get_next_synced_output_block(block_2, size, act_freq_osc_2, sync_offsets, num_of_syncs);
+		
+		osc_1_out = block_1[size - 1] * mag_modulation_osc_1;
+		osc_2_out = block_2[size - 1] * mag_modulation_osc_2;
+		
+		mix_source_block(block_1, 0,
+			mag_modulation_osc_1 * osc_1_send_filter_1_level,
+			mag_modulation_osc_1 * osc_1_send_filter_2_level,
+			out_1, out_2, size);
+		mix_source_block(block_2, 0,
+			mag_modulation_osc_2 * osc_2_send_filter_1_level,
+			mag_modulation_osc_2 * osc_2_send_filter_2_level,
+			out_1, out_2, size);
+		
+		if (profiling_active)
+		{
+			// The synced pair is accounted as OSC 2
+			ticks = profile_mark(_VOICE_PROFILE_MODULE_OSC_2, ticks);
+		}
+	}
+	else if (osc_2_active && osc_2_sync_on_osc_1)
+	{
+		// OSC 2 is synced on OSC 1 cycles: both are rendered sample by sample
+		for (i = 0; i < size; i++)
+		{
+			if (osc_1_active)
+			{
+				osc_1_out = osc_1->get_next_output_val(act_freq_osc_1) * mag_modulation_osc_1;
+			}
+			
+			if (osc_1->get_cycle_restarted_sync_state())
+			{
+				osc_2->sync();
+			}
+			
+			block_1[i] = osc_1_out;
+			block_2[i] = osc_2->get_next_output_val(act_freq_osc_2) * mag_modulation_osc_2;
+		}
+		
+		osc_2_out = block_2[size - 1];
+		
+		mix_source_block(block_1, 0, osc_1_send_filter_1_level, osc_1_send_filter_2_level, out_1, out_2, size);
+		mix_source_block(block_2, 0, osc_2_send_filter_1_level, osc_2_send_filter_2_level, out_1, out_2, size);
+		
+		if (profiling_active)
+		{
+			// The synced pair is accounted as OSC 2
+			ticks = profile_mark(_VOICE_PROFILE_MODULE_OSC_2, ticks);
+		}
+	}
+	else
+	{
+		if (osc_1_active)
+		{
+			osc_1->get_next_output_block(block_1, size, act_freq_osc_1);
+			osc_1_out = block_1[size - 1] * mag_modulation_osc_1;
+			mix_source_block(block_1, 0,
+				mag_modulation_osc_1 * osc_1_send_filter_1_level,
+				mag_modulation_osc_1 * osc_1_send_filter_2_level,
+				out_1, out_2, size);
+			
+			if (profiling_active)
+			{
+				ticks = profile_mark(_VOICE_PROFILE_MODULE_OSC_1, ticks);
+			}
+		}
+		else
+		{
+			mix_source_block(NULL, osc_1_out, osc_1_send_filter_1_level, osc_1_send_filter_2_level, out_1, out_2, size);
+		}
+		
+		if (osc_2_active)
+		{
+			osc_2->get_next_output_block(block_1, size, act_freq_osc_2);
+			osc_2_out = block_1[size - 1] * mag_modulation_osc_2;
+			mix_source_block(block_1, 0,
+				mag_modulation_osc_2 * osc_2_send_filter_1_level,
+				mag_modulation_osc_2 * osc_2_send_filter_2_level,
+				out_1, out_2, size);
+			
+			if (profiling_active)
+			{
+				ticks = profile_mark(_VOICE_PROFILE_MODULE_OSC_2, ticks);
+			}
+		}
+		else
+		{
+			mix_source_block(NULL, osc_2_out, osc_2_send_filter_1_level, osc_2_send_filter_2_level, out_1, out_2, size);
+		}
+	}
+	
+	if (noise_1_active)
+	{
+		float noise_gain = noise_1_amp_lfo_modulation * noise_1_amp_env_modulation;
+		
+		noise_1->get_next_noise_block(block_1, size);
+		noise_1_out = block_1[size - 1] * noise_gain;
+		mix_source_block(block_1, 0,
+			noise_gain * noise_1_send_filter_1_level,
+			noise_gain * noise_1_send_filter_2_level,
+			out_1, out_2, size);
+		
+		if (profiling_active)
+		{
+			ticks = profile_mark(_VOICE_PROFILE_MODULE_NOISE_1, ticks);
+		}
+	}
+	else
+	{
+		mix_source_block(NULL, noise_1_out, noise_1_send_filter_1_level, noise_1_send_filter_2_level, out_1, out_2, size);
+	}
+	
+	if (karplus_1_active)
+	{
+		karplus_1->get_next_output_block(block_1, size);
+		karplus_1_out = block_1[size - 1];
+		mix_source_block(block_1, 0, karplus_1_send_filter_1_level, karplus_1_send_filter_2_level, out_1, out_2, size);
+		
+		if (profiling_active)
+		{
+			ticks = profile_mark(_VOICE_PROFILE_MODULE_KARPLUS_1, ticks);
+		}
+	}
+	else
+	{
+		mix_source_block(NULL, karplus_1_out, karplus_1_send_filter_1_level, karplus_1_send_filter_2_level, out_1, out_2, size);
+	}
+	
+	if (mso_1_active)
+	{
+		mso_1->get_next_mso_wtab_block(block_1, size, act_freq_mso_1);
+		mso_1_out = block_1[size - 1] * mag_modulation_mso_1;
+		mix_source_block(block_1, 0,
+			mag_modulation_mso_1 * mso_1_send_filter_1_level,
+			mag_modulation_mso_1 * mso_1_send_filter_2_level,
+			out_1, out_2, size);
+		
+		if (profiling_active)
+		{
+			ticks = profile_mark(_VOICE_PROFILE_MODULE_MSO_1, ticks);
+		}
+	}
+	else
+	{
+		mix_source_block(NULL, mso_1_out, mso_1_send_filter_1_level, mso_1_send_filter_2_level, out_1, out_2, size);
+	}
+	
+	if (wavetable_1_active)
+	{
+		float gain_1 = mag_modulation_pad_1 * wavetable_1_send_filter_1_level;
+		float gain_2 = mag_modulation_pad_1 * wavetable_1_send_filter_2_level;
+		
+		wavetable_1->set_output_frequency(act_freq_pad_1, false); // false: do not init pointers
+		wavetable_1->get_next_wavetable_block(block_1, block_2, size);
+		wavetable_1_out_1 = block_1[size - 1] * mag_modulation_pad_1;
+		wavetable_1_out_2 = block_2[size - 1] * mag_modulation_pad_1;
+		
+		for (i = 0; i < size; i++)
+		{
+			out_1[i] += block_1[i] * gain_1;
+			out_2[i] += block_2[i] * gain_2;
+		}
+		
+		if (profiling_active)
+		{
+			ticks = profile_mark(_VOICE_PROFILE_MODULE_WAVETABLE_1, ticks);
+		}
+	}
+	else
+	{
+		mix_source_block(NULL, wavetable_1_out_1, wavetable_1_send_filter_1_level, 0, out_1, out_2, size);
+		mix_source_block(NULL, wavetable_1_out_2, 0, wavetable_1_send_filter_2_level, out_1, out_2, size);
+	}
+	
+	if (profiling_active)
+	{
+		ticks = AudioVoiceProfiler::get_ticks();
+	}
+	
+	if (distortion_1_active)
+	{
+		distortion_1->get_next_output_block(out_1, size);
+	}
+	
+	if (distortion_2_active)
+	{
+		distortion_2->get_next_output_block(out_2, size);
+	}
+	
+	if (profiling_active && (distortion_1_active || distortion_2_active))
+	{
+		ticks = profile_mark(_VOICE_PROFILE_MODULE_DISTORTION, ticks);
+	}
+	
+	filter_1->filter_output_block(out_1, size, filter_1_freq_mod);
+	filter_2->filter_output_block(out_2, size, filter_2_freq_mod);
+	
+	if (profiling_active)
+	{
+		profile_mark(_VOICE_PROFILE_MODULE_FILTERS, ticks);
+	}
+}
+
+/**
+*	@brief	Render a block of both voice channels output samples.
+*			The modulation values are updated every _CONTROL_SUB_SAMPLING samples, and each 
+*			control sub-block is rendered by the generators and processors block functions.
+*			If the voice ends during the block (its synth voice is released), the rest of
+*			the block is silent.
+*	@param	out_1			a pointer to a size samples channel 1 output buffer
+*	@param	out_2			a pointer to a size samples channel 2 output buffer
+*	@param	size			number of samples
+*	@param	synth_voice_num	the synth voice this DSP voice is assigned to
+*	@return void
+*/
+void DSP_Voice::render_block(float *out_1, float *out_2, int size, int synth_voice_num)
+{
+	int start, sub_block_size, i;
+	uint64_t ticks = 0;
+	
+	for (start = 0; start < size; start += _CONTROL_SUB_SAMPLING)
+	{
+		sub_block_size = size - start;
+		if (sub_block_size > _CONTROL_SUB_SAMPLING)
+		{
+			sub_block_size = _CONTROL_SUB_SAMPLING;
+		}
+		
+		// Update modulation factors - updated only every _CONTROL_SUB_SAMPLING samples
+		if (profiling_active)
+		{
+			ticks = AudioVoiceProfiler::get_ticks();
+		}
+		
+		calc_next_modulation_values();
+		update_voice_modulation(synth_voice_num);
+		
+		if (profiling_active)
+		{
+			profile_mark(_VOICE_PROFILE_MODULE_MODULATION, ticks);
+		}
+		
+		if (!voice_active)
+		{
+			// Voice ended
+			for (i = start; i < size; i++)
+			{
+				out_1[i] = 0.0f;
+				out_2[i] = 0.0f;
+			}
+			
+			break;
+		}
+		
+		render_sub_block(out_1 + start, out_2 + start, sub_block_size);
+	}
+	
+	if (voice_active)
+	{
+		detect_silence(out_1, out_2, size, synth_voice_num);
+	}
+}
+
+/**
+*	@brief	Render a block of a stolen voice output samples (the voice is no longer assigned 
+*			to a synth voice), to be faded out over the block.
+*			The modulation values are updated once; the voice is not ended by the block.
+*	@param	out_1	a pointer to a size samples channel 1 output buffer
+*	@param	out_2	a pointer to a size samples channel 2 output buffer
+*	@param	size	number of samples (up to _CONTROL_SUB_SAMPLING)
+*	@return void
+*/
+void DSP_Voice::render_fade_out_block(float *out_1, float *out_2, int size)
+{
+	if (size > _CONTROL_SUB_SAMPLING)
+	{
+		size = _CONTROL_SUB_SAMPLING;
+	}
+	
+	calc_next_modulation_values();
+	update_voice_modulation(-1); // -1: no synth voice to end
+	render_sub_block(out_1, out_2, size);
+}
+
+/**
+*	@brief	Voice silence detector: when the block output (after the filters) peak stays below
+*			the silence threshold for the silence hold time, the voice is ended and freed, 
+*			instead of rendering silent blocks until its envelopes or Karplus-Strong energy
+*			decay (e.g. long KPS decays or long release times at a low level).
+*			Played (not released) voices are checked only when all their envelopes are settled.
+*	@param	out_1			a pointer to a size samples channel 1 output buffer
+*	@param	out_2			a pointer to a size samples channel 2 output buffer
+*	@param	size			number of samples
+*	@param	synth_voice_num	the synth voice this DSP voice is assigned to
+*	@return void
+*/
+void DSP_Voice::detect_silence(float *out_1, float *out_2, int size, int synth_voice_num)
+{
+	float peak = 0.0f, remaining_time = 0.0f, cost;
+	unsigned long saved_blocks = 0;
+	unsigned long long saved_time_us = 0;
+	DSP_ADSR *adsrs[] = { adsr_1, adsr_2, adsr_3, adsr_4, adsr_5 };
+	int i;
+	int hold_time_ms = silence_hold_time_ms.load(std::memory_order_relaxed);
+	
+	if ((hold_time_ms <= 0) || (!voice_waits_for_not_active && !envelopes_settled()))
+	{
+		silent_samples = 0;
+		return;
+	}
+	
+	for (i = 0; i < size; i++)
+	{
+		peak = fmaxf(peak, fmaxf(fabsf(out_1[i]), fabsf(out_2[i])));
+	}
+	
+	if (peak >= silence_threshold.load(std::memory_order_relaxed))
+	{
+		silent_samples = 0;
+		return;
+	}
+	
+	silent_samples += size;
+	AudioDspLoadMeter::get_instance()->add_silent_voice_block();
+	
+	if (silent_samples < (int)((long long)hold_time_ms * sample_rate / 1000))
+	{
+		return;
+	}
+	
+	// Estimate the blocks that would have been rendered until the envelopes end
+	for (i = 0; i < 5; i++)
+	{
+		remaining_time = fmaxf(remaining_time, adsrs[i]->get_remaining_release_time());
+	}
+	
+	saved_blocks = (unsigned long)(remaining_time * (float)sample_rate / (float)size);
+	cost = AudioVoiceRenderPool::get_instance()->get_voice_processing_cost(synth_voice_num);
+	if (cost > 0.0f)
+	{
+		saved_time_us = (unsigned long long)((float)saved_blocks * cost);
+	}
+	
+	// Do not leave decaying (denormals prone) states for the next note
+	filter_1->clear();
+	filter_2->clear();
+	karplus_1->clear_state();
+	
+	silent_samples = 0;
+	end_voice(synth_voice_num);
+	
+	AudioDspLoadMeter::get_instance()->add_silent_voice_freed(saved_blocks, saved_time_us);
+}
+
+/**
+*	@brief	Return true if all the voice envelopes are settled (sustain or idle), so
+*			a silent output will not change until the note is released.
+*	@param	none
+*	@return true if all the envelopes are settled; false otherwise
+*/
+bool DSP_Voice::envelopes_settled()
+{
+	DSP_ADSR *adsrs[] = { adsr_1, adsr_2, adsr_3, adsr_4, adsr_5 };
+	int state;
+	
+	for (int i = 0; i < 5; i++)
+	{
+		state = adsrs[i]->get_state();
+		if ((state != ADSR_STATE_SUSTAIN) && (state != ADSR_STATE_IDLE))
+		{
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+/**
+*	@brief	Set the voices silence detector threshold (all voices)
+*	@param	thresh_db	threshold _VOICE_SILENCE_THRESHOLD_DB_MIN to _VOICE_SILENCE_THRESHOLD_DB_MAX [dB]
+*	@return void
+*/
+void DSP_Voice::set_silence_threshold_db(int thresh_db)
+{
+	if (thresh_db < _VOICE_SILENCE_THRESHOLD_DB_MIN)
+	{
+		thresh_db = _VOICE_SILENCE_THRESHOLD_DB_MIN;
+	}
+	else if (thresh_db > _VOICE_SILENCE_THRESHOLD_DB_MAX)
+	{
+		thresh_db = _VOICE_SILENCE_THRESHOLD_DB_MAX;
+	}
+	
+	silence_threshold_db.store(thresh_db, std::memory_order_relaxed);
+	silence_threshold.store(powf(10.0f, (float)thresh_db / 20.0f), std::memory_order_relaxed);
+}
+
+/**
+*	@brief	Return the voices silence detector threshold
+*	@param	none
+*	@return threshold [dB]
+*/
+int DSP_Voice::get_silence_threshold_db() { return silence_threshold_db.load(std::memory_order_relaxed); }
+
+/**
+*	@brief	Set the voices silence detector hold time: the time the output must stay below
+*			the silence threshold before the voice is freed (all voices)
+*	@param	hold_ms	hold time _VOICE_SILENCE_HOLD_MS_MIN to _VOICE_SILENCE_HOLD_MS_MAX [mSec]; 
+*			0 disables the silence detector
+*	@return void
+*/
+void DSP_Voice::set_silence_hold_time_ms(int hold_ms)
+{
+	if (hold_ms < _VOICE_SILENCE_HOLD_MS_MIN)
+	{
+		hold_ms = _VOICE_SILENCE_HOLD_MS_MIN;
+	}
+	else if (hold_ms > _VOICE_SILENCE_HOLD_MS_MAX)
+	{
+		hold_ms = _VOICE_SILENCE_HOLD_MS_MAX;
+	}
+	
+	silence_hold_time_ms.store(hold_ms, std::memory_order_relaxed);
+}
+
+/**
+*	@brief	Return the voices silence detector hold time
+*	@param	none
+*	@return hold time [mSec]
+*/
+int DSP_Voice::get_silence_hold_time_ms() { return silence_hold_time_ms.load(std::memory_order_relaxed); }
+
+/**
+*	@brief	Starts a voice block processing; samples the profiling state for the whole block
+*	@param	none
+*	@return void
+*/
+void DSP_Voice::begin_profile_block()
+{
+	profiling_active = AudioVoiceProfiler::is_enabled();
+}
+
+/**
+*	@brief	Ends a voice block processing; adds the block sub-modules profile times
+*			to the profiler counters
+*	@param	none
+*	@return void
+*/
+void DSP_Voice::end_profile_block()
+{
+	if (!profiling_active)
+	{
+		return;
+	}
+	
+	AudioVoiceProfiler::add_modules_ticks(voice, profile_ticks);
+	
+	for (int i = 0; i < _VOICE_PROFILE_NUM_OF_MODULES; i++)
+	{
+		profile_ticks[i] = 0;
+	}
+	
+	profiling_active = false;
+}
+
 /**
 *	@brief	Set on OSC_2 sync on OSC_1
 *	@param	none
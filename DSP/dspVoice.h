@@ -1,12 +1,19 @@
 /**
 *	@file		dspVoice.h
 *	@author		Nahum Budin
-*	@date		16-Oct-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion. 
-
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Sub-modules profiling counters. 
+*					2. Block based rendering.
+*					3. Compiled modulation matrix and cached detune factors.
+*					4. Output silence detector.
+*					5. Stolen voices fade out rendering.
+*					6. Destructor (releases the voice DSP modules).
+*					7. MSO and PAD wavetables setting (pooled voices binding).
 *					
 *	@History	
+*				version 1.2	16-Oct-2024
+*					1. Code refactoring and notaion. 
 *				version 1.1	25_Jan-2021
 *					1. Code refactoring and notaion. 
 *					2. Adding sample-rate and bloc-size settings
@@ -20,6 +27,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "dspKarplusStrong.h"
 #include "dspMorphedSineOsc.h"
 #include "dspWavetable.h"
@@ -30,7 +39,39 @@
 #include "dspDistortion.h"
 #include "dspAdsr.h"
 
+#include "../Audio/audioVoiceProfiler.h"
+
+// Modulation matrix sources: LFOs outputs, ENVs outputs and a constant zero
+#define _VOICE_MOD_SOURCE_LFO_1				0
+#define _VOICE_MOD_SOURCE_ENV_1				(_VOICE_MOD_SOURCE_LFO_1 + _NUM_OF_LFOS)
+#define _VOICE_MOD_SOURCE_ZERO				(_VOICE_MOD_SOURCE_ENV_1 + _NUM_OF_ADSRS)
+#define _VOICE_MOD_NUM_OF_SOURCES			(_VOICE_MOD_SOURCE_ZERO + 1)
+// An LFO and an ENV route for each modulated destination
+#define _VOICE_MOD_MAX_ROUTES				32
+
 class DSP_Osc;
+class DSP_Voice;
+
+/* A modulation matrix route: apply(depth, source value) every control tick */
+typedef struct voice_modulation_route
+{
+	// Index into the modulation sources values
+	int source;
+	// Modulation depth (the destination modulator level)
+	float DSP_Voice::*depth;
+	// The destination modulation setter
+	void (DSP_Voice::*apply)(float mod_factor, float mod_val);
+} voice_modulation_route_t;
+
+/* Detune settings and their frequency factor (without modulation) */
+typedef struct voice_detune_cache
+{
+	bool valid;
+	int octave;
+	int semitones;
+	float cents;
+	float factor;
+} voice_detune_cache_t;
 
 class DSP_Voice
 {
@@ -46,6 +87,8 @@ public:
 		Wavetable *synth_pad_wavetable = NULL,
 		func_ptr_void_int_t voice_end_event_callback_pointer = NULL);
 	
+	~DSP_Voice();
+	
 	int set_sample_rate(int samp_rate);
 	int get_sample_rate();
 	
@@ -58,11 +101,15 @@ public:
 	
 	void register_voice_end_event_callback(func_ptr_void_int_t func_ptr);
 
-	void copy_my_state_to(DSP_Voice target);
+	void copy_my_state_to(DSP_Voice *target);
 	
 	void in_use();
 	void not_in_use();
 	bool is_in_use();
+	void free_if_ended();
+	
+	void set_mso_wavetable(DSP_MorphingSinusOscWTAB *mso_wtab);
+	void set_pad_wavetable(Wavetable *synth_pad_wavetable);
 	
 	void set_voice_frequency(float frq);
 	float get_voice_frequency();
@@ -346,6 +393,8 @@ public:
 	
 	float detune_frequency_factor(int detune_oct, int detune_semitones, float detune_percents);
 	float detune_frequency_factor(int detune_oct, int detune_semitones, float detune_percents, float modulation);
+	float cached_detune_frequency_factor(voice_detune_cache_t *cache, 
+		int detune_oct, int detune_semitones, float detune_percents, float modulation);
 	
 	void set_lfo_1_frequency(float freq);
 	void set_lfo_2_frequency(float freq);
@@ -355,12 +404,41 @@ public:
 	void set_lfo_6_frequency(float freq);
 
 	void calc_next_modulation_values();
+	void compile_modulation_matrix();
 
 	void update_voice_modulation(int voice = 0);
 	
 	void calc_next_oscilators_output_value();
 	float get_next_output_value_ch_1();
 	float get_next_output_value_ch_2();
+	
+	void render_block(float *out_1, float *out_2, int size, int synth_voice_num);
+	void render_fade_out_block(float *out_1, float *out_2, int size);
+	void end_voice(int synth_voice_num);
+	
+	static void set_silence_threshold_db(int thresh_db);
+	static int get_silence_threshold_db();
+	static void set_silence_hold_time_ms(int hold_ms);
+	static int get_silence_hold_time_ms();
+	
+	void begin_profile_block();
+	void end_profile_block();
+	
+	/**
+	*	@brief	Adds the time passed since start_ticks to a sub-module profile time (when profiling)
+	*	@param	module		_VOICE_PROFILE_MODULE_OSC_1 ... _VOICE_PROFILE_MODULE_MODULATION
+	*	@param	start_ticks	the sub-module processing start time [ticks]
+	*	@return the current time [ticks]
+	*/
+	inline uint64_t profile_mark(int module, uint64_t start_ticks)
+	{
+		uint64_t now = AudioVoiceProfiler::get_ticks();
+		profile_ticks[module] += now - start_ticks;
+		return now;
+	}
+	
+	/* Set once per block: when true the sub-modules processing time is measured */
+	bool profiling_active;
 
 	void set_osc_2_sync_on_osc_1();
 	void set_osc_2_not_sync_on_osc_1();
@@ -408,7 +486,10 @@ public:
 private:
 	int init_lfo_delays();
 	
-	bool used;
+	// Read by the MIDI thread (binding), written by the rendering threads (voice end)
+	std::atomic<bool> used;
+	// Set when the voice ends while rendering; the voice is freed when the block is done
+	bool ended;
 	
 	int sample_rate;
 	int audio_block_size;
@@ -427,7 +508,18 @@ private:
 	float mso_1_out;
 	float wavetable_1_out_1, wavetable_1_out_2;
 
-	float lfo_out[_NUM_OF_LFOS], adsr_out[_NUM_OF_ADSRS];	
+	// LFOs outputs, ENVs outputs and a constant zero (see _VOICE_MOD_SOURCE_LFO_1)
+	float modulation_sources[_VOICE_MOD_NUM_OF_SOURCES];
+	
+	// Active modulation routes; rebuilt when a modulator selection is changed
+	voice_modulation_route_t modulation_routes[_VOICE_MOD_MAX_ROUTES];
+	int num_of_modulation_routes;
+	bool modulation_matrix_changed;
+	// Constant zero depth of the not modulated pan routes
+	float zero_modulation_level;
+	
+	voice_detune_cache_t osc_1_detune_cache, osc_2_detune_cache;
+	voice_detune_cache_t mso_1_detune_cache, pad_1_detune_cache;
 
 	int osc_1_freq_mod_lfo, osc_1_pwm_mod_lfo, osc_1_amp_mod_lfo;
 	float osc_1_freq_mod_lfo_level, osc_1_pwm_mod_lfo_level, osc_1_amp_mod_lfo_level;
@@ -543,5 +635,23 @@ private:
 	bool distortion_1_active, distortion_2_active;
 
 	func_ptr_void_int_t voice_end_event_callback_ptr;
+	
+	/* Sub-modules processing time accumulated over the current block [ticks] */
+	uint64_t profile_ticks[_VOICE_PROFILE_NUM_OF_MODULES];
+	
+	void render_sub_block(float *out_1, float *out_2, int size);
+	void detect_silence(float *out_1, float *out_2, int size, int synth_voice_num);
+	bool envelopes_settled();
+	
+	/* Number of successive output samples below the silence threshold */
+	int silent_samples;
+	
+	/* Silence detector settings (all voices; set by the settings thread, read by the rendering threads) */
+	static std::atomic<int> silence_threshold_db;
+	static std::atomic<float> silence_threshold;
+	static std::atomic<int> silence_hold_time_ms;
+	
+	/* Generators output scratch buffers of a control sub-block */
+	float source_block[2][_CONTROL_SUB_SAMPLING];
 
 };
@@ -1,11 +1,12 @@
 /**
 *	@file		dspVoiceAmp.cpp
 *	@author		Nahum Budin
-*	@date		17-Oct-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion. 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Modulators changes rebuild the modulation matrix. 
 *					
 *	@History	
+*				version	1.2	17-Oct-2024	Code refactoring and notaion.
 *				version	1.1	28_Jan-2021	Code refactoring and notaion
 *				version	1.0	9-Jun-2018 (modulators part of voice; no control blocks and connections.)
 *
@@ -25,6 +26,8 @@ void DSP_Voice::set_amp_1_ch_1_pan_mod_lfo(int lfo) {
 	{
 		amp_1_pan_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		amp_1_pan_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	} 
 }
 
@@ -52,6 +55,8 @@ void DSP_Voice::set_amp_1_ch_2_pan_mod_lfo(int lfo)
 	{
 		amp_2_pan_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		amp_2_pan_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
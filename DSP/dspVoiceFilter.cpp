@@ -1,11 +1,12 @@
 /**
 *	@file		dspVoiceFilter.cpp
 *	@author		Nahum Budin
-*	@date		17-Oct-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion. 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Modulators changes rebuild the modulation matrix. 
 *					
 *	@History	
+*				version	1.2	17-Oct-2024	Code refactoring and notaion.
 *				version	1.1	Code refactoring and notaion.
 *				version	1.0	9-Jun-2018 (modulators part of voice; no control blocks and connections.)
 *
@@ -26,6 +27,8 @@ void DSP_Voice::set_filter_1_freq_mod_lfo(int lfo)
 	{
 		filter_1_freq_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		filter_1_freq_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -52,6 +55,8 @@ void DSP_Voice::set_filter_1_freq_mod_env(int env)
 	if ((env >= _ENV_NONE) && (env <= _ENV_6))
 	{
 		filter_1_freq_mod_env = env;
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -187,6 +192,8 @@ void DSP_Voice::set_filter_2_freq_mod_lfo(int lfo) {
 	{
 		filter_2_freq_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		filter_2_freq_lfo_modulation = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -213,6 +220,8 @@ void DSP_Voice::set_filter_2_freq_mod_env(int env)
 	if ((env >= _ENV_NONE) && (env <= _ENV_6))
 	{
 		filter_2_freq_mod_env = env;
+		
+		modulation_matrix_changed = true;
 	}
 }
 
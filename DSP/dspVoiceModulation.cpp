@@ -0,0 +1,180 @@
+/**
+*	@file		dspVoiceModulation.cpp
+*	@author		Nahum Budin
+*	@date		17-Oct-2026
+*	@version	1.0
+*
+*	@History
+*				version	1.0	17-Oct-2026	1st version
+*
+*	@brief		Synthesizer voice dsp processing - Modulation Matrix Handling.
+*
+*				The modulators selections (LFO/ENV per destination) are compiled into a compact
+*				list of the active routes when a selection is changed; every control tick only
+*				these routes are evaluated (no per destination selection branches).
+*/
+
+#include "dspVoice.h"
+#include "dspFastMath.h"
+
+/* A modulated destination */
+typedef struct voice_modulation_destination
+{
+	// Selected modulator (LFO or ENV number; _LFO_NONE / _ENV_NONE: not modulated)
+	int DSP_Voice::*modulator;
+	// _VOICE_MOD_SOURCE_LFO_1 or _VOICE_MOD_SOURCE_ENV_1
+	int first_source;
+	float DSP_Voice::*depth;
+	void (DSP_Voice::*apply)(float mod_factor, float mod_val);
+	// When not modulated the modulation is set once to idle_value;
+	// if NULL, a zero depth modulation is applied every control tick.
+	float DSP_Voice::*idle_modulation;
+	float idle_value;
+} voice_modulation_destination_t;
+
+/**
+*	@brief	Build the list of the active modulation routes.
+*			Routes are kept in the destinations processing order.
+*			Not modulated destinations are set to their idle modulation value.
+*	@param	none
+*	@return void
+*/
+void DSP_Voice::compile_modulation_matrix()
+{
+	static const voice_modulation_destination_t destinations[] =
+	{
+		{ &DSP_Voice::osc_1_freq_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::osc_1_freq_mod_lfo_level,
+			&DSP_Voice::set_osc_1_freq_lfo_modulation, &DSP_Voice::osc_1_freq_lfo_modulation, 0.0f },
+		{ &DSP_Voice::osc_1_freq_mod_env, _VOICE_MOD_SOURCE_ENV_1, &DSP_Voice::osc_1_freq_mod_env_level,
+			&DSP_Voice::set_osc_1_freq_env_modulation, &DSP_Voice::osc_1_freq_env_modulation, 0.0f },
+		{ &DSP_Voice::osc_1_pwm_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::osc_1_pwm_mod_lfo_level,
+			&DSP_Voice::set_osc_1_pwm_lfo_modulation, &DSP_Voice::osc_1_pwm_lfo_modulation, 0.0f },
+		{ &DSP_Voice::osc_1_pwm_mod_env, _VOICE_MOD_SOURCE_ENV_1, &DSP_Voice::osc_1_pwm_mod_env_level,
+			&DSP_Voice::set_osc_1_pwm_env_modulation, &DSP_Voice::osc_1_pwm_env_modulation, 0.0f },
+		{ &DSP_Voice::osc_1_amp_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::osc_1_amp_mod_lfo_level,
+			&DSP_Voice::set_osc_1_amp_lfo_modulation, &DSP_Voice::osc_1_amp_lfo_modulation, 1.0f },
+		{ &DSP_Voice::osc_1_amp_mod_env, _VOICE_MOD_SOURCE_ENV_1, &DSP_Voice::osc_1_amp_mod_env_level,
+			&DSP_Voice::set_osc_1_amp_env_modulation, &DSP_Voice::osc_1_amp_env_modulation, 0.0f },
+		{ &DSP_Voice::amp_1_pan_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::amp_1_pan_mod_lfo_level,
+			&DSP_Voice::set_amp_1_ch_1_pan_lfo_modulation, NULL, 0.0f },
+
+		{ &DSP_Voice::osc_2_freq_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::osc_2_freq_mod_lfo_level,
+			&DSP_Voice::set_osc_2_freq_lfo_modulation, &DSP_Voice::osc_2_freq_lfo_modulation, 0.0f },
+		{ &DSP_Voice::osc_2_freq_mod_env, _VOICE_MOD_SOURCE_ENV_1, &DSP_Voice::osc_2_freq_mod_env_level,
+			&DSP_Voice::set_osc_2_freq_env_modulation, &DSP_Voice::osc_2_freq_env_modulation, 0.0f },
+		{ &DSP_Voice::osc_2_pwm_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::osc_2_pwm_mod_lfo_level,
+			&DSP_Voice::set_osc_2_pwm_lfo_modulation, &DSP_Voice::osc_2_pwm_lfo_modulation, 0.0f },
+		{ &DSP_Voice::osc_2_pwm_mod_env, _VOICE_MOD_SOURCE_ENV_1, &DSP_Voice::osc_2_pwm_mod_env_level,
+			&DSP_Voice::set_osc_2_pwm_env_modulation, &DSP_Voice::osc_2_pwm_env_modulation, 0.0f },
+		{ &DSP_Voice::osc_2_amp_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::osc_2_amp_mod_lfo_level,
+			&DSP_Voice::set_osc_2_amp_lfo_modulation, &DSP_Voice::osc_2_amp_lfo_modulation, 1.0f },
+		{ &DSP_Voice::osc_2_amp_mod_env, _VOICE_MOD_SOURCE_ENV_1, &DSP_Voice::osc_2_amp_mod_env_level,
+			&DSP_Voice::set_osc_2_amp_env_modulation, &DSP_Voice::osc_2_amp_env_modulation, 0.0f },
+		{ &DSP_Voice::amp_2_pan_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::amp_2_pan_mod_lfo_level,
+			&DSP_Voice::set_amp_1_ch_2_pan_lfo_modulation, NULL, 0.0f },
+
+		// Noise LFO depth is the noise ENV modulation
+		{ &DSP_Voice::noise_1_amp_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::noise_1_amp_env_modulation,
+			&DSP_Voice::set_noise_1_amp_lfo_modulation, &DSP_Voice::noise_1_amp_lfo_modulation, 1.0f },
+		{ &DSP_Voice::noise_1_amp_mod_env, _VOICE_MOD_SOURCE_ENV_1, &DSP_Voice::noise_1_amp_mod_env_level,
+			&DSP_Voice::set_noise_1_amp_env_modulation, &DSP_Voice::noise_1_amp_env_modulation, 0.0f },
+
+		{ &DSP_Voice::mso_1_freq_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::mso_1_freq_mod_lfo_level,
+			&DSP_Voice::set_mso_1_freq_lfo_modulation, &DSP_Voice::mso_1_freq_lfo_modulation, 0.0f },
+		{ &DSP_Voice::mso_1_freq_mod_env, _VOICE_MOD_SOURCE_ENV_1, &DSP_Voice::mso_1_freq_mod_env_level,
+			&DSP_Voice::set_mso_1_freq_env_modulation, &DSP_Voice::mso_1_freq_env_modulation, 0.0f },
+		{ &DSP_Voice::mso_1_pwm_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::mso_1_pwm_mod_lfo_level,
+			&DSP_Voice::set_mso_1_pwm_lfo_modulation, &DSP_Voice::mso_1_pwm_lfo_modulation, 0.0f },
+		{ &DSP_Voice::mso_1_pwm_mod_env, _VOICE_MOD_SOURCE_ENV_1, &DSP_Voice::mso_1_pwm_mod_env_level,
+			&DSP_Voice::set_mso_1_pwm_env_modulation, &DSP_Voice::mso_1_pwm_env_modulation, 0.0f },
+		{ &DSP_Voice::mso_1_amp_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::mso_1_amp_mod_lfo_level,
+			&DSP_Voice::set_mso_1_amp_lfo_modulation, &DSP_Voice::mso_1_amp_lfo_modulation, 1.0f },
+		{ &DSP_Voice::mso_1_amp_mod_env, _VOICE_MOD_SOURCE_ENV_1, &DSP_Voice::mso_1_amp_mod_env_level,
+			&DSP_Voice::set_mso_1_amp_env_modulation, &DSP_Voice::mso_1_amp_env_modulation, 0.0f },
+
+		{ &DSP_Voice::wavetable_1_freq_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::wavetable_1_freq_mod_lfo_level,
+			&DSP_Voice::set_pad_1_freq_lfo_modulation, &DSP_Voice::wavetable_1_freq_lfo_modulation, 0.0f },
+		{ &DSP_Voice::wavetable_1_freq_mod_env, _VOICE_MOD_SOURCE_ENV_1, &DSP_Voice::wavetable_1_freq_mod_env_level,
+			&DSP_Voice::set_pad_1_freq_env_modulation, &DSP_Voice::wavetable_1_freq_env_modulation, 0.0f },
+		{ &DSP_Voice::wavetable_1_amp_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::wavetable_1_amp_mod_lfo_level,
+			&DSP_Voice::set_pad_1_amp_lfo_modulation, &DSP_Voice::wavetable_1_amp_lfo_modulation, 1.0f },
+		{ &DSP_Voice::wavetable_1_amp_mod_env, _VOICE_MOD_SOURCE_ENV_1, &DSP_Voice::wavetable_1_amp_mod_env_level,
+			&DSP_Voice::set_pad_1_amp_env_modulation, &DSP_Voice::wavetable_1_amp_env_modulation, 0.0f },
+
+		{ &DSP_Voice::filter_1_freq_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::filter_1_freq_mod_lfo_level,
+			&DSP_Voice::set_filter_1_freq_lfo_modulation, &DSP_Voice::filter_1_freq_lfo_modulation, 0.0f },
+		{ &DSP_Voice::filter_1_freq_mod_env, _VOICE_MOD_SOURCE_ENV_1, &DSP_Voice::filter_1_freq_mod_env_level,
+			&DSP_Voice::set_filter_1_freq_env_modulation, &DSP_Voice::filter_1_freq_env_modulation, 0.0f },
+		{ &DSP_Voice::filter_2_freq_mod_lfo, _VOICE_MOD_SOURCE_LFO_1, &DSP_Voice::filter_2_freq_mod_lfo_level,
+			&DSP_Voice::set_filter_2_freq_lfo_modulation, &DSP_Voice::filter_2_freq_lfo_modulation, 0.0f },
+		{ &DSP_Voice::filter_2_freq_mod_env, _VOICE_MOD_SOURCE_ENV_1, &DSP_Voice::filter_2_freq_mod_env_level,
+			&DSP_Voice::set_filter_2_freq_env_modulation, &DSP_Voice::filter_2_freq_env_modulation, 0.0f }
+	};
+
+	int num_of_destinations = sizeof(destinations) / sizeof(destinations[0]);
+	const voice_modulation_destination_t *dest;
+	voice_modulation_route_t *route;
+	int modulator;
+
+	modulation_matrix_changed = false;
+	num_of_modulation_routes = 0;
+
+	for (int i = 0; (i < num_of_destinations) && (num_of_modulation_routes < _VOICE_MOD_MAX_ROUTES); i++)
+	{
+		dest = &destinations[i];
+		modulator = this->*dest->modulator;
+		route = &modulation_routes[num_of_modulation_routes];
+
+		// _LFO_NONE and _ENV_NONE are both 0
+		if (modulator > _LFO_NONE)
+		{
+			route->source = dest->first_source + modulator - 1;
+			route->depth = dest->depth;
+			route->apply = dest->apply;
+			num_of_modulation_routes++;
+		}
+		else if (dest->idle_modulation == NULL)
+		{
+			route->source = _VOICE_MOD_SOURCE_ZERO;
+			route->depth = &DSP_Voice::zero_modulation_level;
+			route->apply = dest->apply;
+			num_of_modulation_routes++;
+		}
+		else
+		{
+			this->*dest->idle_modulation = dest->idle_value;
+		}
+	}
+}
+
+/**
+*	@brief	Calculate and return a frequency detune factor including frequency modulation.
+*			The detune part is recalculated only when the detune settings are changed;
+*			the modulation part uses a fast 2^x approximation.
+*	@param	cache	a pointer to the detuned module detune cache
+*	@param	detune_oct	detune Octaves
+*	@param	detune_semitones detune semi-tones
+*	@param	detune_percents detune percents
+*	@param	modulation	modulation value
+*	@return frequency detune factor
+*/
+float DSP_Voice::cached_detune_frequency_factor(voice_detune_cache_t *cache,
+	int detune_oct, int detune_semitones, float detune_percents, float modulation)
+{
+	if (!cache->valid || (cache->octave != detune_oct) || (cache->semitones != detune_semitones) ||
+		(cache->cents != detune_percents))
+	{
+		cache->octave = detune_oct;
+		cache->semitones = detune_semitones;
+		cache->cents = detune_percents;
+		cache->factor = detune_frequency_factor(detune_oct, detune_semitones, detune_percents);
+		cache->valid = true;
+	}
+
+	if (modulation == 0.0f)
+	{
+		return cache->factor;
+	}
+
+	return cache->factor * dsp_fast_exp2f(modulation / 1.4f);
+}
@@ -1,11 +1,12 @@
 /**
 *	@file		dspVoiceMso.cpp
 *	@author		Nahum Budin
-*	@date		17-Oct-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion. 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Modulators changes rebuild the modulation matrix. 
 *					
 *	@History	
+*				version	1.2	17-Oct-2024	Code refactoring and notaion.
 *				version	1.1	25_Jan-2021	Code refactoring and notaion.
 *				version	1.0	9-Jun-2018 (modulators part of voice; no control blocks and connections.)
 *
@@ -94,6 +95,8 @@ void DSP_Voice::set_mso_1_freq_mod_lfo(int lfo)
 	{
 		mso_1_freq_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		mso_1_freq_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -120,6 +123,8 @@ void DSP_Voice::set_mso_1_freq_mod_env(int env)
 	if ((env >= _ENV_NONE) && (env <= _ENV_6))
 	{
 		mso_1_freq_mod_env = env;
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -147,6 +152,8 @@ void DSP_Voice::set_mso_1_pwm_mod_lfo(int lfo)
 	{
 		mso_1_pwm_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		mso_1_pwm_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -173,6 +180,8 @@ void DSP_Voice::set_mso_1_pwm_mod_env(int env)
 	if ((env >= _ENV_NONE) && (env <= _ENV_6))
 	{
 		mso_1_pwm_mod_env = env;
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -200,6 +209,8 @@ void DSP_Voice::set_mso_1_amp_mod_lfo(int lfo)
 	{
 		mso_1_amp_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		mso_1_amp_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -226,6 +237,8 @@ void DSP_Voice::set_mso_1_amp_mod_env(int env)
 	if ((env >= _ENV_NONE) && (env <= _ENV_6))
 	{
 		mso_1_amp_mod_env = env;
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -1,11 +1,12 @@
 /**
 *	@file		dspVoiceNoise.cpp
 *	@author		Nahum Budin
-*	@date		17-Oct-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion. 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Modulators changes rebuild the modulation matrix. 
 *					
 *	@History	
+*				version	1.2	17-Oct-2024	Code refactoring and notaion.
 *				version	1.1	25_Jan-2021	
 *				version	1.0	9-Jun-2018 (modulators part of voice; no control blocks and connections.)
 *					1. Code refactoring and notaion. 
@@ -98,6 +99,8 @@ void DSP_Voice::set_noise_1_amp_mod_lfo(int lfo)
 	{
 		noise_1_amp_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		noise_1_amp_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -124,6 +127,8 @@ void DSP_Voice::set_noise_1_amp_mod_env(int env)
 	if ((env >= _ENV_NONE) && (env <= _ENV_6))
 	{
 		noise_1_amp_mod_env = env;
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -1,11 +1,12 @@
 /**
 *	@file		dspVoiceOscilators.cpp
 *	@author		Nahum Budin
-*	@date		17-Oct-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion. 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Modulators changes rebuild the modulation matrix. 
 *					
 *	@History	
+*				version	1.2	17-Oct-2024	Code refactoring and notaion.
 *				version	1.1	25_Jan-2021
 *					1. Code refactoring and notaion. 
 *					2. Adding sample-rate and bloc-size settings
@@ -170,6 +171,8 @@ void DSP_Voice::set_osc_1_freq_mod_lfo(int lfo)
 	{
 		osc_1_freq_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		osc_1_freq_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -196,6 +199,8 @@ void DSP_Voice::set_osc_1_freq_mod_env(int env)
 	if ((env >= _ENV_NONE) && (env <= _ENV_6))
 	{
 		osc_1_freq_mod_env = env;
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -223,6 +228,8 @@ void DSP_Voice::set_osc_1_pwm_mod_lfo(int lfo)
 	{
 		osc_1_pwm_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		osc_1_pwm_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -249,6 +256,8 @@ void DSP_Voice::set_osc_1_pwm_mod_env(int env)
 	if ((env >= _ENV_NONE) && (env <= _ENV_6))
 	{
 		osc_1_pwm_mod_env = env;
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -276,6 +285,8 @@ void DSP_Voice::set_osc_1_amp_mod_lfo(int lfo)
 	{
 		osc_1_amp_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		osc_1_amp_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -302,6 +313,8 @@ void DSP_Voice::set_osc_1_amp_mod_env(int env)
 	if ((env >= _ENV_NONE) && (env <= _ENV_6))
 	{
 		osc_1_amp_mod_env = env;
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -656,6 +669,8 @@ void DSP_Voice::set_osc_2_freq_mod_lfo(int lfo)
 	{
 		osc_2_freq_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		osc_2_freq_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -682,6 +697,8 @@ void DSP_Voice::set_osc_2_freq_mod_env(int env)
 	if ((env >= _ENV_NONE) && (env <= _ENV_6))
 	{
 		osc_2_freq_mod_env = env;
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -709,6 +726,8 @@ void DSP_Voice::set_osc_2_pwm_mod_lfo(int lfo)
 	{
 		osc_2_pwm_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		osc_2_pwm_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -735,6 +754,8 @@ void DSP_Voice::set_osc_2_pwm_mod_env(int env)
 	if ((env >= _ENV_NONE) && (env <= _ENV_6))
 	{
 		osc_2_pwm_mod_env = env;
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -762,6 +783,8 @@ void DSP_Voice::set_osc_2_amp_mod_lfo(int lfo)
 	{
 		osc_2_amp_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		osc_2_amp_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -788,6 +811,8 @@ void DSP_Voice::set_osc_2_amp_mod_env(int env)
 	if ((env >= _ENV_NONE) && (env <= _ENV_6))
 	{
 		osc_2_amp_mod_env = env;
+		
+		modulation_matrix_changed = true;
 	}
 }
 
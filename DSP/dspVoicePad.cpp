@@ -1,11 +1,12 @@
 /**
 *	@file		dspVoicePad.cpp
 *	@author		Nahum Budin
-*	@date		17-Oct-2024
-*	@version	1.2
-*					1. Code refactoring and notaion. 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Modulators changes rebuild the modulation matrix. 
 *					
 *	@History	
+*				version	1.2	17-Oct-2024	Code refactoring and notaion.
 *				version	1.1	25_Jan-2021
 *					1. Code refactoring and notaion. 
 *					2. Adding sample-rate and bloc-size settings
@@ -98,6 +99,8 @@ void DSP_Voice::set_pad_1_freq_mod_lfo(int lfo)
 	{
 		wavetable_1_freq_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		wavetable_1_freq_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -124,6 +127,8 @@ void DSP_Voice::set_pad_1_freq_mod_env(int env)
 	if ((env >= _ENV_NONE) && (env <= _ENV_3))
 	{
 		wavetable_1_freq_mod_env = env;
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -151,6 +156,8 @@ void DSP_Voice::set_pad_1_amp_mod_lfo(int lfo)
 	{
 		wavetable_1_amp_mod_lfo = ((lfo - 1) % _NUM_OF_LFOS) + 1;
 		wavetable_1_amp_mod_lfo_delay = lfo_delays[lfo];
+		
+		modulation_matrix_changed = true;
 	}
 }
 
@@ -177,6 +184,8 @@ void DSP_Voice::set_pad_1_amp_mod_env(int env)
 	if ((env >= _ENV_NONE) && (env <= _ENV_3))
 	{
 		wavetable_1_amp_mod_env = env;
+		
+		modulation_matrix_changed = true;
 	}
 }
 
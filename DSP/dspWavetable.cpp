@@ -1,11 +1,13 @@
 /**
 *	@file		dspWavetable.h
 *	@author		Nahum Budin
-*	@date		21-Sep-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion. 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Fixed-point phase accumulator (power of 2 table masking).
+*					2. Wavetable setting (pooled voices binding).
 *					
-*	@History	23_Jan-2021 1.1 Code refactoring and notaion.
+*	@History	21-Sep-2024	1.2 Code refactoring and notaion.
+*				23_Jan-2021 1.1 Code refactoring and notaion.
 *				2-Nov-2019	1.0 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1)
 *
 *	@brief		Wavetable of float samples handling.
@@ -31,6 +33,10 @@ DSP_Wavetable::DSP_Wavetable(int i_d, Wavetable *table)
 	
 	wavetable = table;
 	wt_sample_freq = wavetable->base_freq;
+	gen_freq = 0.0f;
+	wt_step = 0.0f;
+	
+	phase_accumulator.set_interpolation(_PHASE_ACC_INTERPOLATION_LINEAR);
 		
 	init();
 }
@@ -47,9 +53,8 @@ DSP_Wavetable::~DSP_Wavetable()
 */
 void DSP_Wavetable::init()
 {
-	pos_h1 = 0;
-	pos_h2 = wavetable->size / 2;
-	pos_l = 0;
+	phase_accumulator.set_table_length(wavetable->size);
+	phase_accumulator.set_phase(0);
 }
 
 /**
@@ -60,9 +65,7 @@ void DSP_Wavetable::init()
 */
 void DSP_Wavetable::randomize_play()
 {
-	pos_h1 = (int)(RND * (wavetable->size - 1)); 
-	pos_h2 = (pos_h1 + wavetable->size / 2) % wavetable->size;
-	pos_l = 0;
+	phase_accumulator.set_phase_fraction(RND);
 }
 
 /**
@@ -72,15 +75,30 @@ void DSP_Wavetable::randomize_play()
 *	@return void
 */
 void DSP_Wavetable::set_output_frequency(float out_freq, bool init_pointers)
+{
+	set_table_output_frequency(wavetable, out_freq, init_pointers);
+}
+
+/**
+*	@brief	Set base frequency (Hz) relative to a given wavetable (the wavetable that is
+*			rendered, which may be swapped meanwhile by a non real-time thread)
+*	@param	table	a pointer to the rendered wavetable
+*	@param	out_freq base frequency
+*	@param	init_pointers if true pointers are initialized.
+*	@return void
+*/
+void DSP_Wavetable::set_table_output_frequency(Wavetable_t *table, float out_freq, bool init_pointers)
 {
 	gen_freq = out_freq;
-	wt_sample_freq = wavetable->base_freq;
+	wt_sample_freq = table->base_freq;
 	
 	// Actual output freq relative to the wavetable sampled freq.
 	wt_step = out_freq / wt_sample_freq;
 
-	wt_step_hi = (int)floor(wt_step);
-	wt_step_lo = wt_step - floor(wt_step);
+	// Fixed-point phase increment (wavetable length is a power of 2)
+	phase_accumulator.set_table_length(table->size);
+	phase_accumulator.set_increment(
+		DSP_PhaseAccumulator::calc_increment((double)wt_step / (double)table->size));
 
 	if (init_pointers)
 	{
@@ -96,43 +114,64 @@ void DSP_Wavetable::set_output_frequency(float out_freq, bool init_pointers)
 */
 void DSP_Wavetable::get_next_wavetable_value(float *out1, float *out2)
 {
-	int nexti;
-
-	pos_h1 += wt_step_hi;
-	pos_h2 += wt_step_hi;
-	pos_l += wt_step_lo;
-
-	if (pos_l >= 1.f)
-	{
-		pos_h1 += 1;
-		pos_h2 += 1;
-		pos_l -= 1.f;
-	}
-
-	if (pos_h1 >= wavetable->size)
+	// The wavetable may be swapped meanwhile - its samples and size are taken from one table
+	Wavetable_t *table = wavetable;
+	
+	if ((table->size != phase_accumulator.get_table_length()) || (table->base_freq != wt_sample_freq))
 	{
-		pos_h1 %= wavetable->size;
+		// Wavetable length (PAD quality) or base frequency was changed
+		set_table_output_frequency(table, gen_freq, false);
 	}
+	
+	phase_accumulator.advance();
+	
+	// Linear interpolation; pointer 2 is half a cycle away 
+	*out1 = phase_accumulator.read_linear(table->samples);
+	*out2 = phase_accumulator.read_linear(table->samples, 0x80000000);
+}
 
-	if (pos_h2 >= wavetable->size)
+/**
+*	@brief	Get a block of next wavetable output values
+*	@param	out_1	a pointer to a block of size samples output 1 buffer
+*	@param	out_2	a pointer to a block of size samples output 2 buffer
+*	@param	size	number of samples
+*	@return void
+*/
+void DSP_Wavetable::get_next_wavetable_block(float *out_1, float *out_2, int size)
+{
+	// The wavetable may be swapped meanwhile - its samples and size are taken from one table
+	Wavetable_t *table = wavetable;
+	const float *samples = table->samples;
+	
+	if ((table->size != phase_accumulator.get_table_length()) || (table->base_freq != wt_sample_freq))
 	{
-		pos_h2 %= wavetable->size;
+		// Wavetable length (PAD quality) or base frequency was changed
+		set_table_output_frequency(table, gen_freq, false);
 	}
-
-	// Linear interpolation
-	nexti = pos_h1 + 1;
-	if (nexti >= wavetable->size)
+	
+	for (int i = 0; i < size; i++)
 	{
-		nexti %= wavetable->size;
+		phase_accumulator.advance();
+		out_1[i] = phase_accumulator.read_linear(samples);
+		out_2[i] = phase_accumulator.read_linear(samples, 0x80000000);
 	}
-	*out1 = wavetable->samples[pos_h1] * (1.f - pos_l) + wavetable->samples[nexti] * pos_l;
+}
 
-	nexti = pos_h2 + 1;
-	if (nexti >= wavetable->size)
+/**
+*	@brief	Set the wavetable (e.g. a pooled voice is bound to a program PAD wavetable).
+*			May be called while the voice is rendered: the phase accumulator table length 
+*			and increment are updated by the rendering thread on its next output calculation.
+*	@param	table	a pointer to a Wavetable_t wavetable
+*	@return void
+*/
+void DSP_Wavetable::set_wavetable(Wavetable_t *table)
+{
+	if (table == NULL)
 	{
-		nexti %= wavetable->size;
+		return;
 	}
-	*out2 = wavetable->samples[pos_h2] * (1.f - pos_l) + wavetable->samples[nexti] * pos_l;
+	
+	wavetable = table;
 }
 
 /**
@@ -1,11 +1,13 @@
 /**
 *	@file		dspWavetable.h
 *	@author		Nahum Budin
-*	@date		21-Sep-2024
-*	@version	1.2 
-*					1. Code refactoring and notaion. 
+*	@date		17-Oct-2026
+*	@version	1.3 
+*					1. Fixed-point phase accumulator (power of 2 table masking).
+*					2. Wavetable setting (pooled voices binding).
 *					
-*	@History	23_Jan-2021 1.1 Code refactoring and notaion.
+*	@History	21-Sep-2024	1.2 Code refactoring and notaion.
+*				23_Jan-2021 1.1 Code refactoring and notaion.
 *				2-Nov-2019	1.0 (revised version from old libAdjHeartRaspiFlSynthMultiCore_3_1)
 *
 *	@brief		Wavetable of float samples handling.
@@ -18,6 +20,8 @@
 #include <math.h>
 #include <stdlib.h>
 
+#include "dspPhaseAccumulator.h"
+
 typedef struct Wavetable 
 {
 	int    size;
@@ -35,7 +39,9 @@ public:
 	void set_output_frequency(float out_freq = 440.f, bool init_pointers = true);
 
 	void get_next_wavetable_value(float *out_1, float *out_2);
+	void get_next_wavetable_block(float *out_1, float *out_2, int size);
 
+	void set_wavetable(Wavetable_t *table);
 	float *get_wavetable();
 	int get_wavetable_size();
 
@@ -68,22 +74,19 @@ public:
 private:
 
 	void init();
+	void set_table_output_frequency(Wavetable_t *table, float out_freq, bool init_pointers);
 	
 	int id;
 
 	Wavetable_t* wavetable;
-	// Table pointers
-	int pos_h1, pos_h2;
-	// Residual
-	float pos_l;
+	// Table pointer 1 phase; pointer 2 is half a cycle away
+	DSP_PhaseAccumulator phase_accumulator;
+	
 	// The wavetavle sampled frequency
 	float wt_sample_freq;
-	// Wavetable actual frequency step
+	// Wavetable actual frequency step (samples)
 	float wt_step;
-	// Integer part of step
-	int wt_step_hi;
-	// residual part step
-	float wt_step_lo;
+	
 	// Generated frequency
 	float gen_freq;
 
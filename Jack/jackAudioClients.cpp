@@ -1,13 +1,16 @@
 /**
 *	@ file		jackAudioClients.h
 *	@ author		Nahum Budin
-*	@ date		2-Oct-2024
-*	@ version	1.3 
-*						1. Code refactoring and notaion.
+*	@ date		17-Oct-2026
+*	@ version	1.4 
+*						1. Output handed through the direct output triple buffer.
+*						2. Optional render of the update cycle inside the process callback.
 *
 *	@ brief		Handle JACK input and output audio streaming
 *	
 *	History:\n
+*		2-Oct-2024 1.3 
+*						1. Code refactoring and notaion.
 *		18-Jan-2021 1.2 
 *						1. Code refactoring and notaion.
 *						2. Adding jack setting mode manual: app sets JACK params; Auto: apps get params from JACK
@@ -31,9 +34,6 @@
 #include "../Audio/audioCommons.h"
 #include "../LibAPI/audio.h"
 
-extern pthread_cond_t update_thread_cv;
-extern pthread_mutex_t update_thread_mutex;
-
 AudioManager *audio_manager = NULL;
 
 jack_client_t *client_out = NULL, *client_in = NULL;
@@ -298,17 +298,21 @@ int jack_callback_process_out(jack_nframes_t nun_of_frames, void *arg)
 	{
 		fprintf(stderr, "jack callback small buffer\n");
 	}
+	
+	if ((audio_manager != NULL) && audio_manager->jack_render_in_callback_is_active())
+	{
+		// Render this period block now and output it in this period (no added block latency)
+		audio_manager->run_audio_update_cycle_in_callback();
+		process_out(nun_of_frames);
+		
+		return 0;
+	}
 
 	process_out(nun_of_frames);
 	
 
-	// Triger update process	
-	if (pthread_mutex_trylock(&update_thread_mutex) == 0)
-	{
-		// Signal update thread
-		pthread_cond_signal(&update_thread_cv);
-		pthread_mutex_unlock(&update_thread_mutex);
-	}
+	// Triger update process (skipped if the update thread mutex is busy)
+	AUDMNG_request_update_cycles(1, 1, false);
 	
 	return 0;
 }
@@ -334,7 +338,7 @@ void process_silence_out(jack_nframes_t nun_of_frames)
 */
 void process_out(jack_nframes_t nun_of_frames) 
 {
-	volatile int i, voice;
+	audio_output_triple_buffer_t *direct_buffer;
 
 	//	static sample_t *prevBufferL = NULL, *prevBufferR = NULL;
 
@@ -356,11 +360,39 @@ void process_out(jack_nframes_t nun_of_frames)
 
 	if (audio_manager != NULL)
 	{
-		for (i = 0; i < nun_of_frames /*_PERIOD_SIZE*/; i++) 
+		if (nun_of_frames > _AUDIO_MAX_BUF_SIZE)
+		{
+			nun_of_frames = _AUDIO_MAX_BUF_SIZE;
+		}
+		
+		direct_buffer = audio_manager->audio_output_direct_buffer;
+		if (direct_buffer && audio_manager->jack_direct_output_is_active())
 		{
-			*(buffer_L + i) = (sample_t)audio_manager->audio_block_stereo_float_shared_memory_outputs->data[_LEFT][i]; // / 32767.0;
-			*(buffer_R + i) = (sample_t)audio_manager->audio_block_stereo_float_shared_memory_outputs->data[_RIGHT][i]; // / 32767.0;
+			if (direct_buffer->published.load(std::memory_order_relaxed) & _AUDIO_OUTPUT_BUFFER_NEW)
+			{
+				// Claim the last completed output buffer; the writer gets the previously read one
+				direct_buffer->read_index = direct_buffer->published.exchange(
+					direct_buffer->read_index, std::memory_order_acq_rel) & _AUDIO_OUTPUT_BUFFER_INDEX_MASK;
+				direct_buffer->read_valid = true;
+			}
+			
+			if (direct_buffer->read_valid)
+			{
+				// No new block - the claimed one is repeated
+				memcpy(buffer_L, direct_buffer->data[direct_buffer->read_index][_LEFT], sizeof(sample_t) * nun_of_frames);
+				memcpy(buffer_R, direct_buffer->data[direct_buffer->read_index][_RIGHT], sizeof(sample_t) * nun_of_frames);
+				return;
+			}
+		}
+		else if (direct_buffer)
+		{
+			direct_buffer->read_valid = false;
 		}
+		
+		memcpy(buffer_L, audio_manager->audio_block_stereo_float_shared_memory_outputs->data[_LEFT], 
+			sizeof(sample_t) * nun_of_frames);
+		memcpy(buffer_R, audio_manager->audio_block_stereo_float_shared_memory_outputs->data[_RIGHT], 
+			sizeof(sample_t) * nun_of_frames);
 	}
 }
 
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include "synthesizer.h"
+
 #define _LEFT								0
 #define _RIGHT								1		
 #define _SEND_LEFT							2
@@ -18,6 +20,7 @@
 
 #define _AUDIO_JACK							0
 #define _AUDIO_ALSA							1
+#define _AUDIO_NULL							2	// no audio device; update cycles are run by the caller (offline)
 #define _DEFAULT_AUDIO_DRIVER				_AUDIO_JACK
 
 #define _SAMPLE_RATE_44						44100
@@ -62,6 +65,143 @@
 #define _JACK_AUTO_CONNECT_MIDI_EN			true
 #define _DEFAULT_JACK_AUTO_CONNECT_MIDI		_JACK_AUTO_CONNECT_MIDI_DIS
 
+#define _MULTI_CORE_VOICES_RENDERING_DIS	false	// all voices are rendered by the update thread
+#define _MULTI_CORE_VOICES_RENDERING_EN		true	// voices are rendered by a worker per core
+#define _DEFAULT_MULTI_CORE_VOICES_RENDERING	_MULTI_CORE_VOICES_RENDERING_EN
+
+#define _AUDIO_BLOCKS_ARENA_DIS				false	// audio blocks are allocated from the blocks pool
+#define _AUDIO_BLOCKS_ARENA_EN				true	// audio blocks are allocated from a per update cycle arena
+#define _DEFAULT_AUDIO_BLOCKS_ARENA			_AUDIO_BLOCKS_ARENA_EN
+
+#define _JACK_DIRECT_OUTPUT_DIS				false	// output is transfered to JACK through the output shared memory
+#define _JACK_DIRECT_OUTPUT_EN				true	// output is rendered into a triple buffer copied by the JACK callback
+#define _DEFAULT_JACK_DIRECT_OUTPUT			_JACK_DIRECT_OUTPUT_EN
+
+#define _JACK_RENDER_IN_CALLBACK_DIS		false	// update cycle is run by the update thread (1 period latency)
+#define _JACK_RENDER_IN_CALLBACK_EN			true	// update cycle is run inside the JACK process callback
+#define _DEFAULT_JACK_RENDER_IN_CALLBACK	_JACK_RENDER_IN_CALLBACK_DIS
+
+#define _UPDATE_TIMER_CATCH_UP_DIS			false	// missed update timer deadlines are skipped
+#define _UPDATE_TIMER_CATCH_UP_EN			true	// missed update timer deadlines cycles are run back to back
+#define _DEFAULT_UPDATE_TIMER_CATCH_UP		_UPDATE_TIMER_CATCH_UP_EN
+// Maximum number of missed cycles that are caught up; when later, the timer is resynchronized
+#define _UPDATE_TIMER_MAX_CATCH_UP_CYCLES	4
+
+// Voices silence detector: a voice whose output peak stays below the threshold for the hold time is freed
+#define _VOICE_SILENCE_THRESHOLD_DB_MIN		-160
+#define _VOICE_SILENCE_THRESHOLD_DB_MAX		-60
+#define _DEFAULT_VOICE_SILENCE_THRESHOLD_DB	-120
+#define _VOICE_SILENCE_HOLD_MS_MIN			0	// 0: silence detector is disabled
+#define _VOICE_SILENCE_HOLD_MS_MAX			2000
+#define _DEFAULT_VOICE_SILENCE_HOLD_MS		50
+
+// Max number of band equalizer bands (default bands: 31Hz to 16KHz)
+#define _EQUALIZER_MAX_NUM_OF_BANDS			10
+
+// DSP load meter update cycle stages
+#define _DSP_LOAD_STAGE_VOICES				0
+#define _DSP_LOAD_STAGE_POLY_MIXER			1
+#define _DSP_LOAD_STAGE_EQUALIZER			2
+#define _DSP_LOAD_STAGE_REVERB				3
+#define _DSP_LOAD_STAGE_OUTPUT				4
+#define _DSP_LOAD_STAGE_OTHER				5	// cycle start tasks and cycle time not measured by any stage
+
+#define _DSP_LOAD_NUM_OF_STAGES				6
+
+/* DSP load of a measured item over the meter sliding window, in percentages of the audio period */
+typedef struct _dsp_load_measure
+{
+	float min;
+	float avg;
+	float max;
+	float p99;
+} _dsp_load_measure_t;
+
+/* DSP load statistics */
+typedef struct _dsp_load_stats
+{
+	/* Whole update cycle */
+	_dsp_load_measure_t cycle;
+	/* Each update cycle stage */
+	_dsp_load_measure_t stage[_DSP_LOAD_NUM_OF_STAGES];
+	/* Number of measured cycles since last reset */
+	unsigned long num_of_cycles;
+	/* Number of cycles longer than the audio period */
+	unsigned long overruns;
+	/* Overruns attributed to each stage (the stage with the largest share of the overrun cycle) */
+	unsigned long stage_overruns[_DSP_LOAD_NUM_OF_STAGES];
+	/* Periodic update timer (ALSA) missed deadlines */
+	unsigned long timer_missed_deadlines;
+	/* Voices freed early by the voices silence detector */
+	unsigned long silent_voices_freed;
+	/* Voices audio blocks rendered below the silence threshold (before the voice was freed) */
+	unsigned long silent_voice_blocks;
+	/* Estimated voices audio blocks not rendered due to the voices freed early (remaining release time) */
+	unsigned long saved_voice_blocks;
+	/* Estimated processing time saved by the voices freed early [uSec] */
+	unsigned long long saved_voice_time_us;
+	/* Polyphony governor current voices cap */
+	int voices_cap;
+	/* Voices stolen by new notes */
+	unsigned long stolen_voices;
+	/* Voices faded out by the polyphony governor to reduce the DSP load */
+	unsigned long shed_voices;
+} _dsp_load_stats_t;
+
+// Voices profiler DSP_Voice sub-modules
+#define _VOICE_PROFILE_MODULE_OSC_1			0
+#define _VOICE_PROFILE_MODULE_OSC_2			1
+#define _VOICE_PROFILE_MODULE_NOISE_1		2
+#define _VOICE_PROFILE_MODULE_KARPLUS_1		3
+#define _VOICE_PROFILE_MODULE_MSO_1			4
+#define _VOICE_PROFILE_MODULE_WAVETABLE_1	5
+#define _VOICE_PROFILE_MODULE_FILTERS		6	// filter 1 and filter 2
+#define _VOICE_PROFILE_MODULE_DISTORTION	7	// distortion 1 and distortion 2
+#define _VOICE_PROFILE_MODULE_MODULATION	8	// LFOs, envelopes and modulation updates
+
+#define _VOICE_PROFILE_NUM_OF_MODULES		9
+// Number of a voice audio blocks update stages (must be equal to _MAX_STAGE_NUM)
+#define _VOICE_PROFILE_NUM_OF_STAGES		8
+
+/* Voices profiling statistics, accumulated since the last reset over all the rendering threads */
+typedef struct _voice_profile_stats
+{
+	/* Each voice stages chains audio blocks update() time [nSec] */
+	unsigned long long stage_ns[_SYNTH_MAX_NUM_OF_VOICES][_VOICE_PROFILE_NUM_OF_STAGES];
+	/* Each voice DSP_Voice sub-modules time [nSec] (part of the voice audio block stage time) */
+	unsigned long long module_ns[_SYNTH_MAX_NUM_OF_VOICES][_VOICE_PROFILE_NUM_OF_MODULES];
+	/* Number of profiled update cycles of each voice */
+	unsigned long long num_of_updates[_SYNTH_MAX_NUM_OF_VOICES];
+	/* Profiler clock ticks frequency [Hz] */
+	unsigned long long ticks_frequency;
+} _voice_profile_stats_t;
+
+// Offline benchmark patch presets (the default patch with only the module generators enabled)
+#define _OFFLINE_BENCHMARK_PRESET_VCO		0	// osc 1 and osc 2
+#define _OFFLINE_BENCHMARK_PRESET_NOISE		1
+#define _OFFLINE_BENCHMARK_PRESET_KPS		2	// Karplus-Strong
+#define _OFFLINE_BENCHMARK_PRESET_MSO		3
+#define _OFFLINE_BENCHMARK_PRESET_PAD		4
+#define _OFFLINE_BENCHMARK_PRESET_ALL		5	// all generators
+
+#define _OFFLINE_BENCHMARK_NUM_OF_PRESETS	6
+
+#define _OFFLINE_BENCHMARK_DEFAULT_CYCLES	200
+
+/* Offline benchmark results of a patch preset */
+typedef struct _offline_benchmark_result
+{
+	int preset;
+	/* Max number of voices played */
+	int num_of_voices;
+	/* Rendered audio time / processing time, at max number of voices */
+	float realtime_factor;
+	/* Processing time per sample per voice [nSec], at max number of voices */
+	float ns_per_sample_per_voice;
+	/* Max number of voices all update cycles were completed within the audio period with */
+	int max_polyphony_at_deadline;
+} _offline_benchmark_result_t;
+
 #define _MESSAGE_JACK_SERV_OUTPUT_NOT_RUNNING		1800
 #define _MESSAGE_JACK_SERV_OUTPUT_RUNNING			1801
 #define _MESSAGE_JACK_SERV_INPUT_NOT_RUNNING		1802
@@ -83,4 +223,80 @@ int mod_synth_start_audio();
 */
 int mod_synth_stop_audio();
 
+/**
+*   @brief  Returns the audio DSP load statistics: update cycles and stages
+*			min/avg/max/p99 loads over the last cycles, and the overruns counters.
+*   @param  stats	a pointer to a _dsp_load_stats_t struct to be filled
+*   @return 0 if done
+*/
+int mod_synth_get_dsp_load_stats(_dsp_load_stats_t *stats);
+
+/**
+*   @brief  Resets the audio DSP load statistics.
+*   @param  none
+*   @return 0 if done
+*/
+int mod_synth_reset_dsp_load_stats();
+
+/**
+*   @brief  Enables or disables the voices profiling counters.
+*			When disabled (default) the voices rendering is not instrumented.
+*   @param  state	true - enabled; false - disabled
+*   @return 0 if done
+*/
+int mod_synth_set_voices_profiling_state(bool state);
+
+/**
+*   @brief  Returns the voices profiling counters enable state.
+*   @param  none
+*   @return true - enabled; false - disabled
+*/
+bool mod_synth_get_voices_profiling_state();
+
+/**
+*   @brief  Returns a snapshot of the voices profiling counters: each voice stages
+*			audio blocks and DSP sub-modules processing time.
+*   @param  stats	a pointer to a _voice_profile_stats_t struct to be filled
+*   @return 0 if done
+*/
+int mod_synth_get_voices_profile_stats(_voice_profile_stats_t *stats);
+
+/**
+*   @brief  Resets the voices profiling counters.
+*   @param  none
+*   @return 0 if done
+*/
+int mod_synth_reset_voices_profile_stats();
+
+/**
+*   @brief  Sets the band equalizer bands. The bands filters coefficients are calculated for
+*			the set sample rate. Fewer bands use less CPU.
+*   @param  num_of_bands		number of bands (1 to _EQUALIZER_MAX_NUM_OF_BANDS)
+*   @param  center_frequencies	an array of num_of_bands bands center frequencies [Hz];
+*								NULL for the default bands frequencies
+*   @return 0 if done; -1 if parameters are out of range
+*/
+int mod_synth_set_equalizer_bands(int num_of_bands, float *center_frequencies);
+
+/**
+*   @brief  Returns the band equalizer number of bands.
+*   @param  none
+*   @return number of bands
+*/
+int mod_synth_get_equalizer_num_of_bands();
+
+/**
+*   @brief  Runs the offline benchmark: the audio service is restarted with the null audio 
+*			driver, and for each patch preset an increasing number of notes is played while
+*			the update cycles are run back to back. The audio service is then restarted with 
+*			the previous driver.
+*			The active sketch generators enable state is restored when done.
+*   @param  results			a pointer to an array of _OFFLINE_BENCHMARK_NUM_OF_PRESETS
+*							_offline_benchmark_result_t structs to be filled
+*   @param  num_of_cycles	number of measured update cycles for each number of voices
+*   @return 0 if done
+*/
+int mod_synth_run_offline_benchmark(_offline_benchmark_result_t *results, 
+	int num_of_cycles = _OFFLINE_BENCHMARK_DEFAULT_CYCLES);
+
 
@@ -80,12 +80,21 @@ int mod_synth_deinit_midi_services();
 */
 void mod_synth_on_exit();	
 
+/**
+*   @brief  Returns the audio DSP load: the average update cycle processing time in precetages
+*			of the audio period (see mod_synth_get_dsp_load_stats()).
+*			Returns the total (all cores) CPU utilization when no audio cycle was measured yet.
+*   @param  none
+*   @return int	the DSP load in precetages (0 to 100, may exceed 100 on overruns).
+*/
+int mod_synth_get_cpu_utilization();
+
 /**
 *   @brief  Returns the total (all cores) CPU utilization.
 *   @param  none
 *   @return int	the total (all cores) CPU utilization in precetages (0 to 100).
 */
-int mod_synth_get_cpu_utilization();
+int mod_synth_get_system_cpu_utilization();
 
 /**
 *   @brief  Adds an instrument.
@@ -263,7 +272,7 @@ int mod_synth_band_equilizer_event(int beqid, int eventid, int val);
 *   @param  int filtid	target filter: _FILTER_1_EVENT, _FILTER_2_EVENT
 *	@param	int eventid	specific event code:\n
 *				_FILTER_FREQ, _FILTER_OCT, _FILTER_Q\n
-*				_FILTER_KBD_TRACK, _FILTER_BAND\n
+*				_FILTER_KBD_TRACK, _FILTER_BAND, _FILTER_MODEL\n
 *				_FILTER_FREQ_MOD_LFO, _FILTER_FREQ_MOD_LFO_LEVEL\n
 *				_FILTER_FREQ_MOD_ENV, _FILTER_FREQ_MOD_ENV_LEVEL\n
 *	@param	int val event parameter value (must be used with the relevant event id):\n
@@ -275,6 +284,10 @@ int mod_synth_band_equilizer_event(int beqid, int eventid, int val);
 \verbatim
 _FILTER_BAND_LPF, _FILTER_BAND_HPF, _FILTER_BAND_BPF, _FILTER_BAND_PASS_ALL\n
 \endverbatim
+*				_FILTER_MODEL:\n
+\verbatim
+_FILTER_MODEL_SVF, _FILTER_MODEL_ZDF_SVF, _FILTER_MODEL_LADDER\n
+\endverbatim
 *				FILTER_FREQ_MOD_LFO:\n
 \verbatim
 	_LFO_NONE, _LFO_1, _LFO_2, _LFO_3, _LFO_4, _LFO_5,
@@ -632,7 +645,7 @@ int mod_synth_reverb_event_bool(int revid, int eventid, bool val);
 *				_OSC_PARAM_WAVEFORM:\n
 \verbatim
 				_OSC_WAVEFORM_SINE, _OSC_WAVEFORM_SQUARE, _OSC_WAVEFORM_PULSE
-				_OSC_WAVEFORM_TRIANGLE, _OSC_WAVEFORM_SAMPHOLD
+				_OSC_WAVEFORM_TRIANGLE, _OSC_WAVEFORM_SAMPHOLD, _OSC_WAVEFORM_SAW
 \endverbatim
 *				_OSC_PWM_SYMMETRY: 5-95\n
 *				_OSC_DETUNE_OCTAVE: 0 to (getOscDetuneMaxOctave() - getOscDetuneMinOctave() + 1); 0->min octave-detune\n
@@ -1011,6 +1024,12 @@ int mod_synth_get_active_filter_1_kbd_track();
 *   @return int	 the value of the active patch filter 1 band (see defs.h).
 */
 int mod_synth_get_active_filter_1_band();
+/**
+*   @brief  Returns the value of the active patch filter 1 model.
+*   @param  none
+*   @return int	 the value of the active patch filter 1 model (see synthesizer.h).
+*/
+int mod_synth_get_active_filter_1_model();
 
 /**
 *   @brief  Returns the value of the active patch filter 1 frequency modulation LFO number.
@@ -1071,6 +1090,12 @@ int mod_synth_get_active_filter_2_kbd_track();
 */
 int mod_synth_get_active_filter_2_band();
 /**
+*   @brief  Returns the value of the active patch filter 2 model.
+*   @param  none
+*   @return int	 the value of the active patch filter 2 model (see synthesizer.h).
+*/
+int mod_synth_get_active_filter_2_model();
+/**
 *   @brief  Returns the state of the active patch filter 2  tracking filter 1.
 *   @param  none
 *   @return int	 the state of the active patch filter 2  tracking filter 1.
@@ -42,6 +42,7 @@ Error - must be no more than 64
 #define _OSC_WAVEFORM_PULSE							2
 #define _OSC_WAVEFORM_TRIANGLE						3
 #define _OSC_WAVEFORM_SAMPHOLD						4
+#define _OSC_WAVEFORM_SAW							5
 
 #define _OSC_DETUNE_MAX_OCTAVE						6
 #define _OSC_DETUNE_MIN_OCTAVE						-6
@@ -112,6 +113,10 @@ Error - must be no more than 64
 #define _FILTER_BAND_BPF			2
 #define _FILTER_BAND_PASS_ALL		3
 
+#define _FILTER_MODEL_SVF			0	// Chamberlin state variable filter (2x oversampled)
+#define _FILTER_MODEL_ZDF_SVF		1	// Zero-delay-feedback state variable filter
+#define _FILTER_MODEL_LADDER		2	// 4-pole zero-delay-feedback ladder filter
+
 #define _CONTROL_SUB_SAMPLING		16
 	
 
@@ -302,6 +307,7 @@ Error - must be no more than 64
 #define _OSC_WAVEFORM_PULSE							2
 #define _OSC_WAVEFORM_TRIANGLE						3
 #define _OSC_WAVEFORM_SAMPHOLD						4
+#define _OSC_WAVEFORM_SAW							5
 		
 #define _OSC_PWM_SYMMETRY							120
 #define _OSC_DETUNE_OCTAVE							130
@@ -378,6 +384,7 @@ Error - must be no more than 64
 #define _FILTER_FREQ_MOD_LFO_LEVEL					408
 #define _FILTER_FREQ_MOD_ENV						409
 #define _FILTER_FREQ_MOD_ENV_LEVEL					410
+#define _FILTER_MODEL								411
 	
 #define _FILTER_BAND_LPF							0
 #define _FILTER_BAND_HPF							1
@@ -466,6 +473,29 @@ Error - must be no more than 64
 #define _KBD_SPLIT_POINT_C3							2
 #define _KBD_SPLIT_POINT_C4							3
 #define _KBD_SPLIT_POINT_C5							4
+
+// Polyphony governor: lowers the voices cap when the DSP load (update cycle time in percentages of the
+// audio period) is above the high threshold, and raises it back when the load is below the low threshold
+#define _POLY_GOVERNOR_DIS							false
+#define _POLY_GOVERNOR_EN							true
+#define _DEFAULT_POLY_GOVERNOR						_POLY_GOVERNOR_EN
+#define _POLY_GOVERNOR_LOAD_MIN						10
+#define _POLY_GOVERNOR_LOAD_MAX						100
+#define _DEFAULT_POLY_GOVERNOR_HIGH_LOAD			85
+#define _DEFAULT_POLY_GOVERNOR_LOW_LOAD				60
+#define _POLY_GOVERNOR_MIN_VOICES_MIN				1
+#define _DEFAULT_POLY_GOVERNOR_MIN_VOICES			8
+
+// MIDI-mapping programs voices and wavetables are created when a patch is loaded into the program's
+// channel or when a note is played on it, and are released after being idle for this time (0: never)
+#define _PROGRAM_IDLE_RELEASE_TIME_SEC_MIN			0
+#define _PROGRAM_IDLE_RELEASE_TIME_SEC_MAX			3600
+#define _DEFAULT_PROGRAM_IDLE_RELEASE_TIME_SEC		300
+
+// All programs voices are rendered by a shared pool of DSP voices, bound to a program at note-on.
+// The spare DSP voices keep stolen voices rendering while they are faded out.
+#define _SYNTH_VOICE_POOL_SPARE_VOICES				4
+#define _SYNTH_VOICE_POOL_MAX_NUM_OF_VOICES			(_SYNTH_MAX_NUM_OF_VOICES + _SYNTH_VOICE_POOL_SPARE_VOICES)
 	
 	
 #define _NOISE_COLOR								700		
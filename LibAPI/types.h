@@ -116,6 +116,8 @@ typedef void (*func_ptr_void_int_uint16_t)(int, uint16_t);
 typedef void (*func_ptr_void_uint8_t_uint8_t)(uint8_t, uint8_t);
 /* void foo(int, int) function pointer */
 typedef void (*func_ptr_void_int_int_t)(int, int);
+/* int foo(int) function pointer */
+typedef int (*func_ptr_int_int_t)(int);
 
 /* void foo(int, bool) function pointer */
 typedef void (*func_ptr_void_int_bool_t)(int, bool);
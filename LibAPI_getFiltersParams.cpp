@@ -1,13 +1,14 @@
 /**
 *	@file		LibAPI_getFiltersParams.cpp
 *	@author		Nahum Budin
-*	@date		9-Feb-2021
-*	@version	1.1
-*					1. Code refactoring and notaion.
+*	@date		17-Oct-2026
+*	@version	1.2
+*					1. Filters model.
 *
 *	@brief		Get active Filters settings parameters
 *
 *	History: 
+*				version 1.1		9-Feb-2021	Code refactoring and notaion
 *				version 1.0		5-Oct-2019	1st version
 *
 */
@@ -94,6 +95,21 @@ int mod_synth_get_active_filter_1_band()
 	}
 }
 
+int mod_synth_get_active_filter_1_model()
+{
+	res_filter = settings_manager->get_int_param(AdjSynth::get_instance()->get_active_patch_params(),
+		"adjsynth.filter1.model",
+		&int_param_filter);
+	if (res_filter == _SETTINGS_KEY_FOUND)
+	{
+		return int_param_filter.value;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
 int mod_synth_get_active_filter_1_Freq_mod_lfo() 
 {
 	res_filter = settings_manager->get_int_param(AdjSynth::get_instance()->get_active_patch_params(),
@@ -230,6 +246,21 @@ int mod_synth_get_active_filter_2_band()
 	}
 }
 
+int mod_synth_get_active_filter_2_model()
+{
+	res_filter = settings_manager->get_int_param(AdjSynth::get_instance()->get_active_patch_params(),
+		"adjsynth.filter2.model",
+		&int_param_filter);
+	if (res_filter == _SETTINGS_KEY_FOUND)
+	{
+		return int_param_filter.value;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
 int mod_synth_get_active_filter_2_Freq_mod_lfo()
 {
 	res_filter = settings_manager->get_int_param(AdjSynth::get_instance()->get_active_patch_params(),
@@ -20,6 +20,7 @@
 #define _THREAD_PRIORITY_CHANGE_CONTROL	12 
 #define _THREAD_PRIORITY_UPDATE_TIMER	13		  
 #define _THREAD_PRIORITY_UPDATE			14
+#define _THREAD_PRIORITY_VOICE_RENDER	14
 #define _THREAD_PRIORITY_JACK			15
 #define _THREAD_PRIORITY_ALSA			16
 
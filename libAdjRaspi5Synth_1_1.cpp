@@ -31,6 +31,8 @@
 #include <string>
 
 #include "modSynth.h"
+#include "./Audio/audioDspLoadMeter.h"
+#include "./Audio/audioVoiceProfiler.h"
 #include "./Settings/settings.h"
 
 #include "Bluetooth\rspiBluetoothServicesQueuesVer.h"
@@ -89,6 +91,76 @@ int mod_synth_stop_audio()
 	return mod_synthesizer->stop_audio();
 }
 
+int mod_synth_get_dsp_load_stats(_dsp_load_stats_t *stats)
+{
+	int res = AudioDspLoadMeter::get_instance()->get_stats(stats);
+	
+	if (res == 0)
+	{
+		stats->timer_missed_deadlines = 
+			mod_synthesizer->adj_synth->audio_manager->get_update_timer_missed_deadlines();
+		stats->voices_cap = mod_synthesizer->adj_synth->synth_polyphony_manager->get_voices_cap();
+		stats->stolen_voices = mod_synthesizer->adj_synth->synth_polyphony_manager->get_stolen_voices();
+		stats->shed_voices = mod_synthesizer->adj_synth->synth_polyphony_manager->get_shed_voices();
+	}
+	
+	return res;
+}
+
+int mod_synth_reset_dsp_load_stats()
+{
+	AudioDspLoadMeter::get_instance()->reset_stats();
+	mod_synthesizer->adj_synth->audio_manager->reset_update_timer_missed_deadlines();
+	mod_synthesizer->adj_synth->synth_polyphony_manager->reset_governor_stats();
+	
+	return 0;
+}
+
+int mod_synth_set_voices_profiling_state(bool state)
+{
+	AudioVoiceProfiler::get_instance()->set_profiling_state(state);
+	
+	return 0;
+}
+
+bool mod_synth_get_voices_profiling_state()
+{
+	return AudioVoiceProfiler::get_instance()->get_profiling_state();
+}
+
+int mod_synth_get_voices_profile_stats(_voice_profile_stats_t *stats)
+{
+	return AudioVoiceProfiler::get_instance()->get_stats(stats);
+}
+
+int mod_synth_reset_voices_profile_stats()
+{
+	AudioVoiceProfiler::get_instance()->reset_stats();
+	
+	return 0;
+}
+
+int mod_synth_set_equalizer_bands(int num_of_bands, float *center_frequencies)
+{
+	return mod_synthesizer->adj_synth->set_equalizer_bands(num_of_bands, center_frequencies);
+}
+
+int mod_synth_get_equalizer_num_of_bands()
+{
+	return mod_synthesizer->adj_synth->get_equalizer_num_of_bands();
+}
+
+int mod_synth_run_offline_benchmark(_offline_benchmark_result_t *results, int num_of_cycles)
+{
+	int res, prev_driver = mod_synthesizer->get_audio_driver_type();
+	
+	mod_synthesizer->set_audio_driver_type(_AUDIO_NULL, true);
+	res = mod_synthesizer->adj_synth->run_offline_benchmark(results, num_of_cycles);
+	mod_synthesizer->set_audio_driver_type(prev_driver, true);
+	
+	return res;
+}
+
 int mod_synth_init_bt_services()
 {
 	/* Inilize */
@@ -164,6 +236,16 @@ int mod_synth_deinit_midi_services()
 }
 
 int mod_synth_get_cpu_utilization() 
+{ 
+	if (mod_synthesizer == NULL)
+	{
+		return ModSynth::cpu_utilization;
+	}
+	
+	return mod_synthesizer->mod_synth_get_cpu_utilization(); 
+}
+
+int mod_synth_get_system_cpu_utilization() 
 { 
 	return ModSynth::cpu_utilization; 
 }
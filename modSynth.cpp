@@ -17,6 +17,7 @@
 #include "modSynthPreset.h"
 
 #include "./CPU/CPUSnapshot.h"
+#include "./Audio/audioDspLoadMeter.h"
 
 #include "./MIDI/midiAlsaQclient.h"
 
@@ -364,6 +365,9 @@ void ModSynth::synth_panic_action()
 */
 void ModSynth::update_tasks(int voc)
 {
+	// Adapt the voices cap to the DSP load
+	adj_synth->synth_polyphony_manager->update_polyphony_governor();
+	
 	if (adj_synth->kbd1->portamento_is_enabled())
 	{
 		adj_synth->kbd1->update_actual_frequency();
@@ -386,6 +390,24 @@ void ModSynth::stop_cheack_cpu_utilization_thread()
 	//	pthread_setname_np(cheack_cpu_utilization_thread_id, "cpuutilthread");
 }
 
+/**
+*   @brief  Returns the audio DSP load (average update cycle time in percentages of the period),
+*			or the total CPU utilization if no audio cycle was measured yet.
+*   @param  none
+*   @return utilization in percentages
+*/
+int ModSynth::mod_synth_get_cpu_utilization()
+{
+	int load = AudioDspLoadMeter::get_instance()->get_load();
+	
+	if (load < 0)
+	{
+		return cpu_utilization;
+	}
+	
+	return load;
+}
+
 
 int ModSynth::init_midi_ext_interface(int ser_port_num)
 {
@@ -683,7 +705,7 @@ int ModSynth::set_audio_block_size(int size)
 
 /**
 *	@brief	Sets the audio driver type
-*	@param	driver  _AUDIO_JACK, _AUDIO_ALSA (default: _DEFAULT_AUDIO)
+*	@param	driver  _AUDIO_JACK, _AUDIO_ALSA, _AUDIO_NULL (default: _DEFAULT_AUDIO)
 *	@param	restart_audio if true set value and restart audio
 *	@return set audio-driver
 */
@@ -711,7 +733,7 @@ int ModSynth::set_audio_driver_type(int driver, bool restart_audio)
 /**
 *	@brief	Sets the audio driver type  value only (without restarting audio)
 *			Settings will be effective only after the next call to start_audio().
-*	@param	driver  _AUDIO_JACK, _AUDIO_ALSA (default: _DEFAULT_AUDIO)
+*	@param	driver  _AUDIO_JACK, _AUDIO_ALSA, _AUDIO_NULL (default: _DEFAULT_AUDIO)
 *	@param	set_only if true only set value, false - set value and restart audio
 *	@return set audio-driver
 */
@@ -776,23 +798,18 @@ int ModSynth::open_adj_synth_patch_file(string path, Settings *settings, _settin
 	
 	return_val_if_true(params == NULL || settings == NULL, _SETTINGS_BAD_PARAMETERS);
 	
+	// Loading a patch maps the program - create its voices and wavetables before setting the patch
+	adj_synth->materialize_program(channel);
+	
 	res = settings->read_settings_file(params, path, _ADJ_SYNTH_PATCH_PARAMS, channel);
 
 	if (res == _SETTINGS_OK)
 	{
 		//		adj_synth->synth_program[channel]->set_program_patch_params(params);
 		
-		adj_synth->synth_program[channel]->synth_pad_creator->generate_wavetable(
-			adj_synth->synth_program[channel]->program_wavetable);
-
-		adj_synth->synth_program[channel]->mso_wtab->calc_segments_lengths(
-			&adj_synth->synth_program[channel]->mso_wtab->morphed_segment_lengths, 
-			&adj_synth->synth_program[channel]->mso_wtab->morphed_segment_positions);
-		
-		adj_synth->synth_program[channel]->mso_wtab->calc_wtab(
-			adj_synth->synth_program[channel]->mso_wtab->morphed_waveform_tab, 
-			&adj_synth->synth_program[channel]->mso_wtab->morphed_segment_lengths, 
-			&adj_synth->synth_program[channel]->mso_wtab->morphed_segment_positions);
+		// Generated only if not shared with another program
+		adj_synth->synth_program[channel]->update_pad_wavetable();
+		adj_synth->synth_program[channel]->update_mso_wavetable();
 		
 		//	printf("Open settings  %s\n", path.c_str());
 		return 0;
@@ -944,6 +961,11 @@ void *cheack_cpu_utilization_thread(void *arg)
 		const float IDLE_TIME = curSnap.GetIdleTimeTotal() - previousSnap.GetIdleTimeTotal();
 		const float TOTAL_TIME = ACTIVE_TIME + IDLE_TIME;
 		ModSynth::cpu_utilization = (int)(100.f * ACTIVE_TIME / TOTAL_TIME);
+		
+		// Release the resources of programs that were not used for a while
+		ModSynth::get_instance()->adj_synth->release_idle_programs();
+		// Delete the shared wavetables that are no longer used by any program
+		SynthWavetablesRegistry::get_instance()->purge_unused_wavetables();
 	}
 
 	return NULL;
@@ -30,6 +30,7 @@ int ModSynth::set_adj_synth_default_settings(_settings_params_t *params)
 
 	res = AdjSynth::get_instance()->set_default_settings_parameters_mixer(params);
 	res |= AdjSynth::get_instance()->set_default_settings_parameters_keyboard(params);
+	res |= AdjSynth::get_instance()->set_default_settings_parameters_polyphony(params);
 	res |= AdjSynth::get_instance()->set_default_settings_parameters_reverb(params);
 	res |= AdjSynth::get_instance()->set_default_settings_parameters_equalizer(params);
 	
@@ -95,6 +95,90 @@ int ModSynth::set_default_settings_parameters_audio(_settings_params_t *params)
 		NULL,
 		_SET_VALUE | _SET_TYPE | _SET_CALLBACK,
 		-1);
+	
+	res |= general_settings_manager->set_bool_param(params,
+		"adjsynth.audio.multi_core_voices_rendering_state",
+		_DEFAULT_MULTI_CORE_VOICES_RENDERING,
+		_ADJ_SYNTH_PATCH_PARAMS,
+		set_audio_multi_core_voices_rendering_state_cb,
+		0,
+		0,
+		NULL,
+		_SET_VALUE | _SET_TYPE | _SET_CALLBACK,
+		-1);
+	
+	res |= general_settings_manager->set_bool_param(params,
+		"adjsynth.audio.blocks_arena_state",
+		_DEFAULT_AUDIO_BLOCKS_ARENA,
+		_ADJ_SYNTH_PATCH_PARAMS,
+		set_audio_blocks_arena_state_cb,
+		0,
+		0,
+		NULL,
+		_SET_VALUE | _SET_TYPE | _SET_CALLBACK,
+		-1);
+	
+	res |= general_settings_manager->set_bool_param(params,
+		"adjsynth.audio.jack_direct_output_state",
+		_DEFAULT_JACK_DIRECT_OUTPUT,
+		_ADJ_SYNTH_PATCH_PARAMS,
+		set_audio_jack_direct_output_state_cb,
+		0,
+		0,
+		NULL,
+		_SET_VALUE | _SET_TYPE | _SET_CALLBACK,
+		-1);
+	
+	res |= general_settings_manager->set_bool_param(params,
+		"adjsynth.audio.jack_render_in_callback_state",
+		_DEFAULT_JACK_RENDER_IN_CALLBACK,
+		_ADJ_SYNTH_PATCH_PARAMS,
+		set_audio_jack_render_in_callback_state_cb,
+		0,
+		0,
+		NULL,
+		_SET_VALUE | _SET_TYPE | _SET_CALLBACK,
+		-1);
+	
+	res |= general_settings_manager->set_bool_param(params,
+		"adjsynth.audio.update_timer_catch_up_state",
+		_DEFAULT_UPDATE_TIMER_CATCH_UP,
+		_ADJ_SYNTH_PATCH_PARAMS,
+		set_audio_update_timer_catch_up_state_cb,
+		0,
+		0,
+		NULL,
+		_SET_VALUE | _SET_TYPE | _SET_CALLBACK,
+		-1);
+	
+	res |= general_settings_manager->set_int_param(params,
+		"adjsynth.audio.voice_silence_threshold_db",
+		_DEFAULT_VOICE_SILENCE_THRESHOLD_DB,
+		_VOICE_SILENCE_THRESHOLD_DB_MAX,
+		_VOICE_SILENCE_THRESHOLD_DB_MIN,
+		_ADJ_SYNTH_PATCH_PARAMS,
+		set_audio_voice_silence_threshold_cb,
+		0,
+		0,
+		NULL,
+		_SET_VALUE | _SET_MAX_VAL | _SET_MIN_VAL |
+			_SET_TYPE | _SET_CALLBACK,
+		-1);
+	
+	res |= general_settings_manager->set_int_param(params,
+		"adjsynth.audio.voice_silence_hold_time_ms",
+		_DEFAULT_VOICE_SILENCE_HOLD_MS,
+		_VOICE_SILENCE_HOLD_MS_MAX,
+		_VOICE_SILENCE_HOLD_MS_MIN,
+		_ADJ_SYNTH_PATCH_PARAMS,
+		set_audio_voice_silence_hold_time_cb,
+		0,
+		0,
+		NULL,
+		_SET_VALUE | _SET_MAX_VAL | _SET_MIN_VAL |
+			_SET_TYPE | _SET_CALLBACK,
+		-1);
+	
 	return res;
 }
 
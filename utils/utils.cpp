@@ -1,8 +1,11 @@
 /**
 *	@file		utils.h
 *	@author		Nahum Budin
-*	@date		11-May-2024
-*	@version	1.1
+*	@date		17-Oct-2026
+*	@version	1.2
+*					1. FNV-1a hash (content keys).
+*					
+*	@version	1.1	11-May-2024
 *					1. Update includes
 *
 *	@brief		Utilities.
@@ -91,6 +94,26 @@ int Utils::calc_log_scale_100_int(int min, int max, int base, int val)
 	return (int)(min + (max - min) * pow((double)base, (double)in / 50.0) / 100.0);
 }
 
+/**
+*	@brief	Returns the FNV-1a 64 bits hash of a data buffer
+*	@param	data	a pointer to the data
+*	@param	size	data size (bytes)
+*	@param	hash	initial hash value (the hash of preceding data may be chained)
+*	@return the data hash
+*/
+uint64_t Utils::calc_fnv1a_hash(const void *data, int size, uint64_t hash)
+{
+	const uint8_t *bytes = (const uint8_t*)data;
+	
+	for (int i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ULL;
+	}
+	
+	return hash;
+}
+
 /**
 *	@brief	Runs a system command using system("cmd") and returns redirested output
 *	@param	cmd command
@@ -146,7 +169,7 @@ pid_t Utils::get_process_id(char* process_name)
 */
 bool is_valid_audio_driver(int driver)
 {
-	return (driver == _AUDIO_JACK) || (driver == _AUDIO_ALSA);
+	return (driver == _AUDIO_JACK) || (driver == _AUDIO_ALSA) || (driver == _AUDIO_NULL);
 }
 
 /**
@@ -1,8 +1,11 @@
 /**
 *	@file		utils.h
 *	@author		Nahum Budin
-*	@date		11-May-2024
-*	@version	1.1 
+*	@date		17-Oct-2026
+*	@version	1.2
+*					1. FNV-1a hash (content keys).
+*					
+*	@version	1.1	11-May-2024
 *					1. Update includes
 *
 *	@brief		Utilities.
@@ -26,6 +29,9 @@ using namespace std;
 
 #define PI 3.1415926536f
 
+// FNV-1a 64 bits hash initial value
+#define _FNV1A_64_OFFSET_BASIS	0xcbf29ce484222325ULL
+
 //Random number generator
 typedef uint32_t prng_t;
 extern prng_t prng_state;  // defined at utils.cpp
@@ -40,6 +46,8 @@ public:
 	static std::string execute_system_command_getstd_out(std::string cmd);
 	
 	static pid_t get_process_id(char *process_name);
+	
+	static uint64_t calc_fnv1a_hash(const void *data, int size, uint64_t hash = _FNV1A_64_OFFSET_BASIS);
 };
 
 